@@ -5,8 +5,18 @@
 #pragma once
 
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <functional>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace c4lib::property_tree {
+class Offset_index;
+class Save_document;
+}
 
 // @formatter:off
 /**
@@ -24,6 +34,20 @@
  *                                             Do not use unless the BTS save is for a mod.
  *    USE_MODULAR_LOADING  [0|1]               Set to 1 if modular loading is used.
  *                                             Do not use unless the save uses modular loading.
+ *    SCHEMA_CACHE_DIR     <path>              Directory in which the compiled schema and imported
+ *                                             definitions are cached.  If not specified, no cache
+ *                                             is used.
+ *    WORKER_COUNT         <count>             Number of threads used by read_saves to read
+ *                                             saves.  If not specified or not positive, one
+ *                                             thread per hardware thread is used.
+ *    IMPORT_WORKER_COUNT  <count>             Number of threads used to import definitions.
+ *                                             If not specified or not positive, one thread
+ *                                             per hardware thread is used.
+ *    PIPELINED_READ       [0|1]               Set to 1 to inflate a save on a separate thread
+ *                                             while it is read.
+ *    DEFLATE_CHECKPOINTS  [0|1]               Set to 1 for a Session to record checkpoints
+ *                                             while writing a save, which speed up writing
+ *                                             a save that differs slightly from the last.
  *    OMIT_OFFSET_COLUMN   [0|1]               Set to 1 to omit the offset column when
  *                                             generating translation files.
  *    OMIT_HEX_COLUMN      [0|1]               Set to 1 to omit the hex column when
@@ -38,9 +62,53 @@
  *    DEBUG_WRITE_BINARIES [0|1]               Write various binary files generated internally
  *                                             by the library.
  *    DEBUG_WRITE_IMPORTS  [0|1]               Write imported enums and constants.</pre>
+ *  Thread safety:\n
+ *  The API functions are reentrant.  Calls made concurrently from several threads are safe provided that each call
+ *  is passed its own options map, since options may be modified by the call, and that calls do not share property
+ *  trees being written or files being written.  The Logger may be used concurrently.  A Session is not thread-safe,
+ *  but separate sessions may be used concurrently.
  */
 // @formatter:on
 namespace c4lib {
+struct Save_summary;
+
+/**
+ * Changes to the values of leaves of a save.  Each patch is a pair consisting of the path of a leaf, the dot-separated
+ * names of the nodes from the root to the leaf, and the new value of the leaf.
+ */
+using Save_patches = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * Changes the values of fixed-size leaves of a save without re-serializing it.  Each leaf patched must be a bool,
+ * hex, int, uint or enum; the new value is written in place of the old in the inflated save, which is then
+ * deflated and checksummed again.  The value of an enum is given by its integer value and must be defined by the
+ * enum.  Leaves whose values are read by the schema, e.g., those giving the dimension of an array or tested by an if
+ * statement, cannot be patched, since changing them would change the layout of the data which follows.
+ * @param in_filename path to the save to patch.
+ * @param out_filename path to the patched save to create.  An existing file is overwritten.  out_filename may equal
+ * in_filename.
+ * @param patches changes to make.  If any patch names a leaf which does not exist or cannot be patched, or gives a
+ * value which does not fit the leaf, Ptree_error is thrown and no save is written.
+ * @param options options to use.  SCHEMA, BTS_INSTALL_DIR and CUSTOM_ASSETS_DIR are required.
+ */
+void patch_save(const std::string& in_filename,
+    const std::string& out_filename,
+    const Save_patches& patches,
+    std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Reads the game metadata recorded in the uncompressed header of a save.  Neither the schema nor the BTS definitions
+ * are used and the compressed data is not inflated, so only the first few kilobytes of the save are read.  The
+ * counts of players and game options are those of BTS; the header of a save for a mod which changes these counts
+ * cannot be peeked.
+ * @param summary output summary.  summary will contain the metadata of the save upon return.
+ * @param filename path to the save.
+ * @param options options to use.  No options are currently supported.
+ */
+void peek_save(Save_summary& summary,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
+
 /**
  * Reads a .info-format file.
  * @param pt output property tree.  pt will contain a representation of the .info file upon return.
@@ -61,6 +129,77 @@ void read_save(boost::property_tree::ptree& pt,
     const std::string& filename,
     std::unordered_map<std::string, std::string>& options);
 
+/**
+ * Reads a .CivBeyondSwordSave save and records the location of each leaf in the composite savegame, which consists
+ * of the save's header, its inflated data and its footer.
+ * @param pt output property tree.  pt will contain a representation of the save upon return.
+ * @param index output index.  index will contain the offset, size and type of each leaf of pt upon return.
+ * @param filename path to the save.
+ * @param options options to use.  SCHEMA, BTS_INSTALL_DIR and CUSTOM_ASSETS_DIR are required.
+ */
+void read_save(boost::property_tree::ptree& pt,
+    property_tree::Offset_index& index,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Reads a .CivBeyondSwordSave save held in memory.
+ * @param pt output property tree.  pt will contain a representation of the save upon return.
+ * @param save content of the save.
+ * @param name name of the save.  name is recorded in the property tree's origin node and is used to name debug
+ * and crash-dump files.
+ * @param options options to use.  SCHEMA, BTS_INSTALL_DIR and CUSTOM_ASSETS_DIR are required.
+ */
+void read_save(boost::property_tree::ptree& pt,
+    std::span<const std::byte> save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Reads a .CivBeyondSwordSave save into a Save_document.  A Save_document holds the same information as the
+ * property tree produced by read_save in considerably less memory.
+ * @param document output document.  document will contain a representation of the save upon return.
+ * @param filename path to the save.
+ * @param options options to use.  SCHEMA, BTS_INSTALL_DIR and CUSTOM_ASSETS_DIR are required.
+ */
+void read_save(property_tree::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Reads a .CivBeyondSwordSave save held in memory into a Save_document.
+ * @param document output document.  document will contain a representation of the save upon return.
+ * @param save content of the save.
+ * @param name name of the save.  name is recorded in the document's origin and is used to name debug and
+ * crash-dump files.
+ * @param options options to use.  SCHEMA, BTS_INSTALL_DIR and CUSTOM_ASSETS_DIR are required.
+ */
+void read_save(property_tree::Save_document& document,
+    std::span<const std::byte> save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Function called by read_saves for each save successfully read.  filename is the path to the save and pt contains
+ * its representation.  pt may be modified or moved from but is destroyed once the function returns.
+ */
+using Read_saves_callback = std::function<void(const std::string& filename, boost::property_tree::ptree& pt)>;
+
+/**
+ * Reads several .CivBeyondSwordSave saves concurrently.  The schema is parsed and definitions are imported once; saves
+ * are then read by a pool of worker threads.\n
+ * If a save cannot be read or callback throws, the remaining saves are still read.  Once all saves have been
+ * processed, the first exception encountered is rethrown.
+ * @param filenames paths to the saves.
+ * @param callback function called for each save read.  callback is called from the worker threads and may be called
+ * concurrently for different saves; it must therefore be thread-safe.  The order of calls is unspecified.
+ * @param options options to use.  SCHEMA, BTS_INSTALL_DIR and CUSTOM_ASSETS_DIR are required.  WORKER_COUNT sets the
+ * number of worker threads and IMPORT_WORKER_COUNT the number of threads importing definitions.
+ */
+void read_saves(const std::vector<std::string>& filenames,
+    const Read_saves_callback& callback,
+    std::unordered_map<std::string, std::string>& options);
+
 /**
  * Writes a .info-format file.
  * @param pt property tree to save in .info-file format.
@@ -81,6 +220,36 @@ void write_save(const boost::property_tree::ptree& pt,
     const std::string& filename,
     std::unordered_map<std::string, std::string>& options);
 
+/**
+ * Writes a .CivBeyondSwordSave save to memory.
+ * @param pt property tree to save.
+ * @param save output buffer.  save will contain the content of the save upon return.
+ * @param options options to use.
+ */
+void write_save(const boost::property_tree::ptree& pt,
+    std::vector<std::byte>& save,
+    std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Writes a .CivBeyondSwordSave save from a Save_document.
+ * @param document document to save as a .CivBeyondSwordSave file.
+ * @param filename path to save file to create.  An existing file is overwritten.
+ * @param options options to use.
+ */
+void write_save(const property_tree::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Writes a .CivBeyondSwordSave save to memory from a Save_document.
+ * @param document document to save.
+ * @param save output buffer.  save will contain the content of the save upon return.
+ * @param options options to use.
+ */
+void write_save(const property_tree::Save_document& document,
+    std::vector<std::byte>& save,
+    std::unordered_map<std::string, std::string>& options);
+
 /**
  * Writes a translation.  A translation is a human-readable text file representing a save.
  * @param pt property tree to save as translation.
@@ -90,4 +259,14 @@ void write_save(const boost::property_tree::ptree& pt,
 void write_translation(const boost::property_tree::ptree& pt,
     const std::string& filename,
     std::unordered_map<std::string, std::string>& options);
+
+/**
+ * Writes a translation from a Save_document.
+ * @param document document to save as translation.
+ * @param filename path to translation file to create.  An existing file is overwritten.
+ * @param options options to use.
+ */
+void write_translation(const property_tree::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
 } // namespace c4lib
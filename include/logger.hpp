@@ -4,15 +4,22 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <format>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 namespace c4lib {
 
+/**
+ * Process-wide logger.  Logger is thread-safe: messages logged concurrently from several threads are written whole
+ * and in some order, and start, stop and set_threshold may be called while other threads are logging.  A stream
+ * passed to start must remain valid until stop or start is next called.
+ */
 class Logger {
 public:
     Logger(const Logger&) = delete;
@@ -71,6 +78,8 @@ private:
     {
         if (severity >= instance().m_threshold) {
             try {
+                // Messages may be logged from several threads; serialize access to the stream.
+                const std::scoped_lock lock{instance().m_mutex};
                 const auto now{std::chrono::system_clock::now()};
                 instance().m_out.get() << std::format("{:%m-%d-%Y %H:%M:%OS} UTC", now);
                 instance().m_out.get() << " " << severity_to_string(severity) << ": ";
@@ -124,9 +133,10 @@ private:
     ~Logger() = default;
 
     std::ofstream m_file{};
+    std::mutex m_mutex;
     static std::fstream m_null_out;
     std::reference_wrapper<std::ostream> m_out{m_file};
-    Severity m_threshold{Severity::info};
+    std::atomic<Severity> m_threshold{Severity::info};
 };
 
 } // namespace c4lib
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <include/node-type.hpp>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace c4lib::property_tree {
+
+// Location of a leaf node within the composite savegame, which consists of the header, the inflated data and the
+// footer of a save.
+struct Leaf_offset {
+    // Dot-separated names of the nodes from the root to the leaf, for example Savegame.CvInitCore.GameTurn.
+    std::string path;
+    // Offset of the leaf's data in the composite savegame.
+    size_t offset{0};
+    // Number of bytes occupied by the leaf's data, including the length of a string.
+    size_t size{0};
+    Node_type type{Node_type::invalid};
+};
+
+/**
+ * An index of the location of each leaf of a save, recorded while the save is read.\n
+ * Leaves are held in the order in which they appear in the composite savegame, so the leaves occupying a range of
+ * offsets may be found by binary search.  A leaf may also be found by path in constant time.
+ */
+class Offset_index {
+public:
+    Offset_index() = default;
+
+    ~Offset_index() = default;
+
+    Offset_index(const Offset_index&) = delete;
+
+    Offset_index& operator=(const Offset_index&) = delete;
+
+    Offset_index(Offset_index&&) noexcept = delete;
+
+    Offset_index& operator=(Offset_index&&) noexcept = delete;
+
+    /**
+     * Appends a leaf.  Leaves must be added in order of increasing offset.
+     * @param leaf the leaf to add.
+     */
+    void add(Leaf_offset leaf);
+
+    /**
+     * Returns the leaf at index.
+     * @param index index of the leaf.  Leaves are indexed in order of offset.
+     */
+    [[nodiscard]] const Leaf_offset& at(size_t index) const;
+
+    // Removes all leaves.
+    void clear();
+
+    /**
+     * Returns the number of leaves.
+     */
+    [[nodiscard]] size_t count() const;
+
+    /**
+     * Returns the index of the leaf at path, or limits::invalid_size if there is no such leaf.
+     * @param path dot-separated node names, for example Savegame.CvInitCore.GameTurn.
+     */
+    [[nodiscard]] size_t find(const std::string& path) const;
+
+    /**
+     * Returns the index of the leaf whose data contains offset, or limits::invalid_size if there is no such leaf.
+     * @param offset offset in the composite savegame.
+     */
+    [[nodiscard]] size_t find_offset(size_t offset) const;
+
+    /**
+     * Returns the half-open range of indices of the leaves whose data overlaps the bytes [begin, end) of the composite
+     * savegame.  The range is empty if no leaf overlaps the bytes.
+     * @param begin offset of the first byte.
+     * @param end offset one past the last byte.
+     */
+    [[nodiscard]] std::pair<size_t, size_t> find_range(size_t begin, size_t end) const;
+
+private:
+    std::vector<Leaf_offset> m_leaves;
+    std::unordered_map<std::string, size_t> m_lookup;
+};
+
+} // namespace c4lib::property_tree
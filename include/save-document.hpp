@@ -0,0 +1,160 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/symbol.hpp>
+#include <string>
+#include <vector>
+
+namespace c4lib::property_tree {
+
+class Document_node_emitter;
+
+// A node of a Save_document.  The fields correspond to those of Attributes_node, with names replaced by symbols and
+// the data held in its native form.  Absent names are invalid_symbol.
+struct Document_node {
+    // Flags indicating which optional attributes are present.
+    static constexpr uint8_t has_size{0x01};
+    static constexpr uint8_t has_data{0x02};
+    static constexpr uint8_t has_formatted_data{0x04};
+    static constexpr uint8_t has_subscripts{0x08};
+
+    Node_type type{Node_type::invalid};
+    uint8_t flags{0};
+    // Size of the type in bytes for integer types, otherwise 0.
+    uint8_t size{0};
+    Symbol name{invalid_symbol};
+    Symbol type_name{invalid_symbol};
+    Symbol array_name{invalid_symbol};
+    Symbol enum_name{invalid_symbol};
+    // For enum types, the name of the enumerator.  The formatted data of other types is derived from value.
+    Symbol enumerator{invalid_symbol};
+    // For array elements, the index of the subscripts, e.g., [2][3], in the document's text table.
+    uint32_t subscripts{0};
+    // For integer types, the integer.  For string types, the index of the string in the document's text table.
+    int64_t value{0};
+    // Children occupy the contiguous range [first_child, first_child + child_count) of the document's nodes.
+    uint32_t first_child{0};
+    uint32_t child_count{0};
+};
+
+/**
+ * A compact, typed representation of a save.\n
+ * Nodes are held in a single contiguous arena.  Integers are stored as integers, names and type names are symbols
+ * and the children of a node occupy a contiguous index range.  Node 0 is the root; its children are the top-level
+ * nodes of the save.\n
+ * read_save fills a Save_document directly, without building a property tree.  A Save_document may also be converted
+ * to and from the property tree representation produced by read_save.
+ */
+class Save_document {
+    friend class Document_node_emitter;
+
+public:
+    Save_document();
+
+    ~Save_document() = default;
+
+    Save_document(const Save_document&) = delete;
+
+    Save_document& operator=(const Save_document&) = delete;
+
+    Save_document(Save_document&&) noexcept = delete;
+
+    Save_document& operator=(Save_document&&) noexcept = delete;
+
+    /**
+     * Returns the node at index.
+     * @param index index of the node.  The root has index 0.
+     */
+    [[nodiscard]] const Document_node& at(size_t index) const;
+
+    // Removes all nodes and text.
+    void clear();
+
+    /**
+     * Returns the number of nodes, including the root.
+     */
+    [[nodiscard]] size_t count() const;
+
+    /**
+     * Returns the index of the node at path, or limits::invalid_size if there is no such node.
+     * @param path dot-separated node names, for example Savegame.CvInitCore.LeaderName.
+     */
+    [[nodiscard]] size_t find(const std::string& path) const;
+
+    /**
+     * Replaces the content of the document with that of a property tree produced by read_save or read_info.
+     * @param pt property tree to convert.
+     */
+    void from_ptree(const boost::property_tree::ptree& pt);
+
+    /**
+     * Returns the formatted data of the node at index, as it appears in a translation.
+     */
+    [[nodiscard]] std::string get_formatted_data(size_t index) const;
+
+    /**
+     * Returns the origin of the document.
+     */
+    [[nodiscard]] const Origin_node& get_origin() const;
+
+    /**
+     * Returns the subscripts, e.g., [2][3], of the node at index.  The node must be an array element.
+     */
+    [[nodiscard]] const std::string& get_subscripts(size_t index) const;
+
+    /**
+     * Returns the string for symbol, or the empty string if symbol is invalid_symbol.
+     */
+    [[nodiscard]] static const std::string& get_symbol(Symbol symbol);
+
+    /**
+     * Returns the string data of the node at index.  The node must be a string type.
+     */
+    [[nodiscard]] const std::string& get_text(size_t index) const;
+
+    /**
+     * Returns true if the document has an origin.
+     */
+    [[nodiscard]] bool has_origin() const;
+
+    /**
+     * Converts the node at index, less its children, to a node of the property tree produced by to_ptree.  For the
+     * root, node holds the origin.
+     * @param index index of the node.
+     * @param node output property tree node.  Existing content is removed.
+     */
+    void node_to_ptree(size_t index, boost::property_tree::ptree& node) const;
+
+    /**
+     * Converts the document to a property tree identical to that produced by read_save.
+     * @param pt output property tree.  Existing content is removed.
+     */
+    void to_ptree(boost::property_tree::ptree& pt) const;
+
+private:
+    // Adds the children of the attribute-bearing property tree pt to the document as children of the node at index.
+    void add_children_(size_t index, const boost::property_tree::ptree& pt);
+
+    // Sets the attributes of the node at index from those of the property tree node, node.
+    void add_node_attributes_(size_t index, const boost::property_tree::ptree& node);
+
+    // Sets the size and data of the node at index from attributes, the attributes of a property tree node.
+    void add_node_data_(size_t index, const boost::property_tree::ptree& attributes);
+
+    void add_ptree_children_(size_t index, boost::property_tree::ptree& pt) const;
+
+    std::vector<Document_node> m_nodes;
+    Origin_node m_origin;
+    bool m_has_origin{false};
+    std::vector<std::string> m_texts;
+};
+
+} // namespace c4lib::property_tree
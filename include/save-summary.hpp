@@ -0,0 +1,48 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace c4lib {
+
+// A player slot of a save, as recorded in CvInitCore.  Enumerated values are given as integers since the
+// enumerations are not imported when a save is peeked.
+struct Save_player {
+    std::string leader_name;
+    std::string civ_description;
+    std::string civ_short_description;
+    std::string civ_adjective;
+    // Hash of the player's password, or the empty string if the player has no password.
+    std::string password_hash;
+    std::string email;
+    int32_t civ{0};
+    int32_t leader{0};
+    int32_t team{0};
+    int32_t handicap{0};
+    int32_t slot_status{0};
+    int32_t slot_claim{0};
+    bool is_playable{false};
+    bool is_minor{false};
+};
+
+// Game metadata recorded in the uncompressed header of a save by GameHeader and CvInitCore.  Strings are UTF-8.
+struct Save_summary {
+    uint32_t game_version{0};
+    std::string required_mod;
+    int32_t game_type{0};
+    std::string game_name;
+    std::string game_password_hash;
+    std::string admin_password_hash;
+    std::string map_script_name;
+    int32_t game_turn{0};
+    int32_t max_turns{0};
+    // One entry for each of the MAX_PLAYERS player slots.
+    std::vector<Save_player> players;
+};
+
+} // namespace c4lib
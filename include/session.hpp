@@ -0,0 +1,137 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <include/c4lib.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace c4lib::property_tree {
+class Offset_index;
+class Save_document;
+}
+
+namespace c4lib::schema_parser {
+class Parser;
+}
+
+namespace c4lib::zlib {
+struct Deflate_checkpoints;
+}
+
+namespace c4lib {
+/**
+ * A session reads and writes saves which share the same SCHEMA, BTS_INSTALL_DIR, CUSTOM_ASSETS_DIR, MOD_NAME and
+ * USE_MODULAR_LOADING options.\n
+ * The free function read_save parses the schema and imports definitions each time it is called.  A session does
+ * this once, upon construction, and reuses the result for each save read.  Definitions created while reading a
+ * save, such as the PlayerTypes enum, are discarded before the next save is read.  A session is not thread-safe, but
+ * separate sessions may be used concurrently.\n
+ * If the DEFLATE_CHECKPOINTS option is set, the session records checkpoints while writing a save and uses them to
+ * speed up the next write of a save which differs only slightly.
+ */
+class Session {
+public:
+    /**
+     * Creates a session.  The schema is parsed and definitions are imported.
+     * @param options options to use for each operation performed by the session.  See c4lib.hpp for a description
+     * of options.  SCHEMA, BTS_INSTALL_DIR and CUSTOM_ASSETS_DIR are required.
+     */
+    explicit Session(std::unordered_map<std::string, std::string> options);
+
+    ~Session();
+
+    Session(const Session&) = delete;
+
+    Session& operator=(const Session&) = delete;
+
+    Session(Session&&) noexcept = delete;
+
+    Session& operator=(Session&&) noexcept = delete;
+
+    /**
+     * Changes the values of fixed-size leaves of a save without re-serializing it.  See c4lib::patch_save.
+     * @param in_filename path to the save to patch.
+     * @param out_filename path to the patched save to create.  An existing file is overwritten.
+     * @param patches changes to make.
+     */
+    void patch_save(const std::string& in_filename, const std::string& out_filename, const Save_patches& patches);
+
+    /**
+     * Reads a .CivBeyondSwordSave save.
+     * @param pt output property tree.  pt will contain a representation of the save upon return.
+     * @param filename path to the save.
+     */
+    void read_save(boost::property_tree::ptree& pt, const std::string& filename);
+
+    /**
+     * Reads a .CivBeyondSwordSave save and records the location of each leaf in the composite savegame.
+     * @param pt output property tree.  pt will contain a representation of the save upon return.
+     * @param index output index.  index will contain the offset, size and type of each leaf of pt upon return.
+     * @param filename path to the save.
+     */
+    void read_save(boost::property_tree::ptree& pt, property_tree::Offset_index& index, const std::string& filename);
+
+    /**
+     * Reads a .CivBeyondSwordSave save held in memory.
+     * @param pt output property tree.  pt will contain a representation of the save upon return.
+     * @param save content of the save.
+     * @param name name of the save, used for the origin node and to name debug and crash-dump files.
+     */
+    void read_save(boost::property_tree::ptree& pt, std::span<const std::byte> save, const std::string& name);
+
+    /**
+     * Reads a .CivBeyondSwordSave save into a Save_document.
+     * @param document output document.  document will contain a representation of the save upon return.
+     * @param filename path to the save.
+     */
+    void read_save(property_tree::Save_document& document, const std::string& filename);
+
+    /**
+     * Writes a .CivBeyondSwordSave save.
+     * @param pt property tree to save as a .CivBeyondSwordSave file.
+     * @param filename path to save file to create.  An existing file is overwritten.
+     */
+    void write_save(const boost::property_tree::ptree& pt, const std::string& filename);
+
+    /**
+     * Writes a .CivBeyondSwordSave save to memory.
+     * @param pt property tree to save.
+     * @param save output buffer.  save will contain the content of the save upon return.
+     */
+    void write_save(const boost::property_tree::ptree& pt, std::vector<std::byte>& save);
+
+    /**
+     * Writes a .CivBeyondSwordSave save from a Save_document.
+     * @param document document to save as a .CivBeyondSwordSave file.
+     * @param filename path to save file to create.  An existing file is overwritten.
+     */
+    void write_save(const property_tree::Save_document& document, const std::string& filename);
+
+    /**
+     * Writes a translation.  A translation is a human-readable text file representing a save.
+     * @param pt property tree to save as translation.
+     * @param filename path to translation file to create.  An existing file is overwritten.
+     */
+    void write_translation(const boost::property_tree::ptree& pt, const std::string& filename);
+
+    /**
+     * Writes a translation from a Save_document.
+     * @param document document to save as translation.
+     * @param filename path to translation file to create.  An existing file is overwritten.
+     */
+    void write_translation(const property_tree::Save_document& document, const std::string& filename);
+
+private:
+    std::unordered_map<std::string, std::string> m_options;
+    std::unique_ptr<zlib::Deflate_checkpoints> m_checkpoints;
+    std::unique_ptr<schema_parser::Parser> m_parser;
+};
+} // namespace c4lib
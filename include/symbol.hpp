@@ -0,0 +1,24 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace c4lib {
+
+/**
+ * Identifier of an interned string.\n
+ * Strings are interned in a single process-wide table, so equal strings have equal symbols and symbols may be hashed
+ * and compared in place of the strings they stand for.  A symbol remains valid for the lifetime of the process.
+ */
+using Symbol = uint32_t;
+
+/**
+ * Symbol which stands for no string, used to mark an absent name.
+ */
+inline constexpr Symbol invalid_symbol{std::numeric_limits<Symbol>::max()};
+
+} // namespace c4lib
@@ -5,13 +5,81 @@
 #pragma once
 
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <include/c4lib.hpp>
+#include <include/offset-index.hpp>
+#include <include/save-document.hpp>
 #include <iosfwd>
+#include <lib/schema-parser/parser.hpp>
+#include <lib/zlib/deflate-checkpoints.hpp>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace c4lib {
 
+// Prepares parser for reading saves using the SCHEMA, BTS_INSTALL_DIR, CUSTOM_ASSETS_DIR, MOD_NAME and
+// USE_MODULAR_LOADING options.
+void prepare_parser(schema_parser::Parser& parser, std::unordered_map<std::string, std::string>& options);
+
+// Patches a save using a parser prepared by prepare_parser.
+void patch_save(schema_parser::Parser& parser,
+    const std::string& in_filename,
+    const std::string& out_filename,
+    const Save_patches& patches,
+    std::unordered_map<std::string, std::string>& options);
+
+// Reads a save using a parser prepared by prepare_parser.
+void read_save(schema_parser::Parser& parser,
+    boost::property_tree::ptree& pt,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
+
+// Reads a save using a parser prepared by prepare_parser and records the location of each leaf in index.
+void read_save(schema_parser::Parser& parser,
+    boost::property_tree::ptree& pt,
+    property_tree::Offset_index& index,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
+
+// Reads a save held in memory using a parser prepared by prepare_parser.
+void read_save(schema_parser::Parser& parser,
+    boost::property_tree::ptree& pt,
+    std::span<const std::byte> save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options);
+
+// Reads a save into a Save_document using a parser prepared by prepare_parser.
+void read_save(schema_parser::Parser& parser,
+    property_tree::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options);
+
+// Writes a save, using and recording the deflate checkpoints held by checkpoints, which may be null.
+void write_save(const boost::property_tree::ptree& pt,
+    const std::string& filename,
+    zlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options);
+
+// Writes a save to memory, using and recording the deflate checkpoints held by checkpoints, which may be null.
+void write_save(const boost::property_tree::ptree& pt,
+    std::vector<std::byte>& save,
+    zlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options);
+
+// Writes a save from a Save_document, using and recording the deflate checkpoints held by checkpoints, which may be
+// null.
+void write_save(const property_tree::Save_document& document,
+    const std::string& filename,
+    zlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options);
+
 void write_composite(
     const boost::property_tree::ptree& pt, std::ostream& out, std::unordered_map<std::string, std::string>& options);
 
+void write_composite(const property_tree::Save_document& document,
+    std::ostream& out,
+    std::unordered_map<std::string, std::string>& options);
+
 } // namespace c4lib
@@ -2,38 +2,70 @@
 // This software is licensed under the MIT License.
 // Created by Hankinsohl on 10/25/2024.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <c4lib-version.hpp>
+#include <charconv>
 #include <chrono>
+#include <cstdint>
 #include <cstddef>
 #include <exception>
 #include <format>
 #include <fstream>
 #include <include/c4lib.hpp>
+#include <include/exceptions.hpp>
 #include <include/logger.hpp>
 #include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/offset-index.hpp>
+#include <include/save-document.hpp>
+#include <include/save-summary.hpp>
 #include <ios>
 #include <iosfwd>
 #include <lib/c4lib/c4lib-internal.hpp>
 #include <lib/io/io.hpp>
+#include <lib/layout/header-layout.hpp>
+#include <lib/layout/layout.hpp>
 #include <lib/logger/log-formats.hpp>
 #include <lib/md5/checksum.hpp>
+#include <lib/native/mapped-file.hpp>
 #include <lib/native/path.hpp>
 #include <lib/ptree/binary-node-reader.hpp>
 #include <lib/ptree/binary-node-writer.hpp>
+#include <lib/ptree/document-node-emitter.hpp>
+#include <lib/ptree/ptree-node-emitter.hpp>
 #include <lib/ptree/recursive-node-source.hpp>
 #include <lib/ptree/translation-node-writer.hpp>
 #include <lib/ptree/util.hpp>
+#include <lib/schema-parser/def-mem.hpp>
+#include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/definition.hpp>
 #include <lib/schema-parser/parser.hpp>
+#include <lib/schema-parser/schema-compiler.hpp>
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/limits.hpp>
 #include <lib/util/narrow.hpp>
 #include <lib/util/options.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <lib/util/timer.hpp>
+#include <lib/zlib/deflate-checkpoints.hpp>
+#include <lib/zlib/deflate-streambuf.hpp>
 #include <lib/zlib/zlib-engine.hpp>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace bpt = boost::property_tree;
 namespace cpt = c4lib::property_tree;
@@ -65,31 +97,349 @@ void read_info_dispatch_(bpt::ptree& pt, const std::string& filename)
     bpt::read_info(c4lib::native::Path{filename}, pt);
 }
 
-void read_save_dispatch_(
-    bpt::ptree& pt, const std::string& filename, std::unordered_map<std::string, std::string>& options)
+void prepare_parser_dispatch_(csp::Parser& parser, std::unordered_map<std::string, std::string>& options)
 {
-    // Clear the ptree and add an origin node.
-    pt.clear();
-    bpt::ptree& origin{pt.put_child(cpt::nn_origin, bpt::ptree{cpt::nv_meta})};
-    const c4lib::native::Path filename_path{filename};
     const c4lib::native::Path schema_path{options[c4lib::options::schema]};
-    origin.add(cpt::nn_savegame, filename_path.str());
-    origin.add(cpt::nn_schema, schema_path.str());
-    // Note: std::chrono::current_zone() is not yet fully implemented by most compilers; therefore
-    // we'll use UTC instead of local time.
-    const auto now{std::chrono::system_clock::now()};
-    origin.add(cpt::nn_date, std::format("{:%m-%d-%Y %H:%M:%OS} UTC", now));
-    origin.add(cpt::nn_c4lib_version, c4lib::constants::c4lib_version);
-
     const c4lib::native::Path custom_assets_path{options[c4lib::options::custom_assets_dir]};
     const c4lib::native::Path install_path{options[c4lib::options::bts_install_dir]};
     const std::string mod_name{options[c4lib::options::mod_name]};
     const bool use_modular_loading{options[c4lib::options::use_modular_loading] == "1"};
 
+    parser.prepare(schema_path, install_path, custom_assets_path, mod_name, use_modular_loading, options);
+}
+
+// Returns the origin of the save named name, read now.
+cpt::Origin_node make_origin_(const std::string& name, std::unordered_map<std::string, std::string>& options)
+{
+    cpt::Origin_node origin;
+    origin.savegame = c4lib::native::Path{name}.str();
+    origin.schema = c4lib::native::Path{options[c4lib::options::schema]}.str();
+    // Note: std::chrono::current_zone() is not yet fully implemented by most compilers; therefore
+    // we'll use UTC instead of local time.
+    const auto now{std::chrono::system_clock::now()};
+    origin.date = std::format("{:%m-%d-%Y %H:%M:%OS} UTC", now);
+    origin.c4lib_version = c4lib::constants::c4lib_version;
+    return origin;
+}
+
+// Reads a save using reader.  name identifies the save in the origin node and names debug files.
+void read_prepared_save_(csp::Parser& parser,
+    bpt::ptree& pt,
+    const std::string& name,
+    cpt::Binary_node_reader& reader,
+    std::unordered_map<std::string, std::string>& options)
+{
+    // Clear the ptree and add an origin node.
+    pt.clear();
+    const cpt::Origin_node origin{make_origin_(name, options)};
+    bpt::ptree& origin_node{pt.put_child(cpt::nn_origin, bpt::ptree{cpt::nv_meta})};
+    origin_node.add(cpt::nn_savegame, origin.savegame);
+    origin_node.add(cpt::nn_schema, origin.schema);
+    origin_node.add(cpt::nn_date, origin.date);
+    origin_node.add(cpt::nn_c4lib_version, origin.c4lib_version);
+
+    cpt::Ptree_node_emitter emitter{pt};
+    parser.parse_save(emitter, c4lib::native::Path{name}, reader, options);
+}
+
+// Reads a save into document using reader.  The nodes are emitted directly into the document; no property tree is
+// built.  name identifies the save in the origin and names debug files.
+void read_prepared_save_(csp::Parser& parser,
+    cpt::Save_document& document,
+    const std::string& name,
+    cpt::Binary_node_reader& reader,
+    std::unordered_map<std::string, std::string>& options)
+{
+    cpt::Document_node_emitter emitter{document};
+    emitter.set_origin(make_origin_(name, options));
+    parser.parse_save(emitter, c4lib::native::Path{name}, reader, options);
+    emitter.finish();
+}
+
+void read_prepared_save_dispatch_(csp::Parser& parser,
+    bpt::ptree& pt,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    cpt::Binary_node_reader binary_node_reader;
+    read_prepared_save_(parser, pt, filename, binary_node_reader, options);
+}
+
+void read_prepared_save_indexed_dispatch_(csp::Parser& parser,
+    bpt::ptree& pt,
+    cpt::Offset_index& index,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    cpt::Binary_node_reader binary_node_reader;
+    binary_node_reader.enable_offset_index();
+    read_prepared_save_(parser, pt, filename, binary_node_reader, options);
+    binary_node_reader.build_offset_index(pt, index);
+}
+
+void read_prepared_save_buffer_dispatch_(csp::Parser& parser,
+    bpt::ptree& pt,
+    const std::span<const std::byte>& save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options)
+{
+    cpt::Binary_node_reader binary_node_reader{save};
+    read_prepared_save_(parser, pt, name, binary_node_reader, options);
+}
+
+void read_prepared_save_document_dispatch_(csp::Parser& parser,
+    cpt::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
     cpt::Binary_node_reader binary_node_reader;
+    read_prepared_save_(parser, document, filename, binary_node_reader, options);
+}
+
+void read_prepared_save_document_buffer_dispatch_(csp::Parser& parser,
+    cpt::Save_document& document,
+    const std::span<const std::byte>& save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options)
+{
+    cpt::Binary_node_reader binary_node_reader{save};
+    read_prepared_save_(parser, document, name, binary_node_reader, options);
+}
+
+// Writes value in place of the leaf at path in composite.  document and emitter hold the save read from composite using
+// parser.  Leaves whose values are read by the schema cannot be patched, since changing them would change the layout
+// of the data following them or fail an assert; referenced_names holds the names of such leaves.
+void patch_leaf_(std::vector<std::byte>& composite,
+    const cpt::Save_document& document,
+    const cpt::Document_node_emitter& emitter,
+    const csp::Parser& parser,
+    const std::unordered_set<c4lib::Symbol>& referenced_names,
+    const std::string& path,
+    const std::string& value)
+{
+    const size_t node_index{document.find(path)};
+    if (node_index == c4lib::limits::invalid_size) {
+        throw c4lib::Ptree_error{std::format(c4lib::fmt::node_not_found, path)};
+    }
+    const cpt::Document_node& node{document.at(node_index)};
+    const cpt::Leaf_offset& leaf{emitter.get_leaf_offset(node_index)};
+    const bool is_signed{leaf.type == cpt::Node_type::int_type || leaf.type == cpt::Node_type::enum_type};
+    if ((!is_signed && leaf.type != cpt::Node_type::bool_type && leaf.type != cpt::Node_type::hex_type
+            && leaf.type != cpt::Node_type::uint_type)
+        || leaf.offset == c4lib::limits::invalid_size || leaf.offset + leaf.size > composite.size()) {
+        throw c4lib::Ptree_error{std::format(c4lib::fmt::node_cannot_be_patched, path, to_string(node.type))};
+    }
+
+    // The elements of an array are referenced through the array, so the name checked is that of the last node along
+    // the path which isn't an array element, e.g., Lengths for Savegame.Lengths.[2].
+    size_t name_end{path.size()};
+    size_t name_begin{path.rfind('.') + 1};
+    while (path[name_begin] == '[' && name_begin > 1) {
+        name_end = name_begin - 1;
+        name_begin = path.rfind('.', name_end - 1) + 1;
+    }
+    const std::string_view name{std::string_view{path}.substr(name_begin, name_end - name_begin)};
+    if (referenced_names.contains(c4lib::symbol_table::find(name))) {
+        throw c4lib::Ptree_error{std::format(c4lib::fmt::node_referenced_by_schema, path)};
+    }
+
+    // Values are decimal unless prefixed by 0x, as formatted hex values are.
+    int64_t number{0};
+    const bool is_hex{value.starts_with("0x")};
+    const char* const first{value.data() + (is_hex ? 2 : 0)}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char* const last{value.data() + value.size()}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto [end, error]{std::from_chars(first, last, number, is_hex ? 16 : 10)};
+    const size_t bits{leaf.size * 8};
+    const int64_t min{is_signed ? -(int64_t{1} << (bits - 1)) : 0};
+    const int64_t max{leaf.type == cpt::Node_type::bool_type ? 1
+                      : is_signed                           ? (int64_t{1} << (bits - 1)) - 1
+                                                            : (int64_t{1} << bits) - 1};
+    if (error != std::errc{} || end != last || first == last || number < min || number > max) {
+        throw c4lib::Ptree_error{std::format(c4lib::fmt::out_of_range_error, value, path)};
+    }
+    if (leaf.type == cpt::Node_type::enum_type) {
+        const csp::Definition& definition{
+            parser.get_definition_table().get_definition(node.enum_name, csp::Def_type::enum_type)};
+        if (std::ranges::none_of(definition.get_members(),
+                [number](const csp::Def_mem& enumerator) { return enumerator.value == number; })) {
+            throw c4lib::Ptree_error{std::format(
+                c4lib::fmt::enumerator_value_not_found, value, c4lib::symbol_table::name(node.enum_name), path)};
+        }
+    }
+
+    // Integers are stored in little-endian order, so the bytes of a narrower integer are the leading bytes of the
+    // 32-bit integer.
+    auto bytes{static_cast<uint32_t>(number)};
+    std::array<std::byte, sizeof(uint32_t)> little_endian{};
+    c4lib::io::write_int(little_endian.data(), bytes);
+    std::copy_n(little_endian.begin(), leaf.size, composite.begin() + gsl::narrow<std::ptrdiff_t>(leaf.offset));
+}
+
+// Reads the save in_filename, patches it and writes the result to out_filename.
+void patch_prepared_save_dispatch_(csp::Parser& parser,
+    const std::string& in_filename,
+    const std::string& out_filename,
+    const c4lib::Save_patches& patches,
+    std::unordered_map<std::string, std::string>& options)
+{
+    // The schema is interpreted to locate the leaves, since the offset of a leaf depends upon the data preceding it.
+    // The save is read into a Save_document whose emitter records the offset of each leaf.  The composite savegame
+    // read is retained so that it need not be serialized again.
+    cpt::Save_document document;
+    cpt::Binary_node_reader reader;
+    reader.enable_offset_index();
+    reader.disable_pipelined_read();
+    cpt::Document_node_emitter emitter{document};
+    emitter.enable_leaf_offsets();
+    parser.parse_save(emitter, c4lib::native::Path{in_filename}, reader, options);
+    emitter.finish();
+    std::vector<std::byte> composite{reader.take_composite()};
+
+    const std::unordered_set<c4lib::Symbol> referenced_names{
+        csp::Schema_compiler::get_referenced_node_names(parser.get_program())};
+    for (const auto& [path, value] : patches) {
+        patch_leaf_(composite, document, emitter, parser, referenced_names, path, value);
+    }
+
+    std::stringstream binary_savegame;
+    binary_savegame.unsetf(std::ios::skipws);
+    {
+        czlib::Deflate_streambuf save_buffer{binary_savegame, cpt::get_footer_size(document),
+            cpt::get_max_players(document), cpt::get_num_game_option_types(document),
+            cpt::get_num_multiplayer_option_types(document)};
+        std::ostream out{&save_buffer};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        c4lib::io::write_bytes(out, reinterpret_cast<const char*>(composite.data()),
+            gsl::narrow<std::streamsize>(composite.size()));
+        save_buffer.finish();
+    }
+    c4lib::io::write_binary_stream_to_file(binary_savegame, 0, 0, out_filename);
+}
+
+void patch_save_dispatch_(const std::string& in_filename,
+    const std::string& out_filename,
+    const c4lib::Save_patches& patches,
+    std::unordered_map<std::string, std::string>& options)
+{
+    csp::Parser parser;
+    prepare_parser_dispatch_(parser, options);
+    patch_prepared_save_dispatch_(parser, in_filename, out_filename, patches, options);
+}
+
+void peek_save_dispatch_(c4lib::Save_summary& summary, const std::string& filename)
+{
+    // The file is mapped so that only the pages spanned by the header are read.
+    const c4lib::native::Mapped_file file{filename};
+    const c4lib::layout::Header_layout header_layout{file.bytes(),
+        c4lib::layout::bts_max_players,
+        c4lib::layout::bts_num_game_option_types,
+        c4lib::layout::bts_num_multiplayer_option_types};
+    header_layout.get_save_summary(summary);
+}
+
+void read_save_dispatch_(
+    bpt::ptree& pt, const std::string& filename, std::unordered_map<std::string, std::string>& options)
+{
+    csp::Parser parser;
+    prepare_parser_dispatch_(parser, options);
+    read_prepared_save_dispatch_(parser, pt, filename, options);
+}
+
+void read_save_indexed_dispatch_(bpt::ptree& pt,
+    cpt::Offset_index& index,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
     csp::Parser parser;
-    parser.parse(schema_path, install_path, custom_assets_path, mod_name, use_modular_loading, pt, filename_path,
-        binary_node_reader, options);
+    prepare_parser_dispatch_(parser, options);
+    read_prepared_save_indexed_dispatch_(parser, pt, index, filename, options);
+}
+
+void read_save_buffer_dispatch_(bpt::ptree& pt,
+    const std::span<const std::byte>& save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options)
+{
+    csp::Parser parser;
+    prepare_parser_dispatch_(parser, options);
+    read_prepared_save_buffer_dispatch_(parser, pt, save, name, options);
+}
+
+void read_save_document_dispatch_(
+    cpt::Save_document& document, const std::string& filename, std::unordered_map<std::string, std::string>& options)
+{
+    csp::Parser parser;
+    prepare_parser_dispatch_(parser, options);
+    read_prepared_save_document_dispatch_(parser, document, filename, options);
+}
+
+void read_save_document_buffer_dispatch_(cpt::Save_document& document,
+    const std::span<const std::byte>& save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options)
+{
+    csp::Parser parser;
+    prepare_parser_dispatch_(parser, options);
+    read_prepared_save_document_buffer_dispatch_(parser, document, save, name, options);
+}
+
+void read_saves_dispatch_(const std::vector<std::string>& filenames,
+    const c4lib::Read_saves_callback& callback,
+    std::unordered_map<std::string, std::string>& options)
+{
+    // Parse the schema and import definitions once.  The prepared parser is never used to read a save; each worker
+    // copies its state instead.  Definitions are imported by IMPORT_WORKER_COUNT threads before any save is read.
+    csp::Parser prepared;
+    prepare_parser_dispatch_(prepared, options);
+
+    const size_t worker_count{std::clamp(c4lib::options::get_worker_count(options, c4lib::options::worker_count),
+        size_t{1}, std::max(filenames.size(), size_t{1}))};
+
+    std::atomic<size_t> next_index{0};
+    std::mutex error_mutex;
+    std::exception_ptr first_error;
+    const auto record_error{[&]() {
+        const std::scoped_lock lock{error_mutex};
+        if (!first_error) {
+            first_error = std::current_exception();
+        }
+    }};
+
+    const auto worker{[&]() {
+        try {
+            // Reading a save modifies both the parser and the options, so each worker requires its own copy.
+            csp::Parser parser;
+            parser.prepare(prepared);
+            std::unordered_map<std::string, std::string> worker_options{options};
+            for (size_t index = next_index++; index < filenames.size(); index = next_index++) {
+                try {
+                    bpt::ptree pt;
+                    c4lib::read_save(parser, pt, filenames[index], worker_options);
+                    callback(filenames[index], pt);
+                }
+                catch (...) {
+                    record_error();
+                }
+            }
+        }
+        catch (...) {
+            record_error();
+        }
+    }};
+
+    // The calling thread acts as one of the workers.  Destruction of workers joins the remaining threads.
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(worker_count - 1);
+        for (size_t i = 1; i < worker_count; ++i) {
+            workers.emplace_back(worker);
+        }
+        worker();
+    }
+
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
 }
 
 void write_composite_dispatch_(
@@ -107,34 +457,47 @@ void write_info_dispatch_(const bpt::ptree& pt, const std::string& filename)
     bpt::write_info(c4lib::native::Path{filename}, pt);
 }
 
-void write_save_dispatch_(
-    const bpt::ptree& pt, const std::string& filename, std::unordered_map<std::string, std::string>& options)
+void write_composite_document_dispatch_(
+    const cpt::Save_document& document, std::ostream& out, std::unordered_map<std::string, std::string>&)
 {
-    const c4lib::native::Path filename_path{filename};
+    cpt::Binary_node_writer writer;
+    writer.write_document(document, out);
+}
 
-    // Generate a composite savegame stream as input to deflate.
-    std::stringstream composite;
-    composite.unsetf(std::ios::skipws);
-    c4lib::write_composite(pt, composite, options);
+// Returns the bytes of s, without copying them.
+std::span<const std::byte> as_bytes_(std::string_view s)
+{
+    return std::as_bytes(std::span{s.data(), s.size()});
+}
+
+// Deflates composite and adds the checksum, writing the save to binary_savegame.  The remaining arguments are
+// obtained from the property tree or document from which composite was generated.  filename is used only to name
+// debug files.
+void make_save_from_composite_(std::stringstream& composite,
+    const std::string& filename,
+    size_t count_footer,
+    int max_players,
+    int num_game_option_types,
+    int num_multiplayer_option_types,
+    std::stringstream& binary_savegame,
+    std::unordered_map<std::string, std::string>& options)
+{
+    const c4lib::native::Path filename_path{filename};
 
     // Deflate the composite savegame stream.
     czlib::ZLib_engine engine;
-    std::stringstream binary_savegame;
     binary_savegame.unsetf(std::ios::skipws);
-    const size_t count_footer{cpt::get_footer_size(pt)};
     size_t count_header{c4lib::limits::invalid_size};
     size_t count_compressed{c4lib::limits::invalid_size};
     size_t count_decompressed{c4lib::limits::invalid_size};
     size_t count_total{c4lib::limits::invalid_size};
 
-    engine.deflate(filename_path, composite, binary_savegame, count_footer, count_header, count_compressed,
-        count_decompressed, count_total, options);
+    engine.deflate(filename_path, as_bytes_(composite.view()), binary_savegame, count_footer, count_header,
+        count_compressed, count_decompressed, count_total, options);
 
-    // Calculate the checksum for the savegame.
-    const int max_players{cpt::get_max_players(pt)};
-    const int num_game_option_types{cpt::get_num_game_option_types(pt)};
-    const int num_multiplayer_option_types{cpt::get_num_multiplayer_option_types(pt)};
-    c4lib::md5::Checksum checksum(binary_savegame, max_players, num_game_option_types, num_multiplayer_option_types);
+    // Calculate the checksum for the savegame.  The view of binary_savegame remains valid until it is written below.
+    c4lib::md5::Checksum checksum(
+        as_bytes_(binary_savegame.view()), max_players, num_game_option_types, num_multiplayer_option_types);
     const std::string md5{checksum.get_hash()};
 
     // Position savegame to checksum location.  The checksum is the final field written to the savegame and is
@@ -144,9 +507,87 @@ void write_save_dispatch_(
 
     // Write the checksum.  write_string also writes the string length.
     c4lib::io::write_string(binary_savegame, md5);
+}
+
+// Generates the binary save for pt, or for a Save_document, in binary_savegame.  checkpoints, which may be null, holds
+// the deflate checkpoints used and recorded by the write.
+template<typename T> void make_save_(const T& source,
+    const std::string& filename,
+    std::stringstream& binary_savegame,
+    czlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options)
+{
+    // Serialize, deflate and checksum the savegame in a single pass.  Debug binaries are written by deflate, which
+    // requires the entire composite savegame, so the composite savegame is generated separately when they are written.
+    if (options[c4lib::options::debug_write_binaries] != "1") {
+        binary_savegame.unsetf(std::ios::skipws);
+        czlib::Deflate_streambuf save_buffer{binary_savegame, cpt::get_footer_size(source),
+            cpt::get_max_players(source), cpt::get_num_game_option_types(source),
+            cpt::get_num_multiplayer_option_types(source), checkpoints};
+        std::ostream composite{&save_buffer};
+        c4lib::write_composite(source, composite, options);
+        save_buffer.finish();
+        return;
+    }
+
+    // Generate a composite savegame stream as input to deflate.
+    std::stringstream composite;
+    composite.unsetf(std::ios::skipws);
+    c4lib::write_composite(source, composite, options);
+
+    make_save_from_composite_(composite, filename, cpt::get_footer_size(source), cpt::get_max_players(source),
+        cpt::get_num_game_option_types(source), cpt::get_num_multiplayer_option_types(source), binary_savegame,
+        options);
+}
+
+// Copies the content of in to save.
+void copy_to_bytes_(const std::stringstream& in, std::vector<std::byte>& save)
+{
+    const std::span<const std::byte> bytes{as_bytes_(in.view())};
+    save.assign(bytes.begin(), bytes.end());
+}
+
+void write_save_dispatch_(const bpt::ptree& pt,
+    const std::string& filename,
+    czlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options)
+{
+    std::stringstream binary_savegame;
+    make_save_(pt, filename, binary_savegame, checkpoints, options);
+
+    // Write the savegame to the destination file.
+    c4lib::io::write_binary_stream_to_file(binary_savegame, 0, 0, filename);
+}
+
+void write_save_buffer_dispatch_(const bpt::ptree& pt,
+    std::vector<std::byte>& save,
+    czlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options)
+{
+    std::stringstream binary_savegame;
+    make_save_(pt, "", binary_savegame, checkpoints, options);
+    copy_to_bytes_(binary_savegame, save);
+}
+
+void write_save_document_dispatch_(const cpt::Save_document& document,
+    const std::string& filename,
+    czlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options)
+{
+    std::stringstream binary_savegame;
+    make_save_(document, filename, binary_savegame, checkpoints, options);
 
     // Write the savegame to the destination file.
-    c4lib::io::write_binary_stream_to_file(binary_savegame, 0, 0, filename_path);
+    c4lib::io::write_binary_stream_to_file(binary_savegame, 0, 0, filename);
+}
+
+void write_save_document_buffer_dispatch_(const cpt::Save_document& document,
+    std::vector<std::byte>& save,
+    std::unordered_map<std::string, std::string>& options)
+{
+    std::stringstream binary_savegame;
+    make_save_(document, "", binary_savegame, nullptr, options);
+    copy_to_bytes_(binary_savegame, save);
 }
 
 void write_translation_dispatch_(
@@ -166,25 +607,165 @@ void write_translation_dispatch_(
     writer.finish();
 }
 
+// Writes the descendants of the node at index within document, whose children are at depth, to writer.  node is
+// reused to hold each node as it is written.
+void write_document_translation_(const cpt::Save_document& document,
+    size_t index,
+    int depth,
+    bpt::ptree& node,
+    cpt::Translation_node_writer& writer)
+{
+    const cpt::Document_node& parent{document.at(index)};
+    for (size_t child = parent.first_child; child < parent.first_child + parent.child_count; ++child) {
+        document.node_to_ptree(child, node);
+        writer.write_node({depth, node});
+        write_document_translation_(document, child, depth + 1, node, writer);
+    }
+}
+
+void write_translation_document_dispatch_(const cpt::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    c4lib::native::Path filename_path{filename};
+    std::ofstream out{filename_path, std::ios_base::out};
+    if (!out.is_open() || out.bad()) {
+        throw std::runtime_error{std::format(c4lib::fmt::runtime_error_opening_file, filename_path)};
+    }
+
+    // The translation node writer reads only the attributes of each node, so each node is converted to a property
+    // tree node as it is written rather than converting the document to a property tree.
+    cpt::Translation_node_writer writer;
+    bpt::ptree node;
+    document.node_to_ptree(0, node);
+    writer.init(node, out, options);
+    write_document_translation_(document, 0, 0, node, writer);
+    writer.finish();
+}
+
 } // namespace
 
 namespace c4lib {
 
+void patch_save(const std::string& in_filename,
+    const std::string& out_filename,
+    const Save_patches& patches,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(patch_save_dispatch_, "patch_save", in_filename, out_filename, patches, options);
+}
+
+void patch_save(csp::Parser& parser,
+    const std::string& in_filename,
+    const std::string& out_filename,
+    const Save_patches& patches,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(patch_prepared_save_dispatch_, "patch_save", parser, in_filename, out_filename, patches, options);
+}
+
+void peek_save(Save_summary& summary, const std::string& filename, std::unordered_map<std::string, std::string>&)
+{
+    dispatch_(peek_save_dispatch_, "peek_save", summary, filename);
+}
+
 void read_info(bpt::ptree& pt, const std::string& filename, std::unordered_map<std::string, std::string>&)
 {
     dispatch_(read_info_dispatch_, "read_info", pt, filename);
 }
 
+void prepare_parser(csp::Parser& parser, std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(prepare_parser_dispatch_, "prepare_parser", parser, options);
+}
+
 void read_save(bpt::ptree& pt, const std::string& filename, std::unordered_map<std::string, std::string>& options)
 {
     dispatch_(read_save_dispatch_, "read_save", pt, filename, options);
 }
 
+void read_save(bpt::ptree& pt,
+    cpt::Offset_index& index,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_save_indexed_dispatch_, "read_save", pt, index, filename, options);
+}
+
+void read_save(bpt::ptree& pt,
+    std::span<const std::byte> save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_save_buffer_dispatch_, "read_save", pt, save, name, options);
+}
+
+void read_save(csp::Parser& parser,
+    bpt::ptree& pt,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_prepared_save_dispatch_, "read_save", parser, pt, filename, options);
+}
+
+void read_save(csp::Parser& parser,
+    bpt::ptree& pt,
+    cpt::Offset_index& index,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_prepared_save_indexed_dispatch_, "read_save", parser, pt, index, filename, options);
+}
+
+void read_save(csp::Parser& parser,
+    bpt::ptree& pt,
+    std::span<const std::byte> save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_prepared_save_buffer_dispatch_, "read_save", parser, pt, save, name, options);
+}
+
+void read_save(csp::Parser& parser,
+    cpt::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_prepared_save_document_dispatch_, "read_save", parser, document, filename, options);
+}
+
+void read_save(
+    cpt::Save_document& document, const std::string& filename, std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_save_document_dispatch_, "read_save", document, filename, options);
+}
+
+void read_save(cpt::Save_document& document,
+    std::span<const std::byte> save,
+    const std::string& name,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_save_document_buffer_dispatch_, "read_save", document, save, name, options);
+}
+
+void read_saves(const std::vector<std::string>& filenames,
+    const Read_saves_callback& callback,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(read_saves_dispatch_, "read_saves", filenames, callback, options);
+}
+
 void write_composite(const bpt::ptree& pt, std::ostream& out, std::unordered_map<std::string, std::string>& options)
 {
     dispatch_(write_composite_dispatch_, "write_composite", pt, out, options);
 }
 
+void write_composite(
+    const cpt::Save_document& document, std::ostream& out, std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(write_composite_document_dispatch_, "write_composite", document, out, options);
+}
+
 void write_info(const bpt::ptree& pt, const std::string& filename, std::unordered_map<std::string, std::string>&)
 {
     dispatch_(write_info_dispatch_, "write_info", pt, filename);
@@ -193,7 +774,54 @@ void write_info(const bpt::ptree& pt, const std::string& filename, std::unordere
 void write_save(
     const bpt::ptree& pt, const std::string& filename, std::unordered_map<std::string, std::string>& options)
 {
-    dispatch_(write_save_dispatch_, "write_save", pt, filename, options);
+    czlib::Deflate_checkpoints* checkpoints{nullptr};
+    dispatch_(write_save_dispatch_, "write_save", pt, filename, checkpoints, options);
+}
+
+void write_save(
+    const bpt::ptree& pt, std::vector<std::byte>& save, std::unordered_map<std::string, std::string>& options)
+{
+    czlib::Deflate_checkpoints* checkpoints{nullptr};
+    dispatch_(write_save_buffer_dispatch_, "write_save", pt, save, checkpoints, options);
+}
+
+void write_save(const cpt::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    czlib::Deflate_checkpoints* checkpoints{nullptr};
+    dispatch_(write_save_document_dispatch_, "write_save", document, filename, checkpoints, options);
+}
+
+void write_save(const cpt::Save_document& document,
+    std::vector<std::byte>& save,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(write_save_document_buffer_dispatch_, "write_save", document, save, options);
+}
+
+void write_save(const bpt::ptree& pt,
+    const std::string& filename,
+    czlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(write_save_dispatch_, "write_save", pt, filename, checkpoints, options);
+}
+
+void write_save(const bpt::ptree& pt,
+    std::vector<std::byte>& save,
+    czlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(write_save_buffer_dispatch_, "write_save", pt, save, checkpoints, options);
+}
+
+void write_save(const cpt::Save_document& document,
+    const std::string& filename,
+    czlib::Deflate_checkpoints* checkpoints,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(write_save_document_dispatch_, "write_save", document, filename, checkpoints, options);
 }
 
 void write_translation(
@@ -202,4 +830,11 @@ void write_translation(
     dispatch_(write_translation_dispatch_, "write_translation", pt, filename, options);
 }
 
+void write_translation(const cpt::Save_document& document,
+    const std::string& filename,
+    std::unordered_map<std::string, std::string>& options)
+{
+    dispatch_(write_translation_document_dispatch_, "write_translation", document, filename, options);
+}
+
 } // namespace c4lib
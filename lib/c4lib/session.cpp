@@ -0,0 +1,91 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <include/c4lib.hpp>
+#include <include/offset-index.hpp>
+#include <include/save-document.hpp>
+#include <include/session.hpp>
+#include <lib/c4lib/c4lib-internal.hpp>
+#include <lib/schema-parser/parser.hpp>
+#include <lib/util/options.hpp>
+#include <lib/util/tune.hpp>
+#include <lib/zlib/deflate-checkpoints.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bpt = boost::property_tree;
+namespace cpt = c4lib::property_tree;
+namespace csp = c4lib::schema_parser;
+
+namespace c4lib {
+
+Session::Session(std::unordered_map<std::string, std::string> options)
+    : m_options(std::move(options)), m_parser(std::make_unique<csp::Parser>())
+{
+    prepare_parser(*m_parser, m_options);
+    if (m_options[options::deflate_checkpoints] == "1") {
+        m_checkpoints = std::make_unique<zlib::Deflate_checkpoints>(tune::deflate_checkpoint_interval);
+    }
+}
+
+Session::~Session() = default;
+
+void Session::patch_save(const std::string& in_filename, const std::string& out_filename, const Save_patches& patches)
+{
+    c4lib::patch_save(*m_parser, in_filename, out_filename, patches, m_options);
+}
+
+void Session::read_save(bpt::ptree& pt, const std::string& filename)
+{
+    c4lib::read_save(*m_parser, pt, filename, m_options);
+}
+
+void Session::read_save(bpt::ptree& pt, cpt::Offset_index& index, const std::string& filename)
+{
+    c4lib::read_save(*m_parser, pt, index, filename, m_options);
+}
+
+void Session::read_save(bpt::ptree& pt, std::span<const std::byte> save, const std::string& name)
+{
+    c4lib::read_save(*m_parser, pt, save, name, m_options);
+}
+
+void Session::read_save(cpt::Save_document& document, const std::string& filename)
+{
+    c4lib::read_save(*m_parser, document, filename, m_options);
+}
+
+void Session::write_save(const bpt::ptree& pt, const std::string& filename)
+{
+    c4lib::write_save(pt, filename, m_checkpoints.get(), m_options);
+}
+
+void Session::write_save(const bpt::ptree& pt, std::vector<std::byte>& save)
+{
+    c4lib::write_save(pt, save, m_checkpoints.get(), m_options);
+}
+
+void Session::write_save(const cpt::Save_document& document, const std::string& filename)
+{
+    c4lib::write_save(document, filename, m_checkpoints.get(), m_options);
+}
+
+void Session::write_translation(const bpt::ptree& pt, const std::string& filename)
+{
+    c4lib::write_translation(pt, filename, m_options);
+}
+
+void Session::write_translation(const cpt::Save_document& document, const std::string& filename)
+{
+    c4lib::write_translation(document, filename, m_options);
+}
+
+} // namespace c4lib
@@ -0,0 +1,69 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <vector>
+
+namespace c4lib::expression_parser {
+
+// Reference to a ptree node, e.g., r.cn1.cn2.[i].  Keys holds the symbol of the name of each node along the path;
+// invalid_symbol stands for an array subscript, e.g., [i], whose value is computed when the expression is evaluated.
+struct Node_reference {
+    std::vector<Symbol> keys;
+    size_t subscript_count{0};
+    // Index of the reference's entry in the variable manager's node cache, which holds the node most recently found
+    // for the reference.  Assigned by the schema compiler; limits::invalid_size if the reference is not cached.
+    size_t slot{limits::invalid_size};
+};
+
+// Reference to an enumerator, e.g., PlayerTypes::NO_PLAYER.
+struct Enumerator_reference {
+    Symbol enum_name{invalid_symbol};
+    Symbol enumerator{invalid_symbol};
+};
+
+struct Operation {
+    enum class Kind {
+        constant,
+        variable,
+        local_variable,
+        node_reference,
+        enumerator_reference,
+        unary_operator,
+        binary_operator
+    };
+
+    Kind kind{Kind::constant};
+    // For unary_operator and binary_operator, the type of the operator's token.
+    schema_parser::Token_type operator_type{schema_parser::Token_type::invalid};
+    // For constant, the value pushed.
+    int value{limits::invalid_value};
+    // For variable and local_variable, the symbol of the variable's name.
+    Symbol symbol{invalid_symbol};
+    // For node_reference and enumerator_reference, the index of the reference within the expression.  For
+    // local_variable, the variable's slot within the frame of the routine being run.
+    size_t reference{limits::invalid_size};
+};
+
+// Compiled form of an expression: a postfix program evaluated with a stack of values.  Operands are pushed and each
+// operator replaces its operands with its result.  The operations for the subscripts of a node reference precede the
+// reference, which pops their values.  Compiling an expression once and evaluating the result avoids tokenizing,
+// parsing and building path strings each time the expression is evaluated.
+//
+// The expression parser compiles each identifier which isn't part of a node reference to a variable.  The schema
+// compiler then resolves the operands of the expressions of a program: an identifier naming a variable of an
+// enclosing for-loop becomes a local_variable, one naming a node becomes a node_reference and one naming a const
+// becomes a constant.  Identifiers which may name a variable of another routine remain variables.
+struct Expression {
+    std::vector<Operation> operations;
+    std::vector<Node_reference> node_references;
+    std::vector<Enumerator_reference> enumerator_references;
+};
+
+} // namespace c4lib::expression_parser
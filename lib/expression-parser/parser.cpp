@@ -8,6 +8,7 @@
 #include <format>
 #include <functional>
 #include <include/exceptions.hpp>
+#include <lib/expression-parser/expression.hpp>
 #include <lib/expression-parser/infix-representation.hpp>
 #include <lib/expression-parser/parser.hpp>
 #include <lib/schema-parser/token-type.hpp>
@@ -15,9 +16,11 @@
 #include <lib/schema-parser/tokenizer.hpp>
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <lib/variable-manager/variable-manager.hpp>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace csp = c4lib::schema_parser;
 
@@ -29,7 +32,7 @@ namespace c4lib::expression_parser {
 // Note: The order of entries in this table must match the order of enumerator definition in the
 // TokenTypes enumeration because the enumerator value is used as an index into this table.
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
-std::array<Parser::Token_info, 24> Parser::token_info_table{{
+const std::array<Parser::Token_info, 24> Parser::token_info_table{{
     {.type = csp::Token_type::invalid, .lbp = 0, .rbp = 0, .nud = nullptr, .led = nullptr},
 
     // Numeric literal
@@ -90,65 +93,72 @@ std::array<Parser::Token_info, 24> Parser::token_info_table{{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // INTERFACE
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-int Parser::parse(
-    csp::Tokenizer& tokenizer, c4lib::Variable_manager& variable_manager, Infix_representation* infix_representation)
+void Parser::compile(csp::Tokenizer& tokenizer, Expression& expression, Infix_representation* infix_representation)
 {
-    while (!m_stack.empty()) {
-        m_stack.pop();
-    }
+    expression = Expression{};
+    m_expression = &expression;
     m_tokenizer = &tokenizer;
-    m_variable_manager = &variable_manager;
     m_infix_representation = infix_representation;
     expr_(0);
-    const int value{pop_()};
-    return value;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// IMPLEMENTATION
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void Parser::expect_(csp::Token_type token_type) const
-{
-    if (const csp::Token & current{m_tokenizer->next()}; current.type != token_type) {
-        throw make_ex<Expression_parser_error>(
-            fmt::unexpected_token_type, current.loc, to_string(current.type), to_string(token_type));
-    }
 }
 
-void Parser::expr_(int rbp)
+int Parser::evaluate(const Expression& expression, c4lib::Variable_manager& variable_manager)
 {
-    nud_();
-    while (rbp < get_token_info_(m_tokenizer->peek()).lbp) {
-        led_();
+    m_stack.clear();
+    for (const Operation& operation : expression.operations) {
+        switch (operation.kind) {
+        case Operation::Kind::constant:
+            push_(operation.value);
+            break;
+
+        case Operation::Kind::variable:
+            push_(variable_manager.get(operation.symbol));
+            break;
+
+        case Operation::Kind::local_variable:
+            push_(variable_manager.get_local(operation.reference));
+            break;
+
+        case Operation::Kind::node_reference:
+            push_(evaluate_node_reference_(expression.node_references.at(operation.reference), variable_manager));
+            break;
+
+        case Operation::Kind::enumerator_reference: {
+            const Enumerator_reference& reference{expression.enumerator_references.at(operation.reference)};
+            push_(variable_manager.get_enumerator(reference.enum_name, reference.enumerator));
+        } break;
+
+        case Operation::Kind::unary_operator:
+            push_(apply_unary_operator_(operation.operator_type, pop_()));
+            break;
+
+        case Operation::Kind::binary_operator: {
+            const int right{pop_()};
+            const int left{pop_()};
+            push_(apply_binary_operator_(operation.operator_type, left, right));
+        } break;
+        }
     }
+    const int value{pop_()};
+    return value;
 }
 
-Parser::Token_info Parser::get_token_info_(const csp::Token& token)
-{
-    size_t token_type{static_cast<size_t>(token.type)};
-    token_type = std::min(token_type, static_cast<size_t>(csp::Token_type::meta_expression_eos));
-    return token_info_table.at(token_type);
-}
-
-void Parser::led_()
+int Parser::parse(
+    csp::Tokenizer& tokenizer, c4lib::Variable_manager& variable_manager, Infix_representation* infix_representation)
 {
-    const csp::Token& token{m_tokenizer->next()};
-    const Token_info ti = get_token_info_(token); // = used for initialization to avoid spurious warning
-    if (ti.led == nullptr) {
-        throw make_ex<Expression_parser_error>(fmt::no_led, token.loc, to_string(token.type));
-    }
-    std::invoke(ti.led, this);
+    Expression expression;
+    compile(tokenizer, expression, infix_representation);
+    const int value{evaluate(expression, variable_manager)};
+    return value;
 }
 
-void Parser::led_binary_op_()
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int Parser::apply_binary_operator_(csp::Token_type operator_type, int left, int right)
 {
-    const csp::Token& token{m_tokenizer->previous()};
-    const Token_info ti = get_token_info_(token); // = used for initialization to avoid spurious warning
-    expr_(ti.rbp); // Note: rbp passed to expr to accommodate right-associative operators
-    const int right{pop_()};
-    const int left{pop_()};
     int value{limits::invalid_value};
-    switch (token.type) {
+    switch (operator_type) {
     case csp::Token_type::minus:
         value = (left - right);
         break;
@@ -203,9 +213,84 @@ void Parser::led_binary_op_()
         break;
         // NOLINTEND(readability-implicit-bool-conversion)
     default:
-        throw std::logic_error{std::format(fmt::internal_bug_in_function, "Parser::led_binary_op_")};
+        throw std::logic_error{std::format(fmt::internal_bug_in_function, "Parser::apply_binary_operator_")};
     }
-    push_(value);
+    return value;
+}
+
+int Parser::apply_unary_operator_(csp::Token_type operator_type, int right)
+{
+    int value{limits::invalid_value};
+    switch (operator_type) {
+    case csp::Token_type::minus:
+        value = (-right);
+        break;
+
+    case csp::Token_type::plus:
+        value = (+right);
+        break;
+
+    case csp::Token_type::bang:
+        // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+        value = (!right);
+        break;
+
+    default:
+        throw std::logic_error(std::format(fmt::internal_bug_in_function, "Parser::apply_unary_operator_"));
+    }
+    return value;
+}
+
+int Parser::evaluate_node_reference_(const Node_reference& reference, c4lib::Variable_manager& variable_manager)
+{
+    // The values of the subscripts were pushed in order, so they are popped starting with the last subscript.
+    m_subscripts.resize(reference.subscript_count);
+    for (size_t i = reference.subscript_count; i-- > 0;) {
+        m_subscripts[i] = pop_();
+    }
+    const int value{variable_manager.get(reference, m_subscripts)};
+    return value;
+}
+
+void Parser::expect_(csp::Token_type token_type) const
+{
+    if (const csp::Token & current{m_tokenizer->next()}; current.type != token_type) {
+        throw make_ex<Expression_parser_error>(
+            fmt::unexpected_token_type, current.get_loc(), to_string(current.type), to_string(token_type));
+    }
+}
+
+void Parser::expr_(int rbp)
+{
+    nud_();
+    while (rbp < get_token_info_(m_tokenizer->peek()).lbp) {
+        led_();
+    }
+}
+
+Parser::Token_info Parser::get_token_info_(const csp::Token& token)
+{
+    size_t token_type{static_cast<size_t>(token.type)};
+    token_type = std::min(token_type, static_cast<size_t>(csp::Token_type::meta_expression_eos));
+    return token_info_table.at(token_type);
+}
+
+void Parser::led_()
+{
+    const csp::Token& token{m_tokenizer->next()};
+    const Token_info ti = get_token_info_(token); // = used for initialization to avoid spurious warning
+    if (ti.led == nullptr) {
+        throw make_ex<Expression_parser_error>(fmt::no_led, token.get_loc(), to_string(token.type));
+    }
+    std::invoke(ti.led, this);
+}
+
+void Parser::led_binary_op_()
+{
+    const csp::Token& token{m_tokenizer->previous()};
+    const Token_info ti = get_token_info_(token); // = used for initialization to avoid spurious warning
+    expr_(ti.rbp); // Note: rbp passed to expr to accommodate right-associative operators
+    emit_(Operation{.kind = Operation::Kind::binary_operator, .operator_type = token.type});
     if (m_infix_representation != nullptr) {
         const std::string r{m_infix_representation->pop()};
         const std::string l{m_infix_representation->pop()};
@@ -219,7 +304,7 @@ void Parser::nud_()
     const csp::Token& token{m_tokenizer->next()};
     const Token_info ti = get_token_info_(token); // = used for initialization to avoid spurious warning
     if (ti.nud == nullptr) {
-        throw make_ex<Expression_parser_error>(fmt::no_nud, token.loc, to_string(token.type));
+        throw make_ex<Expression_parser_error>(fmt::no_nud, token.get_loc(), to_string(token.type));
     }
     std::invoke(ti.nud, this);
 }
@@ -233,8 +318,7 @@ void Parser::nud_grouping_()
 void Parser::nud_number_()
 {
     const csp::Token& token{m_tokenizer->previous()};
-    const int value{std::stoi(token.value, nullptr, 0)};
-    push_(value);
+    emit_(Operation{.kind = Operation::Kind::constant, .value = std::stoi(token.value, nullptr, 0)});
     if (m_infix_representation != nullptr) {
         m_infix_representation->push(token.value);
     }
@@ -245,26 +329,7 @@ void Parser::nud_unary_op_()
     const csp::Token& token{m_tokenizer->previous()};
     const Token_info ti = get_token_info_(token); // = used for initialization to avoid spurious warning
     expr_(ti.rbp);
-    const int right{pop_()};
-    int value{limits::invalid_value};
-    switch (token.type) {
-    case csp::Token_type::minus:
-        value = (-right);
-        break;
-
-    case csp::Token_type::plus:
-        value = (+right);
-        break;
-
-    case csp::Token_type::bang:
-        // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-        value = (!right);
-        break;
-
-    default:
-        throw std::logic_error(std::format(fmt::internal_bug_in_function, "Parser::nud_unary_op_"));
-    }
-    push_(value);
+    emit_(Operation{.kind = Operation::Kind::unary_operator, .operator_type = token.type});
     if (m_infix_representation != nullptr) {
         const std::string r{m_infix_representation->pop()};
         const std::string e{"(" + token.value + r + ")"};
@@ -274,58 +339,80 @@ void Parser::nud_unary_op_()
 
 void Parser::nud_var_or_ref_()
 {
-    // nud_var_or_ref_ is the null derivation for variables, node references and enumerator references.  Parsing
-    // for variables is similar to that for numeric literals except that the node value is obtained from the
-    // variable manager.  Parsing for node references and enumerator references requires that a sequence of tokens
-    // be processed and for that reason involves the use of several production rules.
+    // nud_var_or_ref_ is the null derivation for variables, node references and enumerator references.  Compiling
+    // a variable is similar to compiling a numeric literal except that the value is obtained from the variable
+    // manager when the expression is evaluated.  Parsing node references and enumerator references requires that a
+    // sequence of tokens be processed and for that reason involves the use of several production rules.
     // Variables, node references and enumerator references all begin with an identifier token.  To distinguish
     // between them, we first peek at the current token.  If it's an open square bracket or a dot, we need to process
     // a node reference; if it's a scope resolution operator,  we need to process an enumerator reference; otherwise
     // we process a variable.  Note that a simple node reference without a path will be interpreted as a variable.
-    // This is OK because the variable manager handles such a case.  The main point of the algorithm below is to
-    // process the correct number of tokens associated with the variable or reference and then piece the tokens
-    // together into a string which is passed to the variable manager for resolution.
+    // This is OK because the variable manager handles such a case.  The production rules record the keys of a node
+    // reference, and compile its subscripts, so that the reference can be resolved without forming a path string.
     if (const csp::Token & cur_tok{m_tokenizer->peek()};
         cur_tok.type == csp::Token_type::open_square_bracket || cur_tok.type == csp::Token_type::dot) {
-        std::string path;
+        Node_reference reference;
         // We've already consumed the identifier token which the node reference production starts with.
         // Back up one token to sync with the production rule.
         m_tokenizer->back();
-        const bool is_success{pr_node_reference_(path)};
+        const bool is_success{pr_node_reference_(reference)};
         if (!is_success) {
-            throw make_ex<Expression_parser_error>(fmt::bad_node_reference, cur_tok.loc);
+            throw make_ex<Expression_parser_error>(fmt::bad_node_reference, cur_tok.get_loc());
         }
-        const int value{m_variable_manager->get(path)};
-        push_(value);
         if (m_infix_representation != nullptr) {
+            // The infix representation of each subscript was pushed when the subscript was compiled.
+            std::string path;
+            for (auto it = reference.keys.rbegin(); it != reference.keys.rend(); ++it) {
+                const std::string key{
+                    *it == invalid_symbol ? "[" + m_infix_representation->pop() + "]" : symbol_table::name(*it)};
+                path.insert(0, path.empty() ? key : key + ".");
+            }
             m_infix_representation->push(path);
         }
+        emit_(Operation{
+            .kind = Operation::Kind::node_reference, .reference = m_expression->node_references.size()});
+        m_expression->node_references.push_back(std::move(reference));
     }
     else if (cur_tok.type == csp::Token_type::double_colon) {
-        std::string enumerator_reference;
+        Enumerator_reference reference;
         // We've already consumed the identifier token which the enumerator reference production starts with.
         // Back up one token to sync with the production rule.
         m_tokenizer->back();
-        const bool is_success{pr_enumerator_reference_(enumerator_reference)};
+        const bool is_success{pr_enumerator_reference_(reference)};
         if (!is_success) {
-            throw make_ex<Expression_parser_error>(fmt::bad_enumerator_reference, cur_tok.loc);
+            throw make_ex<Expression_parser_error>(fmt::bad_enumerator_reference, cur_tok.get_loc());
         }
-        const int value{m_variable_manager->get(enumerator_reference)};
-        push_(value);
         if (m_infix_representation != nullptr) {
-            m_infix_representation->push(enumerator_reference);
+            m_infix_representation->push(
+                symbol_table::name(reference.enum_name) + "::" + symbol_table::name(reference.enumerator));
         }
+        emit_(Operation{.kind = Operation::Kind::enumerator_reference,
+            .reference = m_expression->enumerator_references.size()});
+        m_expression->enumerator_references.push_back(std::move(reference));
     }
     else {
         const csp::Token& prev_tok{m_tokenizer->previous()};
-        const int value{m_variable_manager->get(prev_tok.value)};
-        push_(value);
+        emit_(Operation{.kind = Operation::Kind::variable, .symbol = prev_tok.symbol});
         if (m_infix_representation != nullptr) {
             m_infix_representation->push(prev_tok.value);
         }
     }
 }
 
+void Parser::rollback_(Node_reference& reference, size_t key_count, size_t operation_count)
+{
+    for (size_t i = key_count; i < reference.keys.size(); ++i) {
+        if (reference.keys[i] == invalid_symbol) {
+            --reference.subscript_count;
+            if (m_infix_representation != nullptr) {
+                static_cast<void>(m_infix_representation->pop());
+            }
+        }
+    }
+    reference.keys.resize(key_count);
+    m_expression->operations.resize(operation_count);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // IMPLEMENTATION - PRODUCTION RULES
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -344,101 +431,104 @@ void Parser::nud_var_or_ref_()
 // returns.
 
 // <array-node-name> ::= <open-square-bracket> <expression> <close-square-bracket>
-bool Parser::pr_array_node_name_(std::string& path)
+bool Parser::pr_array_node_name_(Node_reference& reference)
 {
-    const bool is_success = pr_open_square_bracket_(path) && pr_expression_(path) && pr_close_square_bracket_(path);
+    const bool is_success = pr_open_square_bracket_() && pr_expression_(reference) && pr_close_square_bracket_();
     return is_success;
 }
 
 // <array-node-name-or-node-name> ::= <array-node-name> | <node-name>
-bool Parser::pr_array_node_name_or_node_name_(std::string& path)
+bool Parser::pr_array_node_name_or_node_name_(Node_reference& reference)
 {
     const size_t index{m_tokenizer->get_index()};
+    const size_t key_count{reference.keys.size()};
+    const size_t operation_count{m_expression->operations.size()};
 
-    bool is_success = pr_array_node_name_(path);
+    bool is_success = pr_array_node_name_(reference);
     if (is_success) {
         return true;
     }
 
     m_tokenizer->set_index(index);
-    is_success = pr_node_name_(path);
+    rollback_(reference, key_count, operation_count);
+    is_success = pr_node_name_(reference);
 
     return is_success;
 }
 
 // <close-square-bracket> ::= ]
-bool Parser::pr_close_square_bracket_(std::string& path) const
+bool Parser::pr_close_square_bracket_() const
 {
     const csp::Token& token{m_tokenizer->next()};
     const bool is_success{token.type == csp::Token_type::close_square_bracket};
-    if (is_success) {
-        path += token.value;
-    }
     return is_success;
 }
 
 // <enum-name> ::= identifier
-bool Parser::pr_enum_name_(std::string& enumerator_reference) const
+bool Parser::pr_enum_name_(Enumerator_reference& reference) const
 {
-    const bool is_success{pr_identifier_(enumerator_reference)};
+    const bool is_success{pr_identifier_(reference.enum_name)};
     return is_success;
 }
 
 // <enumerator> ::= identifier
-bool Parser::pr_enumerator_(std::string& enumerator_reference) const
+bool Parser::pr_enumerator_(Enumerator_reference& reference) const
 {
-    const bool is_success{pr_identifier_(enumerator_reference)};
+    const bool is_success{pr_identifier_(reference.enumerator)};
     return is_success;
 }
 
 // <dot> ::= .
-bool Parser::pr_dot_(std::string& path) const
+bool Parser::pr_dot_() const
 {
     const csp::Token& token{m_tokenizer->next()};
     const bool is_success{token.type == csp::Token_type::dot};
-    if (is_success) {
-        path += token.value;
-    }
     return is_success;
 }
 
 // <enumerator-reference> ::= <enum-name><scope-resolution-operator><enumerator>
-bool Parser::pr_enumerator_reference_(std::string& enumerator_reference) const
+bool Parser::pr_enumerator_reference_(Enumerator_reference& reference) const
 {
-    const bool is_success{pr_enum_name_(enumerator_reference) && pr_scope_resolution_operator_(enumerator_reference)
-                          && pr_enumerator_(enumerator_reference)};
+    const bool is_success{
+        pr_enum_name_(reference) && pr_scope_resolution_operator_() && pr_enumerator_(reference)};
     return is_success;
 }
 
-bool Parser::pr_expression_(std::string& path)
+// The subscript is compiled in place: its operations precede the node reference, which pops its value.
+bool Parser::pr_expression_(Node_reference& reference)
 {
-    const int value{parse(*m_tokenizer, *m_variable_manager, m_infix_representation)};
-    path += std::to_string(value);
+    expr_(0);
+    reference.keys.push_back(invalid_symbol);
+    ++reference.subscript_count;
     return true;
 }
 
 // <identifier> ::= [a-zA-Z][_a-zA-Z0-9]{0,30}
-bool Parser::pr_identifier_(std::string& path) const
+bool Parser::pr_identifier_(Symbol& name) const
 {
     const csp::Token& token{m_tokenizer->next()};
     const bool is_success{token.type == csp::Token_type::identifier};
     if (is_success) {
-        path += token.value;
+        name = token.symbol;
     }
     return is_success;
 }
 
 // <node-name> ::= identifier
-bool Parser::pr_node_name_(std::string& path) const
+bool Parser::pr_node_name_(Node_reference& reference) const
 {
-    const bool is_success = pr_identifier_(path);
+    Symbol name{invalid_symbol};
+    const bool is_success = pr_identifier_(name);
+    if (is_success) {
+        reference.keys.push_back(name);
+    }
     return is_success;
 }
 
 // <node-reference> ::= <node-name> <opt-node-path>
-bool Parser::pr_node_reference_(std::string& path)
+bool Parser::pr_node_reference_(Node_reference& reference)
 {
-    const bool is_success{pr_node_name_(path) && pr_opt_path_(path)};
+    const bool is_success{pr_node_name_(reference) && pr_opt_path_(reference)};
     return is_success;
 }
 
@@ -450,46 +540,44 @@ bool Parser::pr_null_()
 }
 
 // <open-square-bracket> ::= [
-bool Parser::pr_open_square_bracket_(std::string& path) const
+bool Parser::pr_open_square_bracket_() const
 {
     const csp::Token& token{m_tokenizer->next()};
     const bool is_success{token.type == csp::Token_type::open_square_bracket};
-    if (is_success) {
-        path += token.value;
-    }
     return is_success;
 }
 
 // <opt-node-path> ::= <path-separator> <array-node-name-or-node-name> <opt-node-path> | <null>
-bool Parser::pr_opt_path_(std::string& path)
+bool Parser::pr_opt_path_(Node_reference& reference)
 {
     const size_t index{m_tokenizer->get_index()};
+    const size_t key_count{reference.keys.size()};
+    const size_t operation_count{m_expression->operations.size()};
 
-    bool is_success = pr_path_separator_(path) && pr_array_node_name_or_node_name_(path) && pr_opt_path_(path);
+    bool is_success =
+        pr_path_separator_() && pr_array_node_name_or_node_name_(reference) && pr_opt_path_(reference);
     if (is_success) {
         return true;
     }
 
     m_tokenizer->set_index(index);
+    rollback_(reference, key_count, operation_count);
     is_success = pr_null_();
     return is_success;
 }
 
 // <path-separator> ::= <dot>
-bool Parser::pr_path_separator_(std::string& path) const
+bool Parser::pr_path_separator_() const
 {
-    const bool is_success{pr_dot_(path)};
+    const bool is_success{pr_dot_()};
     return is_success;
 }
 
 // <scope-resolution-operator> := ::
-bool Parser::pr_scope_resolution_operator_(std::string& enumerator_reference) const
+bool Parser::pr_scope_resolution_operator_() const
 {
     const csp::Token& token{m_tokenizer->next()};
     const bool is_success{token.type == csp::Token_type::double_colon};
-    if (is_success) {
-        enumerator_reference += token.value;
-    }
     return is_success;
 }
 
@@ -6,18 +6,20 @@
 
 #include <array>
 #include <cstddef>
+#include <lib/expression-parser/expression.hpp>
 #include <lib/expression-parser/infix-representation.hpp>
 #include <lib/schema-parser/token-type.hpp>
 #include <lib/schema-parser/token.hpp>
 #include <lib/schema-parser/tokenizer.hpp>
 #include <lib/util/limits.hpp>
 #include <lib/variable-manager/variable-manager.hpp>
-#include <stack>
 #include <string>
+#include <vector>
 
 namespace c4lib::expression_parser {
 
-// Parses expressions using Pratt parsing.
+// Parses expressions using Pratt parsing.  Each expression is compiled into an Expression, which may then be evaluated
+// any number of times without parsing the expression again.
 class Parser {
 public:
     Parser() = default;
@@ -32,7 +34,16 @@ public:
 	
     Parser& operator=(Parser&&) noexcept = delete;    
 
-    // Processes the expression obtained from the tokenizer and returns the result of evaluation.
+    // Compiles the expression obtained from the tokenizer into expression.  Throws an exception on error.
+    void compile(schema_parser::Tokenizer& tokenizer,
+        Expression& expression,
+        Infix_representation* infix_representation = nullptr);
+
+    // Evaluates expression, which must have been compiled by compile, and returns the result.  Throws an exception if
+    // a variable or reference cannot be resolved.
+    int evaluate(const Expression& expression, Variable_manager& variable_manager);
+
+    // Compiles and evaluates the expression obtained from the tokenizer and returns the result of evaluation.
     // Throws an exception on error.
     int parse(schema_parser::Tokenizer& tokenizer,
         Variable_manager& variable_manager,
@@ -49,6 +60,17 @@ private:
         Denotation_func led{nullptr};
     };
 
+    static int apply_binary_operator_(schema_parser::Token_type operator_type, int left, int right);
+
+    static int apply_unary_operator_(schema_parser::Token_type operator_type, int right);
+
+    void emit_(const Operation& operation)
+    {
+        m_expression->operations.push_back(operation);
+    }
+
+    int evaluate_node_reference_(const Node_reference& reference, Variable_manager& variable_manager);
+
     void expect_(schema_parser::Token_type token_type) const;
 
     void expr_(int rbp);
@@ -71,56 +93,61 @@ private:
 
     int pop_()
     {
-        const int value{m_stack.top()};
-        m_stack.pop();
+        const int value{m_stack.back()};
+        m_stack.pop_back();
         return value;
     }
 
-    bool pr_array_node_name_(std::string& path);
+    bool pr_array_node_name_(Node_reference& reference);
 
-    bool pr_array_node_name_or_node_name_(std::string& path);
+    bool pr_array_node_name_or_node_name_(Node_reference& reference);
 
-    bool pr_close_square_bracket_(std::string& path) const;
+    bool pr_close_square_bracket_() const;
 
-    bool pr_dot_(std::string& path) const;
+    bool pr_dot_() const;
 
-    bool pr_enum_name_(std::string& enumerator_reference) const;
+    bool pr_enum_name_(Enumerator_reference& reference) const;
 
-    bool pr_enumerator_(std::string& enumerator_reference) const;
+    bool pr_enumerator_(Enumerator_reference& reference) const;
 
-    bool pr_enumerator_reference_(std::string& enumerator_reference) const;
+    bool pr_enumerator_reference_(Enumerator_reference& reference) const;
 
-    bool pr_expression_(std::string& path);
+    bool pr_expression_(Node_reference& reference);
 
-    bool pr_identifier_(std::string& path) const;
+    bool pr_identifier_(Symbol& name) const;
 
-    bool pr_node_name_(std::string& path) const;
+    bool pr_node_name_(Node_reference& reference) const;
 
-    bool pr_node_reference_(std::string& path);
+    bool pr_node_reference_(Node_reference& reference);
 
     static bool pr_null_();
 
-    bool pr_open_square_bracket_(std::string& path) const;
+    bool pr_open_square_bracket_() const;
 
-    bool pr_opt_path_(std::string& path);
+    bool pr_opt_path_(Node_reference& reference);
 
-    bool pr_path_separator_(std::string& path) const;
+    bool pr_path_separator_() const;
 
-    bool pr_scope_resolution_operator_(std::string& enumerator_reference) const;
+    bool pr_scope_resolution_operator_() const;
 
     void push_(int value)
     {
-        m_stack.push(value);
+        m_stack.push_back(value);
     }
 
+    // Discards the keys and operations added to reference by a production rule which failed.
+    void rollback_(Node_reference& reference, size_t key_count, size_t operation_count);
+
+    Expression* m_expression{nullptr};
     Infix_representation* m_infix_representation{nullptr};
-    std::stack<int> m_stack;
+    std::vector<int> m_stack;
+    // Subscripts of the node reference being evaluated.  The vector is reused to avoid allocation.
+    std::vector<int> m_subscripts;
     schema_parser::Tokenizer* m_tokenizer{nullptr};
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
-    static std::array<Token_info, 24> token_info_table;
+    static const std::array<Token_info, 24> token_info_table;
     // Verify that we've set the array size correctly.
     static_assert(token_info_table.size() == static_cast<size_t>(schema_parser::Token_type::meta_expression_eos) + 1);
-    Variable_manager* m_variable_manager{nullptr};
 };
 
 } // namespace c4lib::expression_parser
@@ -3,18 +3,54 @@
 // Created by Hankinsohl on 10/16/2024.
 
 #include <algorithm>
-#include <cctype>
 #include <filesystem>
 #include <lib/importer/file-manager.hpp>
 #include <lib/native/path.hpp>
-#include <lib/util/narrow.hpp>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+namespace {
+// Returns path in the form used as a key of the indexes: lexically normal, using '/' as separator and with ASCII
+// letters in lowercase, since Windows considers two file names identical if they match ignoring case.
+std::string make_key_(const std::filesystem::path& path)
+{
+    std::string key{path.lexically_normal().generic_string()};
+    std::ranges::transform(key, key.begin(), [](char c) {
+        if (c == '\\') {
+            return '/';
+        }
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    });
+    return key;
+}
+
+// Returns the entry of dir whose name matches name ignoring case, preferring an exact match, or an empty path if dir
+// holds no such entry.
+std::filesystem::path find_entry_(const std::filesystem::path& dir, const std::filesystem::path& name)
+{
+    std::error_code ec;
+    const std::filesystem::path exact{dir / name};
+    if (std::filesystem::exists(exact, ec)) {
+        return exact;
+    }
+    const std::string key{make_key_(name)};
+    for (const auto& dir_entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (make_key_(dir_entry.path().filename()) == key) {
+            return dir_entry.path();
+        }
+    }
+    return {};
+}
+} // namespace
+
 namespace c4lib {
 
-File_manager::File_manager(native::Path install_root, native::Path custom_assets_path, std::string mod_name)
+File_manager::File_manager(
+    native::Path install_root, native::Path custom_assets_path, std::string mod_name, bool use_modular_loading)
     : m_custom_assets_path(std::move(custom_assets_path)),
       m_install_root(std::move(install_root)),
       m_mod_name(std::move(mod_name))
@@ -31,18 +67,21 @@ File_manager::File_manager(native::Path install_root, native::Path custom_assets
     m_search_path_roots.emplace_back(m_install_root / native::Path{"Assets/XML"});
     m_search_path_roots.emplace_back(m_install_root / native::Path{"../Warlords/Assets/XML"});
     m_search_path_roots.emplace_back(m_install_root / native::Path{"../Assets/XML"});
+
+    if (use_modular_loading) {
+        index_modules_();
+    }
 }
 
 void File_manager::get_full_path(const native::Path& search_path, native::Path& full_path) const
 {
-    for (const auto& root : m_search_path_roots) {
-        full_path = root / search_path;
-        std::filesystem::path const filePath{full_path};
-        if (std::filesystem::is_regular_file(filePath)) {
-            return;
-        }
+    std::call_once(m_search_path_index_flag, [this] { index_search_path_roots_(); });
+    const auto it{m_search_path_index.find(make_key_(std::filesystem::path{search_path}))};
+    if (it == m_search_path_index.end()) {
+        full_path.clear();
+        return;
     }
-    full_path.clear();
+    full_path = it->second;
 }
 
 void File_manager::get_full_paths_modular(const native::Path& search_path, std::vector<native::Path>& full_paths) const
@@ -50,21 +89,60 @@ void File_manager::get_full_paths_modular(const native::Path& search_path, std::
     full_paths.clear();
 
     // Extract the file name from the searchPath.
-    std::string file_pattern{"_" + std::filesystem::path(search_path).filename().string()};
+    const std::string file_pattern{"_" + make_key_(std::filesystem::path(search_path).filename())};
 
-    // Windows considers two file names identical if they match character-for-character when compared
-    // ignoring case.  We therefore convert file names to lowercase prior to comparison.
-    std::ranges::transform(
-        file_pattern, file_pattern.begin(), [](unsigned char c) { return gsl::narrow<char>(std::tolower(c)); });
+    for (const auto& [filename, full_path] : m_module_files) {
+        if (filename.find(file_pattern) != std::string::npos) {
+            full_paths.push_back(full_path);
+        }
+    }
+}
 
-    // Recursively search the modules directory for matching files.
+void File_manager::probe_full_path(const native::Path& search_path, native::Path& full_path) const
+{
+    const std::filesystem::path relative_path{std::filesystem::path{search_path}.lexically_normal()};
+    for (const auto& root : m_search_path_roots) {
+        std::filesystem::path path{root};
+        for (const auto& name : relative_path) {
+            path = find_entry_(path, name);
+            if (path.empty()) {
+                break;
+            }
+        }
+        std::error_code ec;
+        if (!path.empty() && std::filesystem::is_regular_file(path, ec)) {
+            full_path = native::Path{path};
+            return;
+        }
+    }
+    full_path.clear();
+}
+
+void File_manager::index_modules_()
+{
+    // Recursively search the modules directory for files.
     for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(m_modular_search_path_root)) {
-        if (std::filesystem::is_regular_file(dir_entry)) {
-            std::string filename{dir_entry.path().filename().string()};
-            std::ranges::transform(
-                filename, filename.begin(), [](unsigned char c) { return gsl::narrow<char>(std::tolower(c)); });
-            if (filename.find(file_pattern) != std::string::npos) {
-                full_paths.emplace_back(dir_entry.path());
+        if (dir_entry.is_regular_file()) {
+            m_module_files.emplace_back(make_key_(dir_entry.path().filename()), native::Path{dir_entry.path()});
+        }
+    }
+}
+
+void File_manager::index_search_path_roots_() const
+{
+    // Roots are indexed in order of precedence so that the first root holding a file supplies it.  Roots which do not
+    // exist are skipped.
+    for (const auto& root : m_search_path_roots) {
+        const std::filesystem::path root_path{root};
+        std::error_code ec;
+        if (!std::filesystem::is_directory(root_path, ec)) {
+            continue;
+        }
+        for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(
+                 root_path, std::filesystem::directory_options::skip_permission_denied)) {
+            if (dir_entry.is_regular_file()) {
+                m_search_path_index.try_emplace(
+                    make_key_(dir_entry.path().lexically_relative(root_path)), native::Path{dir_entry.path()});
             }
         }
     }
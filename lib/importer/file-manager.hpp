@@ -5,14 +5,27 @@
 #pragma once
 
 #include <lib/native/path.hpp>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace c4lib {
 
+// Locates the XML files which supply imported definitions.  The files under the search path roots are indexed once, on
+// the first call to get_full_path, so that later lookups do not touch the file system; callers needing only a few
+// paths use probe_full_path instead, which reads no more directories than the path names.  The module files of the
+// mod are indexed when the File_manager is created if modular loading is used.  Lookups ignore case, as the game does
+// on Windows.
 class File_manager {
 public:
-    File_manager(native::Path install_root, native::Path custom_assets_path, std::string mod_name);
+    // Throws std::filesystem::filesystem_error if use_modular_loading is true and the Modules directory of the mod
+    // cannot be read.
+    File_manager(native::Path install_root,
+        native::Path custom_assets_path,
+        std::string mod_name,
+        bool use_modular_loading);
 
     ~File_manager() = default;
 
@@ -24,15 +37,33 @@ public:
 	
     File_manager& operator=(File_manager&&) noexcept = delete; 
 
+    // Sets full_path to the path of the file found at search_path under the first search path root holding it, or
+    // clears full_path if no root holds the file.  Indexes the search path roots on first use.
     void get_full_path(const native::Path& search_path, native::Path& full_path) const;
 
+    // Sets full_paths to the paths of the module files whose names contain "_" followed by the filename of
+    // search_path.  full_paths is empty unless modular loading is used.
     void get_full_paths_modular(const native::Path& search_path, std::vector<native::Path>& full_paths) const;
 
+    // Sets full_path as get_full_path does, but by looking search_path up directly under each root rather than
+    // indexing the roots.
+    void probe_full_path(const native::Path& search_path, native::Path& full_path) const;
+
 private:
+    void index_modules_();
+
+    void index_search_path_roots_() const;
+
     native::Path m_custom_assets_path;
     native::Path m_install_root;
     std::string m_mod_name;
+    // Lowercase filename and full path of each module file, in the order found.
+    std::vector<std::pair<std::string, native::Path>> m_module_files;
     native::Path m_modular_search_path_root;
+    // Maps the lowercase path of each file relative to a search path root to its full path under the first root
+    // holding it.  Built on the first call to get_full_path.
+    mutable std::unordered_map<std::string, native::Path> m_search_path_index;
+    mutable std::once_flag m_search_path_index_flag;
     std::vector<native::Path> m_search_path_roots;
 };
 
@@ -3,12 +3,19 @@
 // Created by Hankinsohl on 10/11/2024.
 
 #include <algorithm>
+#include <atomic>
 #include <boost/property_tree/ptree.hpp>
+#include <cstddef>
 #include <boost/property_tree/xml_parser.hpp>
 #include <format>
 #include <include/exceptions.hpp>
+#include <istream>
 #include <lib/importer/file-manager.hpp>
 #include <lib/importer/importer.hpp>
+#include <lib/importer/xml-scanner.hpp>
+#include <lib/io/span-streambuf.hpp>
+#include <lib/native/mapped-file.hpp>
+#include <lib/native/path.hpp>
 #include <lib/schema-parser/def-mem-type.hpp>
 #include <lib/schema-parser/def-mem.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
@@ -20,11 +27,94 @@
 #include <memory>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace bpt = boost::property_tree;
 namespace csp = c4lib::schema_parser;
 
+namespace {
+// Reads the XML file at path into tree.  The file is mapped into memory rather than read through an ifstream.
+void read_xml_(const c4lib::native::Path& path, bpt::ptree& tree)
+{
+    const c4lib::native::Mapped_file file{path};
+    c4lib::io::Span_streambuf buffer{file.bytes()};
+    std::istream in{&buffer};
+    try {
+        bpt::read_xml(in, tree);
+    }
+    catch (const bpt::xml_parser_error& e) {
+        // Errors raised while reading a stream lack the filename.
+        throw bpt::xml_parser_error{e.message(), path, e.line()};
+    }
+}
+
+// Advances scanner to the start of the element reached from the root by following names, taking at each level the
+// first child element with the given name.  Returns false if there is no such element.
+bool find_element_(c4lib::Xml_scanner& scanner, const std::vector<std::string_view>& names)
+{
+    using Event = c4lib::Xml_scanner::Event;
+    for (const auto& name : names) {
+        for (auto event{scanner.next()}; event != Event::start_element || scanner.get_name() != name;
+            event = scanner.next()) {
+            if (event == Event::start_element) {
+                scanner.skip_element();
+            }
+            else if (event == Event::end_element || event == Event::end_of_document) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Reads the text of the first Type child of the element most recently started by scanner into type and advances
+// scanner past the end of the element.  Returns false if the element has no Type child.
+bool read_type_(c4lib::Xml_scanner& scanner, std::string& type)
+{
+    using Event = c4lib::Xml_scanner::Event;
+    type.clear();
+    bool was_found{false};
+    for (auto event{scanner.next()}; event != Event::end_element; event = scanner.next()) {
+        if (event != Event::start_element) {
+            continue;
+        }
+        if (was_found || scanner.get_name() != "Type") {
+            scanner.skip_element();
+            continue;
+        }
+        was_found = true;
+        for (auto type_event{scanner.next()}; type_event != Event::end_element; type_event = scanner.next()) {
+            if (type_event == Event::text) {
+                scanner.append_text(type);
+            }
+            else if (type_event == Event::start_element) {
+                scanner.skip_element();
+            }
+        }
+    }
+    return was_found;
+}
+
+// Reads the GlobalDefines file at path into tree and indexes its Define nodes by DefineName so that each const may be
+// found without searching the file.  Where a name is defined more than once the first definition is indexed.
+void read_defines_(const c4lib::native::Path& path,
+    bpt::ptree& tree,
+    std::unordered_map<std::string, const bpt::ptree*>& defines)
+{
+    read_xml_(path, tree);
+    defines.clear();
+    for (const auto& [key, value] : tree.get_child("Civ4Defines")) {
+        if (key == "Define") {
+            defines.try_emplace(value.get<std::string>("DefineName"), &value);
+        }
+    }
+}
+} // namespace
+
 namespace c4lib {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -33,7 +123,7 @@ namespace c4lib {
 void Importer::add_const(const csp::Token& const_name)
 {
     if (m_const_import_table.contains(const_name.value)) {
-        throw make_ex<Importer_error>(fmt::duplicated_name, const_name.loc, const_name.value);
+        throw make_ex<Importer_error>(fmt::duplicated_name, const_name.get_loc(), const_name.value);
     }
     m_const_import_table.try_emplace(const_name.value, const_name);
 }
@@ -41,7 +131,7 @@ void Importer::add_const(const csp::Token& const_name)
 void Importer::add_enum(const csp::Token& enum_name, const csp::Token& xml_path, const csp::Token& search_path)
 {
     if (m_enum_import_table.contains(enum_name.value)) {
-        throw make_ex<Importer_error>(fmt::duplicated_name, enum_name.loc, enum_name.value);
+        throw make_ex<Importer_error>(fmt::duplicated_name, enum_name.get_loc(), enum_name.value);
     }
     m_enum_import_table.try_emplace(enum_name.value, enum_name, xml_path.value, native::Path{search_path.value});
 }
@@ -50,14 +140,16 @@ void Importer::import_definitions(csp::Def_tbl& definition_table,
     const native::Path& install_root,
     const native::Path& custom_assets_path,
     const std::string& mod_name,
-    bool use_modular_loading)
+    bool use_modular_loading,
+    size_t worker_count)
 {
     m_definition_table = &definition_table;
     m_use_modular_loading = use_modular_loading;
-    const File_manager fileManager{install_root, custom_assets_path, mod_name};
+    m_search_paths.clear();
+    const File_manager fileManager{install_root, custom_assets_path, mod_name, use_modular_loading};
 
     import_consts_(fileManager);
-    import_enums_(fileManager);
+    import_enums_(fileManager, worker_count);
 }
 
 void Importer::reset()
@@ -65,15 +157,54 @@ void Importer::reset()
     m_const_import_table.clear();
     m_definition_table = nullptr;
     m_enum_import_table.clear();
+    m_search_paths.clear();
     m_use_modular_loading = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // IMPLEMENTATION
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool Importer::import_const_(
-    const schema_parser::Token& const_name, const native::Path& file_path, bool is_modular /* = false */) const
+bool Importer::add_enumerators_(const schema_parser::Token& enum_name, const Enum_file& file, bool is_modular) const
 {
+    // When importing an enum, we want the file location to refer to the file path to the XML file.  We'd also like
+    // to reference the line and column number; unfortunately these values are not tracked by the XML scanner.
+    File_location xml_file_location;
+    xml_file_location.filename = std::make_shared<std::string>(file.path);
+    xml_file_location.line = std::make_shared<std::string>("");
+    xml_file_location.line_number = 0;
+    xml_file_location.character_number = 0;
+
+    // Get the definition for the enum.
+    bool was_created{false};
+    csp::Definition& definition{m_definition_table->create_definition(
+        enum_name.value, csp::Def_type::enum_type, xml_file_location, was_created)};
+
+    // If we're not using modular loading, the definition must not yet exist.  Check wasCreated to verify this.
+    if (!is_modular && !was_created) {
+        throw make_ex<Importer_error>(fmt::enum_definition_exists, enum_name.get_loc(), enum_name.value);
+    }
+
+    // Enumerator values begin at 0 and increment by 1 each time an enumerator is added.
+    int enumerator_value{0};
+    for (const auto& enumerator_name : file.enumerator_names) {
+        // Add a definition member to set the value of the enumerator.
+        csp::Def_mem enum_member{csp::Def_mem_type::enum_type, enumerator_name, enumerator_value++, xml_file_location};
+        definition.add_member(enum_member, false, is_modular);
+    }
+
+    return enumerator_value != 0;
+}
+
+bool Importer::import_const_(const schema_parser::Token& const_name,
+    const Define_index& defines,
+    const native::Path& file_path,
+    bool is_modular /* = false */) const
+{
+    const auto it{defines.find(const_name.value)};
+    if (it == defines.end()) {
+        return false;
+    }
+
     // When importing we want the file location to refer to the file path to the XML file.  We'd also like
     // to reference the line and column number; unfortunately these values cannot be obtained using the property tree.
     File_location xml_file_location;
@@ -82,38 +213,27 @@ bool Importer::import_const_(
     xml_file_location.line_number = 0;
     xml_file_location.character_number = 0;
 
-    bpt::ptree tree;
-    bpt::read_xml(file_path, tree);
+    const int int_value{it->second->get<int>("iDefineIntVal")};
+    bool was_created{false};
+    csp::Definition& definition{m_definition_table->create_definition(
+        const_name.value, csp::Def_type::const_type, xml_file_location, was_created)};
 
-    // Iterate over Civ4Defines child nodes.
-    for (const auto& [key, value] : tree.get_child("Civ4Defines")) {
-        // If the child node is a Define node, check the value of DefineName to see if it matches the const name.
-        if (key == "Define") {
-            if (auto define_name{value.get<std::string>("DefineName")}; define_name == const_name.value) {
-                const int int_value{value.get<int>("iDefineIntVal")};
-                bool was_created{false};
-                csp::Definition& definition{m_definition_table->create_definition(
-                    const_name.value, csp::Def_type::const_type, xml_file_location, was_created)};
-
-                // If we're not using modular loading, the definition must not yet exist.  Check
-                // was_created to verify this.
-                if (!is_modular && !was_created) {
-                    throw make_ex<Importer_error>(fmt::const_definition_exists, const_name.loc, const_name.value);
-                }
-
-                // Add a definition member to set the value of the const.
-                csp::Def_mem const_member{
-                    csp::Def_mem_type::const_type, const_name.value, int_value, xml_file_location};
-                definition.add_member(const_member, false, is_modular);
-                return true;
-            }
-        }
+    // If we're not using modular loading, the definition must not yet exist.  Check was_created to verify this.
+    if (!is_modular && !was_created) {
+        throw make_ex<Importer_error>(fmt::const_definition_exists, const_name.get_loc(), const_name.value);
     }
-    return false;
+
+    // Add a definition member to set the value of the const.
+    csp::Def_mem const_member{csp::Def_mem_type::const_type, const_name.value, int_value, xml_file_location};
+    definition.add_member(const_member, false, is_modular);
+    return true;
 }
 
 void Importer::import_consts_(const File_manager& file_manager)
 {
+    m_search_paths.emplace_back("GlobalDefinesAlt.xml");
+    m_search_paths.emplace_back("GlobalDefines.xml");
+
     native::Path global_defines_alt_full_path;
     file_manager.get_full_path(native::Path{"GlobalDefinesAlt.xml"}, global_defines_alt_full_path);
     if (global_defines_alt_full_path.empty()) {
@@ -122,13 +242,23 @@ void Importer::import_consts_(const File_manager& file_manager)
 
     native::Path global_defines_full_path;
     file_manager.get_full_path(native::Path{"GlobalDefines.xml"}, global_defines_full_path);
-    if (global_defines_alt_full_path.empty()) {
+    if (global_defines_full_path.empty()) {
         throw Importer_error(std::format(fmt::missing_file, global_defines_full_path));
     }
 
+    // Each defines file is parsed once and its defines indexed by name.  Consts are then resolved from the index,
+    // GlobalDefinesAlt.xml taking precedence over GlobalDefines.xml.
+    bpt::ptree global_defines_alt;
+    Define_index global_defines_alt_index;
+    read_defines_(global_defines_alt_full_path, global_defines_alt, global_defines_alt_index);
+    bpt::ptree global_defines;
+    Define_index global_defines_index;
+    read_defines_(global_defines_full_path, global_defines, global_defines_index);
+
     for (const auto& token : m_const_import_table | std::views::values) {
-        if (!import_const_(token, global_defines_alt_full_path) && !import_const_(token, global_defines_full_path)) {
-            throw make_ex<Importer_error>(fmt::failure_importing_const, token.loc, token.value);
+        if (!import_const_(token, global_defines_alt_index, global_defines_alt_full_path)
+            && !import_const_(token, global_defines_index, global_defines_full_path)) {
+            throw make_ex<Importer_error>(fmt::failure_importing_const, token.get_loc(), token.value);
         }
     }
 
@@ -137,86 +267,132 @@ void Importer::import_consts_(const File_manager& file_manager)
         std::vector<native::Path> global_defines_modular_paths;
         file_manager.get_full_paths_modular(native::Path{"GlobalDefines.xml"}, global_defines_modular_paths);
         for (const auto& full_path : global_defines_modular_paths) {
+            bpt::ptree modular_defines;
+            Define_index modular_defines_index;
+            read_defines_(full_path, modular_defines, modular_defines_index);
             for (const auto& token : m_const_import_table | std::views::values) {
-                static_cast<void>(import_const_(token, full_path, true));
+                static_cast<void>(import_const_(token, modular_defines_index, full_path, true));
             }
         }
     }
 }
 
-bool Importer::import_enum_(const schema_parser::Token& enum_name,
-    const std::string& xml_path,
-    const native::Path& file_path,
-    bool is_modular /* = false */) const
+void Importer::import_enums_(const File_manager& file_manager, size_t worker_count)
 {
-    bpt::ptree tree;
-    bpt::read_xml(file_path, tree);
-
-    // When importing an enum, we want the file location to refer to the file path to the XML file.  We'd also like
-    // to reference the line and column number; unfortunately these values cannot be obtained using the property tree.
-    File_location xml_file_location;
-    xml_file_location.filename = std::make_shared<std::string>(file_path);
-    xml_file_location.line = std::make_shared<std::string>("");
-    xml_file_location.line_number = 0;
-    xml_file_location.character_number = 0;
-
-    // Break the xmlPath into parent and node components to facilitate search.  Also change path separator from
-    // "/" to "." because BPT uses "."
-    const std::string::size_type last_separator{xml_path.find_last_of('/')};
-    if (last_separator == std::string::npos) {
-        throw make_ex<Importer_error>(fmt::bad_search_path, enum_name.loc, xml_path);
+    // Enums are imported in schema order so that the search paths recorded, the error reported and the definitions
+    // created do not depend upon the order of the import table.
+    std::vector<const Enum_data*> enums;
+    enums.reserve(m_enum_import_table.size());
+    for (const auto& enum_data : m_enum_import_table | std::views::values) {
+        enums.push_back(&enum_data);
+    }
+    std::ranges::sort(enums, [](const Enum_data* lhs, const Enum_data* rhs) {
+        return std::tie(lhs->token.index, lhs->token.value) < std::tie(rhs->token.index, rhs->token.value);
+    });
+    for (const Enum_data* enum_data : enums) {
+        m_search_paths.push_back(enum_data->search_path);
     }
-    std::string parent_xml_path{xml_path.substr(0, last_separator)};
-    const std::string xml_node{xml_path.substr(last_separator + 1)};
-    std::ranges::replace(parent_xml_path, '/', '.');
 
-    // Get the definition for the enum.
-    bool was_created{false};
-    csp::Definition& definition{m_definition_table->create_definition(
-        enum_name.value, csp::Def_type::enum_type, xml_file_location, was_created)};
+    // The files supplying each enum are independent of those supplying other enums, so enums may be scanned
+    // concurrently.  The calling thread acts as one of the workers.  Destruction of workers joins the remaining
+    // threads.
+    std::vector<Enum_scan> scans(enums.size());
+    std::atomic<size_t> next_index{0};
+    const auto worker{[&]() {
+        for (size_t index = next_index++; index < enums.size(); index = next_index++) {
+            try {
+                scan_enum_(*enums[index], file_manager, scans[index]);
+            }
+            catch (...) {
+                scans[index].error = std::current_exception();
+            }
+        }
+    }};
+    worker_count = std::clamp(worker_count, size_t{1}, std::max(enums.size(), size_t{1}));
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(worker_count - 1);
+        for (size_t i = 1; i < worker_count; ++i) {
+            workers.emplace_back(worker);
+        }
+        worker();
+    }
 
-    // If we're not using modular loading, the definition must not yet exist.  Check wasCreated to verify this.
-    if (!is_modular && !was_created) {
-        throw make_ex<Importer_error>(fmt::enum_definition_exists, enum_name.loc, enum_name.value);
+    // Merge the enumerators into the definition table in schema order.  The modular files of each enum follow the
+    // file found using its search path so that they override it as they would if imported serially.
+    for (size_t i = 0; i < enums.size(); ++i) {
+        const Enum_data& enum_data{*enums[i]};
+        if (scans[i].error) {
+            std::rethrow_exception(scans[i].error);
+        }
+        if (!add_enumerators_(enum_data.token, scans[i].files.front(), false)) {
+            throw make_ex<Importer_error>(
+                fmt::failure_importing_enum, enum_data.token.get_loc(), enum_data.token.value);
+        }
+        for (const auto& file : scans[i].files | std::views::drop(1)) {
+            static_cast<void>(add_enumerators_(enum_data.token, file, true));
+        }
     }
+}
 
-    // Enumerator values begin at 0 and increment by 1 each time an enumerator is added.
-    int enumerator_value{0};
+void Importer::scan_enum_(const Enum_data& enum_data, const File_manager& file_manager, Enum_scan& scan) const
+{
+    native::Path full_path;
+    file_manager.get_full_path(enum_data.search_path, full_path);
+    if (full_path.empty()) {
+        throw make_ex<Importer_error>(fmt::search_error, enum_data.token.get_loc(), enum_data.search_path);
+    }
+    std::vector<native::Path> full_paths{full_path};
+    if (m_use_modular_loading) {
+        std::vector<native::Path> modular_paths;
+        file_manager.get_full_paths_modular(enum_data.search_path, modular_paths);
+        full_paths.insert(full_paths.end(), modular_paths.begin(), modular_paths.end());
+    }
 
-    for (auto& [node_name, child] : tree.get_child(parent_xml_path)) {
-        // If the child node matches the search node, get the enumerator name from its <Type> value.
-        if (node_name == xml_node) {
-            auto enumerator_name{child.get<std::string>("Type")};
+    scan.files.resize(full_paths.size());
+    for (size_t i = 0; i < full_paths.size(); ++i) {
+        scan.files[i].path = full_paths[i];
+        scan_enum_file_(enum_data.token, enum_data.xml_path, scan.files[i]);
+    }
+}
 
-            // Add a definition member to set the value of the enumerator.
-            csp::Def_mem enum_member{
-                csp::Def_mem_type::enum_type, enumerator_name, enumerator_value++, xml_file_location};
-            definition.add_member(enum_member, false, is_modular);
+void Importer::scan_enum_file_(const schema_parser::Token& enum_name, const std::string& xml_path, Enum_file& file)
+{
+    // Break the xmlPath into the names of the elements leading to the parent and the name of the node.
+    const std::string::size_type last_separator{xml_path.find_last_of('/')};
+    if (last_separator == std::string::npos) {
+        throw make_ex<Importer_error>(fmt::bad_search_path, enum_name.get_loc(), xml_path);
+    }
+    const std::string_view xml_node{std::string_view{xml_path}.substr(last_separator + 1)};
+    std::vector<std::string_view> parent_names;
+    for (const auto& name : std::string_view{xml_path}.substr(0, last_separator) | std::views::split('/')) {
+        if (!name.empty()) {
+            parent_names.emplace_back(name.begin(), name.end());
         }
     }
 
-    return enumerator_value != 0;
-}
+    // The file is scanned rather than read into a property tree since only the Type of each node is needed.
+    const native::Mapped_file mapped_file{file.path};
+    Xml_scanner scanner{mapped_file.text(), file.path};
+    if (!find_element_(scanner, parent_names)) {
+        throw make_ex<Importer_error>(fmt::bad_search_path, enum_name.get_loc(), xml_path);
+    }
 
-void Importer::import_enums_(const File_manager& file_manager)
-{
-    for (const auto& enum_data : m_enum_import_table | std::views::values) {
-        native::Path full_path;
-        file_manager.get_full_path(enum_data.search_path, full_path);
-        if (full_path.empty()) {
-            throw make_ex<Importer_error>(fmt::search_error, enum_data.token.loc, enum_data.search_path);
+    std::string enumerator_name;
+    for (auto event{scanner.next()}; event != Xml_scanner::Event::end_element; event = scanner.next()) {
+        if (event != Xml_scanner::Event::start_element) {
+            continue;
         }
-        if (!import_enum_(enum_data.token, enum_data.xml_path, full_path, false)) {
-            throw make_ex<Importer_error>(fmt::failure_importing_enum, enum_data.token.loc, enum_data.token.value);
+        if (scanner.get_name() != xml_node) {
+            scanner.skip_element();
+            continue;
         }
 
-        if (m_use_modular_loading) {
-            std::vector<native::Path> modular_paths;
-            file_manager.get_full_paths_modular(enum_data.search_path, modular_paths);
-            for (const auto& modular_full_path : modular_paths) {
-                static_cast<void>(import_enum_(enum_data.token, enum_data.xml_path, modular_full_path, true));
-            }
+        // The child node matches the search node, so get the enumerator name from its <Type> value.
+        if (!read_type_(scanner, enumerator_name)) {
+            throw make_ex<Importer_error>(fmt::missing_xml_element, enum_name.get_loc(), "Type", xml_path);
         }
+        file.enumerator_names.push_back(enumerator_name);
     }
 }
 
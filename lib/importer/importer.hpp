@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <boost/property_tree/ptree_fwd.hpp>
+#include <exception>
 #include <lib/importer/file-manager.hpp>
 #include <lib/native/path.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
@@ -11,6 +13,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace c4lib {
 
@@ -36,16 +39,42 @@ public:
         const schema_parser::Token& xml_path,
         const schema_parser::Token& search_path);
 
+    // Returns the search paths resolved by the most recent call to import_definitions.  Together with the
+    // installation settings, the search paths determine which XML files supply the imported definitions.
+    [[nodiscard]] const std::vector<native::Path>& get_search_paths() const
+    {
+        return m_search_paths;
+    }
+
+    // Imports the consts and enums added to the import tables into definition_table.  The XML files supplying enums
+    // are scanned using up to worker_count threads, including the calling thread.
     void import_definitions(schema_parser::Def_tbl& definition_table,
         const native::Path& install_root,
         const native::Path& custom_assets_path,
         const std::string& mod_name,
-        bool use_modular_loading);
+        bool use_modular_loading,
+        size_t worker_count = 1);
 
     // Resets the definition importer returning it to the state of a newly created importer.
     void reset();
 
 private:
+    // Maps the DefineName of each Define node of a GlobalDefines file to the node.
+    using Define_index = std::unordered_map<std::string, const boost::property_tree::ptree*>;
+
+    // Names of the enumerators scanned from one of the XML files supplying an enum, in document order.
+    struct Enum_file {
+        native::Path path;
+        std::vector<std::string> enumerator_names;
+    };
+
+    // Result of scanning the XML files supplying an enum: the file found using its search path followed by its
+    // modular files, or the exception thrown while scanning them.
+    struct Enum_scan {
+        std::exception_ptr error;
+        std::vector<Enum_file> files;
+    };
+
     struct Enum_data {
         Enum_data(const schema_parser::Token& token_, std::string xml_path_, native::Path search_path_)
             : token(token_), xml_path(std::move(xml_path_)), search_path(std::move(search_path_))
@@ -57,20 +86,28 @@ private:
         native::Path search_path;
     };
 
-    bool import_const_(const schema_parser::Token& const_name, const native::Path& file_path, bool is_modular = false) const;
+    // Adds the enumerators scanned from file to the definition of the enum.  Returns false if file has no enumerators.
+    bool add_enumerators_(const schema_parser::Token& enum_name, const Enum_file& file, bool is_modular) const;
 
-    void import_consts_(const File_manager& file_manager);
-
-    bool import_enum_(const schema_parser::Token& enum_name,
-        const std::string& xml_path,
+    bool import_const_(const schema_parser::Token& const_name,
+        const Define_index& defines,
         const native::Path& file_path,
         bool is_modular = false) const;
 
-    void import_enums_(const File_manager& file_manager);
+    void import_consts_(const File_manager& file_manager);
+
+    void import_enums_(const File_manager& file_manager, size_t worker_count);
+
+    // Scans the file found using the search path of the enum and, if modular loading is used, its modular files.
+    // Safe to call concurrently since neither the importer nor the definition table is modified.
+    void scan_enum_(const Enum_data& enum_data, const File_manager& file_manager, Enum_scan& scan) const;
+
+    static void scan_enum_file_(const schema_parser::Token& enum_name, const std::string& xml_path, Enum_file& file);
 
     std::unordered_map<std::string, schema_parser::Token> m_const_import_table;
     schema_parser::Def_tbl* m_definition_table{nullptr};
     std::unordered_map<std::string, Enum_data> m_enum_import_table;
+    std::vector<native::Path> m_search_paths;
     bool m_use_modular_loading{false};
 };
 
@@ -0,0 +1,311 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <boost/property_tree/xml_parser.hpp>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <lib/importer/xml-scanner.hpp>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace bpt = boost::property_tree;
+
+namespace {
+constexpr std::string_view utf8_bom{"\xEF\xBB\xBF"};
+
+bool is_space_(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Appends code_point to text encoded as UTF-8.  Returns false if code_point is not a Unicode scalar value.
+bool append_utf8_(uint32_t code_point, std::string& text)
+{
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    if (code_point < 0x80) {
+        text.push_back(static_cast<char>(code_point));
+    }
+    else if (code_point < 0x800) {
+        text.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x10000) {
+        if (code_point >= 0xD800 && code_point < 0xE000) {
+            return false;
+        }
+        text.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        text.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x110000) {
+        text.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        text.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else {
+        return false;
+    }
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    return true;
+}
+
+// Appends the character named by reference, the text between '&' and ';' of an entity or character reference, to
+// text.  Returns false if the reference is unknown.
+bool append_reference_(std::string_view reference, std::string& text)
+{
+    if (reference == "lt") {
+        text.push_back('<');
+    }
+    else if (reference == "gt") {
+        text.push_back('>');
+    }
+    else if (reference == "amp") {
+        text.push_back('&');
+    }
+    else if (reference == "quot") {
+        text.push_back('"');
+    }
+    else if (reference == "apos") {
+        text.push_back('\'');
+    }
+    else if (reference.starts_with('#')) {
+        const bool is_hex{reference.starts_with("#x")};
+        const std::string_view digits{reference.substr(is_hex ? 2 : 1)};
+        uint32_t code_point{0};
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        const auto [end, error]{
+            std::from_chars(digits.data(), digits.data() + digits.size(), code_point, is_hex ? 16 : 10)};
+        if (digits.empty() || error != std::errc{} || end != digits.data() + digits.size()) {
+            return false;
+        }
+        return append_utf8_(code_point, text);
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+namespace c4lib {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Xml_scanner::Xml_scanner(std::string_view document, std::string filename)
+    : m_document(document), m_filename(std::move(filename))
+{
+    if (m_document.starts_with(utf8_bom)) {
+        m_position = utf8_bom.size();
+    }
+}
+
+void Xml_scanner::append_text(std::string& text) const
+{
+    if (m_is_cdata) {
+        text.append(m_text);
+        return;
+    }
+
+    size_t first{0};
+    for (size_t ampersand{m_text.find('&')}; ampersand != std::string_view::npos;
+        ampersand = m_text.find('&', first)) {
+        const size_t semicolon{m_text.find(';', ampersand)};
+        text.append(m_text.substr(first, ampersand - first));
+        if (semicolon == std::string_view::npos
+            || !append_reference_(m_text.substr(ampersand + 1, semicolon - ampersand - 1), text)) {
+            fail_("invalid entity or character reference");
+        }
+        first = semicolon + 1;
+    }
+    text.append(m_text.substr(first));
+}
+
+Xml_scanner::Event Xml_scanner::next()
+{
+    if (m_is_empty_element) {
+        m_is_empty_element = false;
+        m_open_elements.pop_back();
+        return Event::end_element;
+    }
+
+    while (m_position < m_document.size()) {
+        const std::string_view rest{m_document.substr(m_position)};
+        if (rest.front() != '<') {
+            const size_t end{std::min(m_document.find('<', m_position), m_document.size())};
+            m_text = m_document.substr(m_position, end - m_position);
+            m_is_cdata = false;
+            if (m_open_elements.empty()) {
+                if (!std::ranges::all_of(m_text, is_space_)) {
+                    fail_("text outside of the root element");
+                }
+                m_position = end;
+                continue;
+            }
+            m_position = end;
+            return Event::text;
+        }
+
+        if (rest.starts_with("<!--")) {
+            m_position = find_end_("-->");
+        }
+        else if (rest.starts_with("<![CDATA[")) {
+            if (m_open_elements.empty()) {
+                fail_("CDATA section outside of the root element");
+            }
+            const size_t end{find_end_("]]>")};
+            const size_t first{m_position + std::string_view{"<![CDATA["}.size()};
+            m_text = m_document.substr(first, end - std::string_view{"]]>"}.size() - first);
+            m_is_cdata = true;
+            m_position = end;
+            return Event::text;
+        }
+        else if (rest.starts_with("<?")) {
+            m_position = find_end_("?>");
+        }
+        else if (rest.starts_with("<!")) {
+            skip_doctype_();
+        }
+        else if (rest.starts_with("</")) {
+            m_position += 2;
+            m_name = scan_name_();
+            while (m_position < m_document.size() && is_space_(m_document[m_position])) {
+                ++m_position;
+            }
+            if (m_position == m_document.size() || m_document[m_position] != '>') {
+                fail_("expected >");
+            }
+            ++m_position;
+            if (m_open_elements.empty() || m_open_elements.back() != m_name) {
+                fail_("invalid closing tag name");
+            }
+            m_open_elements.pop_back();
+            return Event::end_element;
+        }
+        else {
+            scan_start_tag_();
+            return Event::start_element;
+        }
+    }
+
+    if (!m_open_elements.empty()) {
+        fail_("unexpected end of data");
+    }
+    return Event::end_of_document;
+}
+
+void Xml_scanner::skip_element()
+{
+    for (size_t depth{1}; depth != 0;) {
+        switch (next()) {
+        case Event::start_element:
+            ++depth;
+            break;
+        case Event::end_element:
+            --depth;
+            break;
+        case Event::end_of_document:
+        case Event::text:
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void Xml_scanner::fail_(const std::string& message) const
+{
+    const auto line{std::count(m_document.begin(),
+        m_document.begin() + static_cast<std::ptrdiff_t>(std::min(m_position, m_document.size())), '\n')};
+    throw bpt::xml_parser_error{message, m_filename, static_cast<unsigned long>(line + 1)};
+}
+
+size_t Xml_scanner::find_end_(std::string_view terminator) const
+{
+    const size_t found{m_document.find(terminator, m_position)};
+    if (found == std::string_view::npos) {
+        fail_("unexpected end of data");
+    }
+    return found + terminator.size();
+}
+
+std::string_view Xml_scanner::scan_name_()
+{
+    const size_t first{m_position};
+    while (m_position < m_document.size()) {
+        const char c{m_document[m_position]};
+        if (is_space_(c) || c == '/' || c == '>' || c == '=' || c == '<') {
+            break;
+        }
+        ++m_position;
+    }
+    if (m_position == first) {
+        fail_("expected element name");
+    }
+    return m_document.substr(first, m_position - first);
+}
+
+void Xml_scanner::scan_start_tag_()
+{
+    ++m_position;
+    m_name = scan_name_();
+    m_open_elements.push_back(m_name);
+
+    // Skip the attributes, whose quoted values may contain '>'.
+    while (m_position < m_document.size()) {
+        const char c{m_document[m_position]};
+        if (c == '>') {
+            ++m_position;
+            return;
+        }
+        if (c == '/' && m_position + 1 < m_document.size() && m_document[m_position + 1] == '>') {
+            m_position += 2;
+            m_is_empty_element = true;
+            return;
+        }
+        if (c == '"' || c == '\'') {
+            const size_t quote{m_document.find(c, m_position + 1)};
+            if (quote == std::string_view::npos) {
+                break;
+            }
+            m_position = quote + 1;
+        }
+        else if (c == '<') {
+            fail_("expected >");
+        }
+        else {
+            ++m_position;
+        }
+    }
+    fail_("unexpected end of data");
+}
+
+void Xml_scanner::skip_doctype_()
+{
+    // The document type declaration may contain an internal subset, delimited by '[' and ']', holding markup
+    // declarations which themselves end with '>'.
+    size_t subset_depth{0};
+    for (++m_position; m_position < m_document.size(); ++m_position) {
+        const char c{m_document[m_position]};
+        if (c == '[') {
+            ++subset_depth;
+        }
+        else if (c == ']' && subset_depth != 0) {
+            --subset_depth;
+        }
+        else if (c == '>' && subset_depth == 0) {
+            ++m_position;
+            return;
+        }
+    }
+    fail_("unexpected end of data");
+}
+
+} // namespace c4lib
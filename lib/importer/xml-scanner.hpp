@@ -0,0 +1,79 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace c4lib {
+
+// Pull scanner for XML documents.  Each call to next reports the start or end of an element or a run of text, in
+// document order, without building a tree; text is decoded only when requested.  The XML declaration, processing
+// instructions, comments, the document type declaration and attributes are skipped.  Malformed markup, mismatched end
+// tags and unknown entity references cause boost::property_tree::xml_parser_error to be thrown, as they do when the
+// document is read with boost::property_tree::read_xml.
+class Xml_scanner {
+public:
+    enum class Event {
+        end_of_document,
+        start_element,
+        end_element,
+        text,
+    };
+
+    // document must remain valid for the lifetime of the scanner.  filename is used in error messages.
+    Xml_scanner(std::string_view document, std::string filename);
+
+    ~Xml_scanner() = default;
+
+    Xml_scanner(const Xml_scanner&) = delete;
+
+    Xml_scanner& operator=(const Xml_scanner&) = delete;
+
+    Xml_scanner(Xml_scanner&&) noexcept = delete;
+
+    Xml_scanner& operator=(Xml_scanner&&) noexcept = delete;
+
+    // Appends the text most recently scanned to text, replacing entity and character references.
+    void append_text(std::string& text) const;
+
+    // Returns the name of the element most recently started or ended.
+    [[nodiscard]] std::string_view get_name() const
+    {
+        return m_name;
+    }
+
+    // Advances to the next event.  An empty element, <Name/>, is reported as a start followed by an end.
+    Event next();
+
+    // Advances past the end of the element most recently started.
+    void skip_element();
+
+private:
+    [[noreturn]] void fail_(const std::string& message) const;
+
+    // Returns the position of the end of the markup beginning at m_position which is terminated by terminator.
+    [[nodiscard]] size_t find_end_(std::string_view terminator) const;
+
+    // Returns the name beginning at m_position and advances past it.
+    [[nodiscard]] std::string_view scan_name_();
+
+    void scan_start_tag_();
+
+    void skip_doctype_();
+
+    std::string_view m_document;
+    std::string m_filename;
+    bool m_is_cdata{false};
+    bool m_is_empty_element{false};
+    std::string_view m_name;
+    std::vector<std::string_view> m_open_elements;
+    size_t m_position{0};
+    std::string_view m_text;
+};
+
+} // namespace c4lib
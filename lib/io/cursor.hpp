@@ -0,0 +1,100 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <lib/util/exception-formats.hpp>
+#include <span>
+#include <stdexcept>
+
+namespace c4lib::io {
+
+// Cursor is a lightweight alternative to std::istream for reading binary data held in a contiguous buffer.  Reads
+// are bounds-checked and throw std::runtime_error on overrun, so a failed read never leaves the cursor in an error
+// state which must be tested.  The bytes are not copied, so the buffer must outlive the cursor.
+class Cursor {
+public:
+    Cursor() = default;
+
+    explicit Cursor(std::span<const std::byte> bytes)
+        : m_bytes(bytes)
+    {}
+
+    ~Cursor() = default;
+
+    Cursor(const Cursor&) = delete;
+
+    Cursor& operator=(const Cursor&) = delete;
+
+    Cursor(Cursor&&) noexcept = delete;
+
+    Cursor& operator=(Cursor&&) noexcept = delete;
+
+    // Copies the next size bytes to out and advances the cursor.
+    void read(char* out, std::streamsize size)
+    {
+        std::memcpy(out, view(size).data(), static_cast<size_t>(size));
+    }
+
+    // Replaces the buffer read by the cursor and moves the cursor to its beginning.
+    void reset(std::span<const std::byte> bytes)
+    {
+        m_bytes = bytes;
+        m_position = 0;
+    }
+
+    // Returns the number of bytes between the cursor and the end of the buffer.
+    [[nodiscard]] size_t remaining() const
+    {
+        return m_bytes.size() - m_position;
+    }
+
+    // Moves the cursor to offset relative to dir and returns the new position.
+    std::streamoff seek(std::streamoff offset, std::ios_base::seekdir dir = std::ios_base::beg)
+    {
+        std::streamoff base{0};
+        if (dir == std::ios_base::cur) {
+            base = static_cast<std::streamoff>(m_position);
+        }
+        else if (dir == std::ios_base::end) {
+            base = static_cast<std::streamoff>(m_bytes.size());
+        }
+        const std::streamoff position{base + offset};
+        if (position < 0 || position > static_cast<std::streamoff>(m_bytes.size())) {
+            throw std::runtime_error(fmt::runtime_error_seek);
+        }
+        m_position = static_cast<size_t>(position);
+        return position;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_bytes.size();
+    }
+
+    [[nodiscard]] std::streamoff tell() const
+    {
+        return static_cast<std::streamoff>(m_position);
+    }
+
+    // Returns the next size bytes without copying them and advances the cursor.
+    std::span<const std::byte> view(std::streamsize size)
+    {
+        if (size < 0 || static_cast<size_t>(size) > remaining()) {
+            throw std::runtime_error(fmt::runtime_error_read);
+        }
+        const std::span<const std::byte> bytes{m_bytes.subspan(m_position, static_cast<size_t>(size))};
+        m_position += static_cast<size_t>(size);
+        return bytes;
+    }
+
+private:
+    std::span<const std::byte> m_bytes;
+    size_t m_position{0};
+};
+
+} // namespace c4lib::io
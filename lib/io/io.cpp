@@ -12,7 +12,9 @@
 #include <iterator>
 #include <lib/io/io.hpp>
 #include <lib/util/exception-formats.hpp>
+#include <lib/util/narrow.hpp>
 #include <string>
+#include <vector>
 
 namespace c4lib::io {
 
@@ -50,6 +52,21 @@ void read_binary_file_to_stream(const std::string& filename, std::streampos offs
     }
 }
 
+void read_binary_stream(std::istream& in, std::vector<std::byte>& out)
+{
+    const std::streampos begin{in.tellg()};
+    in.seekg(0, std::ios_base::end);
+    const std::streampos end{in.tellg()};
+    in.seekg(begin);
+    if (!in) {
+        throw std::runtime_error(fmt::runtime_error_seek);
+    }
+
+    out.resize(gsl::narrow<size_t>(end - begin));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    read_bytes(in, reinterpret_cast<char*>(out.data()), gsl::narrow<std::streamsize>(out.size()));
+}
+
 void read_bytes(std::istream& in, char* out, std::streamsize size)
 {
     in.read(out, size);
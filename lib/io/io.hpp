@@ -13,9 +13,11 @@
 #include <include/exceptions.hpp>
 #include <ios>
 #include <iosfwd>
+#include <lib/io/cursor.hpp>
 #include <lib/util/limits.hpp>
 #include <lib/util/narrow.hpp>
 #include <string>
+#include <vector>
 
 namespace c4lib::io {
 
@@ -40,12 +42,20 @@ std::string make_path(const std::string& output_dir, const std::string& filename
 
 void read_binary_file_to_stream(const std::string& filename, std::streampos offset, size_t size, std::ostream& out);
 
+// Reads the remainder of the input stream, from its current position, into out.  The stream must be seekable.
+void read_binary_stream(std::istream& in, std::vector<std::byte>& out);
+
 void read_bytes(std::istream& in, char* out, std::streamsize size);
 
+inline void read_bytes(Cursor& in, char* out, std::streamsize size)
+{
+    in.read(out, size);
+}
+
 // Reads binary integer values from the input stream.  The input stream is assumed to be in little endian byte
 // order.  If the native system is big endian, byte order will be reversed in order to preserve the intended
-// integer enumeratorValue.
-template<typename I> void read_int(std::istream& in, I& out)
+// integer enumeratorValue.  In may be std::istream or Cursor.
+template<typename In, typename I> void read_int(In& in, I& out)
 {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
     read_bytes(in, reinterpret_cast<char*>(&out), sizeof(I));
@@ -53,7 +63,7 @@ template<typename I> void read_int(std::istream& in, I& out)
     make_little_endian(reinterpret_cast<char*>(&out), gsl::narrow<std::streamsize>(sizeof(I)));
 }
 
-template<typename S> void read_string(std::istream& in, S& str)
+template<typename In, typename S> void read_string(In& in, S& str)
 {
     uint32_t length{0};
     read_int(in, length);
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <ios>
+#include <span>
+#include <streambuf>
+
+namespace c4lib::io {
+
+// Read-only stream buffer over a span of bytes.  The bytes are not copied, so the span must outlive the buffer.
+// Supports seeking, which std::istream requires for tellg and seekg.
+class Span_streambuf : public std::streambuf {
+public:
+    explicit Span_streambuf(std::span<const std::byte> bytes)
+    {
+        // std::streambuf requires non-const pointers; the get area is never written.
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast, cppcoreguidelines-pro-type-reinterpret-cast)
+        char* begin{const_cast<char*>(reinterpret_cast<const char*>(bytes.data()))};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        setg(begin, begin, begin + bytes.size());
+    }
+
+    ~Span_streambuf() override = default;
+
+    Span_streambuf(const Span_streambuf&) = delete;
+
+    Span_streambuf& operator=(const Span_streambuf&) = delete;
+
+    Span_streambuf(Span_streambuf&&) noexcept = delete;
+
+    Span_streambuf& operator=(Span_streambuf&&) noexcept = delete;
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        if ((which & std::ios_base::in) == 0) {
+            return pos_type{off_type{-1}};
+        }
+
+        off_type base{0};
+        if (dir == std::ios_base::cur) {
+            base = gptr() - eback();
+        }
+        else if (dir == std::ios_base::end) {
+            base = egptr() - eback();
+        }
+        const off_type position{base + off};
+        if (position < 0 || position > egptr() - eback()) {
+            return pos_type{off_type{-1}};
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        setg(eback(), eback() + position, egptr());
+        return pos_type{position};
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type{position}, std::ios_base::beg, which);
+    }
+};
+
+} // namespace c4lib::io
@@ -0,0 +1,318 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <include/save-summary.hpp>
+#include <ios>
+#include <lib/io/cursor.hpp>
+#include <lib/io/io.hpp>
+#include <lib/layout/header-layout.hpp>
+#include <lib/layout/layout.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/text.hpp>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION DETAILS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void skip_bytes_(c4lib::io::Cursor& in, std::streamoff count)
+{
+    in.seek(count, std::ios_base::cur);
+}
+
+void skip_dwords_(c4lib::io::Cursor& in, std::streamoff count)
+{
+    skip_bytes_(in, count * std::streamoff{sizeof(uint32_t)});
+}
+
+// Skips a string of C, returning the offset of its length field.
+template<typename C> std::streamoff skip_string_(c4lib::io::Cursor& in)
+{
+    const std::streamoff offset{in.tell()};
+    uint32_t length{0};
+    c4lib::io::read_int(in, length);
+    skip_bytes_(in, std::streamoff{length} * std::streamoff{sizeof(C)});
+    return offset;
+}
+
+// Skips count strings of C, recording the offset of each in offsets.
+template<typename C> void skip_strings_(c4lib::io::Cursor& in, int count, std::vector<std::streamoff>& offsets)
+{
+    offsets.clear();
+    for (int i{0}; i < count; ++i) {
+        offsets.push_back(skip_string_<C>(in));
+    }
+}
+
+// Skips an array of count elements of size size, returning the offset of the first element.
+std::streamoff skip_array_(c4lib::io::Cursor& in, int count, std::streamoff size)
+{
+    const std::streamoff offset{in.tell()};
+    skip_bytes_(in, count * size);
+    return offset;
+}
+} // namespace
+
+namespace c4lib::layout {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Header_layout::Header_layout(std::span<const std::byte> save)
+    : m_save(save)
+{
+    scan_game_header_();
+}
+
+Header_layout::Header_layout(std::span<const std::byte> save,
+    int max_players,
+    int num_game_option_types,
+    int num_multiplayer_option_types)
+    : m_save(save)
+{
+    scan_game_header_();
+    scan_cv_init_core(max_players, num_game_option_types, num_multiplayer_option_types);
+}
+
+std::u16string Header_layout::get_admin_password_hash() const
+{
+    require_cv_init_core_();
+    return read_string_<std::u16string>(m_admin_password_offset);
+}
+
+uint32_t Header_layout::get_checksum_dword() const
+{
+    return read_int_<uint32_t>(m_checksum_dword_offset);
+}
+
+std::streamoff Header_layout::get_civ4_compressed_data_offset(bool confirm_zlib_magic) const
+{
+    if (confirm_zlib_magic) {
+        // Civ4 writes compressed data in chunks.  The size of the chunk is written, followed by the compressed data for
+        // the chunk, so the zlib magic value follows the size of the first chunk.
+        const std::streamoff zlib_magic_offset{m_compressed_data_offset + std::streamoff{sizeof(uint32_t)}};
+        io::Cursor cursor{m_save};
+        cursor.seek(zlib_magic_offset);
+        const std::span<const std::byte> magic{cursor.view(gsl::narrow<std::streamsize>(zlib_magic.size()))};
+        if (std::memcmp(magic.data(), zlib_magic.data(), zlib_magic.size()) != 0) {
+            throw std::logic_error(fmt::zlib_error_bad_magic_value);
+        }
+    }
+    return m_compressed_data_offset;
+}
+
+std::span<const std::byte> Header_layout::get_cv_init_core_md5_data() const
+{
+    // N.B.: The header MD5 excludes the data size field.
+    const auto size{read_int_<uint32_t>(m_cv_init_core_md5_size_field_offset)};
+    io::Cursor cursor{m_save};
+    cursor.seek(m_cv_init_core_md5_size_field_offset + std::streamoff{sizeof(uint32_t)});
+    return cursor.view(std::streamsize{size});
+}
+
+std::u16string Header_layout::get_game_password_hash() const
+{
+    require_cv_init_core_();
+    return read_string_<std::u16string>(m_game_password_offset);
+}
+
+uint32_t Header_layout::get_game_version() const
+{
+    return read_int_<uint32_t>(game_version_offset);
+}
+
+void Header_layout::get_lma_strings(std::vector<std::string>& lma_strings) const
+{
+    lma_strings.clear();
+    for (const std::streamoff offset : m_lma_string_offsets) {
+        lma_strings.push_back(read_string_<std::string>(offset));
+    }
+}
+
+void Header_layout::get_player_password_hashes(std::vector<std::u16string>& player_password_hashes) const
+{
+    require_cv_init_core_();
+    player_password_hashes.clear();
+    for (const std::streamoff offset : m_players.password_hash) {
+        player_password_hashes.push_back(read_string_<std::u16string>(offset));
+    }
+}
+
+void Header_layout::get_save_summary(Save_summary& summary) const
+{
+    require_cv_init_core_();
+    summary.game_version = get_game_version();
+    summary.required_mod = read_string_<std::string>(required_mod_offset);
+    summary.game_type = read_int_<int32_t>(m_game_type_offset);
+    summary.game_name = read_u16string_as_string_(m_game_name_offset);
+    summary.game_password_hash = read_u16string_as_string_(m_game_password_offset);
+    summary.admin_password_hash = read_u16string_as_string_(m_admin_password_offset);
+    summary.map_script_name = read_u16string_as_string_(m_map_script_name_offset);
+    summary.game_turn = read_int_<int32_t>(m_game_turn_offset);
+    summary.max_turns = read_int_<int32_t>(m_max_turns_offset);
+
+    summary.players.assign(gsl::narrow<size_t>(m_max_players), Save_player{});
+    for (size_t i{0}; i < summary.players.size(); ++i) {
+        Save_player& player{summary.players[i]};
+        const auto index{gsl::narrow<std::streamoff>(i)};
+        const std::streamoff dword_index{index * std::streamoff{sizeof(int32_t)}};
+        player.leader_name = read_u16string_as_string_(m_players.leader_name[i]);
+        player.civ_description = read_u16string_as_string_(m_players.civ_description[i]);
+        player.civ_short_description = read_u16string_as_string_(m_players.civ_short_description[i]);
+        player.civ_adjective = read_u16string_as_string_(m_players.civ_adjective[i]);
+        player.password_hash = read_u16string_as_string_(m_players.password_hash[i]);
+        player.email = read_string_<std::string>(m_players.email[i]);
+        player.civ = read_int_<int32_t>(m_players.civ + dword_index);
+        player.leader = read_int_<int32_t>(m_players.leader + dword_index);
+        player.team = read_int_<int32_t>(m_players.team + dword_index);
+        player.handicap = read_int_<int32_t>(m_players.handicap + dword_index);
+        player.slot_status = read_int_<int32_t>(m_players.slot_status + dword_index);
+        player.slot_claim = read_int_<int32_t>(m_players.slot_claim + dword_index);
+        player.is_playable = read_int_<uint8_t>(m_players.is_playable + index) != 0;
+        player.is_minor = read_int_<uint8_t>(m_players.is_minor + index) != 0;
+    }
+}
+
+void Header_layout::scan_cv_init_core(int max_players, int num_game_option_types, int num_multiplayer_option_types)
+{
+    if (m_max_players != limits::invalid_value) {
+        return;
+    }
+
+    io::Cursor in{m_save};
+    // Seek past CvInitCoreMd5Size and CvInitCore::m_uiSaveFlag.
+    in.seek(m_cv_init_core_md5_size_field_offset);
+    skip_dwords_(in, 2);
+    m_game_type_offset = in.tell();
+    skip_dwords_(in, 1);
+    m_game_name_offset = skip_string_<char16_t>(in);
+    m_game_password_offset = skip_string_<char16_t>(in);
+    m_admin_password_offset = skip_string_<char16_t>(in);
+    m_map_script_name_offset = skip_string_<char16_t>(in);
+    // Seek past 1) CvInitCore::m_bWBMapNoPlayers
+    skip_bytes_(in, 1);
+    // Seek past 1) CvInitCore::m_eWorldSize;
+    //           2) CvInitCore::m_eClimate;
+    //           3) CvInitCore::m_eSeaLevel;
+    //           4) CvInitCore::m_eEra;
+    //           5) CvInitCore::m_eGameSpeed;
+    //           6) CvInitCore::m_eTurnTimer;
+    //           7) CvInitCore::m_eCalendar
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    skip_dwords_(in, 7);
+    uint32_t num_custom_map_options{0};
+    io::read_int(in, num_custom_map_options);
+    // Seek past CvInitCore::m_iNumHiddenCustomMapOptions and CvInitCore::m_aeCustomMapOptions
+    skip_dwords_(in, 1 + std::streamoff{num_custom_map_options});
+    uint32_t num_victories{0};
+    io::read_int(in, num_victories);
+    // Seek past CvInitCore::m_abVictories, m_abOptions, m_abMPOptions and m_bStatReporting
+    skip_bytes_(in, std::streamoff{num_victories} + num_game_option_types + num_multiplayer_option_types + 1);
+    m_game_turn_offset = in.tell();
+    m_max_turns_offset = m_game_turn_offset + std::streamoff{sizeof(int32_t)};
+    // Seek past 1) CvInitCore::m_iGameTurn;
+    //           2) CvInitCore::m_iMaxTurns;
+    //           3) CvInitCore::m_iPitbossTurnTime;
+    //           4) CvInitCore::m_iTargetScore;
+    //           5) CvInitCore::m_iMaxCityElimination;
+    //           6) CvInitCore::m_iNumAdvancedStartPoints
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    skip_dwords_(in, 6);
+
+    // Each array of player data has MAX_PLAYERS elements.
+    constexpr std::streamoff dword_size{sizeof(int32_t)};
+    skip_strings_<char16_t>(in, max_players, m_players.leader_name);
+    skip_strings_<char16_t>(in, max_players, m_players.civ_description);
+    skip_strings_<char16_t>(in, max_players, m_players.civ_short_description);
+    skip_strings_<char16_t>(in, max_players, m_players.civ_adjective);
+    skip_strings_<char16_t>(in, max_players, m_players.password_hash);
+    skip_strings_<char>(in, max_players, m_players.email);
+    // Seek past CvInitCore::m_aszSmtpHost, m_abWhiteFlag and m_aszFlagDecal
+    std::vector<std::streamoff> skipped;
+    skip_strings_<char>(in, max_players, skipped);
+    skip_array_(in, max_players, 1);
+    skip_strings_<char16_t>(in, max_players, skipped);
+    m_players.civ = skip_array_(in, max_players, dword_size);
+    m_players.leader = skip_array_(in, max_players, dword_size);
+    m_players.team = skip_array_(in, max_players, dword_size);
+    m_players.handicap = skip_array_(in, max_players, dword_size);
+    // Seek past CvInitCore::m_aeColor and m_aeArtStyle
+    skip_array_(in, 2 * max_players, dword_size);
+    m_players.slot_status = skip_array_(in, max_players, dword_size);
+    m_players.slot_claim = skip_array_(in, max_players, dword_size);
+    m_players.is_playable = skip_array_(in, max_players, 1);
+    m_players.is_minor = skip_array_(in, max_players, 1);
+
+    // CvGameAI::m_uiFlag, the last field of the header, precedes the compressed data.
+    skip_dwords_(in, 1);
+    if (in.tell() != m_compressed_data_offset) {
+        throw std::logic_error(fmt::bad_file_offset);
+    }
+    m_max_players = max_players;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename I> I Header_layout::read_int_(std::streamoff offset) const
+{
+    io::Cursor cursor{m_save};
+    cursor.seek(offset);
+    I value{0};
+    io::read_int(cursor, value);
+    return value;
+}
+
+template<typename S> S Header_layout::read_string_(std::streamoff offset) const
+{
+    io::Cursor cursor{m_save};
+    cursor.seek(offset);
+    S value;
+    io::read_string(cursor, value);
+    return value;
+}
+
+std::string Header_layout::read_u16string_as_string_(std::streamoff offset) const
+{
+    return text::u16string_to_string(read_string_<std::u16string>(offset));
+}
+
+void Header_layout::require_cv_init_core_() const
+{
+    if (m_max_players == limits::invalid_value) {
+        throw std::logic_error(fmt::cv_init_core_not_scanned);
+    }
+}
+
+void Header_layout::scan_game_header_()
+{
+    io::Cursor in{m_save};
+    // Seek past GameHeader::RequiredMod and GameHeader::ModMd5.
+    in.seek(required_mod_offset);
+    skip_string_<char>(in);
+    skip_string_<char>(in);
+    m_checksum_dword_offset = in.tell();
+    skip_dwords_(in, 1);
+    for (std::streamoff& offset : m_lma_string_offsets) {
+        offset = skip_string_<char>(in);
+    }
+
+    // The value of CvInitCoreMd5Size is both the size of the CvInitCore MD5 data and the offset of the compressed data
+    // relative to the game data element, which follows CvInitCore::m_uiSaveFlag.
+    m_cv_init_core_md5_size_field_offset = in.tell();
+    uint32_t relative_offset_to_compressed_data{0};
+    io::read_int(in, relative_offset_to_compressed_data);
+    skip_dwords_(in, 1);
+    m_compressed_data_offset = in.tell() + std::streamoff{relative_offset_to_compressed_data};
+}
+
+} // namespace c4lib::layout
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <include/save-summary.hpp>
+#include <ios>
+#include <lib/layout/layout.hpp>
+#include <lib/util/limits.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace c4lib::layout {
+
+// Offsets of the fields of the uncompressed header of a save, which consists of GameHeader, CvInitCore and the flag
+// of CvGameAI.  The header is scanned once, when the layout is created, and each getter then reads its field at the
+// recorded offset.  GameHeader is always scanned; CvInitCore, whose layout depends upon MAX_PLAYERS and the numbers of
+// game and multiplayer options, is scanned only when these counts are given.  Getters for the fields of CvInitCore
+// throw std::logic_error if CvInitCore has not been scanned.
+class Header_layout {
+public:
+    // Scans GameHeader.  save is the save or a prefix of the save holding at least its GameHeader and must remain
+    // valid for the lifetime of the layout.  Throws std::runtime_error if save ends within GameHeader.
+    explicit Header_layout(std::span<const std::byte> save);
+
+    // Scans GameHeader and CvInitCore.  Throws std::logic_error if the header does not end at the compressed data, or
+    // std::runtime_error if the scan overruns save, either of which indicates that the counts given do not match those
+    // of the save.
+    Header_layout(std::span<const std::byte> save,
+        int max_players,
+        int num_game_option_types,
+        int num_multiplayer_option_types);
+
+    ~Header_layout() = default;
+
+    Header_layout(const Header_layout&) = delete;
+
+    Header_layout& operator=(const Header_layout&) = delete;
+
+    Header_layout(Header_layout&&) noexcept = delete;
+
+    Header_layout& operator=(Header_layout&&) noexcept = delete;
+
+    [[nodiscard]] std::u16string get_admin_password_hash() const;
+
+    // Returns the bytes scanned, which begin with the header.
+    [[nodiscard]] std::span<const std::byte> get_bytes() const
+    {
+        return m_save;
+    }
+
+    [[nodiscard]] uint32_t get_checksum_dword() const;
+
+    // Returns the offset of the compressed data, which is also the size of the header.  If confirm_zlib_magic is true,
+    // throws std::logic_error unless the compressed data begins with the zlib magic value.
+    [[nodiscard]] std::streamoff get_civ4_compressed_data_offset(bool confirm_zlib_magic) const;
+
+    // Returns the data from which the CvInitCore MD5 is calculated.
+    [[nodiscard]] std::span<const std::byte> get_cv_init_core_md5_data() const;
+
+    [[nodiscard]] std::u16string get_game_password_hash() const;
+
+    [[nodiscard]] uint32_t get_game_version() const;
+
+    void get_lma_strings(std::vector<std::string>& lma_strings) const;
+
+    void get_player_password_hashes(std::vector<std::u16string>& player_password_hashes) const;
+
+    void get_save_summary(Save_summary& summary) const;
+
+    // Replaces the bytes described by the layout, which must begin with the same header, without scanning them again.
+    // Used when the buffer holding the header is reallocated or truncated.
+    void reset(std::span<const std::byte> save)
+    {
+        m_save = save;
+    }
+
+    // Scans CvInitCore if it has not already been scanned.  Throws as described for the constructor if the counts given
+    // do not match those of the save.
+    void scan_cv_init_core(int max_players, int num_game_option_types, int num_multiplayer_option_types);
+
+private:
+    template<typename I> [[nodiscard]] I read_int_(std::streamoff offset) const;
+
+    template<typename S> [[nodiscard]] S read_string_(std::streamoff offset) const;
+
+    // Returns the UTF-16 string at offset as UTF-8.
+    [[nodiscard]] std::string read_u16string_as_string_(std::streamoff offset) const;
+
+    void require_cv_init_core_() const;
+
+    void scan_game_header_();
+
+    // Offsets of the arrays of player data in CvInitCore.  String arrays record the offset of each element; the
+    // elements of other arrays follow the offset of the first at a fixed stride.
+    struct Player_offsets {
+        std::vector<std::streamoff> leader_name;
+        std::vector<std::streamoff> civ_description;
+        std::vector<std::streamoff> civ_short_description;
+        std::vector<std::streamoff> civ_adjective;
+        std::vector<std::streamoff> password_hash;
+        std::vector<std::streamoff> email;
+        std::streamoff civ{limits::invalid_off};
+        std::streamoff leader{limits::invalid_off};
+        std::streamoff team{limits::invalid_off};
+        std::streamoff handicap{limits::invalid_off};
+        std::streamoff slot_status{limits::invalid_off};
+        std::streamoff slot_claim{limits::invalid_off};
+        std::streamoff is_playable{limits::invalid_off};
+        std::streamoff is_minor{limits::invalid_off};
+    };
+
+    std::streamoff m_admin_password_offset{limits::invalid_off};
+    std::streamoff m_checksum_dword_offset{limits::invalid_off};
+    std::streamoff m_compressed_data_offset{limits::invalid_off};
+    std::streamoff m_cv_init_core_md5_size_field_offset{limits::invalid_off};
+    std::streamoff m_game_name_offset{limits::invalid_off};
+    std::streamoff m_game_password_offset{limits::invalid_off};
+    std::streamoff m_game_turn_offset{limits::invalid_off};
+    std::streamoff m_game_type_offset{limits::invalid_off};
+    std::array<std::streamoff, num_lma_strings> m_lma_string_offsets{};
+    std::streamoff m_map_script_name_offset{limits::invalid_off};
+    std::streamoff m_max_turns_offset{limits::invalid_off};
+    int m_max_players{limits::invalid_value};
+    Player_offsets m_players;
+    std::span<const std::byte> m_save;
+};
+
+} // namespace c4lib::layout
@@ -13,6 +13,13 @@ inline constexpr const char* caught_unknown_exception{"Caught  unknown exception
 inline constexpr const char* compressed_data_md5{"Compressed data MD5 is {}."};
 inline constexpr const char* cv_init_core_md5{"CvInitCore MD5 is {}."};
 inline constexpr const char* finished_in{"{} finished in {}."};
+inline constexpr const char* generated_reader_found{"Using the reader generated for program {}."};
+inline constexpr const char* generated_reader_not_found{"No reader generated for program {}; interpreting it."};
 inline constexpr const char* rollup_md5{"Rollup MD5 is {}."};
+inline constexpr const char* schema_cache_damaged{"Schema cache '{}' is damaged."};
+inline constexpr const char* schema_cache_loaded{"Loaded schema cache '{}'."};
+inline constexpr const char* schema_cache_miss{"Schema cache '{}' not found."};
+inline constexpr const char* schema_cache_saved{"Saved schema cache '{}'."};
+inline constexpr const char* schema_cache_stale{"Schema cache '{}' is stale."};
 
 } // namespace c4lib::fmt
@@ -7,6 +7,7 @@
 #include <include/logger.hpp>
 #include <lib/native/path.hpp>
 #include <lib/util/exception-formats.hpp>
+#include <mutex>
 #include <ostream>
 #include <string>
 
@@ -16,6 +17,7 @@ std::fstream Logger::m_null_out{};
 void Logger::start(const std::string& filename, Severity threshold)
 {
     const native::Path path{filename};
+    const std::scoped_lock lock{instance().m_mutex};
     instance().m_file.close();
     instance().m_file.clear();
     instance().m_file.open(path.c_str(), std::ofstream::out | std::ofstream::app);
@@ -30,6 +32,7 @@ void Logger::start(const std::string& filename, Severity threshold)
 
 void Logger::start(std::ostream& stream, Severity threshold)
 {
+    const std::scoped_lock lock{instance().m_mutex};
     // In case our current stream is a file we've opened
     instance().m_file.close();
     instance().m_file.clear();
@@ -41,6 +44,7 @@ void Logger::start(std::ostream& stream, Severity threshold)
 
 void Logger::stop()
 {
+    const std::scoped_lock lock{instance().m_mutex};
     instance().m_file.close();
     instance().m_file.clear();
 
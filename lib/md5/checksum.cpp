@@ -9,8 +9,8 @@
 #include <include/exceptions.hpp>
 #include <include/logger.hpp>
 #include <ios>
-#include <istream>
 #include <lib/io/io.hpp>
+#include <lib/layout/header-layout.hpp>
 #include <lib/layout/layout.hpp>
 #include <lib/logger/log-formats.hpp>
 #include <lib/md5/checksum.hpp>
@@ -18,8 +18,11 @@
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/narrow.hpp>
 #include <lib/util/tune.hpp>
+#include <memory>
 #include <ostream>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace c4lib::md5 {
@@ -27,12 +30,20 @@ namespace c4lib::md5 {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // INTERFACE
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Checksum::Checksum(std::span<const std::byte> civ4_savegame,
+    int max_players,
+    int num_game_option_types,
+    int num_multiplayer_option_types)
+    : m_footer(civ4_savegame),
+      m_header_storage(std::make_unique<layout::Header_layout>(
+          civ4_savegame, max_players, num_game_option_types, num_multiplayer_option_types))
+{
+    m_header = m_header_storage.get();
+}
+
 Checksum::Checksum(
-    std::istream& civ4_savegame, int max_players, int num_game_option_types, int num_multiplayer_option_types)
-    : m_in(civ4_savegame),
-      m_max_players(max_players),
-      m_num_game_option_types(num_game_option_types),
-      m_num_multiplayer_option_types(num_multiplayer_option_types)
+    const layout::Header_layout& header, std::span<const std::byte> footer, std::string compressed_data_md5)
+    : m_compressed_data_md5(std::move(compressed_data_md5)), m_footer(footer), m_header(&header)
 {}
 
 std::string Checksum::get_hash()
@@ -57,24 +68,29 @@ const std::ostream& Checksum::get_hash_data()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void Checksum::calculate_rollup_md5_()
 {
-    m_compressed_data_offset = layout::get_civ4_compressed_data_offset(m_in, true);
     get_cv_init_core_md5_();
-    get_compressed_data_md5_();
+    if (m_compressed_data_md5.empty()) {
+        get_compressed_data_md5_();
+    }
+    else {
+        Logger::info(std::format(fmt::compressed_data_md5, m_compressed_data_md5));
+    }
     get_rollup_md5_();
 }
 
 void Checksum::get_compressed_data_md5_()
 {
     Md5_digest digest;
-    m_in.seekg(m_compressed_data_offset);
+    io::Cursor savegame{m_header->get_bytes()};
+    savegame.seek(m_header->get_civ4_compressed_data_offset(true));
     uint32_t chunk_size{0};
-    io::read_int(m_in, chunk_size);
+    io::read_int(savegame, chunk_size);
     while (chunk_size > 0) {
         if (chunk_size > tune::md5_buffer_size) {
             throw Checksum_error(fmt::invalid_chunk_size);
         }
-        digest.add(m_in, chunk_size);
-        io::read_int(m_in, chunk_size);
+        digest.add(savegame.view(chunk_size));
+        io::read_int(savegame, chunk_size);
     }
     m_compressed_data_md5 = digest.get_hash();
     Logger::info(std::format(fmt::compressed_data_md5, m_compressed_data_md5));
@@ -83,11 +99,7 @@ void Checksum::get_compressed_data_md5_()
 void Checksum::get_cv_init_core_md5_()
 {
     Md5_digest digest;
-    const std::streampos cv_init_core_md5_size_field_offset{layout::seek_to_cv_init_core_md5_size_field(m_in)};
-    const std::streamsize cv_init_core_md5_data_size{
-        gsl::narrow<std::streamsize>(layout::get_cv_init_core_md5_data_size(m_in))};
-    // N.B.: The header MD5 excludes the data size field (add 4 to offset).
-    digest.add(m_in, cv_init_core_md5_size_field_offset + gsl::narrow<std::streampos>(4LL), cv_init_core_md5_data_size);
+    digest.add(m_header->get_cv_init_core_md5_data());
     m_cv_init_core_md5 = digest.get_hash();
     Logger::info(std::format(fmt::cv_init_core_md5, m_cv_init_core_md5));
 }
@@ -95,36 +107,35 @@ void Checksum::get_cv_init_core_md5_()
 void Checksum::get_rollup_md5_()
 {
     // Write the checksum DWORD to the rollup buffer.
-    uint32_t checksum_dword{layout::get_checksum_dword(m_in)};
+    uint32_t checksum_dword{m_header->get_checksum_dword()};
     io::write_int(m_rollup_md5_buffer, checksum_dword);
 
     // Write the game version to the rollup buffer.
-    uint32_t game_version{layout::get_game_version(m_in)};
+    uint32_t game_version{m_header->get_game_version()};
     io::write_int(m_rollup_md5_buffer, game_version);
 
     // Write the checksum byte to the rollup buffer.
-    uint8_t checksum_byte{layout::get_checksum_byte(m_in)};
+    uint8_t checksum_byte{layout::get_checksum_byte(m_footer)};
     io::write_int(m_rollup_md5_buffer, checksum_byte);
 
     // Write the Lock Modified Assets strings to the rollup buffer.
     std::vector<std::string> lmaStrings;
-    layout::get_lma_strings(m_in, lmaStrings);
+    m_header->get_lma_strings(lmaStrings);
     for (const auto& lmaString : lmaStrings) {
         io::write_string(m_rollup_md5_buffer, lmaString);
     }
 
     // Write CvInitCore.m_szAdminPassword (CvWString) to the rollup buffer.
-    const std::u16string admin_password_hash{layout::get_admin_password_hash(m_in)};
+    const std::u16string admin_password_hash{m_header->get_admin_password_hash()};
     io::write_string(m_rollup_md5_buffer, admin_password_hash);
 
     // Write CvInitCore.m_szGamePassword (CvWString) to the rollup buffer.
-    const std::u16string game_password_hash{layout::get_game_password_hash(m_in)};
+    const std::u16string game_password_hash{m_header->get_game_password_hash()};
     io::write_string(m_rollup_md5_buffer, game_password_hash);
 
     // Write each player's password hash (CvWString) to the rollup buffer.
     std::vector<std::u16string> playerPasswordHashes;
-    layout::get_player_password_hashes(
-        m_in, playerPasswordHashes, m_max_players, m_num_game_option_types, m_num_multiplayer_option_types);
+    m_header->get_player_password_hashes(playerPasswordHashes);
     for (const auto& player_password_hash : playerPasswordHashes) {
         io::write_string(m_rollup_md5_buffer, player_password_hash);
     }
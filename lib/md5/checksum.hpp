@@ -4,8 +4,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
+#include <lib/io/cursor.hpp>
+#include <lib/layout/header-layout.hpp>
 #include <lib/util/limits.hpp>
+#include <memory>
+#include <span>
 #include <sstream>
 #include <string>
 
@@ -14,7 +19,17 @@ namespace c4lib::md5 {
 // Checksum is used to calculate the md5 digest which appears at the end of a civ4 savegame.
 class Checksum {
 public:
-    Checksum(std::istream& civ4_savegame, int max_players, int num_game_option_types, int num_multiplayer_option_types);
+    // civ4_savegame must remain valid until the hash has been calculated.
+    Checksum(std::span<const std::byte> civ4_savegame,
+        int max_players,
+        int num_game_option_types,
+        int num_multiplayer_option_types);
+
+    // Creates a checksum for a savegame whose compressed data has already been hashed, as when the savegame is
+    // deflated as it is written.  header is the layout of the uncompressed game header, which must have scanned
+    // CvInitCore, and footer is the uncompressed game footer.  Both must remain valid until the hash has been
+    // calculated.  compressed_data_md5 is the md5 of the compressed data chunks, excluding their sizes.
+    Checksum(const layout::Header_layout& header, std::span<const std::byte> footer, std::string compressed_data_md5);
 
     ~Checksum() = default;
 
@@ -42,13 +57,14 @@ private:
     void get_rollup_md5_();
 
     std::string m_compressed_data_md5;
-    std::streampos m_compressed_data_offset{limits::invalid_off};
     std::string m_cv_init_core_md5;
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-    std::istream& m_in;
-    int m_max_players{limits::invalid_value};
-    int m_num_game_option_types{limits::invalid_value};
-    int m_num_multiplayer_option_types{limits::invalid_value};
+    // Cursor over the game footer.  When the checksum is created from an entire savegame, the cursor reads the
+    // savegame.
+    io::Cursor m_footer;
+    // Layout of the game header, which is owned by m_header_storage when the checksum is created from an entire
+    // savegame.
+    const layout::Header_layout* m_header{nullptr};
+    std::unique_ptr<layout::Header_layout> m_header_storage;
     std::string m_rollup_md5;
     std::stringstream m_rollup_md5_buffer;
 };
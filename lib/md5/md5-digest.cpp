@@ -10,6 +10,7 @@
 #include <lib/md5/md5-digest.hpp>
 #include <lib/util/narrow.hpp>
 #include <lib/util/tune.hpp>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,11 @@ void Md5_digest::add(std::istream& in, std::streampos start, std::streamsize cou
     add(in, count);
 }
 
+void Md5_digest::add(std::span<const std::byte> bytes)
+{
+    m_md5.add(bytes.data(), bytes.size());
+}
+
 std::string Md5_digest::get_hash()
 {
     return m_md5.getHash();
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <ios>
 #include <iosfwd>
 #include <lib/md5/md5.hpp>
+#include <span>
 #include <string>
 
 namespace c4lib::md5 {
@@ -17,6 +19,8 @@ public:
 
     void add(std::istream& in, std::streamsize count);
 
+    void add(std::span<const std::byte> bytes);
+
     std::string get_hash();
 
 private:
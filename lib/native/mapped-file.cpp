@@ -0,0 +1,130 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <lib/native/mapped-file.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/narrow.hpp>
+#include <stdexcept>
+#include <string>
+
+#ifdef linux
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <ios>
+#include <lib/io/io.hpp>
+#endif
+
+namespace {
+#ifdef linux
+// Initial buffer size used when reading a file of unknown size.
+constexpr size_t min_read_size{0x10000};
+#endif
+} // namespace
+
+namespace c4lib::native {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef linux
+Mapped_file::Mapped_file(const std::string& filename)
+    : m_filename(filename)
+{
+    const int fd{::open(filename.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd < 0) {
+        throw std::runtime_error{std::format(fmt::runtime_error_opening_file, filename)};
+    }
+
+    struct stat status{};
+    if (::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error{std::format(fmt::runtime_error_reading_from_file, filename)};
+    }
+
+    // mmap fails for empty files, and files other than regular files may not support it at all.
+    const size_t size{S_ISREG(status.st_mode) ? gsl::narrow<size_t>(status.st_size) : 0};
+    if (size > 0) {
+        void* mapping{::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+        if (mapping != MAP_FAILED) {
+            m_mapping = mapping;
+            m_mapping_size = size;
+            m_bytes = std::span<const std::byte>{static_cast<const std::byte*>(m_mapping), m_mapping_size};
+        }
+    }
+
+    if (m_mapping == nullptr) {
+        try {
+            read_(fd, size);
+        }
+        catch (...) {
+            ::close(fd);
+            throw;
+        }
+    }
+
+    // The mapping remains valid once the file is closed.
+    ::close(fd);
+}
+
+Mapped_file::~Mapped_file()
+{
+    if (m_mapping != nullptr) {
+        ::munmap(m_mapping, m_mapping_size);
+    }
+}
+#else
+Mapped_file::Mapped_file(const std::string& filename)
+    : m_filename(filename)
+{
+    std::ifstream file{filename, std::ios_base::in | std::ios_base::binary};
+    if (!file.is_open() || file.bad()) {
+        throw std::runtime_error{std::format(fmt::runtime_error_opening_file, filename)};
+    }
+    io::read_binary_stream(file, m_buffer);
+    m_bytes = m_buffer;
+}
+
+Mapped_file::~Mapped_file() = default;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef linux
+void Mapped_file::read_(int fd, size_t size)
+{
+    // Allow for one byte more than expected so that end-of-file is detected without growing the buffer.
+    m_buffer.resize(std::max(size + 1, min_read_size));
+    size_t count{0};
+    for (;;) {
+        if (count == m_buffer.size()) {
+            m_buffer.resize(m_buffer.size() * 2);
+        }
+        const ssize_t count_read{
+            ::pread(fd, &m_buffer[count], m_buffer.size() - count, gsl::narrow<off_t>(count))};
+        if (count_read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error{std::format(fmt::runtime_error_reading_from_file, m_filename)};
+        }
+        if (count_read == 0) {
+            break;
+        }
+        count += gsl::narrow<size_t>(count_read);
+    }
+    m_buffer.resize(count);
+    m_bytes = m_buffer;
+}
+#endif
+
+} // namespace c4lib::native
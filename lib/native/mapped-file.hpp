@@ -0,0 +1,65 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace c4lib::native {
+
+// Read-only view of the content of a file.  On Linux the file is mapped with MAP_PRIVATE so that its content is read
+// directly from the page cache.  If the file cannot be mapped, e.g., because it is empty or is not a regular file, it
+// is read into memory with pread.  On other platforms the file is read into memory.
+class Mapped_file {
+public:
+    // Opens and maps filename.  Throws std::runtime_error if the file cannot be opened or read.
+    explicit Mapped_file(const std::string& filename);
+
+    ~Mapped_file();
+
+    Mapped_file(const Mapped_file&) = delete;
+
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    Mapped_file(Mapped_file&&) noexcept = delete;
+
+    Mapped_file& operator=(Mapped_file&&) noexcept = delete;
+
+    // Returns the content of the file.  The bytes remain valid for the lifetime of the Mapped_file.
+    [[nodiscard]] std::span<const std::byte> bytes() const
+    {
+        return m_bytes;
+    }
+
+    // Returns true if the content of the file is memory-mapped rather than read into memory.
+    [[nodiscard]] bool is_mapped() const
+    {
+        return m_mapping != nullptr;
+    }
+
+    // Returns the content of the file as text.
+    [[nodiscard]] std::string_view text() const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return std::string_view{reinterpret_cast<const char*>(m_bytes.data()), m_bytes.size()};
+    }
+
+private:
+#ifdef linux
+    // Reads the file open as fd into m_buffer.  size is the expected size of the file, which may be 0 if unknown.
+    void read_(int fd, size_t size);
+#endif
+
+    std::vector<std::byte> m_buffer;
+    std::span<const std::byte> m_bytes;
+    std::string m_filename;
+    void* m_mapping{nullptr};
+    size_t m_mapping_size{0};
+};
+
+} // namespace c4lib::native
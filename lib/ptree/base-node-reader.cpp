@@ -17,6 +17,7 @@
 #include <lib/util/constants.hpp>
 #include <lib/util/file-location.hpp>
 #include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -53,11 +54,22 @@ void Base_node_reader::read_node(boost::property_tree::ptree& node)
         // Check to see if this is a "Leader" array member.  If so, we need to create the
         // definition for the corresponding PlayerTypes enumeration.
         if (is_leader_array_member_(node)) {
-            create_player_types_enumerator_definition_(node);
+            create_player_types_enumerator_definition_(
+                leader_array_subscript_(attributes_node.get<std::string>(nn_name)), attributes_node.get<int>(nn_data));
         }
     }
 }
 
+void Base_node_reader::read_node(Document_node& node, Leaf_data& data)
+{
+    read_node_impl_(node, data);
+
+    if (node.type == Node_type::enum_type && is_leader_array_member_(node)) {
+        create_player_types_enumerator_definition_(
+            leader_array_subscript_(symbol_table::name(node.name)), gsl::narrow<int>(node.value));
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // SHARED IMPLEMENTATION
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -73,25 +85,31 @@ bool Base_node_reader::is_leader_array_member_(const bpt::ptree& node) const
     return enum_name == constants::leader_head_types;
 }
 
+bool Base_node_reader::is_leader_array_member_(const Document_node& node)
+{
+    static const Symbol leader_array{symbol_table::intern(constants::leader_array)};
+    static const Symbol leader_head_types{symbol_table::intern(constants::leader_head_types)};
+    return node.array_name == leader_array && node.enum_name == leader_head_types;
+}
+
+size_t Base_node_reader::leader_array_subscript_(const std::string& node_name)
+{
+    assert(node_name[0] == '[');
+    return std::stoul(node_name.substr(1));
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // PRIVATE IMPLEMENTATION
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void Base_node_reader::create_player_types_enumerator_definition_(const bpt::ptree& node) const
+void Base_node_reader::create_player_types_enumerator_definition_(size_t subscript, int leader_head) const
 {
-    // Set the player types enumerator value using the Leader array subscript obtained from the Leader array node name.
-    const bpt::ptree& attributes_node{node.get_child(nn_attributes)};
-    const bpt::ptree& leader_array_name_node{attributes_node.get_child(nn_name)};
-    const std::string leader_array_node_name{leader_array_name_node.get_value<std::string>()};
-    assert(leader_array_node_name[0] == '[');
-    const size_t player_types_enumerator_value{std::stoul(leader_array_node_name.substr(1))};
+    // The player types enumerator value is the Leader array subscript.
+    const size_t player_types_enumerator_value{subscript};
     const std::string player_types_enumerator_value_string{std::to_string(player_types_enumerator_value)};
 
-    // Get the leader head enumerator value from the value of the node and then
-    // get the leader head types enumerator definition from the definition table.
-    const bpt::ptree& data_node{attributes_node.get_child(nn_data)};
-    const int leader_head_types_enumerator_value{data_node.get_value<int>()};
+    // Get the leader head types enumerator definition from the definition table.
     const csp::Def_mem& leader_head_types_enumerator_def{
-        m_definition_table->get_enumerator(constants::leader_head_types, leader_head_types_enumerator_value)};
+        m_definition_table->get_enumerator(constants::leader_head_types, leader_head)};
 
     // Get/create the player types enum definition from the definition table.
     bool was_created{false};
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <include/save-document.hpp>
 #include <lib/native/path.hpp>
 #include <lib/ptree/node-reader.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
@@ -34,6 +36,8 @@ public:
 
     void read_node(boost::property_tree::ptree& node) final;
 
+    void read_node(Document_node& node, Leaf_data& data) final;
+
 protected:
     // Node readers may optionally override init_impl_ to perform reader-specific initialization
     // not covered by Base_node_reader::init.  Within Base_node_reader's implementation of init,
@@ -43,6 +47,11 @@ protected:
 
     [[nodiscard]] bool is_leader_array_member_(const boost::property_tree::ptree& node) const;
 
+    [[nodiscard]] static bool is_leader_array_member_(const Document_node& node);
+
+    // Returns the subscript of a Leader array member, obtained from the member's name, e.g., 3 for [3].
+    [[nodiscard]] static size_t leader_array_subscript_(const std::string& node_name);
+
     // Base_node_reader calls read_node_impl_ from within its implementation of read_node.  When
     // read_node_impl_ returns, Base_node_reader performs processing common to all readers such as
     // creating the PlayerTypes enumeration based on values in the "Leader" array. Classes inheriting
@@ -50,6 +59,9 @@ protected:
     // for non-aggregate types.
     virtual void read_node_impl_(boost::property_tree::ptree& node) = 0;
 
+    // As above for the typed form of read_node.
+    virtual void read_node_impl_(Document_node& node, Leaf_data& data) = 0;
+
     // Base_node_reader sets m_array_name within read_node prior to calling read_node_impl_.  Child classes
     // may use m_array_name to determine whether a node is an array member.
     std::string m_array_name;
@@ -63,7 +75,8 @@ protected:
     std::unordered_map<std::string, std::string>* m_options{nullptr};
 
 private:
-    void create_player_types_enumerator_definition_(const boost::property_tree::ptree& node) const;
+    // Creates the PlayerTypes enumerator for the Leader array member at subscript, whose value is leader_head.
+    void create_player_types_enumerator_definition_(size_t subscript, int leader_head) const;
 };
 
 } // namespace c4lib::property_tree
@@ -10,8 +10,10 @@
 #include <include/exceptions.hpp>
 #include <include/node-attributes.hpp>
 #include <include/node-type.hpp>
-#include <iosfwd>
+#include <include/offset-index.hpp>
+#include <lib/io/cursor.hpp>
 #include <lib/io/io.hpp>
+#include <lib/native/mapped-file.hpp>
 #include <lib/ptree/binary-node-reader.hpp>
 #include <lib/ptree/internationalization-text.hpp>
 #include <lib/schema-parser/def-mem.hpp>
@@ -19,11 +21,18 @@
 #include <lib/util/constants.hpp>
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/options.hpp>
 #include <lib/util/schema.hpp>
 #include <lib/util/text.hpp>
 #include <lib/util/util.hpp>
+#include <lib/zlib/inflate-pipeline.hpp>
 #include <lib/zlib/zlib-engine.hpp>
+#include <ios>
+#include <memory>
+#include <span>
 #include <string>
+#include <unordered_map>
 
 namespace bpt = boost::property_tree;
 namespace cpt = c4lib::property_tree;
@@ -31,8 +40,8 @@ namespace csp = c4lib::schema_parser;
 namespace czlib = c4lib::zlib;
 
 namespace {
-template<typename T> void add_data(
-    std::istream& in, bpt::ptree& attributes_node, cpt::Node_type type, size_t size, csp::Def_tbl& definition_table)
+template<typename T, typename In> void add_data(
+    In& in, bpt::ptree& attributes_node, cpt::Node_type type, size_t size, csp::Def_tbl& definition_table)
 {
     T value;
     c4lib::io::read_int(in, value);
@@ -72,9 +81,49 @@ template<typename T> void add_data(
     }
 }
 
+// Reads an integer of type T from in.
+template<typename T, typename In> int64_t read_value(In& in)
+{
+    T value;
+    c4lib::io::read_int(in, value);
+    return value;
+}
+
+// Sets the path of each node of pt which is a key of leaf_paths.  path is the path of pt.
+void add_leaf_paths(const bpt::ptree& pt,
+    const std::string& path,
+    std::unordered_map<const bpt::ptree*, std::string>& leaf_paths)
+{
+    for (const auto& [name, child] : pt) {
+        if (child.data() == cpt::nv_meta) {
+            continue;
+        }
+        const std::string child_path{path.empty() ? name : path + '.' + name};
+        if (const auto it{leaf_paths.find(&child)}; it != leaf_paths.end()) {
+            it->second = child_path;
+        }
+        add_leaf_paths(child, child_path, leaf_paths);
+    }
+}
+
 } // namespace
 
 namespace c4lib::property_tree {
+void Binary_node_reader::build_offset_index(const bpt::ptree& pt, Offset_index& index) const
+{
+    // The reader is passed each node but not its path, so the paths of the leaves read are found by walking pt.
+    std::unordered_map<const bpt::ptree*, std::string> leaf_paths;
+    leaf_paths.reserve(m_leaf_locations.size());
+    for (const auto& [node, location] : m_leaf_locations) {
+        leaf_paths.emplace(node, std::string{});
+    }
+    add_leaf_paths(pt, "", leaf_paths);
+
+    index.clear();
+    for (const auto& [node, location] : m_leaf_locations) {
+        index.add({std::move(leaf_paths[node]), location.offset, location.size, location.type});
+    }
+}
 
 size_t Binary_node_reader::get_undocumented_footer_bytes_count()
 {
@@ -83,19 +132,39 @@ size_t Binary_node_reader::get_undocumented_footer_bytes_count()
 
 void Binary_node_reader::init_impl_()
 {
-    // Prepare the stream for binary input
-    m_save.unsetf(std::ios::skipws);
+    // In pipelined mode the savegame is inflated on a separate thread while it is read.  Debug binaries require the
+    // entire composite savegame, so pipelined mode is not used when they are written.
+    if ((*m_options)[options::pipelined_read] == "1" && (*m_options)[options::debug_write_binaries] != "1"
+        && !m_is_pipelined_read_disabled) {
+        std::span<const std::byte> save{m_input};
+        if (!m_is_input_set) {
+            m_file = std::make_unique<native::Mapped_file>(m_filename);
+            save = m_file->bytes();
+        }
+        m_pipeline = std::make_unique<czlib::Inflate_pipeline>(save);
+
+        // The footer consists of the undocumented footer bytes, the checksum byte and the savegame md5 checksum
+        // characters plus preceding length.
+        m_undocumented_footer_bytes_count = m_pipeline->count_footer() - 1 - (4 + constants::checksum_length);
+        return;
+    }
 
-    // Read the savegame into m_save.
+    // Inflate the savegame into m_save.
     czlib::ZLib_engine zlib;
     size_t count_header{limits::invalid_size};
     size_t count_compressed{limits::invalid_size};
     size_t count_decompressed{limits::invalid_size};
     size_t count_footer{limits::invalid_size};
     size_t count_total{limits::invalid_size};
-    zlib.inflate(
-        m_filename, m_save, count_header, count_compressed, count_decompressed, count_footer, count_total, *m_options);
-    m_save.seekg(0);
+    if (m_is_input_set) {
+        zlib.inflate(m_filename, m_input, m_save, count_header, count_compressed, count_decompressed, count_footer,
+            count_total, *m_options);
+    }
+    else {
+        zlib.inflate(m_filename, m_save, count_header, count_compressed, count_decompressed, count_footer,
+            count_total, *m_options);
+    }
+    m_cursor.reset(m_save);
 
     // The number of bytes in the undocumented footer equals the total savegame file size minus the
     // header size - 4 pad bytes - size of decompressed data minus the checksum byte minus the savegame
@@ -105,13 +174,35 @@ void Binary_node_reader::init_impl_()
 }
 
 void Binary_node_reader::read_node_impl_(bpt::ptree& node)
+{
+    if (m_pipeline) {
+        read_node_(*m_pipeline, node);
+    }
+    else {
+        read_node_(m_cursor, node);
+    }
+}
+
+void Binary_node_reader::read_node_impl_(Document_node& node, Leaf_data& data)
+{
+    if (m_pipeline) {
+        read_node_(*m_pipeline, node, data);
+    }
+    else {
+        read_node_(m_cursor, node, data);
+    }
+}
+
+template<typename In> void Binary_node_reader::read_node_(In& in, bpt::ptree& node)
 {
     bpt::ptree& attributes_node{node.get_child(nn_attributes)};
 
     const bpt::ptree& type_node{attributes_node.get_child(nn_type)};
     bpt::ptree& type_name_node{attributes_node.get_child(nn_typename)};
+    const std::streamoff offset{in.tell()};
 
-    switch (const Node_type type{type_node.get_value<Node_type>()}) {
+    const Node_type type{type_node.get_value<Node_type>()};
+    switch (type) {
     case Node_type::bool_type:
     case Node_type::hex_type:
     case Node_type::int_type:
@@ -129,25 +220,25 @@ void Binary_node_reader::read_node_impl_(bpt::ptree& node)
         // Signed integer types
         if (type == Node_type::int_type || type == Node_type::enum_type) {
             if (size == 1) {
-                add_data<int8_t>(m_save, attributes_node, type, size, *m_definition_table);
+                add_data<int8_t>(in, attributes_node, type, size, *m_definition_table);
             }
             else if (size == 2) {
-                add_data<int16_t>(m_save, attributes_node, type, size, *m_definition_table);
+                add_data<int16_t>(in, attributes_node, type, size, *m_definition_table);
             }
             else {
-                add_data<int32_t>(m_save, attributes_node, type, size, *m_definition_table);
+                add_data<int32_t>(in, attributes_node, type, size, *m_definition_table);
             }
         }
         // Unsigned integer types
         else {
             if (size == 1) {
-                add_data<uint8_t>(m_save, attributes_node, type, size, *m_definition_table);
+                add_data<uint8_t>(in, attributes_node, type, size, *m_definition_table);
             }
             else if (size == 2) {
-                add_data<uint16_t>(m_save, attributes_node, type, size, *m_definition_table);
+                add_data<uint16_t>(in, attributes_node, type, size, *m_definition_table);
             }
             else {
-                add_data<uint32_t>(m_save, attributes_node, type, size, *m_definition_table);
+                add_data<uint32_t>(in, attributes_node, type, size, *m_definition_table);
             }
         }
     } break;
@@ -157,7 +248,7 @@ void Binary_node_reader::read_node_impl_(bpt::ptree& node)
     case Node_type::md5_type: {
         if (type == Node_type::u16string_type) {
             std::u16string wide_string;
-            io::read_string(m_save, wide_string);
+            io::read_string(in, wide_string);
             // Convert the UTF-16 value to UTF-8.
             std::string utf8_string{text::u16string_to_string(wide_string)};
             attributes_node.add(nn_data, utf8_string);
@@ -166,7 +257,7 @@ void Binary_node_reader::read_node_impl_(bpt::ptree& node)
         }
         else {
             std::string char_string;
-            io::read_string(m_save, char_string);
+            io::read_string(in, char_string);
             if (type == Node_type::md5_type) {
                 const size_t md5_length{char_string.length()};
                 if (md5_length != limits::md5_length && md5_length != 0) {
@@ -182,7 +273,7 @@ void Binary_node_reader::read_node_impl_(bpt::ptree& node)
     case Node_type::struct_type:
     case Node_type::template_type:
         // Aggregate types lack size and data attributes.
-        break;
+        return;
 
         // If the node type isn't one of the types previously processed, an error has occurred.
         // By design, the Generative_node_source should not emit array_type nodes, so if we're passed one
@@ -191,6 +282,94 @@ void Binary_node_reader::read_node_impl_(bpt::ptree& node)
     default:
         throw Parser_error(std::format(fmt::bad_type_enumeration, to_string(type)));
     }
+
+    if (m_is_offset_index_enabled) {
+        const auto offset_value{gsl::narrow<size_t>(offset)};
+        m_leaf_locations.emplace_back(
+            &node, Leaf_location{offset_value, gsl::narrow<size_t>(in.tell()) - offset_value, type});
+    }
+}
+
+template<typename In> void Binary_node_reader::read_node_(In& in, Document_node& node, Leaf_data& data)
+{
+    const std::streamoff offset{in.tell()};
+
+    switch (node.type) {
+    case Node_type::bool_type:
+    case Node_type::hex_type:
+    case Node_type::int_type:
+    case Node_type::uint_type:
+    case Node_type::enum_type: {
+        // The size is set from the type name, which the schema compiler checks has a size of 1, 2 or 4.
+        assert(node.size == 1 || node.size == 2 || node.size == 4);
+
+        // Signed integer types
+        if (node.type == Node_type::int_type || node.type == Node_type::enum_type) {
+            if (node.size == 1) {
+                node.value = read_value<int8_t>(in);
+            }
+            else if (node.size == 2) {
+                node.value = read_value<int16_t>(in);
+            }
+            else {
+                node.value = read_value<int32_t>(in);
+            }
+        }
+        // Unsigned integer types
+        else {
+            if (node.size == 1) {
+                node.value = read_value<uint8_t>(in);
+            }
+            else if (node.size == 2) {
+                node.value = read_value<uint16_t>(in);
+            }
+            else {
+                node.value = read_value<uint32_t>(in);
+            }
+        }
+
+        // The formatted data of enums is the enumerator's name; for other integer types it is derived from the value.
+        if (node.type == Node_type::enum_type) {
+            node.enumerator
+                = m_definition_table->get_enumerator(node.enum_name, gsl::narrow<int>(node.value)).symbol;
+        }
+        node.flags |= Document_node::has_size | Document_node::has_data | Document_node::has_formatted_data;
+    } break;
+
+    case Node_type::u16string_type: {
+        std::u16string wide_string;
+        io::read_string(in, wide_string);
+        // Convert the UTF-16 value to UTF-8.
+        data.text = text::u16string_to_string(wide_string);
+        node.flags |= Document_node::has_data | Document_node::has_formatted_data;
+    } break;
+
+    case Node_type::string_type:
+    case Node_type::md5_type: {
+        io::read_string(in, data.text);
+        if (node.type == Node_type::md5_type) {
+            const size_t md5_length{data.text.length()};
+            if (md5_length != limits::md5_length && md5_length != 0) {
+                throw Parser_error(std::format(fmt::invalid_md5_length, md5_length, limits::md5_length));
+            }
+        }
+        node.flags |= Document_node::has_data | Document_node::has_formatted_data;
+    } break;
+
+    case Node_type::struct_type:
+    case Node_type::template_type:
+        // Aggregate types lack size and data attributes.
+        return;
+
+    case Node_type::array_type:
+    default:
+        throw Parser_error(std::format(fmt::bad_type_enumeration, to_string(node.type)));
+    }
+
+    if (m_is_offset_index_enabled) {
+        data.offset = gsl::narrow<size_t>(offset);
+        data.size = gsl::narrow<size_t>(in.tell()) - data.offset;
+    }
 }
 
 } // namespace c4lib::property_tree
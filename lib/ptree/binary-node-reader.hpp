@@ -6,9 +6,17 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <cstddef>
+#include <include/node-type.hpp>
+#include <include/offset-index.hpp>
+#include <lib/io/cursor.hpp>
+#include <lib/native/mapped-file.hpp>
 #include <lib/ptree/base-node-reader.hpp>
 #include <lib/util/limits.hpp>
-#include <sstream>
+#include <lib/zlib/inflate-pipeline.hpp>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace c4lib::property_tree {
 
@@ -17,7 +25,13 @@ namespace c4lib::property_tree {
 class Binary_node_reader : public Base_node_reader {
 public:
     Binary_node_reader() = default;
-    
+
+    // Creates a reader which reads the savegame from save rather than from the file passed to init.  The filename
+    // is then used only to name debug files.  save must remain valid until the reader is initialized.
+    explicit Binary_node_reader(std::span<const std::byte> save)
+        : m_input(save), m_is_input_set(true)
+    {}
+
     ~Binary_node_reader() override = default;
 
     Binary_node_reader(const Binary_node_reader&) = delete;   
@@ -28,6 +42,32 @@ public:
 	
     Binary_node_reader& operator=(Binary_node_reader&&) noexcept = delete;    
 
+    // Reads the save through a contiguous buffer even if the PIPELINED_READ option is set, so that take_composite may
+    // be called once the save has been read.
+    void disable_pipelined_read()
+    {
+        m_is_pipelined_read_disabled = true;
+    }
+
+    // Returns the composite savegame read, leaving the reader empty.  Requires that the save was not read through a
+    // pipeline.
+    [[nodiscard]] std::vector<std::byte> take_composite()
+    {
+        m_cursor.reset({});
+        return std::move(m_save);
+    }
+
+    // Records the offset of each leaf read so that build_offset_index may be called once the save has been read.  The
+    // typed form of read_node instead reports the offset of each leaf in the Leaf_data passed to it.
+    void enable_offset_index()
+    {
+        m_is_offset_index_enabled = true;
+    }
+
+    // Fills index with the location of each leaf of pt, the property tree populated by this reader.  Requires that
+    // enable_offset_index was called before the save was read.
+    void build_offset_index(const boost::property_tree::ptree& pt, Offset_index& index) const;
+
 protected:
     size_t get_undocumented_footer_bytes_count() override;
 
@@ -35,9 +75,35 @@ protected:
 
     void read_node_impl_(boost::property_tree::ptree& node) override;
 
+    void read_node_impl_(Document_node& node, Leaf_data& data) override;
+
 private:
-    std::stringstream m_save;
+    // Offset, size and type of a leaf, recorded while reading before the leaf's path is known.
+    struct Leaf_location {
+        size_t offset{0};
+        size_t size{0};
+        Node_type type{Node_type::invalid};
+    };
+
+    // Reads the data for node from in, which is either m_cursor or m_pipeline.
+    template<typename In> void read_node_(In& in, boost::property_tree::ptree& node);
+
+    // As above for the typed form of read_node.
+    template<typename In> void read_node_(In& in, Document_node& node, Leaf_data& data);
+
+    std::span<const std::byte> m_input;
+    bool m_is_input_set{false};
+    bool m_is_pipelined_read_disabled{false};
+    // The composite savegame, inflated into a single contiguous buffer, and the cursor from which nodes are read.
+    std::vector<std::byte> m_save;
+    io::Cursor m_cursor;
+    // Used in place of m_save and m_cursor if the PIPELINED_READ option is set.  m_file must outlive m_pipeline.
+    std::unique_ptr<native::Mapped_file> m_file;
+    std::unique_ptr<zlib::Inflate_pipeline> m_pipeline;
     size_t m_undocumented_footer_bytes_count{limits::invalid_size};
+    // Leaves read, in order, if the offset index is enabled.
+    bool m_is_offset_index_enabled{false};
+    std::vector<std::pair<const boost::property_tree::ptree*, Leaf_location>> m_leaf_locations;
 };
 
 } // namespace c4lib::property_tree
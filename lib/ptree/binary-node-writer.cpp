@@ -9,6 +9,7 @@
 #include <format>
 #include <include/node-attributes.hpp>
 #include <include/node-type.hpp>
+#include <include/save-document.hpp>
 #include <iosfwd>
 #include <lib/io/io.hpp>
 #include <lib/ptree/binary-node-writer.hpp>
@@ -23,6 +24,14 @@
 using namespace std::string_literals;
 namespace bpt = boost::property_tree;
 
+namespace {
+template<typename T> void write_narrowed_int(std::ostream& out, int64_t value)
+{
+    T raw_value{gsl::narrow<T>(value)};
+    c4lib::io::write_int(out, raw_value);
+}
+} // namespace
+
 namespace c4lib::property_tree {
 
 void Binary_node_writer::finish() {}
@@ -114,4 +123,78 @@ void Binary_node_writer::write_node(std::pair<int, const bpt::ptree&> depth_node
     }
 }
 
+void Binary_node_writer::write_document(const Save_document& document, std::ostream& out)
+{
+    m_out = &out;
+    const Document_node& root{document.at(0)};
+    for (size_t index = root.first_child; index < root.first_child + root.child_count; ++index) {
+        write_document_node_(document, index);
+    }
+}
+
+void Binary_node_writer::write_document_node_(const Save_document& document, size_t index)
+{
+    const Document_node& node{document.at(index)};
+    std::ostream& out{*m_out};
+
+    switch (node.type) {
+    case Node_type::bool_type:
+    case Node_type::hex_type:
+    case Node_type::int_type:
+    case Node_type::uint_type:
+    case Node_type::enum_type:
+        assert(node.size == 1 || node.size == 2 || node.size == 4);
+        if (node.type == Node_type::int_type || node.type == Node_type::enum_type) {
+            if (node.size == 1) {
+                write_narrowed_int<int8_t>(out, node.value);
+            }
+            else if (node.size == 2) {
+                write_narrowed_int<int16_t>(out, node.value);
+            }
+            else {
+                write_narrowed_int<int32_t>(out, node.value);
+            }
+        }
+        else {
+            if (node.size == 1) {
+                write_narrowed_int<uint8_t>(out, node.value);
+            }
+            else if (node.size == 2) {
+                write_narrowed_int<uint16_t>(out, node.value);
+            }
+            else {
+                write_narrowed_int<uint32_t>(out, node.value);
+            }
+        }
+        break;
+
+    case Node_type::u16string_type:
+        io::write_string(out, text::string_to_u16string(document.get_text(index)));
+        break;
+
+    case Node_type::string_type:
+    case Node_type::md5_type: {
+        const std::string& value{document.get_text(index)};
+        if (node.type == Node_type::md5_type) {
+            if (const size_t md5_length{value.length()}; md5_length != limits::md5_length && md5_length != 0) {
+                throw Parser_error{std::format(fmt::invalid_md5_length, value.length(), limits::md5_length)};
+            }
+        }
+        io::write_string(out, value);
+    } break;
+
+    case Node_type::struct_type:
+    case Node_type::template_type:
+    case Node_type::array_type:
+        // Aggregate types lack size and data attributes.
+        for (size_t child = node.first_child; child < node.first_child + node.child_count; ++child) {
+            write_document_node_(document, child);
+        }
+        break;
+
+    default:
+        throw Parser_error(std::format(fmt::bad_type_enumeration, to_string(node.type)));
+    }
+}
+
 } // namespace c4lib::property_tree
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <include/save-document.hpp>
 #include <iostream>
 #include <lib/ptree/node-writer.hpp>
 #include <string>
@@ -35,7 +37,13 @@ public:
 
     void write_node(std::pair<int, const boost::property_tree::ptree&> depth_node_pair) override;
 
+    // Writes each node of document to out in depth-first order.  Integers are written as stored in the document,
+    // without conversion to and from text.  init need not be called.
+    void write_document(const Save_document& document, std::ostream& out);
+
 private:
+    void write_document_node_(const Save_document& document, size_t index);
+
     std::ostream* m_out{nullptr};
 };
 
@@ -0,0 +1,206 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/offset-index.hpp>
+#include <include/save-document.hpp>
+#include <include/symbol.hpp>
+#include <lib/ptree/debug.hpp>
+#include <lib/ptree/document-node-emitter.hpp>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/ptree/node-reader.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bpt = boost::property_tree;
+
+namespace c4lib::property_tree {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Document_node_emitter::Document_node_emitter(Save_document& document)
+    : m_document(document), m_first_child{no_node}, m_last_child{no_node}, m_next_sibling{no_node}, m_child_count{0}
+{
+    m_document.clear();
+}
+
+size_t Document_node_emitter::add_node(size_t parent, const Emitted_node& node)
+{
+    const size_t index{m_document.m_nodes.size()};
+    const auto id{gsl::narrow<uint32_t>(index)};
+    m_first_child.push_back(no_node);
+    m_last_child.push_back(no_node);
+    m_next_sibling.push_back(no_node);
+    m_child_count.push_back(0);
+    if (m_last_child.at(parent) == no_node) {
+        m_first_child[parent] = id;
+    }
+    else {
+        m_next_sibling[m_last_child[parent]] = id;
+    }
+    m_last_child[parent] = id;
+    ++m_child_count[parent];
+    assert(m_document.m_nodes[parent].type != Node_type::array_type
+           || id == m_first_child[parent] + m_child_count[parent] - 1);
+
+    Document_node& document_node{m_document.m_nodes.emplace_back()};
+    document_node.type = node.type;
+    document_node.size = node.size;
+    document_node.name = node.name;
+    document_node.type_name = node.type_name;
+    document_node.array_name = node.array_name;
+    document_node.enum_name = node.enum_name;
+    if (!node.subscripts.empty()) {
+        document_node.subscripts = gsl::narrow<uint32_t>(m_document.m_texts.size());
+        m_document.m_texts.emplace_back(node.subscripts);
+        document_node.flags |= Document_node::has_subscripts;
+    }
+    return index;
+}
+
+void Document_node_emitter::dump(const std::string& filename)
+{
+    // The document is converted to a property tree as laid out so far.  Nodes which have yet to be read are included
+    // without their data.
+    finish();
+    bpt::ptree pt;
+    m_document.to_ptree(pt);
+    dump_ptree(filename, pt);
+}
+
+size_t Document_node_emitter::find(size_t node, std::span<const Symbol> keys, std::span<const int> subscripts) const
+{
+    size_t current{node};
+    size_t subscript_index{0};
+    for (const Symbol key : keys) {
+        uint32_t child{no_node};
+        if (key == invalid_symbol) {
+            const int subscript{subscripts[subscript_index++]};
+            if (m_document.m_nodes[current].type == Node_type::array_type && subscript >= 0
+                && gsl::narrow<uint32_t>(subscript) < m_child_count[current]) {
+                child = m_first_child[current] + gsl::narrow<uint32_t>(subscript);
+            }
+        }
+        else {
+            child = m_first_child.at(current);
+            while (child != no_node && m_document.m_nodes[child].name != key) {
+                child = m_next_sibling[child];
+            }
+        }
+        if (child == no_node) {
+            return limits::invalid_size;
+        }
+        current = child;
+    }
+    return current;
+}
+
+void Document_node_emitter::finish()
+{
+    std::vector<Document_node> nodes;
+    nodes.reserve(m_document.m_nodes.size());
+    nodes.push_back(m_document.m_nodes.front());
+    std::vector<uint32_t> ids(m_leaf_offsets.empty() ? 0 : m_document.m_nodes.size());
+    lay_out_children_(0, 0, nodes, ids);
+    m_document.m_nodes.swap(nodes);
+
+    if (!m_leaf_offsets.empty()) {
+        std::vector<Leaf_offset> leaf_offsets(m_document.m_nodes.size(), Leaf_offset{.offset = limits::invalid_size});
+        for (size_t id = 1; id < m_leaf_offsets.size(); ++id) {
+            leaf_offsets[ids[id]] = m_leaf_offsets[id];
+        }
+        m_leaf_offsets.swap(leaf_offsets);
+    }
+
+    m_first_child.clear();
+    m_last_child.clear();
+    m_next_sibling.clear();
+    m_child_count.clear();
+}
+
+size_t Document_node_emitter::get_child_count(size_t node) const
+{
+    return m_child_count.at(node);
+}
+
+const Leaf_offset& Document_node_emitter::get_leaf_offset(size_t index) const
+{
+    static const Leaf_offset not_recorded{.offset = limits::invalid_size};
+    return index < m_leaf_offsets.size() ? m_leaf_offsets[index] : not_recorded;
+}
+
+Node_type Document_node_emitter::get_type(size_t node) const
+{
+    return m_document.m_nodes.at(node).type;
+}
+
+int64_t Document_node_emitter::get_value(size_t node) const
+{
+    return m_document.m_nodes.at(node).value;
+}
+
+int64_t Document_node_emitter::read_node(size_t node, Node_reader& reader)
+{
+    Document_node& document_node{m_document.m_nodes.at(node)};
+    Leaf_data data;
+    reader.read_node(document_node, data);
+    if (m_is_leaf_offset_enabled && data.offset != limits::invalid_size) {
+        if (node >= m_leaf_offsets.size()) {
+            m_leaf_offsets.resize(m_document.m_nodes.size(), Leaf_offset{.offset = limits::invalid_size});
+        }
+        m_leaf_offsets[node] = Leaf_offset{.offset = data.offset, .size = data.size, .type = document_node.type};
+    }
+
+    if (document_node.type >= Node_type::first_integer_type && document_node.type <= Node_type::last_integer_type) {
+        return document_node.value;
+    }
+    if ((document_node.flags & Document_node::has_data) != 0) {
+        // String data is held in the document's text table.
+        document_node.value = gsl::narrow<int64_t>(m_document.m_texts.size());
+        m_document.m_texts.push_back(std::move(data.text));
+    }
+    return 0;
+}
+
+void Document_node_emitter::set_origin(const Origin_node& origin)
+{
+    m_document.m_origin = origin;
+    m_document.m_has_origin = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The layout matches that produced by Save_document::from_ptree: the children of a node are allocated as a block
+// before any grandchildren.
+void Document_node_emitter::lay_out_children_(
+    size_t node, size_t index, std::vector<Document_node>& nodes, std::vector<uint32_t>& ids) const
+{
+    const size_t first_child{nodes.size()};
+    for (uint32_t child = m_first_child[node]; child != no_node; child = m_next_sibling[child]) {
+        if (!ids.empty()) {
+            ids[child] = gsl::narrow<uint32_t>(nodes.size());
+        }
+        nodes.push_back(m_document.m_nodes[child]);
+    }
+    nodes[index].first_child = gsl::narrow<uint32_t>(first_child);
+    nodes[index].child_count = gsl::narrow<uint32_t>(nodes.size() - first_child);
+
+    size_t child_index{first_child};
+    for (uint32_t child = m_first_child[node]; child != no_node; child = m_next_sibling[child]) {
+        lay_out_children_(child, child_index++, nodes, ids);
+    }
+}
+
+} // namespace c4lib::property_tree
@@ -0,0 +1,94 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/offset-index.hpp>
+#include <include/save-document.hpp>
+#include <include/symbol.hpp>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/ptree/node-reader.hpp>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace c4lib::property_tree {
+
+// Emits nodes into a Save_document.  Node ids are indices of the document's nodes, which are held in emission order
+// until finish is called.  Node attributes are stored in the document as they are emitted and node readers write the
+// data of each leaf directly into its Document_node, so no property tree is built.
+class Document_node_emitter : public Node_emitter {
+public:
+    // document receives the nodes.  Existing content is removed.
+    explicit Document_node_emitter(Save_document& document);
+
+    ~Document_node_emitter() override = default;
+
+    Document_node_emitter(const Document_node_emitter&) = delete;
+
+    Document_node_emitter& operator=(const Document_node_emitter&) = delete;
+
+    Document_node_emitter(Document_node_emitter&&) noexcept = delete;
+
+    Document_node_emitter& operator=(Document_node_emitter&&) noexcept = delete;
+
+    size_t add_node(size_t parent, const Emitted_node& node) override;
+
+    void dump(const std::string& filename) override;
+
+    // Records the location within the composite savegame of each leaf whose location is reported by the node reader,
+    // so that get_leaf_offset may be used once finish has been called.  Must be called before any node is read.
+    void enable_leaf_offsets()
+    {
+        m_is_leaf_offset_enabled = true;
+    }
+
+    [[nodiscard]] size_t find(
+        size_t node, std::span<const Symbol> keys, std::span<const int> subscripts) const override;
+
+    // Lays out the document so that the children of each node occupy a contiguous range, as Save_document requires.
+    // Must be called once all nodes have been emitted; no nodes may be emitted afterward.
+    void finish();
+
+    [[nodiscard]] size_t get_child_count(size_t node) const override;
+
+    // Returns the offset, size and type of the leaf at index in the finished document.  The path is not set.  The
+    // offset is limits::invalid_size if the leaf's location was not recorded.
+    [[nodiscard]] const Leaf_offset& get_leaf_offset(size_t index) const;
+
+    [[nodiscard]] Node_type get_type(size_t node) const override;
+
+    [[nodiscard]] int64_t get_value(size_t node) const override;
+
+    int64_t read_node(size_t node, Node_reader& reader) override;
+
+    void set_origin(const Origin_node& origin);
+
+private:
+    static constexpr uint32_t no_node{std::numeric_limits<uint32_t>::max()};
+
+    // Appends the children of node, followed by their descendants, to nodes.  index is the index of node in nodes.
+    // Unless ids is empty, the index in nodes of each node appended is stored at its id in ids.
+    void lay_out_children_(
+        size_t node, size_t index, std::vector<Document_node>& nodes, std::vector<uint32_t>& ids) const;
+
+    Save_document& m_document;
+    // Until finish is called, the children of each node form a list linked by these vectors, indexed by node id.
+    // The elements of an array are emitted consecutively, so element i of an array is found at m_first_child + i.
+    std::vector<uint32_t> m_first_child;
+    std::vector<uint32_t> m_last_child;
+    std::vector<uint32_t> m_next_sibling;
+    std::vector<uint32_t> m_child_count;
+    bool m_is_leaf_offset_enabled{false};
+    // Location of each leaf, indexed by node id until finish is called and by document index afterward.
+    std::vector<Leaf_offset> m_leaf_offsets;
+};
+
+} // namespace c4lib::property_tree
@@ -0,0 +1,29 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstdint>
+#include <include/node-type.hpp>
+#include <include/symbol.hpp>
+#include <string_view>
+
+namespace c4lib::property_tree {
+
+// Attributes of a node passed to Node_emitter::add_node.  The fields correspond to those of Attributes_node which
+// are known before the node is read.  Absent names are invalid_symbol.
+struct Emitted_node {
+    Node_type type{Node_type::invalid};
+    // Size of the type in bytes for integer types, otherwise 0.  Node readers use the size rather than deriving it
+    // from the type name.
+    uint8_t size{0};
+    Symbol name{invalid_symbol};
+    Symbol type_name{invalid_symbol};
+    Symbol array_name{invalid_symbol};
+    Symbol enum_name{invalid_symbol};
+    // Subscripts of an array, e.g., [4], or of an array element, e.g., [2][3].  Empty for other nodes.
+    std::string_view subscripts;
+};
+
+} // namespace c4lib::property_tree
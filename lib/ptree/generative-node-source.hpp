@@ -4,12 +4,12 @@
 
 #pragma once
 
-#include <boost/property_tree/ptree_fwd.hpp>
 #include <cstddef>
 #include <include/exceptions.hpp>
+#include <include/symbol.hpp>
 #include <lib/schema-parser/parser-phase-two.hpp>
+#include <lib/schema-parser/program.hpp>
 #include <lib/schema-parser/token.hpp>
-#include <lib/schema-parser/tokenizer.hpp>
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/limits.hpp>
 #include <memory>
@@ -18,14 +18,14 @@
 
 namespace c4lib::property_tree {
 
-// Generative_node_source encapsulates the information required to emit a property tree node.
+// Generative_node_source encapsulates the information required to emit the nodes of a statement.  Nodes are added
+// to the parser's emitter and identified by their ids.
 class Generative_node_source {
 public:
     friend class iterator;
 
-    Generative_node_source(schema_parser::Parser_phase_two& parser,
-        const schema_parser::Token& type,
-        const schema_parser::Token& identifier);
+    Generative_node_source(
+        schema_parser::Parser_phase_two& parser, const schema_parser::Definition_statement& statement);
 
     ~Generative_node_source() = default;
 
@@ -42,41 +42,41 @@ public:
         iterator() = default;
 
         explicit iterator(Generative_node_source* ns)
-            : m_ns(ns), m_ptree(ns == nullptr ? nullptr : ns->m_parser.m_ptree_parent)
+            : m_ns(ns), m_node(ns == nullptr ? limits::invalid_size : ns->m_parser.m_parent)
         {
             if (ns == nullptr) {
                 throw std::invalid_argument{fmt::null_pointer_error};
             }
 
             // Call next_ to initialize the tree.
-            if (!m_ns->next_(m_ptree)) {
+            if (!m_ns->next_(m_node)) {
                 throw make_ex<Node_source_error>(
-                    fmt::node_source_error, m_ns->m_identifier.loc, m_ns->m_identifier.value);
+                    fmt::node_source_error, m_ns->m_identifier.get_loc(), m_ns->m_identifier.value);
             }
         }
 
         iterator& operator++()
         {
-            if (!m_ns->next_(m_ptree)) {
+            if (!m_ns->next_(m_node)) {
                 throw make_ex<Node_source_error>(
-                    fmt::node_source_error, m_ns->m_identifier.loc, m_ns->m_identifier.value);
+                    fmt::node_source_error, m_ns->m_identifier.get_loc(), m_ns->m_identifier.value);
             }
             return *this;
         }
 
         bool operator!=(const iterator& rhs) const
         {
-            return m_ptree != rhs.m_ptree;
+            return m_node != rhs.m_node;
         }
 
-        boost::property_tree::ptree& operator*() const
+        size_t operator*() const
         {
-            return *m_ptree;
+            return m_node;
         }
 
     private:
         Generative_node_source* m_ns{nullptr};
-        boost::property_tree::ptree* m_ptree{nullptr};
+        size_t m_node{limits::invalid_size};
     };
 
     iterator begin()
@@ -97,8 +97,8 @@ private:
     struct Dimension_node {
         // Pointer to parent of this node.  Nullptr if this node is the root.
         Dimension_node* parent{nullptr};
-        // ptree associated with this node.
-        boost::property_tree::ptree* ptree{nullptr};
+        // Id of the emitted node associated with this node.
+        size_t node{limits::invalid_size};
         // Index into the nodes vector used to iterate over the dimension
         size_t index{limits::invalid_size};
         // If the nodes vector is size 0, the node is a leaf and represents a type.  Otherwise,
@@ -108,84 +108,53 @@ private:
         std::vector<Dimension_node> nodes;
     };
 
-    // Initializes the tree associated with m_type.
-    bool init_();
+    // Evaluates the array suffix at suffix_index, storing the size of the dimension in dimension_size.  Returns false
+    // if the suffix cannot be evaluated.
+    bool evaluate_array_suffix_(size_t suffix_index, size_t& dimension_size) const;
+
+    // Emits the elements of node, an array named name whose dimension is given by the array suffix at suffix_index,
+    // followed by the elements of each element which is itself an array.  cumulative_subscript_string holds the
+    // subscripts of node, e.g., [2] for element 2 of a two-dimensional array.
+    bool emit_elements_(
+        Dimension_node* node, Symbol name, size_t suffix_index, const std::string& cumulative_subscript_string);
 
-    bool init_node_(Dimension_node* node,
+    // Emits node, whose parent is parent, as a child of the emitted node emitted_parent.  array_name is the name of
+    // the array of which node is an element, or invalid_symbol if node isn't an element.  If node is an array, its
+    // dimension is evaluated but its elements are not emitted.
+    bool emit_node_(Dimension_node* node,
         Dimension_node* parent,
-        boost::property_tree::ptree* ptree_parent,
-        size_t bracket_token_index,
+        size_t emitted_parent,
+        size_t suffix_index,
         size_t array_subscript,
-        const std::string& array_name,
+        Symbol array_name,
         const std::string& cumulative_subscript_string);
 
-    [[nodiscard]] bool is_query_reader_production_(size_t bracket_token_index) const;
-
-    [[nodiscard]] bool is_use_capture_production_(size_t bracket_token_index) const;
+    // Initializes the tree associated with m_type.
+    bool init_();
 
     // The next_ function is used to support ranged-for iteration over the node source.  The function
     // is private because it is an implementation detail of iteration.
     //
-    // Gets the next ptree node for the type passed to the ctor, and stores a pointer to the node
-    // in ptree.  If no additional nodes exist for the type, nullptr is returned.  If an error occurs,
-    // false is returned.
+    // Gets the next node for the type passed to the ctor, and stores its id in node.  If no additional nodes exist
+    // for the type, node is set to limits::invalid_size.  If an error occurs, false is returned.
     //
     // In the case of arrays, next iterates over each array member in ascending subscript order.  It also
     // generates  and links fully-formed array nodes so that array navigation can take the form
     // ".identifier_name.[1].[3]" for example (for the [1][3] member of the 2-dimensional array).  Finally,
-    // it creates a child __Attributes__ node to serve as the root for attributes of the type.
-    bool next_(boost::property_tree::ptree*& ptree);
-
-    static boost::property_tree::ptree* next_(Dimension_node& node, bool& increment_caller_index);
-
-    bool parse_dimension_info_(size_t bracket_token_index,
-        size_t& next_bracket_token_index,
-        bool& is_array,
-        size_t& dimension_size,
-        std::string& enum_name,
-        bool& is_capture) const;
-
-    bool pr_array_suffix_(size_t bracket_token_index,
-        size_t& next_bracket_token_index,
-        size_t& dimension_size,
-        std::string& enum_name,
-        bool& is_capture) const;
-
-    bool pr_array_suffix_standard_(size_t bracket_token_index,
-        size_t& next_bracket_token_index,
-        size_t& dimension_size,
-        std::string& enum_name,
-        bool& is_capture) const;
-
-    bool pr_array_suffix_with_query_reader_(
-        size_t bracket_token_index, size_t& next_bracket_token_index, size_t& dimension_size) const;
-
-    bool pr_array_suffix_with_use_capture_(
-        size_t bracket_token_index, size_t& next_bracket_token_index, size_t& dimension_size, std::string& enum_name) const;
-
-    [[nodiscard]] bool pr_capture_index_keyword_() const;
-
-    bool pr_enum_name_(std::string& enum_name) const;
-
-    [[nodiscard]] bool pr_node_name_() const;
-
-    bool pr_index_capture_(bool& is_capture) const;
-
-    bool pr_opt_enum_bind_(std::string& enum_name) const;
-
-    bool pr_opt_index_capture_(bool& is_capture) const;
-
-    bool pr_query_reader_keyword_(int& value) const;
+    // it sets the attributes of each node.
+    bool next_(size_t& node);
 
-    [[nodiscard]] bool pr_use_capture_keyword_() const;
+    static size_t next_(Dimension_node& node, bool& increment_caller_index);
 
-    bool pr_use_capture_node_reference_(int& value) const;
+    // Looks up the value of the node referenced by a use-capture suffix, storing it in value.  Returns false if
+    // the node cannot be found.
+    bool resolve_use_capture_(const schema_parser::Token& node_name, int& value) const;
 
     size_t m_captured_index{limits::invalid_size};
     const schema_parser::Token& m_identifier;
     schema_parser::Parser_phase_two& m_parser;
     std::unique_ptr<Dimension_node> m_root;
-    schema_parser::Tokenizer& m_tokenizer;
+    const schema_parser::Definition_statement& m_statement;
     const schema_parser::Token& m_type;
 };
 
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <include/node-type.hpp>
+#include <include/symbol.hpp>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/ptree/node-reader.hpp>
+#include <span>
+#include <string>
+
+namespace c4lib::property_tree {
+
+// Receives the nodes generated by the phase two parser.  Ptree_node_emitter builds a property tree and
+// Document_node_emitter builds a Save_document.  Nodes are identified by ids assigned by the emitter; the root, whose
+// children are the top-level nodes of the save, has the id root.
+//
+// Nodes are passed to the emitter as typed attributes.  Each emitter stores them in its own representation and passes
+// that representation to the node reader, so Document_node_emitter builds no property tree nodes.
+class Node_emitter {
+public:
+    static constexpr size_t root{0};
+
+    Node_emitter() = default;
+
+    virtual ~Node_emitter() = default;
+
+    Node_emitter(const Node_emitter&) = delete;
+
+    Node_emitter& operator=(const Node_emitter&) = delete;
+
+    Node_emitter(Node_emitter&&) noexcept = delete;
+
+    Node_emitter& operator=(Node_emitter&&) noexcept = delete;
+
+    // Adds node as the last child of parent and returns its id.  The node's data attributes are added later by
+    // read_node.
+    virtual size_t add_node(size_t parent, const Emitted_node& node) = 0;
+
+    // Writes the nodes emitted so far to filename for debugging.
+    virtual void dump(const std::string& filename) = 0;
+
+    // Returns the id of the node reached from node by following keys, or limits::invalid_size if there is no such
+    // node.  A key of invalid_symbol stands for the next of subscripts, e.g., keys {CvGame, invalid_symbol} and
+    // subscripts {3} for CvGame.[3].
+    [[nodiscard]] virtual size_t find(
+        size_t node, std::span<const Symbol> keys, std::span<const int> subscripts) const = 0;
+
+    // Returns the number of children of node.  Since children are only ever added, a node reached by find from node
+    // remains the first match until its parent gains a child.
+    [[nodiscard]] virtual size_t get_child_count(size_t node) const = 0;
+
+    [[nodiscard]] virtual Node_type get_type(size_t node) const = 0;
+
+    // Returns the data of node, which must be of an integer type and must have been read.
+    [[nodiscard]] virtual int64_t get_value(size_t node) const = 0;
+
+    // Reads the data of node using reader.  Returns the data for integer types and 0 for other types.
+    virtual int64_t read_node(size_t node, Node_reader& reader) = 0;
+};
+
+} // namespace c4lib::property_tree
@@ -5,14 +5,27 @@
 #pragma once
 
 #include <cstddef>
+#include <include/save-document.hpp>
 #include <lib/native/path.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
+#include <lib/util/limits.hpp>
 #include <string>
 #include <unordered_map>
 #include <boost/property_tree/ptree_fwd.hpp>
 
 namespace c4lib::property_tree {
 
+// Data read for a leaf by the typed form of Node_reader::read_node which is not held by the leaf's Document_node.
+struct Leaf_data {
+    // The string read for a string type.
+    std::string text;
+    // Offset of the leaf's data in the composite savegame and the number of bytes it occupies, including the length
+    // of a string.  Set only by readers which record offsets, e.g., Binary_node_reader once enable_offset_index has
+    // been called; otherwise offset is limits::invalid_size.
+    size_t offset{limits::invalid_size};
+    size_t size{0};
+};
+
 class Node_reader {
 public:
     Node_reader() = default;
@@ -44,6 +57,11 @@ public:
     // read_node is responsible for setting the values of a node's size and data members for non-aggregate types.
     // It is also responsible for generating the PlayerTypes enumeration based on values in the "Leader" array.
     virtual void read_node(boost::property_tree::ptree& node) = 0;
+
+    // As above for a node emitted into a Save_document.  The type, size, names and subscripts of node are set by the
+    // caller; read_node sets its flags and, for integer types, its value and enumerator.  The string read for a string
+    // type is stored in data.text, which the caller moves into the document's text table.
+    virtual void read_node(Document_node& node, Leaf_data& data) = 0;
 };
 
 } // namespace c4lib::property_tree
@@ -5,16 +5,18 @@
 #include <lib/schema-parser/def-type.hpp>
 #include <lib/util/exception-formats.hpp>
 #include <boost/property_tree/ptree.hpp>
-#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <format>
 #include <include/exceptions.hpp>
 #include <include/node-attributes.hpp>
 #include <include/node-type.hpp>
+#include <include/save-document.hpp>
 #include <lib/ptree/null-node-reader.hpp>
 #include <lib/util/constants.hpp>
 #include <lib/util/narrow.hpp>
 #include <lib/util/schema.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <string>
 
 using namespace std::string_literals;
@@ -50,64 +52,18 @@ void Null_node_reader::read_node_impl_(bpt::ptree& node)
         std::string const size{size_from_type(type_name_node.data())};
         attributes_node.add(nn_size, size);
 
-        if (node_name == constants::game_version) {
-            // Set the value of the GameVersion node to pass the assert statement in the schema:
-            //     assert(GameVersion >= 100 && GameVersion < 400)
-            attributes_node.add(nn_data, "302");
-        }
-        else if (node_name == constants::revealed_route_type_count) {
-            // RevealedRouteTypeCount must be [0, NUM_ROUTE_TYPES) and NUM_ROUTE_TYPES is 2.
-            attributes_node.add(nn_data, "2");
-        }
-        else if (type == Node_type::bool_type) {
-            // We'll set the data for bools to 1 indicating truth.
-            attributes_node.add(nn_data, "1");
-        }
-        else if (type == Node_type::enum_type) {
-            // Check to see if this is a "Leader" array member.  If so, we need to create the
-            // data for the PlayerTypes enumerator.
-            if (is_leader_array_member_(node)) {
-                std::string const data{create_player_types_enumerator_data_(node)};
-                attributes_node.add(nn_data, data);
-            }
-            else {
-                bpt::ptree const& enum_node{attributes_node.get_child(nn_enum)};
-                std::string const enum_name{enum_node.get_value<std::string>()};
-                if (enum_name == constants::chat_target_types || enum_name == constants::player_vote_types) {
-                    attributes_node.add(nn_data, "-1");
-                }
-                else {
-                    // We'll set the data for enums to 1 since 1 is probably going to be valid.  If
-                    // this causes errors later on we'll need to do something a bit more sophisticated.
-                    attributes_node.add(nn_data, "1");
-                }
-            }
-        }
-        else {
-            // We'll set the data for hex, int, and uint all simple types to 4 since 4 is probably
-            // going to be valid, and since some types are used to determine array size, using 4
-            // will cause array generation and enhance testing of arrays.
-            attributes_node.add(nn_data, "4");
-        }
-    } break;
-
-    case Node_type::u16string_type: {
-        std::string const wchar_string{"wstring"};
-        attributes_node.add(nn_size, 4 + (2 * wchar_string.length()));
-        attributes_node.add(nn_data, wchar_string);
-    } break;
-
-    case Node_type::string_type: {
-        std::string const char_string{"string"};
-        attributes_node.add(nn_size, 4 + char_string.length());
-        attributes_node.add(nn_data, char_string);
+        std::string const enum_name{
+            type == Node_type::enum_type ? attributes_node.get_child(nn_enum).get_value<std::string>() : ""};
+        attributes_node.add(
+            nn_data, std::to_string(fabricate_integer_(type, node_name, enum_name, is_leader_array_member_(node))));
     } break;
 
+    case Node_type::u16string_type:
+    case Node_type::string_type:
     case Node_type::md5_type: {
-        // md5 of the text "frog" - used here as valid filler data
-        std::string const md5_string{"938c2cc0dcc05f2b68c4287040cfcf71"};
-        attributes_node.add(nn_size, 4 + md5_string.length());
-        attributes_node.add(nn_data, md5_string);
+        std::string const& text{fabricate_text_(type)};
+        attributes_node.add(nn_size, fabricate_text_size_(type, text));
+        attributes_node.add(nn_data, text);
     } break;
 
     case Node_type::struct_type:
@@ -121,17 +77,45 @@ void Null_node_reader::read_node_impl_(bpt::ptree& node)
     }
 }
 
+void Null_node_reader::read_node_impl_(Document_node& node, Leaf_data& data)
+{
+    switch (node.type) {
+    case Node_type::bool_type:
+    case Node_type::hex_type:
+    case Node_type::int_type:
+    case Node_type::uint_type:
+    case Node_type::enum_type:
+        node.value = fabricate_integer_(node.type, symbol_table::name(node.name),
+            Save_document::get_symbol(node.enum_name), is_leader_array_member_(node));
+        node.flags |= Document_node::has_size | Document_node::has_data;
+        break;
+
+    case Node_type::u16string_type:
+    case Node_type::string_type:
+    case Node_type::md5_type:
+        data.text = fabricate_text_(node.type);
+        node.size = gsl::narrow<uint8_t>(fabricate_text_size_(node.type, data.text));
+        node.flags |= Document_node::has_size | Document_node::has_data;
+        break;
+
+    case Node_type::struct_type:
+    case Node_type::template_type:
+    case Node_type::array_type:
+        // Aggregate types lack size and data attributes.
+        break;
+
+    default:
+        throw Parser_error(std::format(fmt::bad_type_enumeration, to_string(node.type)));
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // PRIVATE IMPLEMENTATION
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-std::string Null_node_reader::create_player_types_enumerator_data_(const bpt::ptree& node) const
+int Null_node_reader::create_player_types_enumerator_data_(size_t subscript) const
 {
-    // Set the player types enumerator value using the Civ array subscript obtained from the Civ array node name.
-    const bpt::ptree& attributes_node{node.get_child(nn_attributes)};
-    const bpt::ptree& civ_array_name_node{attributes_node.get_child(nn_name)};
-    std::string const civ_array_node_name{civ_array_name_node.get_value<std::string>()};
-    assert(civ_array_node_name[0] == '[');
-    int const player_types_enumerator_value{std::stoi(civ_array_node_name.substr(1))};
+    // The player types enumerator value is the Leader array subscript.
+    auto const player_types_enumerator_value{gsl::narrow<int>(subscript)};
 
     // Fabricate the civ enumerator value which will be used to set the data for this node.
     int civ_enumerator_value{player_types_enumerator_value + 10};
@@ -144,7 +128,63 @@ std::string Null_node_reader::create_player_types_enumerator_data_(const bpt::pt
         civ_enumerator_value = gsl::narrow<int>(ct_enum_def.get_members().size() - 2);
     }
 
-    return std::to_string(civ_enumerator_value);
+    return civ_enumerator_value;
+}
+
+int Null_node_reader::fabricate_integer_(
+    Node_type type, const std::string& node_name, const std::string& enum_name, bool is_leader_array_member) const
+{
+    if (node_name == constants::game_version) {
+        // Set the value of the GameVersion node to pass the assert statement in the schema:
+        //     assert(GameVersion >= 100 && GameVersion < 400)
+        return 302;
+    }
+    if (node_name == constants::revealed_route_type_count) {
+        // RevealedRouteTypeCount must be [0, NUM_ROUTE_TYPES) and NUM_ROUTE_TYPES is 2.
+        return 2;
+    }
+    if (type == Node_type::bool_type) {
+        // We'll set the data for bools to 1 indicating truth.
+        return 1;
+    }
+    if (type == Node_type::enum_type) {
+        // Check to see if this is a "Leader" array member.  If so, we need to create the
+        // data for the PlayerTypes enumerator.
+        if (is_leader_array_member) {
+            return create_player_types_enumerator_data_(leader_array_subscript_(node_name));
+        }
+        if (enum_name == constants::chat_target_types || enum_name == constants::player_vote_types) {
+            return -1;
+        }
+        // We'll set the data for enums to 1 since 1 is probably going to be valid.  If
+        // this causes errors later on we'll need to do something a bit more sophisticated.
+        return 1;
+    }
+    // We'll set the data for hex, int, and uint all simple types to 4 since 4 is probably
+    // going to be valid, and since some types are used to determine array size, using 4
+    // will cause array generation and enhance testing of arrays.
+    return 4;
+}
+
+const std::string& Null_node_reader::fabricate_text_(Node_type type)
+{
+    static const std::string wchar_string{"wstring"};
+    static const std::string char_string{"string"};
+    // md5 of the text "frog" - used here as valid filler data
+    static const std::string md5_string{"938c2cc0dcc05f2b68c4287040cfcf71"};
+    switch (type) {
+    case Node_type::u16string_type:
+        return wchar_string;
+    case Node_type::string_type:
+        return char_string;
+    default:
+        return md5_string;
+    }
+}
+
+size_t Null_node_reader::fabricate_text_size_(Node_type type, const std::string& text)
+{
+    return 4 + (type == Node_type::u16string_type ? 2 * text.length() : text.length());
 }
 
 } // namespace c4lib::property_tree
@@ -6,6 +6,8 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <cstddef>
+#include <include/node-type.hpp>
+#include <include/save-document.hpp>
 #include <lib/ptree/base-node-reader.hpp>
 #include <string>
 
@@ -34,8 +36,22 @@ protected:
 
     void read_node_impl_(boost::property_tree::ptree& node) override;
 
+    void read_node_impl_(Document_node& node, Leaf_data& data) override;
+
 private:
-    [[nodiscard]] std::string create_player_types_enumerator_data_(const boost::property_tree::ptree& node) const;
+    // Returns the value of the PlayerTypes enumerator fabricated for the Leader array member at subscript.
+    [[nodiscard]] int create_player_types_enumerator_data_(size_t subscript) const;
+
+    // Returns the data fabricated for an integer node of type named node_name.  enum_name is the name of the node's
+    // enum or empty if the node is not an enum.
+    [[nodiscard]] int fabricate_integer_(
+        Node_type type, const std::string& node_name, const std::string& enum_name, bool is_leader_array_member) const;
+
+    // Returns the data fabricated for a string node of type.
+    [[nodiscard]] static const std::string& fabricate_text_(Node_type type);
+
+    // Returns the size fabricated for a string node of type whose data is text.
+    [[nodiscard]] static size_t fabricate_text_size_(Node_type type, const std::string& text);
 };
 
 } // namespace c4lib::property_tree
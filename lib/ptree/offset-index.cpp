@@ -0,0 +1,67 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <include/offset-index.hpp>
+#include <iterator>
+#include <lib/util/limits.hpp>
+#include <string>
+#include <utility>
+
+namespace c4lib::property_tree {
+
+void Offset_index::add(Leaf_offset leaf)
+{
+    assert(m_leaves.empty() || leaf.offset >= m_leaves.back().offset + m_leaves.back().size);
+    m_lookup.emplace(leaf.path, m_leaves.size());
+    m_leaves.push_back(std::move(leaf));
+}
+
+const Leaf_offset& Offset_index::at(size_t index) const
+{
+    return m_leaves.at(index);
+}
+
+void Offset_index::clear()
+{
+    m_leaves.clear();
+    m_lookup.clear();
+}
+
+size_t Offset_index::count() const
+{
+    return m_leaves.size();
+}
+
+size_t Offset_index::find(const std::string& path) const
+{
+    const auto it{m_lookup.find(path)};
+    return it == m_lookup.end() ? limits::invalid_size : it->second;
+}
+
+size_t Offset_index::find_offset(size_t offset) const
+{
+    const auto [first, last] = find_range(offset, offset + 1);
+    return first == last ? limits::invalid_size : first;
+}
+
+std::pair<size_t, size_t> Offset_index::find_range(size_t begin, size_t end) const
+{
+    if (begin >= end) {
+        return {0, 0};
+    }
+
+    // Leaves do not overlap and are held in order of offset, so both the offsets at which they begin and the offsets
+    // at which they end are sorted.
+    const auto first{std::ranges::upper_bound(
+        m_leaves, begin, {}, [](const Leaf_offset& leaf) { return leaf.offset + leaf.size; })};
+    const auto last{std::ranges::lower_bound(m_leaves, end, {}, [](const Leaf_offset& leaf) { return leaf.offset; })};
+    const auto first_index{static_cast<size_t>(std::distance(m_leaves.begin(), first))};
+    const auto last_index{static_cast<size_t>(std::distance(m_leaves.begin(), last))};
+    return {first_index, std::max(first_index, last_index)};
+}
+
+} // namespace c4lib::property_tree
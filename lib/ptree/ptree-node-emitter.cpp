@@ -0,0 +1,128 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/symbol.hpp>
+#include <lib/ptree/debug.hpp>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/ptree/node-reader.hpp>
+#include <lib/ptree/ptree-node-emitter.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <span>
+#include <string>
+
+namespace bpt = boost::property_tree;
+
+namespace {
+const std::string attributes_key{c4lib::property_tree::nn_attributes};
+} // namespace
+
+namespace c4lib::property_tree {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Ptree_node_emitter::Ptree_node_emitter(bpt::ptree& root)
+    : m_nodes{&root}, m_types{Node_type::invalid}, m_ids{{&root, 0}}
+{}
+
+size_t Ptree_node_emitter::add_node(size_t parent, const Emitted_node& node)
+{
+    // Attributes are added in the order used by Save_document::node_to_ptree.
+    const std::string& name{symbol_table::name(node.name)};
+    bpt::ptree& child{m_nodes.at(parent)->add_child(name, bpt::ptree{})};
+    bpt::ptree& attributes{child.put_child(nn_attributes, bpt::ptree{nv_meta})};
+    attributes.add(nn_name, name);
+    if (node.array_name != invalid_symbol) {
+        attributes.add(nn_array_name, symbol_table::name(node.array_name));
+    }
+    attributes.add(nn_type, to_string(node.type));
+    attributes.add(nn_typename, symbol_table::name(node.type_name));
+    if (!node.subscripts.empty()) {
+        attributes.add(nn_subscripts, std::string{node.subscripts});
+    }
+    if (node.enum_name != invalid_symbol) {
+        attributes.add(nn_enum, symbol_table::name(node.enum_name));
+    }
+
+    m_ids.emplace(&child, m_nodes.size());
+    m_nodes.push_back(&child);
+    m_types.push_back(node.type);
+    return m_nodes.size() - 1;
+}
+
+void Ptree_node_emitter::dump(const std::string& filename)
+{
+    dump_ptree(filename, *m_nodes.front());
+}
+
+size_t Ptree_node_emitter::find(size_t node, std::span<const Symbol> keys, std::span<const int> subscripts) const
+{
+    // Keys are followed as boost::property_tree::ptree::get_child_optional follows the fragments of a path.
+    bpt::ptree* current{m_nodes.at(node)};
+    size_t subscript_index{0};
+    for (const Symbol key : keys) {
+        Symbol name{key};
+        if (key == invalid_symbol) {
+            const int subscript{subscripts[subscript_index++]};
+            if (subscript < 0) {
+                return limits::invalid_size;
+            }
+            name = symbol_table::subscript(gsl::narrow<size_t>(subscript));
+        }
+        const auto it{current->find(symbol_table::name(name))};
+        if (it == current->not_found()) {
+            return limits::invalid_size;
+        }
+        current = &it->second;
+    }
+
+    if (const auto it{m_ids.find(current)}; it != m_ids.end()) {
+        return it->second;
+    }
+    const auto it{current->find(attributes_key)};
+    if (it == current->not_found()) {
+        return limits::invalid_size;
+    }
+    m_ids.emplace(current, m_nodes.size());
+    m_nodes.push_back(current);
+    m_types.push_back(it->second.get<Node_type>(nn_type));
+    return m_nodes.size() - 1;
+}
+
+size_t Ptree_node_emitter::get_child_count(size_t node) const
+{
+    // The attributes of a node are held by a child which is not counted.
+    const bpt::ptree& pt{*m_nodes.at(node)};
+    return pt.size() - pt.count(attributes_key);
+}
+
+Node_type Ptree_node_emitter::get_type(size_t node) const
+{
+    return m_types.at(node);
+}
+
+int64_t Ptree_node_emitter::get_value(size_t node) const
+{
+    return m_nodes.at(node)->get_child(attributes_key).get<int64_t>(nn_data);
+}
+
+int64_t Ptree_node_emitter::read_node(size_t node, Node_reader& reader)
+{
+    bpt::ptree& pt{*m_nodes.at(node)};
+    reader.read_node(pt);
+    if (const Node_type type{m_types[node]};
+        type < Node_type::first_integer_type || type > Node_type::last_integer_type) {
+        return 0;
+    }
+    return pt.get_child(attributes_key).get<int64_t>(nn_data);
+}
+
+} // namespace c4lib::property_tree
@@ -0,0 +1,63 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <include/node-type.hpp>
+#include <include/symbol.hpp>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/ptree/node-reader.hpp>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace c4lib::property_tree {
+
+// Emits nodes into a property tree.  Nodes are added to the tree as they are emitted, so the tree may be inspected
+// while it is being built.
+class Ptree_node_emitter : public Node_emitter {
+public:
+    // root is the property tree to which the top-level nodes are added.  Existing content is kept.
+    explicit Ptree_node_emitter(boost::property_tree::ptree& root);
+
+    ~Ptree_node_emitter() override = default;
+
+    Ptree_node_emitter(const Ptree_node_emitter&) = delete;
+
+    Ptree_node_emitter& operator=(const Ptree_node_emitter&) = delete;
+
+    Ptree_node_emitter(Ptree_node_emitter&&) noexcept = delete;
+
+    Ptree_node_emitter& operator=(Ptree_node_emitter&&) noexcept = delete;
+
+    size_t add_node(size_t parent, const Emitted_node& node) override;
+
+    void dump(const std::string& filename) override;
+
+    // Nodes of the tree reached by find which were not emitted, e.g., nodes of the tree passed to the constructor, are
+    // assigned ids when first found.
+    [[nodiscard]] size_t find(
+        size_t node, std::span<const Symbol> keys, std::span<const int> subscripts) const override;
+
+    [[nodiscard]] size_t get_child_count(size_t node) const override;
+
+    [[nodiscard]] Node_type get_type(size_t node) const override;
+
+    [[nodiscard]] int64_t get_value(size_t node) const override;
+
+    int64_t read_node(size_t node, Node_reader& reader) override;
+
+private:
+    // The property tree node and type of each id, and the id of each property tree node.
+    mutable std::vector<boost::property_tree::ptree*> m_nodes;
+    mutable std::vector<Node_type> m_types;
+    mutable std::unordered_map<const boost::property_tree::ptree*, size_t> m_ids;
+};
+
+} // namespace c4lib::property_tree
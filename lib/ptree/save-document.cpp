@@ -0,0 +1,312 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/save-document.hpp>
+#include <include/symbol.hpp>
+#include <lib/ptree/internationalization-text.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <string>
+#include <string_view>
+
+namespace bpt = boost::property_tree;
+
+namespace {
+bool is_integer_type(c4lib::property_tree::Node_type type)
+{
+    return type >= c4lib::property_tree::Node_type::first_integer_type
+           && type <= c4lib::property_tree::Node_type::last_integer_type;
+}
+} // namespace
+
+namespace c4lib::property_tree {
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Save_document::Save_document()
+{
+    clear();
+}
+
+const Document_node& Save_document::at(size_t index) const
+{
+    return m_nodes.at(index);
+}
+
+void Save_document::clear()
+{
+    m_nodes.assign(1, Document_node{});
+    m_origin = Origin_node{};
+    m_has_origin = false;
+    m_texts.clear();
+}
+
+size_t Save_document::count() const
+{
+    return m_nodes.size();
+}
+
+size_t Save_document::find(const std::string& path) const
+{
+    size_t index{0};
+    size_t begin{0};
+    while (begin <= path.length()) {
+        size_t end{path.find('.', begin)};
+        if (end == std::string::npos) {
+            end = path.length();
+        }
+        const Symbol name{symbol_table::find(std::string_view{path}.substr(begin, end - begin))};
+        if (name == invalid_symbol) {
+            return limits::invalid_size;
+        }
+
+        const Document_node& parent{m_nodes.at(index)};
+        index = limits::invalid_size;
+        for (size_t child = parent.first_child; child < parent.first_child + parent.child_count; ++child) {
+            if (m_nodes[child].name == name) {
+                index = child;
+                break;
+            }
+        }
+        if (index == limits::invalid_size) {
+            return limits::invalid_size;
+        }
+        begin = end + 1;
+    }
+    return index;
+}
+
+void Save_document::from_ptree(const bpt::ptree& pt)
+{
+    clear();
+
+    if (const boost::optional<const bpt::ptree&> origin{pt.get_child_optional(nn_origin)}) {
+        m_origin.savegame = origin->get<std::string>(nn_savegame, "");
+        m_origin.schema = origin->get<std::string>(nn_schema, "");
+        m_origin.date = origin->get<std::string>(nn_date, "");
+        m_origin.c4lib_version = origin->get<std::string>(nn_c4lib_version, "");
+        m_has_origin = true;
+    }
+
+    add_children_(0, pt);
+}
+
+std::string Save_document::get_formatted_data(size_t index) const
+{
+    const Document_node& node{m_nodes.at(index)};
+    switch (node.type) {
+    case Node_type::bool_type:
+        return node.value != 0 ? text_true : text_false;
+
+    case Node_type::hex_type:
+        return std::format("0x{:0{}x}", node.value, node.size * 2);
+
+    case Node_type::int_type:
+    case Node_type::uint_type:
+        return std::to_string(node.value);
+
+    case Node_type::enum_type:
+        return get_symbol(node.enumerator);
+
+    case Node_type::string_type:
+    case Node_type::u16string_type:
+    case Node_type::md5_type:
+        return "\"" + get_text(index) + "\"";
+
+    default:
+        return "";
+    }
+}
+
+const Origin_node& Save_document::get_origin() const
+{
+    return m_origin;
+}
+
+const std::string& Save_document::get_subscripts(size_t index) const
+{
+    return m_texts.at(m_nodes.at(index).subscripts);
+}
+
+const std::string& Save_document::get_symbol(Symbol symbol)
+{
+    static const std::string empty;
+    return symbol == invalid_symbol ? empty : symbol_table::name(symbol);
+}
+
+const std::string& Save_document::get_text(size_t index) const
+{
+    return m_texts.at(gsl::narrow<size_t>(m_nodes.at(index).value));
+}
+
+bool Save_document::has_origin() const
+{
+    return m_has_origin;
+}
+
+void Save_document::node_to_ptree(size_t index, bpt::ptree& node) const
+{
+    node.clear();
+
+    if (index == 0) {
+        if (m_has_origin) {
+            bpt::ptree& origin{node.put_child(nn_origin, bpt::ptree{nv_meta})};
+            origin.add(nn_savegame, m_origin.savegame);
+            origin.add(nn_schema, m_origin.schema);
+            origin.add(nn_date, m_origin.date);
+            origin.add(nn_c4lib_version, m_origin.c4lib_version);
+        }
+        return;
+    }
+
+    // Attributes are added in the order used by Generative_node_source and the node readers.
+    const Document_node& document_node{m_nodes.at(index)};
+    bpt::ptree& attributes{node.put_child(nn_attributes, bpt::ptree{nv_meta})};
+    attributes.add(nn_name, get_symbol(document_node.name));
+    if (document_node.array_name != invalid_symbol) {
+        attributes.add(nn_array_name, get_symbol(document_node.array_name));
+    }
+    attributes.add(nn_type, to_string(document_node.type));
+    attributes.add(nn_typename, get_symbol(document_node.type_name));
+    if ((document_node.flags & Document_node::has_subscripts) != 0) {
+        attributes.add(nn_subscripts, get_subscripts(index));
+    }
+    if (document_node.enum_name != invalid_symbol) {
+        attributes.add(nn_enum, get_symbol(document_node.enum_name));
+    }
+    if ((document_node.flags & Document_node::has_size) != 0) {
+        attributes.add(nn_size, std::to_string(document_node.size));
+    }
+    if ((document_node.flags & Document_node::has_data) != 0) {
+        attributes.add(
+            nn_data, is_integer_type(document_node.type) ? std::to_string(document_node.value) : get_text(index));
+    }
+    if ((document_node.flags & Document_node::has_formatted_data) != 0) {
+        attributes.add(nn_formatted_data, get_formatted_data(index));
+    }
+}
+
+void Save_document::to_ptree(bpt::ptree& pt) const
+{
+    node_to_ptree(0, pt);
+    add_ptree_children_(0, pt);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void Save_document::add_children_(size_t index, const bpt::ptree& pt)
+{
+    // Meta nodes (attributes and origin) are not children.  The children of a node are allocated as a block before
+    // any grandchildren so that they occupy a contiguous range.
+    size_t child_count{0};
+    for (const auto& [key, child] : pt) {
+        if (child.data() != nv_meta) {
+            ++child_count;
+        }
+    }
+
+    const size_t first_child{m_nodes.size()};
+    m_nodes.resize(first_child + child_count);
+    m_nodes[index].first_child = gsl::narrow<uint32_t>(first_child);
+    m_nodes[index].child_count = gsl::narrow<uint32_t>(child_count);
+
+    size_t child_index{first_child};
+    for (const auto& [key, child] : pt) {
+        if (child.data() != nv_meta) {
+            add_node_attributes_(child_index, child);
+            add_children_(child_index, child);
+            ++child_index;
+        }
+    }
+}
+
+void Save_document::add_node_attributes_(size_t index, const bpt::ptree& node)
+{
+    Document_node& document_node{m_nodes[index]};
+    const bpt::ptree& attributes{node.get_child(nn_attributes)};
+    for (const auto& [key, attribute] : attributes) {
+        if (key == nn_name) {
+            document_node.name = symbol_table::intern(attribute.data());
+        }
+        else if (key == nn_type) {
+            document_node.type = attribute.get_value<Node_type>();
+        }
+        else if (key == nn_typename) {
+            document_node.type_name = symbol_table::intern(attribute.data());
+        }
+        else if (key == nn_array_name) {
+            document_node.array_name = symbol_table::intern(attribute.data());
+        }
+        else if (key == nn_subscripts) {
+            document_node.subscripts = gsl::narrow<uint32_t>(m_texts.size());
+            m_texts.push_back(attribute.data());
+            document_node.flags |= Document_node::has_subscripts;
+        }
+        else if (key == nn_enum) {
+            document_node.enum_name = symbol_table::intern(attribute.data());
+        }
+    }
+
+    add_node_data_(index, attributes);
+}
+
+void Save_document::add_node_data_(size_t index, const bpt::ptree& attributes)
+{
+    Document_node& document_node{m_nodes[index]};
+    const bpt::ptree* data_node{nullptr};
+    const bpt::ptree* formatted_data_node{nullptr};
+
+    for (const auto& [key, attribute] : attributes) {
+        if (key == nn_size) {
+            document_node.size = gsl::narrow<uint8_t>(attribute.get_value<int>());
+            document_node.flags |= Document_node::has_size;
+        }
+        else if (key == nn_data) {
+            data_node = &attribute;
+        }
+        else if (key == nn_formatted_data) {
+            formatted_data_node = &attribute;
+        }
+    }
+
+    if (data_node != nullptr) {
+        if (is_integer_type(document_node.type)) {
+            document_node.value = data_node->get_value<int64_t>();
+        }
+        else {
+            document_node.value = gsl::narrow<int64_t>(m_texts.size());
+            m_texts.push_back(data_node->data());
+        }
+        document_node.flags |= Document_node::has_data;
+    }
+
+    // Only the formatted data of enum nodes is stored; for other types it is derived from the data.
+    if (formatted_data_node != nullptr) {
+        if (document_node.type == Node_type::enum_type) {
+            document_node.enumerator = symbol_table::intern(formatted_data_node->data());
+        }
+        document_node.flags |= Document_node::has_formatted_data;
+    }
+}
+
+void Save_document::add_ptree_children_(size_t index, bpt::ptree& pt) const
+{
+    const Document_node& parent{m_nodes.at(index)};
+    for (size_t child_index = parent.first_child; child_index < parent.first_child + parent.child_count;
+         ++child_index) {
+        bpt::ptree& child{pt.add_child(get_symbol(m_nodes[child_index].name), bpt::ptree{})};
+        node_to_ptree(child_index, child);
+        add_ptree_children_(child_index, child);
+    }
+}
+
+} // namespace c4lib::property_tree
@@ -7,6 +7,7 @@
 #include <format>
 #include <include/exceptions.hpp>
 #include <include/node-attributes.hpp>
+#include <include/save-document.hpp>
 #include <lib/ptree/util.hpp>
 #include <lib/util/constants.hpp>
 #include <lib/util/exception-formats.hpp>
@@ -18,6 +19,31 @@
 
 namespace bpt = boost::property_tree;
 
+namespace {
+// Returns the dimension of an array from its subscripts attribute, e.g., 19 for [19].
+int array_dimension_from_subscripts(const std::string& subscripts)
+{
+    if (subscripts.empty()) {
+        throw c4lib::Ptree_error{std::format(c4lib::fmt::bad_subscripts_format, c4lib::property_tree::nn_subscripts)};
+    }
+    int array_dimension{std::stoi(subscripts.substr(1))};
+    if (array_dimension < 0 || gsl::narrow<size_t>(array_dimension) > c4lib::limits::max_array_dimension) {
+        throw c4lib::Ptree_error{std::format(c4lib::fmt::array_dimension_out_of_range, array_dimension)};
+    }
+    return array_dimension;
+}
+
+// Computes the footer size from the number of undocumented footer bytes.
+size_t footer_size_from_undocumented_byte_count(int undocumented_footer_byte_count)
+{
+    // The footer size = undocumented footer byte count + 1 (checksum byte) + 4 (md5 length field) +
+    // 32 (characters in md5).
+    const int footer_size{undocumented_footer_byte_count + 1 + 4 + 32};
+
+    return gsl::narrow<size_t>(footer_size);
+}
+} // namespace
+
 namespace c4lib::property_tree {
 
 int get_array_dimension(const bpt::ptree& pt, const std::string& path)
@@ -28,27 +54,33 @@ int get_array_dimension(const bpt::ptree& pt, const std::string& path)
         throw Ptree_error{std::format(fmt::node_not_found, path)};
     }
 
-    const std::string subscripts{subscripts_node->data()};
-    if (subscripts.empty()) {
-        throw Ptree_error{std::format(fmt::bad_subscripts_format, nn_subscripts)};
+    return array_dimension_from_subscripts(subscripts_node->data());
+}
+
+int get_array_dimension(const Save_document& document, const std::string& path)
+{
+    const size_t index{document.find(path)};
+    if (index == limits::invalid_size) {
+        throw Ptree_error{std::format(fmt::node_not_found, path)};
     }
-    int array_dimension{std::stoi(subscripts.substr(1))};
-    if (array_dimension < 0 || gsl::narrow<size_t>(array_dimension) > limits::max_array_dimension) {
-        throw Ptree_error{std::format(fmt::array_dimension_out_of_range, array_dimension)};
+
+    if ((document.at(index).flags & Document_node::has_subscripts) == 0) {
+        return array_dimension_from_subscripts("");
     }
-    return array_dimension;
+    return array_dimension_from_subscripts(document.get_subscripts(index));
 }
 
 size_t get_footer_size(const bpt::ptree& pt)
 {
     // Get the UndocumentedFooterBytes node from pt.
-    const int undocumented_footer_byte_count{get_array_dimension(pt, constants::undocumented_footer_bytes_path)};
-
-    // Compute the footer size.  The footer size = undocumented footer byte count + 1 (checksum byte) +
-    // 4 (md5 length field) + 32 (characters in md5).
-    const int footer_size{undocumented_footer_byte_count + 1 + 4 + 32};
+    return footer_size_from_undocumented_byte_count(
+        get_array_dimension(pt, constants::undocumented_footer_bytes_path));
+}
 
-    return gsl::narrow<size_t>(footer_size);
+size_t get_footer_size(const Save_document& document)
+{
+    return footer_size_from_undocumented_byte_count(
+        get_array_dimension(document, constants::undocumented_footer_bytes_path));
 }
 
 int get_max_players(const bpt::ptree& pt)
@@ -61,6 +93,11 @@ int get_max_players(const bpt::ptree& pt)
     return get_array_dimension(pt, constants::leader_name_path);
 }
 
+int get_max_players(const Save_document& document)
+{
+    return get_array_dimension(document, constants::leader_name_path);
+}
+
 int get_num_game_option_types(const bpt::ptree& pt)
 {
     // From the schema we have:
@@ -71,6 +108,11 @@ int get_num_game_option_types(const bpt::ptree& pt)
     return get_array_dimension(pt, constants::options_path);
 }
 
+int get_num_game_option_types(const Save_document& document)
+{
+    return get_array_dimension(document, constants::options_path);
+}
+
 int get_num_multiplayer_option_types(const bpt::ptree& pt)
 {
     // From the schema we have:
@@ -81,4 +123,9 @@ int get_num_multiplayer_option_types(const bpt::ptree& pt)
     return get_array_dimension(pt, constants::multiplayer_options_path);
 }
 
+int get_num_multiplayer_option_types(const Save_document& document)
+{
+    return get_array_dimension(document, constants::multiplayer_options_path);
+}
+
 } // namespace c4lib::property_tree
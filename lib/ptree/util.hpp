@@ -11,14 +11,26 @@
 
 namespace c4lib::property_tree {
 
+class Save_document;
+
 int get_array_dimension(const boost::property_tree::ptree& pt, const std::string& path);
 
+int get_array_dimension(const Save_document& document, const std::string& path);
+
 size_t get_footer_size(const boost::property_tree::ptree& pt);
 
+size_t get_footer_size(const Save_document& document);
+
 int get_max_players(const boost::property_tree::ptree& pt);
 
+int get_max_players(const Save_document& document);
+
 int get_num_game_option_types(const boost::property_tree::ptree& pt);
 
+int get_num_game_option_types(const Save_document& document);
+
 int get_num_multiplayer_option_types(const boost::property_tree::ptree& pt);
 
+int get_num_multiplayer_option_types(const Save_document& document);
+
 } // namespace c4lib::property_tree
@@ -9,6 +9,7 @@
 #include <lib/schema-parser/def-mem-type.hpp>
 #include <lib/util/file-location.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <string>
 #include <utility>
 
@@ -16,7 +17,7 @@ namespace c4lib::schema_parser {
 
 struct Def_mem {
     Def_mem(Def_mem_type type_, std::string name_, int value_, File_location loc_)
-        : loc(std::move(loc_)), name(std::move(name_)), type(type_), value(value_)
+        : loc(std::move(loc_)), name(std::move(name_)), symbol(symbol_table::intern(name)), type(type_), value(value_)
     {}
 
     // Used to sort definitions in ascending order based on value.
@@ -28,6 +29,7 @@ struct Def_mem {
     // Location at which the definition was found.  Useful for debugging and error messages.
     File_location loc;
     std::string name;
+    Symbol symbol{invalid_symbol};
     Def_mem_type type{Def_mem_type::invalid};
     // For consts and enumerators, value is the value of the type.  For structs and templates,
     // value is an index into the token vector where the definition is found.
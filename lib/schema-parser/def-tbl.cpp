@@ -12,6 +12,7 @@
 #include <lib/schema-parser/definition.hpp>
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/file-location.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <lib/util/text.hpp>
 #include <map>
 #include <ostream>
@@ -26,21 +27,46 @@ namespace c4lib::schema_parser {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // INTERFACE
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-Definition& Def_tbl::create_definition(
-    const std::string& name, Def_type type, const File_location& loc, bool& was_created)
+void Def_tbl::checkpoint()
 {
-    if (!m_definition_table.contains(name)) {
-        m_definition_table.try_emplace(name, name, type, loc);
-        was_created = true;
+    m_checkpoint.clear();
+    for (const auto& [name, definition] : m_definition_table) {
+        m_checkpoint.try_emplace(name, definition.get_members().size());
     }
-    else {
-        was_created = false;
+    m_has_checkpoint = true;
+}
+
+void Def_tbl::copy_from(const Def_tbl& other)
+{
+    reset();
+    for (const auto& [name, other_definition] : other.m_definition_table) {
+        bool was_created{false};
+        Definition& definition{
+            create_definition(name, other_definition.get_type(), other_definition.get_file_location(), was_created)};
+        // Members are copied in order.  Duplicates are allowed since modular overrides have already been resolved.
+        for (Def_mem member : other_definition.get_members()) {
+            definition.add_member(member, true, false);
+        }
     }
-    Definition& def{m_definition_table.at(name)};
+    m_checkpoint = other.m_checkpoint;
+    m_has_checkpoint = other.m_has_checkpoint;
+}
+
+Definition& Def_tbl::create_definition(
+    const std::string& name, Def_type type, const File_location& loc, bool& was_created)
+{
+    return create_definition(symbol_table::intern(name), type, loc, was_created);
+}
+
+Definition& Def_tbl::create_definition(Symbol name, Def_type type, const File_location& loc, bool& was_created)
+{
+    const auto [it, is_inserted]{m_definition_table.try_emplace(name, symbol_table::name(name), type, loc)};
+    was_created = is_inserted;
+    Definition& def{it->second};
 
     if (def.get_type() != type) {
         throw make_ex<Parser_error>(
-            fmt::type_mismatch_in_definition, loc, name, to_string(type), to_string(def.get_type()));
+            fmt::type_mismatch_in_definition, loc, def.get_name(), to_string(type), to_string(def.get_type()));
     }
 
     return def;
@@ -64,43 +90,71 @@ void Def_tbl::export_definitions(Def_type type, std::ostream& out) const
 
 int Def_tbl::get_const_value(const std::string& const_name) const
 {
-    const Def_mem& member{get_first_member(const_name, Def_type::const_type)};
-    return member.value;
+    if (const Symbol symbol{find_symbol_(const_name)}; symbol != invalid_symbol) {
+        return get_const_value(symbol);
+    }
+    throw Parser_error(std::format(fmt::definition_does_not_exist, const_name));
+}
+
+int Def_tbl::get_const_value(Symbol const_name) const
+{
+    const Definition& def{get_definition(const_name, Def_type::const_type)};
+    return def.get_members().at(0).value;
 }
 
 const Definition& Def_tbl::get_definition(const std::string& name, Def_type type) const
 {
-    try {
-        const Definition& def{m_definition_table.at(name)};
-        if (def.get_type() != type) {
-            throw make_ex<Parser_error>(fmt::type_mismatch_in_definition, def.get_file_location(), name,
-                to_string(type), to_string(def.get_type()));
-        }
+    if (const Symbol symbol{find_symbol_(name)}; symbol != invalid_symbol) {
+        return get_definition(symbol, type);
+    }
+    throw Parser_error(std::format(fmt::definition_does_not_exist, name));
+}
 
-        return def;
+const Definition& Def_tbl::get_definition(Symbol name, Def_type type) const
+{
+    const auto it{m_definition_table.find(name)};
+    if (it == m_definition_table.end()) {
+        throw Parser_error(std::format(fmt::definition_does_not_exist, symbol_table::name(name)));
     }
-    catch (std::out_of_range&) {
-        throw Parser_error(std::format(fmt::definition_does_not_exist, name));
+    const Definition& def{it->second};
+    if (def.get_type() != type) {
+        throw make_ex<Parser_error>(fmt::type_mismatch_in_definition, def.get_file_location(), def.get_name(),
+            to_string(type), to_string(def.get_type()));
     }
+
+    return def;
 }
 
 Definition& Def_tbl::get_definition(const std::string& name, Def_type type)
 {
-    try {
-        Definition& def{m_definition_table.at(name)};
-        if (def.get_type() != type) {
-            throw make_ex<Parser_error>(fmt::type_mismatch_in_definition, def.get_file_location(), name,
-                to_string(type), to_string(def.get_type()));
-        }
+    if (const Symbol symbol{find_symbol_(name)}; symbol != invalid_symbol) {
+        return get_definition(symbol, type);
+    }
+    throw Parser_error(std::format(fmt::definition_does_not_exist, name));
+}
 
-        return def;
+Definition& Def_tbl::get_definition(Symbol name, Def_type type)
+{
+    const auto it{m_definition_table.find(name)};
+    if (it == m_definition_table.end()) {
+        throw Parser_error(std::format(fmt::definition_does_not_exist, symbol_table::name(name)));
     }
-    catch (std::out_of_range&) {
-        throw Parser_error(std::format(fmt::definition_does_not_exist, name));
+    Definition& def{it->second};
+    if (def.get_type() != type) {
+        throw make_ex<Parser_error>(fmt::type_mismatch_in_definition, def.get_file_location(), def.get_name(),
+            to_string(type), to_string(def.get_type()));
     }
+
+    return def;
 }
 
 const Def_mem& Def_tbl::get_enumerator(const std::string& enum_name, int enumerator_value) const
+{
+    const Definition& def{get_definition(enum_name, Def_type::enum_type)};
+    return get_enumerator(def.get_symbol(), enumerator_value);
+}
+
+const Def_mem& Def_tbl::get_enumerator(Symbol enum_name, int enumerator_value) const
 {
     const Definition& def{get_definition(enum_name, Def_type::enum_type)};
     for (const auto& def_mem : def.get_members()) {
@@ -108,20 +162,30 @@ const Def_mem& Def_tbl::get_enumerator(const std::string& enum_name, int enumera
             return def_mem;
         }
     }
-    throw make_ex<Parser_error>(fmt::enumerator_not_found, def.get_file_location(), enum_name, enumerator_value);
+    throw make_ex<Parser_error>(
+        fmt::enumerator_not_found, def.get_file_location(), def.get_name(), enumerator_value);
 }
 
 const Def_mem& Def_tbl::get_enumerator(const std::string& enum_name, const std::string& enumerator_name) const
 {
     const Definition& def{get_definition(enum_name, Def_type::enum_type)};
-    for (const auto& def_mem : def.get_members()) {
-        if (def_mem.name == enumerator_name) {
-            return def_mem;
-        }
+    const Symbol enumerator{find_symbol_(enumerator_name)};
+    if (const Def_mem* def_mem{enumerator == invalid_symbol ? nullptr : def.find_member(enumerator)}) {
+        return *def_mem;
     }
     throw make_ex<Parser_error>(fmt::enumerator_not_found, def.get_file_location(), enum_name, enumerator_name);
 }
 
+const Def_mem& Def_tbl::get_enumerator(Symbol enum_name, Symbol enumerator_name) const
+{
+    const Definition& def{get_definition(enum_name, Def_type::enum_type)};
+    if (const Def_mem* def_mem{def.find_member(enumerator_name)}) {
+        return *def_mem;
+    }
+    throw make_ex<Parser_error>(fmt::enumerator_not_found, def.get_file_location(), def.get_name(),
+        symbol_table::name(enumerator_name));
+}
+
 const Def_mem& Def_tbl::get_first_member(const std::string& name, Def_type type) const
 {
     const Definition& def{get_definition(name, type)};
@@ -136,25 +200,49 @@ Def_mem& Def_tbl::get_first_member(const std::string& name, Def_type type)
     return members.at(0);
 }
 
-std::unordered_map<std::string, Definition>& Def_tbl::get_definitions()
+const std::unordered_map<Symbol, Definition>& Def_tbl::get_definitions() const
+{
+    return m_definition_table;
+}
+
+std::unordered_map<Symbol, Definition>& Def_tbl::get_definitions()
 {
     return m_definition_table;
 }
 
 Def_type Def_tbl::get_type(const std::string& name) const
 {
-    try {
-        const Definition& def{m_definition_table.at(name)};
-        return def.get_type();
+    if (const Symbol symbol{find_symbol_(name)}; symbol != invalid_symbol) {
+        return get_type(symbol);
     }
-    catch (std::out_of_range&) {
-        throw Parser_error(std::format(fmt::definition_does_not_exist, name));
+    throw Parser_error(std::format(fmt::definition_does_not_exist, name));
+}
+
+Def_type Def_tbl::get_type(Symbol name) const
+{
+    const auto it{m_definition_table.find(name)};
+    if (it == m_definition_table.end()) {
+        throw Parser_error(std::format(fmt::definition_does_not_exist, symbol_table::name(name)));
     }
+    return it->second.get_type();
 }
 
 void Def_tbl::reset()
 {
+    m_checkpoint.clear();
     m_definition_table.clear();
+    m_has_checkpoint = false;
+}
+
+void Def_tbl::rollback()
+{
+    if (!m_has_checkpoint) {
+        return;
+    }
+    std::erase_if(m_definition_table, [this](const auto& pr) { return !m_checkpoint.contains(pr.first); });
+    for (auto& [name, definition] : m_definition_table) {
+        definition.truncate_members(m_checkpoint.at(name));
+    }
 }
 
 // Returns the number of definitions in the table.
@@ -190,7 +278,7 @@ void Def_tbl::export_enum_definitions_(std::ostream& out) const
 
         // export the NUM_ constant for the enum, should one exist.
         const std::string const_name = "NUM_" + text::screaming_snake_case(def->get_name());
-        if (m_definition_table.contains(const_name)) {
+        if (m_definition_table.contains(find_symbol_(const_name))) {
             const Definition& const_def{get_definition(const_name, Def_type::const_type)};
             const std::vector<Def_mem>& members{const_def.get_members()};
             const int const_value{members.at(0).value};
@@ -201,6 +289,11 @@ void Def_tbl::export_enum_definitions_(std::ostream& out) const
     }
 }
 
+Symbol Def_tbl::find_symbol_(const std::string& name)
+{
+    return symbol_table::find(name);
+}
+
 // Creates a map so that definitions appear in lexicographical sort order.
 void Def_tbl::make_map_(std::map<std::string, const Definition*>& def_map, Def_type type) const
 {
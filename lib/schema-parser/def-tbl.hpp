@@ -8,6 +8,7 @@
 #include <lib/schema-parser/def-mem.hpp>
 #include <lib/schema-parser/def-type.hpp>
 #include <lib/schema-parser/definition.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <lib/util/tune.hpp>
 #include <map>
 #include <string>
@@ -17,6 +18,8 @@
 
 namespace c4lib::schema_parser {
 
+// Table of definitions keyed by the symbols of their names.  Each lookup taking a name has an overload taking the
+// name's symbol; the symbol overloads do not use the symbol table and so are used while reading saves.
 class Def_tbl {
 public:
     Def_tbl() = default;
@@ -31,36 +34,60 @@ public:
 	
     Def_tbl& operator=(Def_tbl&&) noexcept = delete;
     
+    // Records the current contents of the table.  A later call to rollback removes the definitions and members added
+    // after the checkpoint.  Used to discard per-save definitions, e.g., PlayerTypes, when reading several saves
+    // with the same table.
+    void checkpoint();
+
+    // Replaces the contents of the table, including its checkpoint, with a copy of other.  Used to give each of
+    // several parsers its own table when the parsers share a single prepared schema.
+    void copy_from(const Def_tbl& other);
+
     // Returns a reference to the specified definition.  If the definition does not exist it is created and
     // was_created is set to true.  Throws an exception if the definition exists but the type passed does not match the
     // existing type.
     Definition& create_definition(const std::string& name, Def_type type, const File_location& loc, bool& was_created);
 
+    Definition& create_definition(Symbol name, Def_type type, const File_location& loc, bool& was_created);
+
     // Prints the definitions of the specified type to the output stream.  Throws an exception on error.
     void export_definitions(Def_type type, std::ostream& out) const;
 
     // Returns the value of constant const_name.  Throws an exception if const_name does not exist.
     [[nodiscard]] int get_const_value(const std::string& const_name) const;
 
+    [[nodiscard]] int get_const_value(Symbol const_name) const;
+
     // Returns a reference to the existing named definition.  Throws an exception if the definition does not
     // exist or is of unexpected type.
     [[nodiscard]] const Definition& get_definition(const std::string& name, Def_type type) const;
 
+    [[nodiscard]] const Definition& get_definition(Symbol name, Def_type type) const;
+
     // Returns a reference to the existing named definition.  Throws an exception if the definition does not
     // exist or is of unexpected type.
     Definition& get_definition(const std::string& name, Def_type type);
 
+    Definition& get_definition(Symbol name, Def_type type);
+
     // Returns a reference to the definition table.
-    std::unordered_map<std::string, Definition>& get_definitions();
+    [[nodiscard]] const std::unordered_map<Symbol, Definition>& get_definitions() const;
+
+    // Returns a reference to the definition table.
+    std::unordered_map<Symbol, Definition>& get_definitions();
 
     // Returns a reference to the definition member for the specified enumerator.  Throws an exception if the
     // definition member does not exist.
     [[nodiscard]] const Def_mem& get_enumerator(const std::string& enum_name, int enumerator_value) const;
 
+    [[nodiscard]] const Def_mem& get_enumerator(Symbol enum_name, int enumerator_value) const;
+
     // Returns a reference to the definition member for the specified enumerator.  Throws an exception if the
     // definition member does not exist.
     [[nodiscard]] const Def_mem& get_enumerator(const std::string& enum_name, const std::string& enumerator_name) const;
 
+    [[nodiscard]] const Def_mem& get_enumerator(Symbol enum_name, Symbol enumerator_name) const;
+
     // Returns a reference to the first member of the existing named definition.  Throws an exception if the
     // definition does not or if no first member exists or if the definition is of unexpected type.
     [[nodiscard]] const Def_mem& get_first_member(const std::string& name, Def_type type) const;
@@ -72,9 +99,15 @@ public:
     // Returns the type for name.  Throws an exception if name does not exist.
     [[nodiscard]] Def_type get_type(const std::string& name) const;
 
+    [[nodiscard]] Def_type get_type(Symbol name) const;
+
     // Resets the definition table returning it to the state of a newly created table.
     void reset();
 
+    // Restores the table to its state at the most recent call to checkpoint.  Takes no action if checkpoint has not
+    // been called.  N.B.: Modular overrides of existing members made after the checkpoint are not undone.
+    void rollback();
+
     // Returns the number of definitions in the table.
     [[nodiscard]] size_t size() const;
 
@@ -85,7 +118,13 @@ private:
 
     void make_map_(std::map<std::string, const Definition*>& def_map, Def_type type) const;
 
-    std::unordered_map<std::string, Definition> m_definition_table{tune::definition_reserve_size};
+    // Returns the symbol for name, or invalid_symbol, which names no definition, if name has not been interned.
+    static Symbol find_symbol_(const std::string& name);
+
+    // Maps the name of each definition present at the last checkpoint to its member count.
+    std::unordered_map<Symbol, size_t> m_checkpoint;
+    std::unordered_map<Symbol, Definition> m_definition_table{tune::definition_reserve_size};
+    bool m_has_checkpoint{false};
 };
 
 } // namespace c4lib::schema_parser
@@ -10,6 +10,8 @@
 #include <lib/schema-parser/definition.hpp>
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/file-location.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,27 +19,33 @@
 namespace c4lib::schema_parser {
 
 Definition::Definition(std::string name, Def_type type, File_location loc)
-    : m_def_type(type), m_loc(std::move(loc)), m_name(std::move(name))
+    : m_def_type(type), m_loc(std::move(loc)), m_name(std::move(name)), m_symbol(symbol_table::intern(m_name))
 {}
 
 // Adds a member to the definition.  If member is inconsistent with the definition, an exception is thrown.
 void Definition::add_member(Def_mem& member, bool allow_duplicates, bool is_modular)
 {
     check_member_type_(member);
-    if (m_members_hash_map.contains(member.name) && !allow_duplicates) {
-        if (!is_modular || m_members.at(m_members_hash_map[member.name]).type != member.type
+    if (m_members_hash_map.contains(member.symbol) && !allow_duplicates) {
+        if (!is_modular || m_members.at(m_members_hash_map[member.symbol]).type != member.type
             || (member.type != Def_mem_type::const_type && member.type != Def_mem_type::enum_type)) {
             throw make_ex<Importer_error>(fmt::duplicated_name, member.loc, member.name);
         }
-        m_members.at(m_members_hash_map[member.name]) = member;
+        m_members.at(m_members_hash_map[member.symbol]) = member;
     }
     else {
         const size_t index{m_members.size()};
-        m_members_hash_map[member.name] = index;
+        m_members_hash_map[member.symbol] = index;
         m_members.push_back(member);
     }
 }
 
+const Def_mem* Definition::find_member(Symbol symbol) const
+{
+    const auto it{m_members_hash_map.find(symbol)};
+    return it == m_members_hash_map.end() ? nullptr : &m_members[it->second];
+}
+
 const File_location& Definition::get_file_location() const
 {
     return m_loc;
@@ -58,11 +66,31 @@ const std::string& Definition::get_name() const
     return m_name;
 }
 
+Symbol Definition::get_symbol() const
+{
+    return m_symbol;
+}
+
 Def_type Definition::get_type() const
 {
     return m_def_type;
 }
 
+void Definition::truncate_members(size_t count)
+{
+    if (count >= m_members.size()) {
+        return;
+    }
+    m_members.erase(m_members.begin() + gsl::narrow<std::ptrdiff_t>(count), m_members.end());
+
+    // Rebuild the hash map so that it matches the state prior to adding the removed members.  When duplicates are
+    // allowed the most recently added member wins; replaying the members in order preserves this.
+    m_members_hash_map.clear();
+    for (size_t i = 0; i < m_members.size(); ++i) {
+        m_members_hash_map[m_members.at(i).symbol] = i;
+    }
+}
+
 void Definition::check_member_type_(const Def_mem& member) const
 {
     bool is_compatible{false};
@@ -8,6 +8,7 @@
 #include <lib/schema-parser/def-mem.hpp>
 #include <lib/schema-parser/def-type.hpp>
 #include <lib/util/file-location.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -35,6 +36,10 @@ public:
     // otherwise an exception is thrown.
     void add_member(Def_mem& member, bool allow_duplicates, bool is_modular);
 
+    // Returns the member whose name is symbol, or nullptr if there is no such member.  If duplicates were allowed,
+    // the most recently added member of that name is returned.
+    [[nodiscard]] const Def_mem* find_member(Symbol symbol) const;
+
     // Returns the location at which the definition was found (useful for debugging).
     [[nodiscard]] const File_location& get_file_location() const;
 
@@ -45,17 +50,26 @@ public:
     // Returns the name of the definition.
     [[nodiscard]] const std::string& get_name() const;
 
+    // Returns the symbol of the name of the definition.
+    [[nodiscard]] Symbol get_symbol() const;
+
     // Returns the type of the definition.
     [[nodiscard]] Def_type get_type() const;
 
+    // Removes all members beyond the first count members.  Takes no action if the definition has count or fewer
+    // members.
+    void truncate_members(size_t count);
+
 private:
     void check_member_type_(const Def_mem& member) const;
 
     Def_type m_def_type;
     const File_location m_loc;
     std::vector<Def_mem> m_members;
-    std::unordered_map<std::string, size_t> m_members_hash_map;
+    // Maps the symbol of each member's name to the index of the member.
+    std::unordered_map<Symbol, size_t> m_members_hash_map;
     std::string m_name;
+    Symbol m_symbol;
 };
 
 } // namespace c4lib::schema_parser
@@ -0,0 +1,248 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <include/exceptions.hpp>
+#include <include/node-type.hpp>
+#include <include/symbol.hpp>
+#include <initializer_list>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/schema-parser/def-mem.hpp>
+#include <lib/schema-parser/generated-reader.hpp>
+#include <lib/schema-parser/parser-phase-two.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cpt = c4lib::property_tree;
+namespace esp = c4lib::expression_parser;
+
+namespace c4lib::schema_parser {
+
+namespace {
+struct Registry {
+    std::mutex mutex;
+    std::vector<const Generated_reader*> readers;
+};
+
+// Readers register themselves during static initialization, so the registry is constructed on first use.
+Registry& get_registry()
+{
+    static Registry registry;
+    return registry;
+}
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void register_generated_reader(const Generated_reader& reader)
+{
+    Registry& registry{get_registry()};
+    const std::scoped_lock lock{registry.mutex};
+    registry.readers.push_back(&reader);
+}
+
+const Generated_reader* find_generated_reader(std::string_view hash)
+{
+    Registry& registry{get_registry()};
+    const std::scoped_lock lock{registry.mutex};
+    const auto it{std::ranges::find_if(
+        registry.readers, [hash](const Generated_reader* reader) { return std::string_view{reader->hash} == hash; })};
+    return it == registry.readers.end() ? nullptr : *it;
+}
+
+bool has_generated_readers()
+{
+    Registry& registry{get_registry()};
+    const std::scoped_lock lock{registry.mutex};
+    return !registry.readers.empty();
+}
+
+Generated_reader_runtime::Generated_reader_runtime(Parser_phase_two& parser)
+    : m_parser(parser), m_program(parser.m_program), m_variable_manager(parser.m_variable_manager)
+{}
+
+void Generated_reader_runtime::add_local(size_t slot, size_t token_index, int value)
+{
+    m_variable_manager.add_local(slot, m_parser.m_tokenizer.at(token_index).symbol, value);
+}
+
+size_t Generated_reader_runtime::add_array(size_t statement, size_t dimension)
+{
+    cpt::Emitted_node emitted_node{get_statement_(statement).prototype};
+    emitted_node.type = cpt::Node_type::array_type;
+    emitted_node.size = 0;
+    emitted_node.array_name = emitted_node.name;
+    emitted_node.enum_name = invalid_symbol;
+    const std::string array_subscript_string{std::format("[{}]", dimension)};
+    emitted_node.subscripts = array_subscript_string;
+    return m_parser.m_emitter.add_node(m_parser.m_parent, emitted_node);
+}
+
+size_t Generated_reader_runtime::add_array(
+    size_t parent, size_t statement, size_t index, size_t array_index, size_t dimension)
+{
+    const cpt::Emitted_node& prototype{get_statement_(statement).prototype};
+    cpt::Emitted_node emitted_node{prototype};
+    emitted_node.type = cpt::Node_type::array_type;
+    emitted_node.size = 0;
+    emitted_node.name = symbol_table::subscript(index);
+    emitted_node.array_name =
+        array_index == limits::invalid_size ? prototype.name : symbol_table::subscript(array_index);
+    emitted_node.enum_name = invalid_symbol;
+    const std::string array_subscript_string{std::format("[{}]", dimension)};
+    emitted_node.subscripts = array_subscript_string;
+    return m_parser.m_emitter.add_node(parent, emitted_node);
+}
+
+size_t Generated_reader_runtime::add_element(
+    size_t parent, size_t statement, size_t index, size_t array_index, const std::string& subscripts)
+{
+    const cpt::Emitted_node& prototype{get_statement_(statement).prototype};
+    cpt::Emitted_node emitted_node{prototype};
+    emitted_node.name = symbol_table::subscript(index);
+    emitted_node.array_name =
+        array_index == limits::invalid_size ? prototype.name : symbol_table::subscript(array_index);
+    emitted_node.subscripts = subscripts;
+    return m_parser.m_emitter.add_node(parent, emitted_node);
+}
+
+size_t Generated_reader_runtime::add_node(size_t statement)
+{
+    return m_parser.m_emitter.add_node(m_parser.m_parent, get_statement_(statement).prototype);
+}
+
+void Generated_reader_runtime::assert_true(int value, size_t token_index) const
+{
+    if (value == 0) {
+        throw make_ex<Parser_error>(fmt::assertion_failed, m_parser.m_tokenizer.at(token_index).get_loc());
+    }
+}
+
+size_t Generated_reader_runtime::begin_frame()
+{
+    return m_variable_manager.begin_frame();
+}
+
+void Generated_reader_runtime::check_bool(size_t statement, int64_t value) const
+{
+    m_parser.check_leaf_(get_statement_(statement), cpt::Node_type::bool_type, value);
+}
+
+void Generated_reader_runtime::check_enum(size_t statement, int64_t value) const
+{
+    m_parser.check_leaf_(get_statement_(statement), cpt::Node_type::enum_type, value);
+}
+
+void Generated_reader_runtime::end_frame(size_t frame)
+{
+    m_variable_manager.end_frame(frame);
+}
+
+std::string Generated_reader_runtime::format_subscript(const std::string& prefix, size_t index, Symbol enum_name) const
+{
+    if (enum_name != invalid_symbol) {
+        const Def_mem& enumerator{m_parser.m_definition_table.get_enumerator(enum_name, gsl::narrow<int>(index))};
+        return std::format("{}[{}:{}]", prefix, index, enumerator.name);
+    }
+    return std::format("{}[{}]", prefix, index);
+}
+
+int Generated_reader_runtime::get_captured_value(size_t statement, size_t suffix, size_t captured) const
+{
+    const Definition_statement& s{get_statement_(statement)};
+    const Token& node_name{s.array_suffixes.at(suffix).node_name};
+    const std::array keys{node_name.symbol, invalid_symbol};
+    const std::array subscripts{gsl::narrow<int>(captured)};
+    const size_t node{m_parser.m_emitter.find(m_parser.m_parent, keys, subscripts)};
+    if (node == limits::invalid_size) {
+        throw make_ex<Node_source_error>(fmt::node_source_error, s.identifier.get_loc(), s.identifier.value);
+    }
+    if (m_parser.m_emitter.get_type(node) != cpt::Node_type::int_type) {
+        throw make_ex<Parser_error>(fmt::referenced_node_not_int, node_name.get_loc(), std::format("[{}]", captured));
+    }
+    return gsl::narrow<int>(m_parser.m_emitter.get_value(node));
+}
+
+size_t Generated_reader_runtime::get_dimension(size_t statement, int value) const
+{
+    const size_t dimension{gsl::narrow<size_t>(value)};
+    if (dimension > limits::max_array_dimension) {
+        throw make_ex<Node_source_error>(
+            fmt::array_dimension_out_of_range, get_statement_(statement).identifier.get_loc(), dimension);
+    }
+    return dimension;
+}
+
+Symbol Generated_reader_runtime::get_enum_name(size_t statement, size_t suffix) const
+{
+    const std::string& enum_name{get_statement_(statement).array_suffixes.at(suffix).enum_name};
+    return enum_name.empty() ? invalid_symbol : symbol_table::intern(enum_name);
+}
+
+int Generated_reader_runtime::get_enumerator(size_t expression, size_t reference) const
+{
+    const esp::Enumerator_reference& r{m_program.expressions.at(expression).enumerator_references.at(reference)};
+    return m_variable_manager.get_enumerator(r.enum_name, r.enumerator);
+}
+
+int Generated_reader_runtime::get_footer_bytes_count() const
+{
+    return gsl::narrow<int>(m_parser.m_node_reader.get_undocumented_footer_bytes_count());
+}
+
+int Generated_reader_runtime::get_node(size_t expression, size_t reference, std::initializer_list<int> subscripts)
+{
+    const esp::Node_reference& r{m_program.expressions.at(expression).node_references.at(reference)};
+    return m_variable_manager.get(r, std::span{subscripts.begin(), subscripts.size()});
+}
+
+int Generated_reader_runtime::get_variable(size_t expression, size_t operation)
+{
+    return m_variable_manager.get(m_program.expressions.at(expression).operations.at(operation).symbol);
+}
+
+void Generated_reader_runtime::pop_scope()
+{
+    m_variable_manager.pop();
+    --m_parser.m_scope_depth;
+}
+
+void Generated_reader_runtime::push_scope()
+{
+    m_variable_manager.push();
+    ++m_parser.m_scope_depth;
+}
+
+int64_t Generated_reader_runtime::read_node(size_t node)
+{
+    return m_parser.m_emitter.read_node(node, m_parser.m_node_reader);
+}
+
+void Generated_reader_runtime::set_variable(size_t token_index, int value)
+{
+    m_variable_manager.set(m_parser.m_tokenizer.at(token_index).symbol, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const Definition_statement& Generated_reader_runtime::get_statement_(size_t statement) const
+{
+    return m_program.statements.at(statement);
+}
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,188 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <include/symbol.hpp>
+#include <initializer_list>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/schema-parser/parser-phase-two.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/variable-manager/variable-manager.hpp>
+#include <string>
+#include <string_view>
+
+namespace c4lib::schema_parser {
+
+class Generated_reader_runtime;
+
+// A reader generated by Reader_generator from a compiled program.  The reader does the work of Parser_phase_two for
+// that program with straight-line code: routines are functions, expressions are C++ expressions and arrays are loops.
+// It refers to the program's statements and expressions by index, so it may be run only against a program whose hash
+// is the reader's hash.
+struct Generated_reader {
+    // Hash of the program from which the reader was generated.  See Reader_generator::get_hash.
+    const char* hash{nullptr};
+    // Emits the nodes of the program's root statement.
+    void (*read)(Generated_reader_runtime& runtime){nullptr};
+};
+
+// Registers reader, making it available to find_generated_reader.  Generated sources register their reader during
+// static initialization; reader must remain valid for the lifetime of the process.
+void register_generated_reader(const Generated_reader& reader);
+
+// Returns the reader registered for hash or nullptr if there is none.
+[[nodiscard]] const Generated_reader* find_generated_reader(std::string_view hash);
+
+// Returns true if any reader has been registered.
+[[nodiscard]] bool has_generated_readers();
+
+// Services used by generated readers.  Each operation corresponds to a step taken by Parser_phase_two and
+// Generative_node_source, on whose state the runtime operates, so that a generated reader emits the same nodes and
+// throws the same errors as the phase two parser.  Statements, expressions and tokens are identified by their indices
+// within the program and the tokenizer.
+class Generated_reader_runtime {
+public:
+    explicit Generated_reader_runtime(Parser_phase_two& parser);
+
+    ~Generated_reader_runtime() = default;
+
+    Generated_reader_runtime(const Generated_reader_runtime&) = delete;
+
+    Generated_reader_runtime& operator=(const Generated_reader_runtime&) = delete;
+
+    Generated_reader_runtime(Generated_reader_runtime&&) noexcept = delete;
+
+    Generated_reader_runtime& operator=(Generated_reader_runtime&&) noexcept = delete;
+
+    // Makes parent the node to which nodes are added and relative to which node references are resolved while a
+    // routine is run for parent.
+    class Parent_scope {
+    public:
+        Parent_scope(Generated_reader_runtime& runtime, size_t parent)
+            : m_old_parent(runtime.m_parser.m_parent), m_runtime(runtime)
+        {
+            runtime.m_parser.m_parent = parent;
+        }
+
+        ~Parent_scope()
+        {
+            m_runtime.m_parser.m_parent = m_old_parent;
+        }
+
+        Parent_scope(const Parent_scope&) = delete;
+
+        Parent_scope& operator=(const Parent_scope&) = delete;
+
+        Parent_scope(Parent_scope&&) noexcept = delete;
+
+        Parent_scope& operator=(Parent_scope&&) noexcept = delete;
+
+    private:
+        size_t m_old_parent{property_tree::Node_emitter::root};
+        Generated_reader_runtime& m_runtime;
+    };
+
+    // Adds a variable of the routine being run.  See Variable_manager::add_local.
+    void add_local(size_t slot, size_t token_index, int value);
+
+    // Adds the array node of statement, which has dimension elements, to the current parent.
+    size_t add_array(size_t statement, size_t dimension);
+
+    // Adds the element at index of the array node parent, the element being itself an array with dimension elements.
+    // array_index is the index of parent within its own array or limits::invalid_size if parent is the array node of
+    // statement.
+    size_t add_array(size_t parent, size_t statement, size_t index, size_t array_index, size_t dimension);
+
+    // As above for an element which is a leaf or struct, whose subscripts are subscripts, e.g., [2][3:YIELD_FOOD].
+    size_t add_element(size_t parent,
+        size_t statement,
+        size_t index,
+        size_t array_index,
+        const std::string& subscripts);
+
+    // Adds the node of statement, which isn't an array, to the current parent.
+    size_t add_node(size_t statement);
+
+    // Throws if value, the value of the expression of an assert, is zero.
+    void assert_true(int value, size_t token_index) const;
+
+    // Begins the frame of a routine.  See Variable_manager::begin_frame.
+    [[nodiscard]] size_t begin_frame();
+
+    // Throws if value, read for a leaf of statement, isn't a valid bool.
+    void check_bool(size_t statement, int64_t value) const;
+
+    // Throws if value, read for a leaf of statement, isn't a value of the statement's enum.
+    void check_enum(size_t statement, int64_t value) const;
+
+    // Ends the frame begun by begin_frame.
+    void end_frame(size_t frame);
+
+    // Returns prefix followed by the subscript for index, naming the enumerator of enum_name for index unless
+    // enum_name is invalid_symbol, e.g., [2][3:YIELD_FOOD].
+    [[nodiscard]] std::string format_subscript(const std::string& prefix, size_t index, Symbol enum_name) const;
+
+    // Returns the value of the element at captured of the node named by the use_capture suffix at suffix of statement.
+    [[nodiscard]] int get_captured_value(size_t statement, size_t suffix, size_t captured) const;
+
+    // Returns the dimension of an array of statement given value, the value of its array suffix.
+    [[nodiscard]] size_t get_dimension(size_t statement, int value) const;
+
+    // Returns the symbol of the enum bound to the array suffix at suffix of statement or invalid_symbol.
+    [[nodiscard]] Symbol get_enum_name(size_t statement, size_t suffix) const;
+
+    // Returns the value of the enumerator referenced at reference within expression.
+    [[nodiscard]] int get_enumerator(size_t expression, size_t reference) const;
+
+    [[nodiscard]] int get_footer_bytes_count() const;
+
+    [[nodiscard]] int get_local(size_t slot) const
+    {
+        return m_variable_manager.get_local(slot);
+    }
+
+    // Returns the value of the node referenced at reference within expression.
+    [[nodiscard]] int get_node(size_t expression, size_t reference, std::initializer_list<int> subscripts);
+
+    // Returns the value of the variable named by the operation at operation within expression.
+    [[nodiscard]] int get_variable(size_t expression, size_t operation);
+
+    // Operators && and || evaluate both of their operands, as does the phase two parser.
+    [[nodiscard]] static int logical_and(int left, int right)
+    {
+        return static_cast<int>(left != 0 && right != 0);
+    }
+
+    [[nodiscard]] static int logical_or(int left, int right)
+    {
+        return static_cast<int>(left != 0 || right != 0);
+    }
+
+    void pop_scope();
+
+    void push_scope();
+
+    // Reads the data of node and returns its value.
+    int64_t read_node(size_t node);
+
+    void set_local(size_t slot, int value)
+    {
+        m_variable_manager.set_local(slot, value);
+    }
+
+    // Sets the variable, of another routine, named by the token at token_index.
+    void set_variable(size_t token_index, int value);
+
+private:
+    [[nodiscard]] const Definition_statement& get_statement_(size_t statement) const;
+
+    Parser_phase_two& m_parser;
+    const Program& m_program;
+    Variable_manager& m_variable_manager;
+};
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,40 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <array>
+#include <cstddef>
+#include <lib/schema-parser/opcode.hpp>
+#include <string>
+#include <utility>
+
+namespace csp = c4lib::schema_parser;
+
+namespace {
+
+// Note: The lookup table below using name-value pairs allows for bidirectional
+// lookup, that is enumerator-to-string as well as string-to-enumerator.
+const std::array opcode_names{
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::invalid, "invalid"},
+
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::add_variable, "add_variable"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::assert_true, "assert_true"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::branch_if_false, "branch_if_false"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::emit, "emit"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::jump, "jump"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::pop_scope, "pop_scope"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::push_scope, "push_scope"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::ret, "ret"},
+    std::pair<csp::Opcode, const std::string>{csp::Opcode::set_variable, "set_variable"},
+};
+
+} // namespace
+
+namespace c4lib::schema_parser {
+const std::string& to_string(Opcode opcode)
+{
+    const size_t index{static_cast<size_t>(opcode)};
+    return opcode_names.at(index).second;
+}
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,56 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <string>
+
+namespace c4lib::schema_parser {
+
+// Operation codes for instructions generated by the schema compiler and executed by the phase two parser.
+// NOLINTNEXTLINE(readability-enum-initial-value)
+enum class Opcode {
+    // N.B.: Opcode is iterable.  For this to work, the first enumerator must have value 0,
+    // each succeeding enumerator must increment the previous value by 1, and the helper enumerators
+    // "count", "begin" and "end" must not be removed.
+
+    // Invalid value indicative of error.
+    invalid = 0,
+
+    // Evaluates the expression and adds the result to the current scope as a new variable.
+    add_variable,
+
+    // Evaluates the expression and throws if the result is zero.
+    assert_true,
+
+    // Evaluates the expression and jumps to the target if the result is zero.
+    branch_if_false,
+
+    // Emits and reads the nodes for a definition statement.
+    emit,
+
+    // Jumps unconditionally to the target.
+    jump,
+
+    // Pops the current variable scope.
+    pop_scope,
+
+    // Pushes a new variable scope.
+    push_scope,
+
+    // Returns from the routine for a struct or template body.
+    ret,
+
+    // Evaluates the expression and sets the value of an existing variable to the result.
+    set_variable,
+
+    // Helper enumerators used for iteration - do not remove
+    count,
+    begin = 0,
+    end = count - 1,
+};
+
+const std::string& to_string(Opcode opcode);
+
+} // namespace c4lib::schema_parser
@@ -66,11 +66,11 @@ void Parser_phase_one::parse()
 
     if (!pr_schema_()) {
         const Token& token{m_tokenizer.peek()};
-        throw make_ex<Parser_error>(fmt::syntax_error, token.loc, to_string(token.type));
+        throw make_ex<Parser_error>(fmt::syntax_error, token.get_loc(), to_string(token.type));
     }
 
-    m_importer.import_definitions(
-        m_definition_table, m_install_root, m_custom_assets_path, m_mod_name, m_use_modular_loading);
+    m_importer.import_definitions(m_definition_table, m_install_root, m_custom_assets_path, m_mod_name,
+        m_use_modular_loading, m_import_worker_count);
     tidy_definitions_();
 
     // Check that vector resizing is minimized
@@ -84,18 +84,18 @@ void Parser_phase_one::parse()
 void Parser_phase_one::add_alias_definition_(const Token& template_token, const Token& alias_token) const
 {
     bool was_created{false};
-    Definition& alias_definition{
-        m_definition_table.create_definition(alias_token.value, Def_type::alias_type, alias_token.loc, was_created)};
+    Definition& alias_definition{m_definition_table.create_definition(
+        alias_token.value, Def_type::alias_type, alias_token.get_loc(), was_created)};
     if (!was_created) {
         // If an alias_definition exists for the token name, it's an error.
-        throw make_ex<Parser_error>(fmt::duplicated_name, alias_token.loc, alias_token.value);
+        throw make_ex<Parser_error>(fmt::duplicated_name, alias_token.get_loc(), alias_token.value);
     }
 
     // Get the corresponding template definition's first alias_member and the corresponding template index.
     // We store the template index in the alias definition to facilitate lookup of the template.
     const Def_mem& template_member{m_definition_table.get_first_member(template_token.value, Def_type::template_type)};
     const int template_index{template_member.value};
-    Def_mem alias_member{Def_mem_type::alias_type, template_token.value, template_index, template_token.loc};
+    Def_mem alias_member{Def_mem_type::alias_type, template_token.value, template_index, template_token.get_loc()};
     alias_definition.add_member(alias_member, false, false);
 }
 
@@ -105,16 +105,16 @@ void Parser_phase_one::add_const_definition_(const Token& token, int value) cons
     // we call add_member below.
     bool was_created{false};
     Definition& definition{
-        m_definition_table.create_definition(token.value, Def_type::const_type, token.loc, was_created)};
-    Def_mem member{Def_mem_type::const_type, token.value, value, token.loc};
+        m_definition_table.create_definition(token.value, Def_type::const_type, token.get_loc(), was_created)};
+    Def_mem member{Def_mem_type::const_type, token.value, value, token.get_loc()};
     definition.add_member(member, false, false);
 }
 
 void Parser_phase_one::add_enumerator_definition_(const Token& token) const
 {
     bool was_created{false};
-    Definition& definition{
-        m_definition_table.create_definition(m_enum_name_token->value, Def_type::enum_type, token.loc, was_created)};
+    Definition& definition{m_definition_table.create_definition(
+        m_enum_name_token->value, Def_type::enum_type, token.get_loc(), was_created)};
     int value{0};
     if (!was_created) {
         // The value of the enumerator is one more than the value of the enumerator last added.
@@ -122,7 +122,7 @@ void Parser_phase_one::add_enumerator_definition_(const Token& token) const
         const size_t index{members.size() - 1};
         value = members.at(index).value + 1;
     }
-    Def_mem member(Def_mem_type::enum_type, token.value, value, token.loc);
+    Def_mem member(Def_mem_type::enum_type, token.value, value, token.get_loc());
     definition.add_member(member, false, false);
 }
 
@@ -131,9 +131,9 @@ void Parser_phase_one::add_enumerator_definition_(const Token& token, int value)
     // Note: was_created is unused.  If the definition already exists, the appropriate exception will be thrown when
     // we call add_member below.
     bool was_created{false};
-    Definition& definition{
-        m_definition_table.create_definition(m_enum_name_token->value, Def_type::enum_type, token.loc, was_created)};
-    Def_mem member{Def_mem_type::enum_type, token.value, value, token.loc};
+    Definition& definition{m_definition_table.create_definition(
+        m_enum_name_token->value, Def_type::enum_type, token.get_loc(), was_created)};
+    Def_mem member{Def_mem_type::enum_type, token.value, value, token.get_loc()};
     definition.add_member(member, false, false);
 }
 
@@ -167,14 +167,15 @@ void Parser_phase_one::add_struct_definition_(const Token& token) const
 {
     bool was_created{false};
     Definition& definition{
-        m_definition_table.create_definition(token.value, Def_type::struct_type, token.loc, was_created)};
+        m_definition_table.create_definition(token.value, Def_type::struct_type, token.get_loc(), was_created)};
     if (!was_created) {
         // If a definition exists for the token name, it's an error.
-        throw make_ex<Parser_error>(fmt::duplicated_name, token.loc, token.value);
+        throw make_ex<Parser_error>(fmt::duplicated_name, token.get_loc(), token.value);
     }
     // token.index corresponds to the name of the struct.  The definition begins one token later,
     // at the open-brace.  Add one to token.index to reflect this.
-    Def_mem member{Def_mem_type::struct_type, constants::index_member, gsl::narrow<int>(token.index + 1), token.loc};
+    Def_mem member{
+        Def_mem_type::struct_type, constants::index_member, gsl::narrow<int>(token.index + 1), token.get_loc()};
     definition.add_member(member, false, false);
 }
 
@@ -182,14 +183,15 @@ void Parser_phase_one::add_template_definition_(const Token& token) const
 {
     bool was_created{false};
     Definition& definition{
-        m_definition_table.create_definition(token.value, Def_type::template_type, token.loc, was_created)};
+        m_definition_table.create_definition(token.value, Def_type::template_type, token.get_loc(), was_created)};
     if (!was_created) {
         // If a definition exists for the token name, it's an error.
-        throw make_ex<Parser_error>(fmt::duplicated_name, token.loc, token.value);
+        throw make_ex<Parser_error>(fmt::duplicated_name, token.get_loc(), token.value);
     }
     // token.index corresponds to the name of the template.  Add one to token.index
     // to skip past the name and point at the bracketed typename, <T>.
-    Def_mem member{Def_mem_type::template_type, constants::index_member, gsl::narrow<int>(token.index + 1), token.loc};
+    Def_mem member{
+        Def_mem_type::template_type, constants::index_member, gsl::narrow<int>(token.index + 1), token.get_loc()};
     definition.add_member(member, false, false);
 }
 
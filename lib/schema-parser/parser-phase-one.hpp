@@ -13,6 +13,7 @@
 #include <lib/schema-parser/tokenizer.hpp>
 #include <lib/variable-manager/variable-manager.hpp>
 #include <string>
+#include <vector>
 
 namespace c4lib::schema_parser {
 
@@ -38,6 +39,18 @@ public:
 
     Parser_phase_one& operator=(Parser_phase_one&&) noexcept = delete;
 
+    // Returns the search paths used to locate the XML files from which definitions were imported.
+    [[nodiscard]] const std::vector<native::Path>& get_import_search_paths() const
+    {
+        return m_importer.get_search_paths();
+    }
+
+    // Sets the number of threads used to import definitions.  Defaults to 1.
+    void set_import_worker_count(size_t worker_count)
+    {
+        m_import_worker_count = worker_count;
+    }
+
     // The phase one parser does the following:
     //      * Builds the definition tables
     //      * Imports enums and consts
@@ -167,6 +180,7 @@ private:
     Def_tbl& m_definition_table;
     const Token* m_enum_name_token{nullptr};
     expression_parser::Parser m_expression_parser;
+    size_t m_import_worker_count{1};
     Importer m_importer;
     const native::Path m_install_root;
     const std::string m_mod_name;
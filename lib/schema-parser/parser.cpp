@@ -2,7 +2,7 @@
 // This software is licensed under the MIT License.
 // Created by Hankinsohl on 10/4/2024.
 
-#include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
 #include <format>
 #include <include/exceptions.hpp>
 #include <include/logger.hpp>
@@ -12,12 +12,16 @@
 #include <lib/io/io.hpp>
 #include <lib/logger/log-formats.hpp>
 #include <lib/native/path.hpp>
-#include <lib/ptree/debug.hpp>
+#include <lib/ptree/node-emitter.hpp>
 #include <lib/ptree/node-reader.hpp>
 #include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/generated-reader.hpp>
 #include <lib/schema-parser/parser-phase-one.hpp>
 #include <lib/schema-parser/parser-phase-two.hpp>
 #include <lib/schema-parser/parser.hpp>
+#include <lib/schema-parser/reader-generator.hpp>
+#include <lib/schema-parser/schema-cache.hpp>
+#include <lib/schema-parser/schema-compiler.hpp>
 #include <lib/schema-parser/token-type.hpp>
 #include <lib/schema-parser/token.hpp>
 #include <lib/util/constants.hpp>
@@ -26,11 +30,11 @@
 #include <lib/util/options.hpp>
 #include <lib/util/timer.hpp>
 #include <lib/variable-manager/variable-manager.hpp>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
 
-namespace bpt = boost::property_tree;
 namespace cpt = c4lib::property_tree;
 namespace esp = c4lib::expression_parser;
 
@@ -49,10 +53,60 @@ void Parser::parse(const native::Path& schema,
     const native::Path& custom_assets_path,
     const std::string& mod_name,
     bool use_modular_loading,
-    bpt::ptree& ptree_root,
+    cpt::Node_emitter& emitter,
     const native::Path& filename,
     cpt::Node_reader& node_reader,
     std::unordered_map<std::string, std::string>& options)
+{
+    prepare(schema, install_root, custom_assets_path, mod_name, use_modular_loading, options);
+    parse_save(emitter, filename, node_reader, options);
+}
+
+void Parser::parse_save(cpt::Node_emitter& emitter,
+    const native::Path& filename,
+    cpt::Node_reader& node_reader,
+    std::unordered_map<std::string, std::string>& options)
+{
+    if (!m_is_prepared) {
+        throw Parser_error{fmt::parser_not_prepared};
+    }
+
+    // Discard definitions created while reading the previous save, e.g., PlayerTypes.
+    m_definition_table.rollback();
+
+    m_options = &options;
+    m_emitter = &emitter;
+    m_node_reader = &node_reader;
+    m_node_reader->init(filename, &m_definition_table, options);
+
+    Parser_phase_two p2_parser(
+        m_tokenizer, m_definition_table, m_program, m_variable_manager, *m_emitter, *m_node_reader, *m_options);
+    try {
+        Logger::info(std::format(c4lib::fmt::calling, "Parser_phase_two::parse"));
+        Timer timer;
+        timer.start();
+        if (m_generated_reader != nullptr) {
+            p2_parser.parse(*m_generated_reader);
+        }
+        else {
+            p2_parser.parse();
+        }
+        Logger::info(std::format(fmt::finished_in, "Parser_phase_two::parse", timer.to_string()));
+    }
+    catch (...) {
+        const std::string path{
+            io::make_path(options[options::debug_output_dir], filename, constants::crash_dump_extension)};
+        m_emitter->dump(path);
+        throw;
+    }
+}
+
+void Parser::prepare(const native::Path& schema,
+    const native::Path& install_root,
+    const native::Path& custom_assets_path,
+    const std::string& mod_name,
+    bool use_modular_loading,
+    std::unordered_map<std::string, std::string>& options)
 {
     reset();
 
@@ -62,18 +116,59 @@ void Parser::parse(const native::Path& schema,
     m_mod_name = mod_name;
     m_use_modular_loading = use_modular_loading;
     m_options = &options;
-    m_ptree_root = &ptree_root;
-    m_node_reader = &node_reader;
-    m_node_reader->init(filename, &m_definition_table, options);
 
-    Parser_phase_one p1_parser(m_schema, m_install_root, m_custom_assets_path, m_mod_name, m_use_modular_loading,
-        m_tokenizer, m_definition_table, m_root_name_index, m_variable_manager);
-    Logger::info(std::format(c4lib::fmt::calling, "Parser_phase_one::parse"));
+    // If a schema cache is in use and holds a valid entry, phase one parsing and schema compilation are skipped.
+    const std::string& cache_dir{options[options::schema_cache_dir]};
+    std::unique_ptr<Schema_cache> cache;
+    if (!cache_dir.empty()) {
+        cache = std::make_unique<Schema_cache>(native::Path{cache_dir}, m_schema, m_install_root,
+            m_custom_assets_path, m_mod_name, m_use_modular_loading);
+    }
     Timer timer;
-    timer.start();
-    ;
-    p1_parser.parse();
-    Logger::info(std::format(fmt::finished_in, "Parser_phase_one::parse", timer.to_string()));
+    bool is_cached{false};
+    if (cache) {
+        Logger::info(std::format(c4lib::fmt::calling, "Schema_cache::load"));
+        timer.start();
+        is_cached = cache->load(m_tokenizer, m_definition_table, m_program, m_root_name_index);
+        if (is_cached) {
+            Schema_compiler::build_prototypes(m_program);
+        }
+        Logger::info(std::format(fmt::finished_in, "Schema_cache::load", timer.to_string()));
+    }
+
+    if (!is_cached) {
+        Parser_phase_one p1_parser(m_schema, m_install_root, m_custom_assets_path, m_mod_name, m_use_modular_loading,
+            m_tokenizer, m_definition_table, m_root_name_index, m_variable_manager);
+        p1_parser.set_import_worker_count(
+            c4lib::options::get_worker_count(options, c4lib::options::import_worker_count));
+        Logger::info(std::format(c4lib::fmt::calling, "Parser_phase_one::parse"));
+        timer.start();
+        p1_parser.parse();
+        Logger::info(std::format(fmt::finished_in, "Parser_phase_one::parse", timer.to_string()));
+
+        Schema_compiler compiler(m_tokenizer, m_definition_table);
+        Logger::info(std::format(c4lib::fmt::calling, "Schema_compiler::compile"));
+        timer.start();
+        compiler.compile(m_root_name_index, m_program);
+        Logger::info(std::format(fmt::finished_in, "Schema_compiler::compile", timer.to_string()));
+
+        if (cache) {
+            cache->save(
+                m_tokenizer, m_definition_table, m_program, m_root_name_index, p1_parser.get_import_search_paths());
+        }
+    }
+
+    // Select the reader generated for the program, if any.  The hash is computed only if a reader has been registered.
+    if (has_generated_readers()) {
+        const Reader_generator generator{m_program};
+        m_generated_reader = find_generated_reader(generator.get_hash());
+        if (m_generated_reader != nullptr) {
+            Logger::info(std::format(fmt::generated_reader_found, generator.get_hash()));
+        }
+        else {
+            Logger::info(std::format(fmt::generated_reader_not_found, generator.get_hash()));
+        }
+    }
 
     if (options[options::debug_write_imports] == "1") {
         const native::Path const_definitions_filename{io::make_path(options[options::debug_output_dir],
@@ -85,31 +180,44 @@ void Parser::parse(const native::Path& schema,
         export_definitions_(Def_type::enum_type, enum_definitions_filename);
     }
 
-    Parser_phase_two p2_parser(m_tokenizer, m_definition_table, m_root_name_index, m_variable_manager, *m_ptree_root,
-        *m_node_reader, *m_options);
-    try {
-        Logger::info(std::format(c4lib::fmt::calling, "Parser_phase_two::parse"));
-        timer.start();
-        ;
-        p2_parser.parse();
-        Logger::info(std::format(fmt::finished_in, "Parser_phase_two::parse", timer.to_string()));
-    }
-    catch (...) {
-        const std::string path{
-            io::make_path(options[options::debug_output_dir], filename, constants::crash_dump_extension)};
-        cpt::dump_ptree(path, *m_ptree_root);
-        throw;
+    // Record the state of the definition table so that definitions created while reading a save can be discarded
+    // before the next save is read.
+    m_definition_table.checkpoint();
+    m_is_prepared = true;
+}
+
+void Parser::prepare(const Parser& prepared)
+{
+    if (!prepared.m_is_prepared) {
+        throw Parser_error{fmt::parser_not_prepared};
     }
+
+    reset();
+
+    m_schema = prepared.m_schema;
+    m_install_root = prepared.m_install_root;
+    m_custom_assets_path = prepared.m_custom_assets_path;
+    m_mod_name = prepared.m_mod_name;
+    m_use_modular_loading = prepared.m_use_modular_loading;
+    m_tokenizer.set_tokens(prepared.m_tokenizer.get_tokens());
+    m_definition_table.copy_from(prepared.m_definition_table);
+    m_generated_reader = prepared.m_generated_reader;
+    m_program = prepared.m_program;
+    m_root_name_index = prepared.m_root_name_index;
+    m_is_prepared = true;
 }
 
 void Parser::reset()
 {
     m_custom_assets_path.clear();
     m_definition_table.reset();
+    m_emitter = nullptr;
+    m_generated_reader = nullptr;
     m_install_root.clear();
+    m_is_prepared = false;
     m_mod_name = "";
-    m_ptree_root = nullptr;
     m_node_reader = nullptr;
+    m_program.clear();
     m_root_name_index = limits::invalid_size;
     m_schema.clear();
     m_tokenizer.reset();
@@ -142,7 +250,8 @@ void Parser::skip_past_enclosed_tokens(Tokenizer& tokenizer, Token_type punc)
     while (current_nest == 0) {
         const Token& t{tokenizer.next()};
         if (t.type == close_punctuation || t.type == Token_type::meta_eos) {
-            throw make_ex<Parser_error>(fmt::parser_skip_error, t.loc, to_string(open_punctuation), to_string(t.type));
+            throw make_ex<Parser_error>(
+                fmt::parser_skip_error, t.get_loc(), to_string(open_punctuation), to_string(t.type));
         }
         else if (t.type == open_punctuation) {
             current_nest = 1;
@@ -158,7 +267,8 @@ void Parser::skip_past_enclosed_tokens(Tokenizer& tokenizer, Token_type punc)
             ++current_nest;
         }
         else if (t.type == Token_type::meta_eos) {
-            throw make_ex<Parser_error>(fmt::parser_skip_error, t.loc, to_string(open_punctuation), to_string(t.type));
+            throw make_ex<Parser_error>(
+                fmt::parser_skip_error, t.get_loc(), to_string(open_punctuation), to_string(t.type));
         }
     }
 }
@@ -4,13 +4,14 @@
 
 #pragma once
 
-#include <boost/property_tree/ptree_fwd.hpp>
 #include <cstddef>
 #include <lib/expression-parser/parser.hpp>
 #include <lib/native/path.hpp>
+#include <lib/ptree/node-emitter.hpp>
 #include <lib/ptree/node-reader.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
 #include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/program.hpp>
 #include <lib/schema-parser/token-type.hpp>
 #include <lib/schema-parser/tokenizer.hpp>
 #include <lib/util/limits.hpp>
@@ -20,6 +21,8 @@
 
 namespace c4lib::schema_parser {
 
+struct Generated_reader;
+
 class Parser {
 public:
     Parser();
@@ -34,19 +37,42 @@ public:
 
     Parser& operator=(Parser&&) noexcept = delete;
 
+    // Returns the definition table.  Definitions created while reading the most recent save, e.g., PlayerTypes, are
+    // included.
+    [[nodiscard]] const Def_tbl& get_definition_table() const
+    {
+        return m_definition_table;
+    }
+
+    // Returns the program compiled from the schema by prepare.
+    [[nodiscard]] const Program& get_program() const
+    {
+        return m_program;
+    }
+
     // Parses the token vector, consuming import blocks, constant definitions, enumeration definitions, structure
     // definitions and template definitions.  Consumed tokens are marked as such but are left in the token vector.
     // Creates an entry in the definition table for each constant, enumeration, structure and template.  When an error
     // is detected, throws ParserException.
     //
     // When importing enums and consts, uses install_root, custom_assets_dir and mod_name to locate the XML files
-    // for import.
+    // for import.  Equivalent to calling prepare followed by parse_save.
     void parse(const native::Path& schema,
         const native::Path& install_root,
         const native::Path& custom_assets_path,
         const std::string& mod_name,
         bool use_modular_loading,
-        boost::property_tree::ptree& ptree_root,
+        c4lib::property_tree::Node_emitter& emitter,
+        const native::Path& filename,
+        c4lib::property_tree::Node_reader& node_reader,
+        std::unordered_map<std::string, std::string>& options);
+
+    // Reads a save using the schema and definitions established by a prior call to prepare.  Definitions created
+    // while reading a previous save are discarded first.  parse_save may be called any number of times following
+    // a call to prepare.  The nodes of the save are passed to emitter.  If prepare found a reader generated for the
+    // compiled program, the reader is run; otherwise the program is interpreted.  Throws Parser_error if prepare has
+    // not been called.
+    void parse_save(c4lib::property_tree::Node_emitter& emitter,
         const native::Path& filename,
         c4lib::property_tree::Node_reader& node_reader,
         std::unordered_map<std::string, std::string>& options);
@@ -54,6 +80,23 @@ public:
     static bool parse_expression(
         c4lib::expression_parser::Parser& parser, Tokenizer& tokenizer, Variable_manager& variable_manager, int& value);
 
+    // Performs the save-independent portion of parsing: phase one parsing of the schema, import of definitions and
+    // compilation of the schema, or, if a schema cache is in use, loading of these from the cache.  If a reader has
+    // been generated for the compiled program, i.e., one with the program's hash has been registered, it is selected.
+    // Following prepare, parse_save may be used to read one or more saves.
+    void prepare(const native::Path& schema,
+        const native::Path& install_root,
+        const native::Path& custom_assets_path,
+        const std::string& mod_name,
+        bool use_modular_loading,
+        std::unordered_map<std::string, std::string>& options);
+
+    // Prepares the parser by copying the state established by a prior call to prepare on another parser, avoiding
+    // the cost of parsing the schema and importing definitions again.  Since parse_save modifies the token stream and
+    // definition table, each thread reading saves concurrently requires its own parser; this method allows such
+    // parsers to be created from a single prepared parser.  Throws Parser_error if prepared has not been prepared.
+    void prepare(const Parser& prepared);
+
     // Resets the parser returning it to the state of a newly created parser.
     void reset();
 
@@ -64,11 +107,15 @@ private:
 
     native::Path m_custom_assets_path;
     Def_tbl m_definition_table;
+    c4lib::property_tree::Node_emitter* m_emitter{nullptr};
+    // Reader generated for m_program or nullptr if the program is interpreted.
+    const Generated_reader* m_generated_reader{nullptr};
     native::Path m_install_root;
+    bool m_is_prepared{false};
     std::string m_mod_name;
     c4lib::property_tree::Node_reader* m_node_reader{nullptr};
     std::unordered_map<std::string, std::string>* m_options{nullptr};
-    boost::property_tree::ptree* m_ptree_root{nullptr};
+    Program m_program;
     size_t m_root_name_index{limits::invalid_size};
     native::Path m_schema;
     Tokenizer m_tokenizer;
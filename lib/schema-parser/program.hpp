@@ -0,0 +1,92 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/schema-parser/opcode.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/util/limits.hpp>
+#include <string>
+#include <vector>
+
+namespace c4lib::schema_parser {
+
+// Compiled form of a single array suffix, e.g., [NUM_PROJECT_TYPES:ProjectTypes:capture_index].
+struct Array_suffix {
+    enum class Kind { standard, query_reader, use_capture };
+
+    Kind kind{Kind::standard};
+    // Index into Program::expressions of the dimension expression.  Used by standard suffixes only.
+    size_t expression{limits::invalid_size};
+    // Name of the enum bound to the dimension or empty if no enum is bound.
+    std::string enum_name;
+    // True if the dimension index is captured for use by a subsequent use_capture suffix.
+    bool is_capture{false};
+    // Node referenced by a use_capture suffix.
+    Token node_name;
+};
+
+// Compiled form of a definition statement, e.g., "int32[Length] Data".
+struct Definition_statement {
+    // Type of the statement.  Within an instantiated template the typename is replaced by the instantiating type.
+    Token type;
+    Token identifier;
+    // Array suffixes in the order in which they appear in the schema.  Empty if the statement isn't an array.
+    std::vector<Array_suffix> array_suffixes;
+    // Index into Program::routines of the routine used to read the body of a struct or template.  Set to
+    // limits::invalid_size for non-aggregate types.
+    size_t routine{limits::invalid_size};
+    // Attributes of the node emitted by the statement or, for an array, of each of its elements other than the
+    // element's name, array name and subscripts.  The phase two parser emits the node of a statement which isn't an
+    // array by passing its prototype to the emitter.  Set by Schema_compiler::build_prototypes.
+    property_tree::Emitted_node prototype;
+};
+
+struct Instruction {
+    Opcode opcode{Opcode::invalid};
+    // Index of the token used for error reporting.  For add_variable and set_variable this is the index of the
+    // variable's identifier token.
+    size_t token_index{limits::invalid_size};
+    // Index into Program::expressions of the expression evaluated by add_variable, assert_true, branch_if_false and
+    // set_variable.
+    size_t expression{limits::invalid_size};
+    // For emit, the index into Program::statements.  For jump and branch_if_false, the target program counter.  For
+    // add_variable and set_variable, the variable's slot within the frame of the routine or limits::invalid_size if
+    // set_variable names a variable of another routine.
+    size_t operand{limits::invalid_size};
+};
+
+// A program is the compiled form of the schema.  Each struct definition and each template instantiation reachable
+// from the root structure is compiled into a routine: a run of instructions ending in Opcode::ret.  All routines
+// share a single flat instruction vector.  Each expression in the schema is compiled once, along with the program, and
+// instructions and array suffixes refer to the compiled expressions by index.  The phase two parser evaluates the
+// compiled form against the current ptree.
+struct Program {
+    std::vector<Instruction> instructions;
+    // Compiled expressions.  An expression shared by several routines, e.g., by each instantiation of a template, is
+    // compiled once.
+    std::vector<expression_parser::Expression> expressions;
+    // Program counter of the first instruction of each routine.
+    std::vector<size_t> routines;
+    std::vector<Definition_statement> statements;
+    // Index into statements of the fabricated statement which emits the root structure.
+    size_t root_statement{limits::invalid_size};
+    // Number of node references assigned a slot in the variable manager's node cache.
+    size_t node_reference_count{0};
+
+    void clear()
+    {
+        instructions.clear();
+        expressions.clear();
+        routines.clear();
+        statements.clear();
+        root_statement = limits::invalid_size;
+        node_reference_count = 0;
+    }
+};
+
+} // namespace c4lib::schema_parser
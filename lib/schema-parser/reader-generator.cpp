@@ -0,0 +1,504 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <include/node-type.hpp>
+#include <ios>
+#include <iosfwd>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/md5/md5-digest.hpp>
+#include <lib/schema-parser/opcode.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/reader-generator.hpp>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace esp = c4lib::expression_parser;
+
+namespace c4lib::schema_parser {
+
+namespace {
+// Version of the generated code.  The version is part of the code and hence of the hash, so that a change to the
+// generated code invalidates readers generated before the change.
+constexpr int generated_code_version{1};
+
+constexpr size_t indent_width{4};
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Reader_generator::Reader_generator(const Program& program)
+    : m_program(program)
+{
+    generate_();
+
+    const std::string code{m_code.str()};
+    md5::Md5_digest digest;
+    digest.add(std::as_bytes(std::span{code}));
+    m_hash = digest.get_hash();
+}
+
+void Reader_generator::write(std::ostream& out, std::string_view source) const
+{
+    out << "// Reader generated from " << source << " by c4gen.  Do not edit.\n"
+        << "// Program hash " << m_hash << ".\n"
+        << "\n"
+        << "#include <cstddef>\n"
+        << "#include <include/symbol.hpp>\n"
+        << "#include <lib/schema-parser/generated-reader.hpp>\n"
+        << "#include <lib/util/limits.hpp>\n"
+        << "#include <string>\n"
+        << "#include <vector>\n"
+        << "\n"
+        << "namespace c4lib::schema_parser {\n"
+        << "\n"
+        << "namespace {\n"
+        << "using Parent_scope = Generated_reader_runtime::Parent_scope;\n"
+        << "\n"
+        << m_code.str() << "\n"
+        << "const Generated_reader reader{\"" << m_hash << "\", &read_save};\n"
+        << "\n"
+        << "// Registers the reader during static initialization.\n"
+        << "const struct Registration {\n"
+        << "    Registration()\n"
+        << "    {\n"
+        << "        register_generated_reader(reader);\n"
+        << "    }\n"
+        << "} registration;\n"
+        << "} // namespace\n"
+        << "\n"
+        << "} // namespace c4lib::schema_parser\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string Reader_generator::expression_(size_t expression) const
+{
+    // The operations are in postfix order, so the C++ expression is built with a stack of the C++ expressions of the
+    // operands.  Every operator is parenthesized.
+    const esp::Expression& e{m_program.expressions.at(expression)};
+    std::vector<std::string> stack;
+    const auto pop{[&stack]() {
+        if (stack.empty()) {
+            throw std::logic_error{std::format(fmt::internal_bug_in_function, "Reader_generator::expression_")};
+        }
+        std::string value{std::move(stack.back())};
+        stack.pop_back();
+        return value;
+    }};
+
+    for (size_t index = 0; index < e.operations.size(); ++index) {
+        const esp::Operation& operation{e.operations[index]};
+        switch (operation.kind) {
+        case esp::Operation::Kind::constant:
+            stack.push_back(literal_(operation.value));
+            break;
+
+        case esp::Operation::Kind::variable:
+            stack.push_back(std::format("rt.get_variable({}, {})", expression, index));
+            break;
+
+        case esp::Operation::Kind::local_variable:
+            stack.push_back(std::format("rt.get_local({})", operation.reference));
+            break;
+
+        case esp::Operation::Kind::node_reference: {
+            const esp::Node_reference& reference{e.node_references.at(operation.reference)};
+            std::vector<std::string> subscripts(reference.subscript_count);
+            for (size_t i = reference.subscript_count; i-- > 0;) {
+                subscripts[i] = pop();
+            }
+            std::string list;
+            for (const std::string& subscript : subscripts) {
+                list += list.empty() ? subscript : ", " + subscript;
+            }
+            stack.push_back(std::format("rt.get_node({}, {}, {{{}}})", expression, operation.reference, list));
+        } break;
+
+        case esp::Operation::Kind::enumerator_reference:
+            stack.push_back(std::format("rt.get_enumerator({}, {})", expression, operation.reference));
+            break;
+
+        case esp::Operation::Kind::unary_operator: {
+            const std::string right{pop()};
+            switch (operation.operator_type) {
+            case Token_type::minus:
+                stack.push_back(std::format("(-{})", right));
+                break;
+            case Token_type::plus:
+                stack.push_back(std::format("(+{})", right));
+                break;
+            case Token_type::bang:
+                stack.push_back(std::format("static_cast<int>({} == 0)", right));
+                break;
+            default:
+                throw std::logic_error{std::format(fmt::internal_bug_in_function, "Reader_generator::expression_")};
+            }
+        } break;
+
+        case esp::Operation::Kind::binary_operator: {
+            const std::string right{pop()};
+            const std::string left{pop()};
+            std::string_view arithmetic;
+            std::string_view comparison;
+            switch (operation.operator_type) {
+            case Token_type::minus:
+                arithmetic = "-";
+                break;
+            case Token_type::plus:
+                arithmetic = "+";
+                break;
+            case Token_type::asterisk:
+                arithmetic = "*";
+                break;
+            case Token_type::slash:
+                arithmetic = "/";
+                break;
+            case Token_type::percent:
+                arithmetic = "%";
+                break;
+            case Token_type::double_ampersand:
+                stack.push_back(std::format("Generated_reader_runtime::logical_and({}, {})", left, right));
+                break;
+            case Token_type::double_bar:
+                stack.push_back(std::format("Generated_reader_runtime::logical_or({}, {})", left, right));
+                break;
+            case Token_type::open_angle_bracket:
+                comparison = "<";
+                break;
+            case Token_type::open_angle_equals:
+                comparison = "<=";
+                break;
+            case Token_type::double_equals:
+                comparison = "==";
+                break;
+            case Token_type::bang_equals:
+                comparison = "!=";
+                break;
+            case Token_type::close_angle_equals:
+                comparison = ">=";
+                break;
+            case Token_type::close_angle_bracket:
+                comparison = ">";
+                break;
+            default:
+                throw std::logic_error{std::format(fmt::internal_bug_in_function, "Reader_generator::expression_")};
+            }
+            if (!arithmetic.empty()) {
+                stack.push_back(std::format("({} {} {})", left, arithmetic, right));
+            }
+            else if (!comparison.empty()) {
+                stack.push_back(std::format("static_cast<int>({} {} {})", left, comparison, right));
+            }
+        } break;
+        }
+    }
+
+    std::string value{pop()};
+    if (!stack.empty()) {
+        throw std::logic_error{std::format(fmt::internal_bug_in_function, "Reader_generator::expression_")};
+    }
+    return value;
+}
+
+void Reader_generator::generate_()
+{
+    // Find the routines reachable from the root statement.  Only these are generated, since a function which is never
+    // called would draw a warning.
+    std::vector<bool> is_reached(m_program.routines.size(), false);
+    const auto reach{[this, &is_reached](size_t statement) {
+        const size_t routine{m_program.statements.at(statement).routine};
+        if (routine != limits::invalid_size && !is_reached.at(routine)) {
+            is_reached[routine] = true;
+            m_routines.push_back(routine);
+        }
+    }};
+    reach(m_program.root_statement);
+    for (size_t index = 0; index < m_routines.size(); ++index) {
+        const size_t routine{m_routines[index]};
+        const size_t end{get_routine_end_(routine)};
+        for (size_t pc = m_program.routines.at(routine); pc < end; ++pc) {
+            const Instruction& instruction{m_program.instructions[pc]};
+            if (instruction.opcode == Opcode::emit) {
+                reach(instruction.operand);
+            }
+        }
+    }
+
+    line_(0, std::format("// Generated code version {}.", generated_code_version));
+    for (const size_t routine : m_routines) {
+        line_(0, std::format("void routine_{}(Generated_reader_runtime& rt);", routine));
+    }
+    line_(0, "");
+    line_(0, "void read_save(Generated_reader_runtime& rt)");
+    line_(0, "{");
+    generate_emit_(1, m_program.root_statement);
+    line_(0, "}");
+    for (const size_t routine : m_routines) {
+        line_(0, "");
+        generate_routine_(routine);
+    }
+}
+
+void Reader_generator::generate_elements_(size_t depth,
+    size_t statement,
+    size_t suffix,
+    const std::string& a,
+    const std::string& n,
+    const std::string& prefix,
+    const std::string& array_index)
+{
+    // The elements are emitted in the order used by Generative_node_source: the elements of a dimension are emitted
+    // before the elements of any of its elements.  The leaves are collected in subscript order to be read once every
+    // node of the statement has been emitted.
+    const Definition_statement& s{m_program.statements.at(statement)};
+    const Array_suffix& array_suffix{s.array_suffixes.at(suffix)};
+    const bool is_last{suffix + 1 == s.array_suffixes.size()};
+    const bool has_use_capture{std::ranges::any_of(
+        s.array_suffixes, [](const Array_suffix& other) { return other.kind == Array_suffix::Kind::use_capture; })};
+    const std::string i{std::format("i{}", suffix)};
+    const std::string capture{array_suffix.is_capture && has_use_capture ? std::format("captured = {};", i) : ""};
+
+    std::string enum_name{"invalid_symbol"};
+    if (!array_suffix.enum_name.empty()) {
+        enum_name = std::format("e{}", suffix);
+        line_(depth, std::format("const Symbol {}{{rt.get_enum_name({}, {})}};", enum_name, statement, suffix));
+    }
+    const std::string subscripts{std::format("rt.format_subscript({}, {}, {})", prefix, i, enum_name)};
+    const std::string loop{std::format("for (size_t {0} = 0; {0} < {1}; ++{0}) {{", i, n)};
+
+    if (is_last) {
+        line_(depth, loop);
+        if (!capture.empty()) {
+            line_(depth + 1, capture);
+        }
+        line_(depth + 1,
+            std::format(
+                "leaves.push_back(rt.add_element({}, {}, {}, {}, {}));", a, statement, i, array_index, subscripts));
+        line_(depth, "}");
+        return;
+    }
+
+    const std::string next_a{std::format("a{}", suffix + 1)};
+    const std::string next_n{std::format("n{}", suffix + 1)};
+    const std::string next_s{std::format("s{}", suffix + 1)};
+    line_(depth, std::format("std::vector<size_t> {}({});", next_a, n));
+    line_(depth, std::format("std::vector<size_t> {}({});", next_n, n));
+    line_(depth, std::format("std::vector<std::string> {}({});", next_s, n));
+    line_(depth, loop);
+    if (!capture.empty()) {
+        line_(depth + 1, capture);
+    }
+    line_(depth + 1, std::format("{}[{}] = {};", next_s, i, subscripts));
+    line_(depth + 1, std::format("{}[{}] = {};", next_n, i, get_dimension_(statement, suffix + 1)));
+    line_(depth + 1,
+        std::format(
+            "{0}[{1}] = rt.add_array({2}, {3}, {1}, {4}, {5}[{1}]);", next_a, i, a, statement, array_index, next_n));
+    line_(depth, "}");
+    line_(depth, loop);
+    if (!capture.empty()) {
+        line_(depth + 1, capture);
+    }
+    generate_elements_(depth + 1, statement, suffix + 1, std::format("{}[{}]", next_a, i),
+        std::format("{}[{}]", next_n, i), std::format("{}[{}]", next_s, i), i);
+    line_(depth, "}");
+}
+
+void Reader_generator::generate_emit_(size_t depth, size_t statement)
+{
+    const Definition_statement& s{m_program.statements.at(statement)};
+    std::string comment{std::format("// {}", s.type.value)};
+    for (const Array_suffix& suffix : s.array_suffixes) {
+        comment += suffix.enum_name.empty() ? "[]" : std::format("[:{}]", suffix.enum_name);
+    }
+    comment += " " + s.identifier.value;
+
+    line_(depth, "{");
+    line_(depth + 1, comment);
+    if (s.array_suffixes.empty()) {
+        line_(depth + 1, std::format("const size_t node{{rt.add_node({})}};", statement));
+        generate_leaf_(depth + 1, statement, "node");
+        line_(depth, "}");
+        return;
+    }
+
+    if (std::ranges::any_of(s.array_suffixes,
+            [](const Array_suffix& other) { return other.kind == Array_suffix::Kind::use_capture; })) {
+        line_(depth + 1, "size_t captured{limits::invalid_size};");
+    }
+    line_(depth + 1,
+        std::format("const size_t n0{{rt.get_dimension({}, {})}};", statement, get_dimension_(statement, 0)));
+    line_(depth + 1, std::format("const size_t a0{{rt.add_array({}, n0)}};", statement));
+    line_(depth + 1, "std::vector<size_t> leaves;");
+    line_(depth + 1, "leaves.reserve(n0);");
+    generate_elements_(depth + 1, statement, 0, "a0", "n0", "{}", "limits::invalid_size");
+    line_(depth + 1, "for (const size_t node : leaves) {");
+    generate_leaf_(depth + 2, statement, "node");
+    line_(depth + 1, "}");
+    line_(depth, "}");
+}
+
+void Reader_generator::generate_leaf_(size_t depth, size_t statement, const std::string& node)
+{
+    const Definition_statement& s{m_program.statements.at(statement)};
+    const std::string read{std::format("rt.read_node({})", node)};
+    if (s.routine != limits::invalid_size) {
+        line_(depth, std::format("static_cast<void>({});", read));
+        line_(depth, std::format("const Parent_scope scope{{rt, {}}};", node));
+        line_(depth, std::format("routine_{}(rt);", s.routine));
+    }
+    else if (s.prototype.type == property_tree::Node_type::enum_type) {
+        line_(depth, std::format("rt.check_enum({}, {});", statement, read));
+    }
+    else if (s.prototype.type == property_tree::Node_type::bool_type) {
+        line_(depth, std::format("rt.check_bool({}, {});", statement, read));
+    }
+    else {
+        line_(depth, std::format("static_cast<void>({});", read));
+    }
+}
+
+void Reader_generator::generate_routine_(size_t routine)
+{
+    // Jumps become gotos.  Each instruction is written as its own block so that no goto crosses a declaration, and
+    // only the targets of jumps are labeled.
+    const size_t begin{m_program.routines.at(routine)};
+    const size_t end{get_routine_end_(routine)};
+    std::vector<bool> is_target(end - begin, false);
+    for (size_t pc = begin; pc < end; ++pc) {
+        const Instruction& instruction{m_program.instructions[pc]};
+        if (instruction.opcode == Opcode::jump || instruction.opcode == Opcode::branch_if_false) {
+            if (instruction.operand < begin || instruction.operand >= end) {
+                throw std::logic_error{
+                    std::format(fmt::internal_bug_in_function, "Reader_generator::generate_routine_")};
+            }
+            is_target[instruction.operand - begin] = true;
+        }
+    }
+
+    line_(0, std::format("void routine_{}(Generated_reader_runtime& rt)", routine));
+    line_(0, "{");
+    line_(1, "const size_t frame{rt.begin_frame()};");
+    for (size_t pc = begin; pc < end; ++pc) {
+        if (is_target[pc - begin]) {
+            line_(0, std::format("pc_{}:", pc));
+        }
+        const Instruction& instruction{m_program.instructions[pc]};
+        switch (instruction.opcode) {
+        case Opcode::add_variable:
+            line_(1, std::format("rt.add_local({}, {}, {});", instruction.operand, instruction.token_index,
+                         expression_(instruction.expression)));
+            break;
+
+        case Opcode::assert_true:
+            line_(1, std::format("rt.assert_true({}, {});", expression_(instruction.expression),
+                         instruction.token_index));
+            break;
+
+        case Opcode::branch_if_false:
+            line_(1, std::format("if ({} == 0) {{", expression_(instruction.expression)));
+            line_(2, std::format("goto pc_{};", instruction.operand));
+            line_(1, "}");
+            break;
+
+        case Opcode::emit:
+            generate_emit_(1, instruction.operand);
+            break;
+
+        case Opcode::jump:
+            line_(1, std::format("goto pc_{};", instruction.operand));
+            break;
+
+        case Opcode::pop_scope:
+            line_(1, "rt.pop_scope();");
+            break;
+
+        case Opcode::push_scope:
+            line_(1, "rt.push_scope();");
+            break;
+
+        case Opcode::ret:
+            line_(1, "rt.end_frame(frame);");
+            if (pc + 1 < end) {
+                line_(1, "return;");
+            }
+            break;
+
+        case Opcode::set_variable:
+            if (instruction.operand != limits::invalid_size) {
+                line_(1,
+                    std::format("rt.set_local({}, {});", instruction.operand, expression_(instruction.expression)));
+            }
+            else {
+                line_(1, std::format("rt.set_variable({}, {});", instruction.token_index,
+                             expression_(instruction.expression)));
+            }
+            break;
+
+        default:
+            throw std::logic_error{std::format(fmt::internal_bug_in_function, "Reader_generator::generate_routine_")};
+        }
+    }
+    line_(0, "}");
+}
+
+std::string Reader_generator::get_dimension_(size_t statement, size_t suffix) const
+{
+    const Array_suffix& array_suffix{m_program.statements.at(statement).array_suffixes.at(suffix)};
+    switch (array_suffix.kind) {
+    case Array_suffix::Kind::standard:
+        return expression_(array_suffix.expression);
+    case Array_suffix::Kind::query_reader:
+        return "rt.get_footer_bytes_count()";
+    case Array_suffix::Kind::use_capture:
+        return std::format("rt.get_captured_value({}, {}, captured)", statement, suffix);
+    }
+    throw std::logic_error{std::format(fmt::internal_bug_in_function, "Reader_generator::get_dimension_")};
+}
+
+size_t Reader_generator::get_routine_end_(size_t routine) const
+{
+    // A routine runs until the first routine which begins after it or, failing that, the end of the program.
+    const size_t begin{m_program.routines.at(routine)};
+    size_t end{m_program.instructions.size()};
+    for (const size_t other : m_program.routines) {
+        if (other > begin && other < end) {
+            end = other;
+        }
+    }
+    return end;
+}
+
+void Reader_generator::line_(size_t depth, std::string_view text)
+{
+    if (!text.empty()) {
+        m_code << std::string(depth * indent_width, ' ') << text;
+    }
+    m_code << '\n';
+}
+
+std::string Reader_generator::literal_(int value)
+{
+    // The negation of the literal for the magnitude of the minimum value would overflow.
+    if (value == std::numeric_limits<int>::min()) {
+        return std::format("({} - 1)", value + 1);
+    }
+    return value < 0 ? std::format("({})", value) : std::format("{}", value);
+}
+
+} // namespace c4lib::schema_parser
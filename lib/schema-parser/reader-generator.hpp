@@ -0,0 +1,96 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace c4lib::schema_parser {
+
+// The reader generator translates a compiled program into C++ which reads saves with straight-line code.  Each
+// routine becomes a function whose instructions are statements: jumps become gotos, expressions become C++
+// expressions over constants, local variables and node references, and each array becomes nested loops which emit its
+// elements.  The generated reader does what Parser_phase_two does for the program, by way of
+// Generated_reader_runtime, but without dispatching instructions, evaluating postfix expressions or building a tree of
+// dimensions for each array.
+//
+// The generated code is specific to the program: constants, including those imported from the game's XML, are
+// inlined and statements and expressions are referred to by index.  The hash of a program is the MD5 of the code
+// generated for it, so a program has the hash of a generated reader only if it is the program the reader was
+// generated from.  Parser::prepare uses the hash to select a registered reader, interpreting the program if none
+// matches, e.g., for a mod whose schema or definitions differ.
+class Reader_generator {
+public:
+    // Generates the code for program, which must have been compiled and its prototypes built.  Throws
+    // std::logic_error if program is malformed.
+    explicit Reader_generator(const Program& program);
+
+    ~Reader_generator() = default;
+
+    Reader_generator(const Reader_generator&) = delete;
+
+    Reader_generator& operator=(const Reader_generator&) = delete;
+
+    Reader_generator(Reader_generator&&) noexcept = delete;
+
+    Reader_generator& operator=(Reader_generator&&) noexcept = delete;
+
+    [[nodiscard]] const std::string& get_hash() const
+    {
+        return m_hash;
+    }
+
+    // Writes a translation unit which defines the reader and registers it during static initialization.  source
+    // names the schema from which the program was compiled and is written to a comment.
+    void write(std::ostream& out, std::string_view source) const;
+
+private:
+    // Returns the C++ expression for the expression at index expression within Program::expressions.
+    [[nodiscard]] std::string expression_(size_t expression) const;
+
+    void generate_();
+
+    // Writes the statements which emit the elements of the array node a, of dimension n, for the array suffix at
+    // suffix of statement.  prefix is the subscripts of a and array_index its index within its own array.
+    void generate_elements_(size_t depth,
+        size_t statement,
+        size_t suffix,
+        const std::string& a,
+        const std::string& n,
+        const std::string& prefix,
+        const std::string& array_index);
+
+    // Writes the statements which emit the nodes of statement.
+    void generate_emit_(size_t depth, size_t statement);
+
+    // Writes the statements which read node, emitted by statement, and run its routine or check its value.
+    void generate_leaf_(size_t depth, size_t statement, const std::string& node);
+
+    void generate_routine_(size_t routine);
+
+    // Returns the C++ expression for the dimension given by the array suffix at suffix of statement.
+    [[nodiscard]] std::string get_dimension_(size_t statement, size_t suffix) const;
+
+    // Returns the program counter one past the last instruction of routine.
+    [[nodiscard]] size_t get_routine_end_(size_t routine) const;
+
+    void line_(size_t depth, std::string_view text);
+
+    [[nodiscard]] static std::string literal_(int value);
+
+    std::stringstream m_code;
+    std::string m_hash;
+    const Program& m_program;
+    // Routines reachable from the root statement in the order they were reached.
+    std::vector<size_t> m_routines;
+};
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,676 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <include/exceptions.hpp>
+#include <include/logger.hpp>
+#include <ios>
+#include <istream>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/importer/file-manager.hpp>
+#include <lib/io/io.hpp>
+#include <lib/logger/log-formats.hpp>
+#include <lib/md5/md5-digest.hpp>
+#include <lib/native/mapped-file.hpp>
+#include <lib/native/path.hpp>
+#include <lib/schema-parser/def-mem-type.hpp>
+#include <lib/schema-parser/def-mem.hpp>
+#include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/definition.hpp>
+#include <lib/schema-parser/opcode.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/schema-cache.hpp>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/constants.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/file-location.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/location-table.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef linux
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <process.h>
+#endif
+
+namespace esp = c4lib::expression_parser;
+
+namespace c4lib::schema_parser {
+
+namespace {
+
+constexpr std::array<char, 4> cache_magic{'C', '4', 'S', 'C'};
+
+// Increment whenever the layout of the cache file or of the cached types changes.
+constexpr uint32_t cache_version{4};
+
+// Number of characters of the settings hash used to form the cache filename.
+constexpr size_t settings_hash_length{16};
+
+// Reads an enumerator stored as uint32_t, checking that it does not exceed last.
+template<typename E> void read_enum(std::istream& in, E& value, E last)
+{
+    uint32_t raw{0};
+    io::read_int(in, raw);
+    if (raw > static_cast<uint32_t>(last)) {
+        throw IO_error{std::format(fmt::index_out_of_range, raw)};
+    }
+    value = static_cast<E>(raw);
+}
+
+template<typename E> void write_enum(std::ostream& out, E value)
+{
+    uint32_t raw{static_cast<uint32_t>(value)};
+    io::write_int(out, raw);
+}
+
+// Symbols are assigned when strings are interned and so differ from process to process.  They are stored as the
+// strings for which they stand, an empty string standing for invalid_symbol.
+void read_symbol(std::istream& in, Symbol& symbol)
+{
+    std::string name;
+    io::read_string(in, name);
+    symbol = name.empty() ? invalid_symbol : symbol_table::intern(name);
+}
+
+void write_symbol(std::ostream& out, Symbol symbol)
+{
+    io::write_string(out, symbol == invalid_symbol ? std::string{} : symbol_table::name(symbol));
+}
+
+// Adds the path along with the size and modification time of the file it names to the key stream.  Absent files
+// are recorded as such so that their later appearance changes the key.
+void write_file_stamp(std::ostream& out, const native::Path& path)
+{
+    io::write_string(out, std::string{path});
+    std::error_code ec;
+    const std::filesystem::path fs_path{path};
+    int64_t size{-1};
+    int64_t time{0};
+    if (!path.empty()) {
+        const auto file_size{std::filesystem::file_size(fs_path, ec)};
+        const auto write_time{std::filesystem::last_write_time(fs_path, ec)};
+        if (!ec) {
+            size = gsl::narrow<int64_t>(file_size);
+            time = gsl::narrow<int64_t>(write_time.time_since_epoch().count());
+        }
+    }
+    io::write_int(out, size);
+    io::write_int(out, time);
+}
+
+// Returns a path, in the directory of path, for a temporary file unique to this process and call.  Processes saving
+// the same entry concurrently thus write separate files, each of which is renamed to path once complete.
+std::filesystem::path make_temp_path(const std::filesystem::path& path)
+{
+#ifdef linux
+    const auto pid{static_cast<int64_t>(::getpid())};
+#elif defined(_WIN32)
+    const auto pid{static_cast<int64_t>(::_getpid())};
+#else
+    const int64_t pid{0};
+#endif
+    std::random_device random;
+    std::uniform_int_distribution<uint64_t> distribution;
+    return std::filesystem::path{std::format("{}.{}-{:016x}.tmp", path.string(), pid, distribution(random))};
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Schema_cache::Schema_cache(native::Path cache_dir,
+    native::Path schema,
+    native::Path install_root,
+    native::Path custom_assets_path,
+    std::string mod_name,
+    bool use_modular_loading)
+    : m_custom_assets_path(std::move(custom_assets_path)),
+      m_install_root(std::move(install_root)),
+      m_mod_name(std::move(mod_name)),
+      m_schema(std::move(schema)),
+      m_use_modular_loading(use_modular_loading)
+{
+    // Distinct settings map to distinct cache files so that alternating between, e.g., mods does not repeatedly
+    // invalidate a single entry.
+    std::stringstream settings;
+    io::write_string(settings, std::filesystem::absolute(std::filesystem::path{m_schema}).string());
+    io::write_string(settings, std::string{m_install_root});
+    io::write_string(settings, std::string{m_custom_assets_path});
+    io::write_string(settings, m_mod_name);
+    uint8_t is_modular{m_use_modular_loading ? uint8_t{1} : uint8_t{0}};
+    io::write_int(settings, is_modular);
+    md5::Md5_digest digest;
+    digest.add(settings, 0, gsl::narrow<std::streamsize>(settings.str().size()));
+
+    const std::string stem{std::filesystem::path{m_schema}.stem().string()};
+    const std::string filename{stem + "-" + digest.get_hash().substr(0, settings_hash_length)};
+    m_path = native::Path{io::make_path(cache_dir, filename, constants::schema_cache_extension)};
+}
+
+bool Schema_cache::load(Tokenizer& tokenizer, Def_tbl& def_tbl, Program& program, size_t& root_name_index) const
+{
+    bool is_success{false};
+    try {
+        if (!std::filesystem::exists(std::filesystem::path{m_path})) {
+            Logger::info(std::format(fmt::schema_cache_miss, m_path));
+        }
+        else {
+            // Read the entire file into memory before deserializing it to avoid many small reads from disk.
+            std::ifstream file{m_path, std::ios_base::in | std::ios_base::binary};
+            if (!file.is_open() || file.bad()) {
+                throw std::runtime_error{std::format(fmt::runtime_error_opening_file, m_path)};
+            }
+            std::stringstream in;
+            in << file.rdbuf();
+            if (!file) {
+                throw std::runtime_error{std::format(fmt::runtime_error_reading_from_file, m_path)};
+            }
+            file.close();
+
+            std::string body_digest;
+            if (!read_header_(in, body_digest)) {
+                Logger::info(std::format(fmt::schema_cache_stale, m_path));
+            }
+            else if (!check_body_(in, body_digest)) {
+                Logger::warn(std::format(fmt::schema_cache_damaged, m_path));
+            }
+            else {
+                read_(in, tokenizer, def_tbl, program, root_name_index);
+                is_success = true;
+                Logger::info(std::format(fmt::schema_cache_loaded, m_path));
+            }
+        }
+    }
+    catch (const std::exception& ex) {
+        Logger::warn(std::format(fmt::caught_std_exception, ex.what()));
+    }
+
+    if (!is_success) {
+        tokenizer.reset();
+        def_tbl.reset();
+        program.clear();
+        root_name_index = limits::invalid_size;
+    }
+    return is_success;
+}
+
+void Schema_cache::save(const Tokenizer& tokenizer,
+    const Def_tbl& def_tbl,
+    const Program& program,
+    size_t root_name_index,
+    const std::vector<native::Path>& search_paths) const
+{
+    try {
+        // The body is serialized first so that the location table, which is written ahead of the rest of the body,
+        // is complete.
+        Location_writer locations;
+        std::stringstream entries;
+        write_size_(entries, tokenizer.count());
+        for (const Token& token : tokenizer.get_tokens()) {
+            write_token_(entries, locations, token);
+        }
+        write_size_(entries, root_name_index);
+        write_def_tbl_(entries, locations, def_tbl);
+        write_program_(entries, locations, program);
+
+        std::stringstream body;
+        locations.write_table(body);
+        body << entries.rdbuf();
+        md5::Md5_digest digest;
+        digest.add(std::as_bytes(std::span{body.view()}));
+
+        // Write to a temporary file and then rename so that a concurrent load never observes a partial entry.
+        const std::filesystem::path path{m_path};
+        std::filesystem::create_directories(path.parent_path());
+        const std::filesystem::path temp_path{make_temp_path(path)};
+        try {
+            {
+                std::ofstream out{temp_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+                if (!out.is_open() || out.bad()) {
+                    throw std::runtime_error{std::format(fmt::runtime_error_opening_file, temp_path.string())};
+                }
+                io::write_bytes(out, cache_magic.data(), cache_magic.size());
+                uint32_t version{cache_version};
+                io::write_int(out, version);
+                io::write_string(out, compute_key_(search_paths));
+                write_size_(out, search_paths.size());
+                for (const auto& search_path : search_paths) {
+                    io::write_string(out, std::string{search_path});
+                }
+                io::write_string(out, digest.get_hash());
+                out << body.rdbuf();
+                if (!out) {
+                    throw std::runtime_error{std::format(fmt::runtime_error_writing_to_file, temp_path.string())};
+                }
+            }
+            std::filesystem::rename(temp_path, path);
+        }
+        catch (const std::exception&) {
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            throw;
+        }
+        Logger::info(std::format(fmt::schema_cache_saved, m_path));
+    }
+    catch (const std::exception& ex) {
+        Logger::warn(std::format(fmt::caught_std_exception, ex.what()));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void Schema_cache::Location_reader::read(std::istream& in, File_location& loc) const
+{
+    uint32_t filename{0};
+    io::read_int(in, filename);
+    uint32_t line{0};
+    io::read_int(in, line);
+    loc.filename = m_strings.at(filename);
+    loc.line = m_strings.at(line);
+    read_size_(in, loc.line_number);
+    read_size_(in, loc.character_number);
+}
+
+void Schema_cache::Location_reader::read_table(std::istream& in)
+{
+    size_t count{0};
+    read_size_(in, count);
+    m_strings.clear();
+    m_strings.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string str;
+        io::read_string(in, str);
+        m_strings.push_back(std::make_shared<const std::string>(std::move(str)));
+    }
+}
+
+uint32_t Schema_cache::Location_writer::index_of_(const std::shared_ptr<const std::string>& str)
+{
+    const auto [it, was_inserted]{m_indices.try_emplace(str.get(), gsl::narrow<uint32_t>(m_strings.size()))};
+    if (was_inserted) {
+        m_strings.push_back(str.get());
+    }
+    return it->second;
+}
+
+void Schema_cache::Location_writer::write(std::ostream& out, const File_location& loc)
+{
+    uint32_t filename{index_of_(loc.filename)};
+    io::write_int(out, filename);
+    uint32_t line{index_of_(loc.line)};
+    io::write_int(out, line);
+    write_size_(out, loc.line_number);
+    write_size_(out, loc.character_number);
+}
+
+void Schema_cache::Location_writer::write_table(std::ostream& out) const
+{
+    write_size_(out, m_strings.size());
+    for (const std::string* str : m_strings) {
+        io::write_string(out, *str);
+    }
+}
+
+std::string Schema_cache::compute_key_(const std::vector<native::Path>& search_paths) const
+{
+    std::stringstream key;
+    uint32_t version{cache_version};
+    io::write_int(key, version);
+
+    const native::Mapped_file schema{m_schema};
+    io::write_bytes(key, schema.text().data(), gsl::narrow<std::streamsize>(schema.text().size()));
+
+    io::write_string(key, std::string{m_install_root});
+    io::write_string(key, std::string{m_custom_assets_path});
+    io::write_string(key, m_mod_name);
+    uint8_t is_modular{m_use_modular_loading ? uint8_t{1} : uint8_t{0}};
+    io::write_int(key, is_modular);
+
+    // Resolve each search path as the importer would, probing rather than indexing the search path roots so that a
+    // warm start does not walk them.  Modular resolution is recorded whenever modular loading is in use; recording
+    // more files than the importer reads can only make the key more conservative.
+    const File_manager file_manager{m_install_root, m_custom_assets_path, m_mod_name, m_use_modular_loading};
+    for (const auto& search_path : search_paths) {
+        native::Path full_path;
+        file_manager.probe_full_path(search_path, full_path);
+        write_file_stamp(key, full_path);
+        if (m_use_modular_loading) {
+            std::vector<native::Path> modular_paths;
+            file_manager.get_full_paths_modular(search_path, modular_paths);
+            for (const auto& modular_path : modular_paths) {
+                write_file_stamp(key, modular_path);
+            }
+        }
+    }
+
+    md5::Md5_digest digest;
+    digest.add(key, 0, gsl::narrow<std::streamsize>(key.str().size()));
+    return digest.get_hash();
+}
+
+void Schema_cache::read_(
+    std::istream& in, Tokenizer& tokenizer, Def_tbl& def_tbl, Program& program, size_t& root_name_index) const
+{
+    Location_reader locations;
+    locations.read_table(in);
+
+    size_t token_count{0};
+    read_size_(in, token_count);
+    std::vector<Token> tokens(token_count);
+    for (Token& token : tokens) {
+        read_token_(in, locations, token);
+    }
+    tokenizer.set_tokens(std::move(tokens));
+    tokenizer.set_filename(m_schema);
+
+    read_size_(in, root_name_index);
+    def_tbl.reset();
+    read_def_tbl_(in, locations, def_tbl);
+    program.clear();
+    read_program_(in, locations, program);
+}
+
+bool Schema_cache::check_body_(std::stringstream& in, const std::string& body_digest)
+{
+    // The body is the remainder of the entry following the header.
+    const std::string_view body{in.view().substr(gsl::narrow<size_t>(std::streamoff{in.tellg()}))};
+    md5::Md5_digest digest;
+    digest.add(std::as_bytes(std::span{body}));
+    return digest.get_hash() == body_digest;
+}
+
+bool Schema_cache::read_header_(std::istream& in, std::string& body_digest) const
+{
+    std::array<char, cache_magic.size()> magic{};
+    io::read_bytes(in, magic.data(), magic.size());
+    uint32_t version{0};
+    io::read_int(in, version);
+    if (magic != cache_magic || version != cache_version) {
+        return false;
+    }
+
+    std::string key;
+    io::read_string(in, key);
+    size_t search_path_count{0};
+    read_size_(in, search_path_count);
+    std::vector<native::Path> search_paths;
+    for (size_t i = 0; i < search_path_count; ++i) {
+        std::string search_path;
+        io::read_string(in, search_path);
+        search_paths.emplace_back(search_path);
+    }
+    io::read_string(in, body_digest);
+    return key == compute_key_(search_paths);
+}
+
+void Schema_cache::read_def_tbl_(std::istream& in, const Location_reader& locations, Def_tbl& def_tbl)
+{
+    size_t definition_count{0};
+    read_size_(in, definition_count);
+    for (size_t i = 0; i < definition_count; ++i) {
+        std::string name;
+        io::read_string(in, name);
+        Def_type type{Def_type::invalid};
+        read_enum(in, type, Def_type::end);
+        File_location loc;
+        locations.read(in, loc);
+        bool was_created{false};
+        Definition& definition{def_tbl.create_definition(name, type, loc, was_created)};
+
+        size_t member_count{0};
+        read_size_(in, member_count);
+        for (size_t j = 0; j < member_count; ++j) {
+            std::string member_name;
+            io::read_string(in, member_name);
+            Def_mem_type member_type{Def_mem_type::invalid};
+            read_enum(in, member_type, Def_mem_type::end);
+            int32_t value{0};
+            io::read_int(in, value);
+            File_location member_loc;
+            locations.read(in, member_loc);
+            // Members are replayed in their original order.  Duplicates are allowed since modular overrides were
+            // resolved before the entry was written.
+            Def_mem member{member_type, std::move(member_name), value, std::move(member_loc)};
+            definition.add_member(member, true, false);
+        }
+    }
+}
+
+void Schema_cache::read_expression_(std::istream& in, esp::Expression& expression)
+{
+    size_t operation_count{0};
+    read_size_(in, operation_count);
+    expression.operations.resize(operation_count);
+    for (esp::Operation& operation : expression.operations) {
+        read_enum(in, operation.kind, esp::Operation::Kind::binary_operator);
+        read_enum(in, operation.operator_type, Token_type::end);
+        int32_t value{0};
+        io::read_int(in, value);
+        operation.value = value;
+        read_symbol(in, operation.symbol);
+        read_size_(in, operation.reference);
+    }
+
+    size_t node_reference_count{0};
+    read_size_(in, node_reference_count);
+    expression.node_references.resize(node_reference_count);
+    for (esp::Node_reference& reference : expression.node_references) {
+        size_t key_count{0};
+        read_size_(in, key_count);
+        reference.keys.resize(key_count);
+        for (Symbol& key : reference.keys) {
+            read_symbol(in, key);
+        }
+        read_size_(in, reference.subscript_count);
+        read_size_(in, reference.slot);
+    }
+
+    size_t enumerator_reference_count{0};
+    read_size_(in, enumerator_reference_count);
+    expression.enumerator_references.resize(enumerator_reference_count);
+    for (esp::Enumerator_reference& reference : expression.enumerator_references) {
+        read_symbol(in, reference.enum_name);
+        read_symbol(in, reference.enumerator);
+    }
+}
+
+void Schema_cache::read_program_(std::istream& in, const Location_reader& locations, Program& program)
+{
+    size_t instruction_count{0};
+    read_size_(in, instruction_count);
+    program.instructions.resize(instruction_count);
+    for (Instruction& instruction : program.instructions) {
+        read_enum(in, instruction.opcode, Opcode::end);
+        read_size_(in, instruction.token_index);
+        read_size_(in, instruction.expression);
+        read_size_(in, instruction.operand);
+    }
+
+    size_t routine_count{0};
+    read_size_(in, routine_count);
+    program.routines.resize(routine_count);
+    for (size_t& routine : program.routines) {
+        read_size_(in, routine);
+    }
+
+    size_t statement_count{0};
+    read_size_(in, statement_count);
+    program.statements.resize(statement_count);
+    for (Definition_statement& statement : program.statements) {
+        read_token_(in, locations, statement.type);
+        read_token_(in, locations, statement.identifier);
+        size_t suffix_count{0};
+        read_size_(in, suffix_count);
+        statement.array_suffixes.resize(suffix_count);
+        for (Array_suffix& suffix : statement.array_suffixes) {
+            read_enum(in, suffix.kind, Array_suffix::Kind::use_capture);
+            read_size_(in, suffix.expression);
+            io::read_string(in, suffix.enum_name);
+            uint8_t is_capture{0};
+            io::read_int(in, is_capture);
+            suffix.is_capture = is_capture != 0;
+            read_token_(in, locations, suffix.node_name);
+        }
+        read_size_(in, statement.routine);
+    }
+
+    read_size_(in, program.root_statement);
+    read_size_(in, program.node_reference_count);
+
+    size_t expression_count{0};
+    read_size_(in, expression_count);
+    program.expressions.resize(expression_count);
+    for (esp::Expression& expression : program.expressions) {
+        read_expression_(in, expression);
+    }
+}
+
+void Schema_cache::read_size_(std::istream& in, size_t& value)
+{
+    uint64_t raw{0};
+    io::read_int(in, raw);
+    value = gsl::narrow<size_t>(raw);
+}
+
+void Schema_cache::read_token_(std::istream& in, const Location_reader& locations, Token& token)
+{
+    read_size_(in, token.index);
+    File_location loc;
+    locations.read(in, loc);
+    token.location = location_table::add(loc);
+    read_enum(in, token.type, Token_type::end);
+    io::read_string(in, token.value);
+    token.intern();
+}
+
+void Schema_cache::write_def_tbl_(std::ostream& out, Location_writer& locations, const Def_tbl& def_tbl)
+{
+    write_size_(out, def_tbl.size());
+    for (const Definition& definition : def_tbl.get_definitions() | std::views::values) {
+        io::write_string(out, definition.get_name());
+        write_enum(out, definition.get_type());
+        locations.write(out, definition.get_file_location());
+
+        const std::vector<Def_mem>& members{definition.get_members()};
+        write_size_(out, members.size());
+        for (const Def_mem& member : members) {
+            io::write_string(out, member.name);
+            write_enum(out, member.type);
+            int32_t value{member.value};
+            io::write_int(out, value);
+            locations.write(out, member.loc);
+        }
+    }
+}
+
+void Schema_cache::write_expression_(std::ostream& out, const esp::Expression& expression)
+{
+    write_size_(out, expression.operations.size());
+    for (const esp::Operation& operation : expression.operations) {
+        write_enum(out, operation.kind);
+        write_enum(out, operation.operator_type);
+        int32_t value{operation.value};
+        io::write_int(out, value);
+        write_symbol(out, operation.symbol);
+        write_size_(out, operation.reference);
+    }
+
+    write_size_(out, expression.node_references.size());
+    for (const esp::Node_reference& reference : expression.node_references) {
+        write_size_(out, reference.keys.size());
+        for (const Symbol key : reference.keys) {
+            write_symbol(out, key);
+        }
+        write_size_(out, reference.subscript_count);
+        write_size_(out, reference.slot);
+    }
+
+    write_size_(out, expression.enumerator_references.size());
+    for (const esp::Enumerator_reference& reference : expression.enumerator_references) {
+        write_symbol(out, reference.enum_name);
+        write_symbol(out, reference.enumerator);
+    }
+}
+
+void Schema_cache::write_program_(std::ostream& out, Location_writer& locations, const Program& program)
+{
+    write_size_(out, program.instructions.size());
+    for (const Instruction& instruction : program.instructions) {
+        write_enum(out, instruction.opcode);
+        write_size_(out, instruction.token_index);
+        write_size_(out, instruction.expression);
+        write_size_(out, instruction.operand);
+    }
+
+    write_size_(out, program.routines.size());
+    for (const size_t routine : program.routines) {
+        write_size_(out, routine);
+    }
+
+    write_size_(out, program.statements.size());
+    for (const Definition_statement& statement : program.statements) {
+        write_token_(out, locations, statement.type);
+        write_token_(out, locations, statement.identifier);
+        write_size_(out, statement.array_suffixes.size());
+        for (const Array_suffix& suffix : statement.array_suffixes) {
+            write_enum(out, suffix.kind);
+            write_size_(out, suffix.expression);
+            io::write_string(out, suffix.enum_name);
+            uint8_t is_capture{suffix.is_capture ? uint8_t{1} : uint8_t{0}};
+            io::write_int(out, is_capture);
+            write_token_(out, locations, suffix.node_name);
+        }
+        write_size_(out, statement.routine);
+    }
+
+    write_size_(out, program.root_statement);
+    write_size_(out, program.node_reference_count);
+
+    write_size_(out, program.expressions.size());
+    for (const esp::Expression& expression : program.expressions) {
+        write_expression_(out, expression);
+    }
+}
+
+void Schema_cache::write_size_(std::ostream& out, size_t value)
+{
+    uint64_t raw{value};
+    io::write_int(out, raw);
+}
+
+void Schema_cache::write_token_(std::ostream& out, Location_writer& locations, const Token& token)
+{
+    write_size_(out, token.index);
+    locations.write(out, token.get_loc());
+    write_enum(out, token.type);
+    io::write_string(out, token.value);
+}
+
+} // namespace c4lib::schema_parser
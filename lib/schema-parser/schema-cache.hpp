@@ -0,0 +1,138 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/native/path.hpp>
+#include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/file-location.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace c4lib::schema_parser {
+
+// The schema cache persists the results of phase one parsing and schema compilation - the token stream, the
+// definition table and the compiled program - so that later loads using the same schema and assets can skip
+// tokenizing, importing XML definitions and compiling.
+//
+// A cache entry is keyed by an MD5 hash of the schema contents, the installation settings and, for each search
+// path used to import definitions, the resolved XML file paths along with their sizes and modification times.
+// Since the search paths are stored within the entry, the key is recomputed on load without importing; any change
+// to the schema, the settings or the resolved XML files causes the entry to be treated as stale.  The header also
+// records an MD5 of the body so that a damaged entry is rejected before it is deserialized.  Entries are written to
+// a temporary file unique to the writer and then renamed, so concurrent processes may save the same entry.
+class Schema_cache {
+public:
+    Schema_cache(native::Path cache_dir,
+        native::Path schema,
+        native::Path install_root,
+        native::Path custom_assets_path,
+        std::string mod_name,
+        bool use_modular_loading);
+
+    ~Schema_cache() = default;
+
+    Schema_cache(const Schema_cache&) = delete;
+
+    Schema_cache& operator=(const Schema_cache&) = delete;
+
+    Schema_cache(Schema_cache&&) noexcept = delete;
+
+    Schema_cache& operator=(Schema_cache&&) noexcept = delete;
+
+    // Returns the path to the cache file used for the schema and installation settings.
+    [[nodiscard]] const native::Path& get_path() const
+    {
+        return m_path;
+    }
+
+    // Loads the cache entry into tokenizer, def_tbl and program and sets root_name_index.  Returns true on success.
+    // Returns false if the entry does not exist, is stale or cannot be read; in these cases tokenizer, def_tbl and
+    // program are reset.
+    bool load(Tokenizer& tokenizer, Def_tbl& def_tbl, Program& program, size_t& root_name_index) const;
+
+    // Writes a cache entry for the state produced by phase one parsing and schema compilation.  search_paths are
+    // the search paths used by the importer.  Failure to write the entry is logged but is otherwise ignored.
+    void save(const Tokenizer& tokenizer,
+        const Def_tbl& def_tbl,
+        const Program& program,
+        size_t root_name_index,
+        const std::vector<native::Path>& search_paths) const;
+
+private:
+    // Location strings are shared between tokens and definition members.  Location_writer and Location_reader map
+    // the shared strings to and from indices into a table written once per cache entry.
+    class Location_writer {
+    public:
+        void write(std::ostream& out, const File_location& loc);
+
+        void write_table(std::ostream& out) const;
+
+    private:
+        uint32_t index_of_(const std::shared_ptr<const std::string>& str);
+
+        std::unordered_map<const std::string*, uint32_t> m_indices;
+        std::vector<const std::string*> m_strings;
+    };
+
+    class Location_reader {
+    public:
+        void read(std::istream& in, File_location& loc) const;
+
+        void read_table(std::istream& in);
+
+    private:
+        std::vector<std::shared_ptr<const std::string>> m_strings;
+    };
+
+    [[nodiscard]] std::string compute_key_(const std::vector<native::Path>& search_paths) const;
+
+    void read_(std::istream& in, Tokenizer& tokenizer, Def_tbl& def_tbl, Program& program, size_t& root_name_index)
+        const;
+
+    // Returns true if the MD5 of the remainder of in, the body of the entry, is body_digest.
+    [[nodiscard]] static bool check_body_(std::stringstream& in, const std::string& body_digest);
+
+    // Reads the entry header and returns true if the entry matches the current schema, settings and XML files.  Sets
+    // body_digest to the MD5 of the body recorded in the header.
+    [[nodiscard]] bool read_header_(std::istream& in, std::string& body_digest) const;
+
+    static void read_def_tbl_(std::istream& in, const Location_reader& locations, Def_tbl& def_tbl);
+
+    static void read_expression_(std::istream& in, expression_parser::Expression& expression);
+
+    static void read_program_(std::istream& in, const Location_reader& locations, Program& program);
+
+    static void read_size_(std::istream& in, size_t& value);
+
+    static void read_token_(std::istream& in, const Location_reader& locations, Token& token);
+
+    static void write_def_tbl_(std::ostream& out, Location_writer& locations, const Def_tbl& def_tbl);
+
+    static void write_expression_(std::ostream& out, const expression_parser::Expression& expression);
+
+    static void write_program_(std::ostream& out, Location_writer& locations, const Program& program);
+
+    static void write_size_(std::ostream& out, size_t value);
+
+    static void write_token_(std::ostream& out, Location_writer& locations, const Token& token);
+
+    native::Path m_custom_assets_path;
+    native::Path m_install_root;
+    std::string m_mod_name;
+    native::Path m_path;
+    native::Path m_schema;
+    bool m_use_modular_loading{false};
+};
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,647 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <include/exceptions.hpp>
+#include <include/logger.hpp>
+#include <include/node-type.hpp>
+#include <initializer_list>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/logger/log-formats.hpp>
+#include <lib/ptree/emitted-node.hpp>
+#include <lib/schema-parser/def-mem.hpp>
+#include <lib/schema-parser/definition.hpp>
+#include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/opcode.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/schema-compiler.hpp>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/file-location.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/schema.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace esp = c4lib::expression_parser;
+
+namespace c4lib::schema_parser {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Schema_compiler::Schema_compiler(Tokenizer& tokenizer, const Def_tbl& def_tbl)
+    : m_definition_table(def_tbl), m_tokenizer(tokenizer)
+{}
+
+void Schema_compiler::compile(size_t root_name_index, Program& program)
+{
+    program.clear();
+    m_expression_lookup.clear();
+    m_pending_routines.clear();
+    m_routine_lookup.clear();
+    m_program = &program;
+
+    // The root structure is emitted by a statement which does not exist in the schema so we need to create
+    // it here.  The statement we're creating needs to reflect the result of compiling the following statement:
+    //        struct_<root-name> <root-name>
+    // where <root-name> is the name referenced by root_name_index.
+    const std::string root_name{at_(root_name_index).value};
+    const std::string struct_root_name{"struct_" + root_name};
+    const File_location loc{std::make_shared<std::string>("internally generated tokens"),
+        std::make_shared<std::string>(struct_root_name + " " + root_name), 1, 1};
+    Definition_statement root;
+    root.type = Token{Token_type::struct_type, struct_root_name, loc, limits::invalid_size};
+    root.identifier = Token{Token_type::identifier, root_name, loc, limits::invalid_size};
+    root.routine = routine_for_struct_(root.type);
+    program.root_statement = program.statements.size();
+    program.statements.push_back(std::move(root));
+
+    // Compiling a routine may request further routines.  Keep going until every routine reachable from the
+    // root has been compiled.
+    while (!m_pending_routines.empty()) {
+        const Pending_routine pending{m_pending_routines.front()};
+        m_pending_routines.pop_front();
+        compile_routine_(pending);
+    }
+    resolve_operands_();
+    build_prototypes(program);
+
+    m_program = nullptr;
+}
+
+void Schema_compiler::build_prototypes(Program& program)
+{
+    namespace cpt = c4lib::property_tree;
+
+    for (Definition_statement& statement : program.statements) {
+        cpt::Emitted_node& prototype{statement.prototype};
+        prototype = cpt::Emitted_node{};
+        prototype.type = token_type_to_node_type(statement.type.type);
+        prototype.name = statement.identifier.symbol;
+        prototype.type_name = symbol_table::intern(statement.type.value);
+        if (prototype.type >= cpt::Node_type::first_integer_type
+            && prototype.type <= cpt::Node_type::last_integer_type) {
+            prototype.size = gsl::narrow<uint8_t>(std::stoi(c4lib::size_from_type(statement.type.value)));
+        }
+        if (statement.type.type == Token_type::enum_type) {
+            prototype.enum_name = symbol_table::intern(c4lib::enum_name_from_type(statement.type.value));
+        }
+    }
+}
+
+std::unordered_set<Symbol> Schema_compiler::get_referenced_node_names(const Program& program)
+{
+    std::unordered_set<Symbol> names;
+    for (const esp::Expression& expression : program.expressions) {
+        for (const esp::Operation& operation : expression.operations) {
+            if (operation.kind == esp::Operation::Kind::variable) {
+                names.insert(operation.symbol);
+            }
+        }
+        for (const esp::Node_reference& reference : expression.node_references) {
+            if (const auto it{std::ranges::find_if(
+                    reference.keys.rbegin(), reference.keys.rend(), [](Symbol key) { return key != invalid_symbol; })};
+                it != reference.keys.rend()) {
+                names.insert(*it);
+            }
+        }
+    }
+    for (const Definition_statement& statement : program.statements) {
+        for (const Array_suffix& suffix : statement.array_suffixes) {
+            if (suffix.kind == Array_suffix::Kind::use_capture) {
+                names.insert(suffix.node_name.symbol);
+            }
+        }
+    }
+    return names;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const Token& Schema_compiler::at_(size_t index) const
+{
+    return m_tokenizer.at(index);
+}
+
+// <array-suffix> ::= <open-square-bracket> <use-capture-node-reference> <opt-enum-bind> <close-square-bracket> |
+//                    <open-square-bracket> <query-reader-keyword> <close-square-bracket> |
+//                    <open-square-bracket> <expression> <opt-enum-bind> <opt-index-capture> <close-square-bracket>
+size_t Schema_compiler::compile_array_suffix_(size_t index, Array_suffix& suffix)
+{
+    index = expect_(index, Token_type::open_square_bracket);
+
+    if (at_(index).type == Token_type::query_reader_keyword) {
+        suffix.kind = Array_suffix::Kind::query_reader;
+        return expect_(index + 1, Token_type::close_square_bracket);
+    }
+
+    // <use-capture-node-reference> ::= <node-name> <open-square-bracket> <use-capture-keyword> <close-square-bracket>
+    if (at_(index).type == Token_type::identifier && at_(index + 1).type == Token_type::open_square_bracket
+        && at_(index + 2).type == Token_type::use_capture_keyword) {
+        suffix.kind = Array_suffix::Kind::use_capture;
+        suffix.node_name = at_(index);
+        index = expect_(index + 3, Token_type::close_square_bracket);
+    }
+    else {
+        suffix.kind = Array_suffix::Kind::standard;
+        index = compile_expression_(index, {Token_type::colon, Token_type::close_square_bracket}, suffix.expression);
+    }
+
+    // <opt-enum-bind> ::= <colon> <enum-name> | <null>
+    if (at_(index).type == Token_type::colon && at_(index + 1).type == Token_type::identifier) {
+        suffix.enum_name = at_(index + 1).value;
+        index += 2;
+    }
+
+    // <opt-index-capture> ::= <colon> <index-capture> | <null>
+    if (suffix.kind == Array_suffix::Kind::standard && at_(index).type == Token_type::colon
+        && at_(index + 1).type == Token_type::capture_index_keyword) {
+        suffix.is_capture = true;
+        index += 2;
+    }
+
+    return expect_(index, Token_type::close_square_bracket);
+}
+
+// <assert-statement> ::= <assert-keyword> <open-parenthesis> <expression> <close-parenthesis>
+size_t Schema_compiler::compile_assert_statement_(size_t index)
+{
+    const size_t assert_index{index};
+    index = expect_(index + 1, Token_type::open_parenthesis);
+    size_t expression{limits::invalid_size};
+    index = compile_expression_(index, {Token_type::close_parenthesis}, expression);
+    emit_(Instruction{.opcode = Opcode::assert_true, .token_index = assert_index, .expression = expression});
+    return expect_(index, Token_type::close_parenthesis);
+}
+
+// Compiles a brace-enclosed block and returns the index of the token following the close brace.
+size_t Schema_compiler::compile_block_(size_t index, const Template_context& tc)
+{
+    index = expect_(index, Token_type::open_brace);
+    while (at_(index).type != Token_type::close_brace) {
+        index = compile_statement_(index, tc);
+    }
+    return index + 1;
+}
+
+// <definition-statement> ::= <complex-integer-type> <integer-variable-name> |
+//                            <complex-enum-type> <enum-variable-name> |
+//                            <complex-string_type-like-type> <string_type-like-variable-name> |
+//                            <complex-struct-type> <struct-variable-name> |
+//                            <complex-template-type> <template-variable-name>
+// <template-definition-statement> ::= <complex-typename-type> <typename-variable-name> | <definition-statement>
+size_t Schema_compiler::compile_definition_statement_(size_t index, const Template_context& tc)
+{
+    const size_t statement_begin{index};
+    Definition_statement statement;
+
+    const Token& first{at_(index)};
+    if (is_simple_or_struct_type_(first.type)) {
+        statement.type = first;
+        ++index;
+    }
+    else if (first.type == Token_type::template_type) {
+        // <complex-template-type> ::= <template-type> <bracketed-type> <opt-array-suffix>
+        statement.type = first;
+        index = expect_(index + 1, Token_type::open_angle_bracket);
+        const Token& instantiating_type{at_(index)};
+        if (!is_instantiating_type_(instantiating_type.type)) {
+            throw_syntax_error_(index);
+        }
+        index = expect_(index + 1, Token_type::close_angle_bracket);
+        statement.routine = routine_for_template_(first, instantiating_type);
+    }
+    else if (first.type == Token_type::identifier && tc.type_name != nullptr) {
+        // <complex-typename-type> ::= <typename-type> <opt-array-suffix>
+        // The typename is replaced by the instantiating type so that the statement is compiled as if the
+        // instantiating type had been written in place of the typename.
+        if (tc.type_name->value != first.value) {
+            throw make_ex<Parser_error>(fmt::mismatched_type_names, first.get_loc(), tc.type_name->value, first.value);
+        }
+        statement.type = tc.instantiating_type;
+        statement.type.index = index;
+        ++index;
+    }
+    else {
+        throw_syntax_error_(index);
+    }
+
+    // <opt-array-suffix> ::= <array-suffix><opt-array-suffix> | <null>
+    while (at_(index).type == Token_type::open_square_bracket) {
+        index = compile_array_suffix_(index, statement.array_suffixes.emplace_back());
+    }
+
+    statement.identifier = at_(index);
+    index = expect_(index, Token_type::identifier);
+
+    if (statement.type.type == Token_type::struct_type) {
+        statement.routine = routine_for_struct_(statement.type);
+    }
+
+    const size_t statement_index{m_program->statements.size()};
+    m_program->statements.push_back(std::move(statement));
+    emit_(Instruction{.opcode = Opcode::emit, .token_index = statement_begin, .operand = statement_index});
+    return index;
+}
+
+// Compiles the expression beginning at index, which ends at the first of terminators not enclosed by parentheses or
+// square brackets, and sets expression to its index within Program::expressions.  Returns the index of the terminator.
+// Expressions are parsed using the Pratt Parsing method within the expression parser class, which must consume each
+// token of the expression.  An expression shared by several routines is compiled once.
+size_t Schema_compiler::compile_expression_(
+    size_t index, std::initializer_list<Token_type> terminators, size_t& expression)
+{
+    const size_t terminator_index{skip_expression_(index, terminators)};
+    if (const auto it{m_expression_lookup.find(index)}; it != m_expression_lookup.end()) {
+        expression = it->second;
+        return terminator_index;
+    }
+
+    esp::Expression compiled;
+    m_tokenizer.set_index(index);
+    try {
+        m_expression_parser.compile(m_tokenizer, compiled);
+    }
+    catch (const Expression_parser_error& ex) {
+        Logger::warn(std::format(fmt::caught_expression_parser_error, ex.what()));
+        throw_syntax_error_(m_tokenizer.get_index());
+    }
+    if (m_tokenizer.get_index() != terminator_index) {
+        throw_syntax_error_(m_tokenizer.get_index());
+    }
+
+    expression = m_program->expressions.size();
+    m_program->expressions.push_back(std::move(compiled));
+    m_expression_lookup.emplace(index, expression);
+    return terminator_index;
+}
+
+// <for-loop-block> ::= <for-keyword> <open-parenthesis> <for-assignment> <semicolon>
+//                         <for-continuation> <semicolon>
+//                         <for-update> <close-parenthesis>
+//			   <open-brace> <opt_blocks-or-statements> <close-brace>
+// <for-assignment> ::= <identifier> <assignment-operator> <expression>
+// <for-update> ::= <identifier> <assignment-operator> <expression>
+//
+// The loop compiles to:
+//        push_scope
+//        add_variable <for-assignment>
+// loop:  branch_if_false <for-continuation>, exit
+//        <opt_blocks-or-statements>
+//        set_variable <for-update>
+//        jump loop
+// exit:  pop_scope
+size_t Schema_compiler::compile_for_loop_block_(size_t index, const Template_context& tc)
+{
+    const size_t for_index{index};
+    index = expect_(index + 1, Token_type::open_parenthesis);
+
+    const size_t assignment_index{index};
+    index = expect_(index, Token_type::identifier);
+    index = expect_(index, Token_type::equals);
+    size_t assignment_expression{limits::invalid_size};
+    index = compile_expression_(index, {Token_type::semicolon}, assignment_expression);
+    index = expect_(index, Token_type::semicolon);
+
+    const size_t continuation_index{index};
+    size_t continuation_expression{limits::invalid_size};
+    index = compile_expression_(index, {Token_type::semicolon}, continuation_expression);
+    index = expect_(index, Token_type::semicolon);
+
+    const size_t update_index{index};
+    index = expect_(index, Token_type::identifier);
+    index = expect_(index, Token_type::equals);
+    size_t update_expression{limits::invalid_size};
+    index = compile_expression_(index, {Token_type::close_parenthesis}, update_expression);
+    index = expect_(index, Token_type::close_parenthesis);
+
+    emit_(Instruction{.opcode = Opcode::push_scope, .token_index = for_index});
+    emit_(Instruction{
+        .opcode = Opcode::add_variable, .token_index = assignment_index, .expression = assignment_expression});
+    const size_t loop_pc{emit_(Instruction{
+        .opcode = Opcode::branch_if_false, .token_index = continuation_index, .expression = continuation_expression})};
+    index = compile_block_(index, tc);
+    emit_(Instruction{.opcode = Opcode::set_variable, .token_index = update_index, .expression = update_expression});
+    emit_(Instruction{.opcode = Opcode::jump, .token_index = for_index, .operand = loop_pc});
+    m_program->instructions.at(loop_pc).operand
+        = emit_(Instruction{.opcode = Opcode::pop_scope, .token_index = for_index});
+    return index;
+}
+
+// <if-elif-else-block> ::= <if-block> <opt-elif-blocks> <opt-else-block>
+// <if-block> ::= <if-keyword> <open-parenthesis> <if-expression> <close-parenthesis> <conditional_block>
+// <elif-block> ::= <elif-keyword> <open-parenthesis> <if-expression> <close-parenthesis> <conditional_block>
+// <else-block> ::= <else-keyword> <conditional-block>
+//
+// Each condition branches past its block to the next elif or else when false.  Each block ends by jumping past
+// the remainder of the if-elif-else block.
+size_t Schema_compiler::compile_if_elif_else_block_(size_t index, const Template_context& tc)
+{
+    std::vector<size_t> exit_jumps;
+    Token_type keyword{Token_type::if_keyword};
+    while (keyword == Token_type::if_keyword || keyword == Token_type::elif_keyword) {
+        index = expect_(index + 1, Token_type::open_parenthesis);
+        const size_t condition_index{index};
+        size_t condition_expression{limits::invalid_size};
+        index = compile_expression_(index, {Token_type::close_parenthesis}, condition_expression);
+        index = expect_(index, Token_type::close_parenthesis);
+
+        const size_t branch_pc{emit_(Instruction{
+            .opcode = Opcode::branch_if_false, .token_index = condition_index, .expression = condition_expression})};
+        index = compile_block_(index, tc);
+        exit_jumps.push_back(emit_(Instruction{.opcode = Opcode::jump, .token_index = condition_index}));
+        m_program->instructions.at(branch_pc).operand = m_program->instructions.size();
+
+        keyword = at_(index).type;
+        if (keyword == Token_type::else_keyword) {
+            index = compile_block_(index + 1, tc);
+        }
+    }
+
+    for (const size_t pc : exit_jumps) {
+        m_program->instructions.at(pc).operand = m_program->instructions.size();
+    }
+    return index;
+}
+
+// <struct-definition> ::= <open-brace> <blocks-or-statements> <close-brace>
+// <template-definition> ::= <bracketed-typename> <open-brace> <template-blocks-or-statements> <close-brace>
+void Schema_compiler::compile_routine_(const Pending_routine& pending)
+{
+    m_program->routines.at(pending.routine) = m_program->instructions.size();
+
+    size_t index{pending.definition_index};
+    Template_context tc;
+    if (pending.is_template) {
+        // <bracketed-typename> ::= <open-angle-bracket> <typename> <close-angle-bracket>
+        index = expect_(index, Token_type::open_angle_bracket);
+        tc.type_name = &at_(index);
+        index = expect_(index, Token_type::identifier);
+        index = expect_(index, Token_type::close_angle_bracket);
+        tc.instantiating_type = pending.instantiating_type;
+    }
+
+    // Unlike conditional blocks, struct and template definitions must contain at least one statement.
+    if (at_(index).type == Token_type::open_brace && at_(index + 1).type == Token_type::close_brace) {
+        throw_syntax_error_(index + 1);
+    }
+    index = compile_block_(index, tc);
+    emit_(Instruction{.opcode = Opcode::ret, .token_index = index - 1});
+}
+
+// <block-or-statement> ::= <definition-statement> | <control-block> | <assert-statement>
+// <template-block-or-statement> ::= <template-definition-statement> | <control-block> | <assert-statement>
+// <control-block> ::= <if-elif-else-block> | <for-loop-block>
+size_t Schema_compiler::compile_statement_(size_t index, const Template_context& tc)
+{
+    switch (at_(index).type) {
+    case Token_type::if_keyword:
+        return compile_if_elif_else_block_(index, tc);
+    case Token_type::for_keyword:
+        return compile_for_loop_block_(index, tc);
+    case Token_type::assert_keyword:
+        return compile_assert_statement_(index);
+    default:
+        return compile_definition_statement_(index, tc);
+    }
+}
+
+// Appends instruction to the program and returns its program counter.
+size_t Schema_compiler::emit_(const Instruction& instruction)
+{
+    const size_t pc{m_program->instructions.size()};
+    m_program->instructions.push_back(instruction);
+    return pc;
+}
+
+// Throws if the token at index is not of the expected type; otherwise returns the index of the following token.
+size_t Schema_compiler::expect_(size_t index, Token_type type) const
+{
+    if (at_(index).type != type) {
+        throw_syntax_error_(index);
+    }
+    return index + 1;
+}
+
+// <instantiating-type> ::= <integer-type> | <enum-type> | <string_type-like-type> | <struct-type>
+bool Schema_compiler::is_instantiating_type_(Token_type type)
+{
+    return is_simple_or_struct_type_(type);
+}
+
+bool Schema_compiler::is_simple_or_struct_type_(Token_type type)
+{
+    switch (type) {
+    case Token_type::bool_type:
+    case Token_type::hex_type:
+    case Token_type::int_type:
+    case Token_type::uint_type:
+    case Token_type::enum_type:
+    case Token_type::string_type:
+    case Token_type::u16string_type:
+    case Token_type::md5_type:
+    case Token_type::struct_type:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void Schema_compiler::resolve_operands_()
+{
+    m_is_resolved.assign(m_program->expressions.size(), false);
+    m_node_names.clear();
+    m_variable_names.clear();
+    for (const Definition_statement& statement : m_program->statements) {
+        m_node_names.insert(statement.identifier.symbol);
+    }
+    for (const Instruction& instruction : m_program->instructions) {
+        if (instruction.opcode == Opcode::add_variable) {
+            m_variable_names.insert(at_(instruction.token_index).symbol);
+        }
+    }
+
+    // Routines are compiled in schema order, so the variables of the for-loops enclosing an instruction are those
+    // added, but not yet removed, by the instructions preceding it within its routine.  Each for-loop pushes a scope
+    // and adds one variable, so a variable's slot is the number of for-loops enclosing its own.
+    std::vector<Symbol> locals;
+    for (const size_t routine : m_program->routines) {
+        locals.clear();
+        for (size_t pc = routine; m_program->instructions.at(pc).opcode != Opcode::ret; ++pc) {
+            Instruction& instruction{m_program->instructions[pc]};
+            switch (instruction.opcode) {
+            case Opcode::add_variable:
+                // The variable is added once its initial value has been evaluated.
+                resolve_operands_(instruction.expression, locals);
+                instruction.operand = locals.size();
+                locals.push_back(at_(instruction.token_index).symbol);
+                break;
+
+            case Opcode::assert_true:
+            case Opcode::branch_if_false:
+                resolve_operands_(instruction.expression, locals);
+                break;
+
+            case Opcode::emit:
+                for (const Array_suffix& suffix : m_program->statements.at(instruction.operand).array_suffixes) {
+                    if (suffix.kind == Array_suffix::Kind::standard) {
+                        resolve_operands_(suffix.expression, locals);
+                    }
+                }
+                break;
+
+            case Opcode::pop_scope:
+                locals.pop_back();
+                break;
+
+            case Opcode::set_variable: {
+                resolve_operands_(instruction.expression, locals);
+                const auto it{std::ranges::find(locals, at_(instruction.token_index).symbol)};
+                instruction.operand = it == locals.end() ? limits::invalid_size
+                                                         : gsl::narrow<size_t>(std::distance(locals.begin(), it));
+            } break;
+
+            default:
+                break;
+            }
+        }
+    }
+}
+
+void Schema_compiler::resolve_operands_(size_t expression, const std::vector<Symbol>& locals)
+{
+    // An expression shared by several routines, e.g., by each instantiation of a template, appears at the same place
+    // within each and so is enclosed by the same for-loops.
+    if (m_is_resolved.at(expression)) {
+        return;
+    }
+    m_is_resolved[expression] = true;
+
+    esp::Expression& compiled{m_program->expressions[expression]};
+    for (esp::Operation& operation : compiled.operations) {
+        if (operation.kind != esp::Operation::Kind::variable) {
+            continue;
+        }
+
+        // Names are resolved in the order used by Variable_manager::get: variables, then nodes, then consts.  A name
+        // which isn't a variable of an enclosing for-loop might still name a variable of the routine which ran this
+        // one, so any name used for a variable is left for the variable manager to resolve.
+        if (const auto it{std::ranges::find(locals, operation.symbol)}; it != locals.end()) {
+            operation.kind = esp::Operation::Kind::local_variable;
+            operation.reference = gsl::narrow<size_t>(std::distance(locals.begin(), it));
+        }
+        else if (m_variable_names.contains(operation.symbol)) {
+            continue;
+        }
+        else if (m_node_names.contains(operation.symbol)) {
+            operation.kind = esp::Operation::Kind::node_reference;
+            operation.reference = compiled.node_references.size();
+            compiled.node_references.push_back(esp::Node_reference{.keys = {operation.symbol}});
+        }
+        else if (const auto def{m_definition_table.get_definitions().find(operation.symbol)};
+                 def != m_definition_table.get_definitions().end() && def->second.get_type() == Def_type::const_type) {
+            operation.kind = esp::Operation::Kind::constant;
+            operation.value = def->second.get_members().at(0).value;
+        }
+    }
+
+    // Each node reference is given an entry in the variable manager's node cache.
+    for (esp::Node_reference& reference : compiled.node_references) {
+        reference.slot = m_program->node_reference_count++;
+    }
+}
+
+size_t Schema_compiler::routine_for_struct_(const Token& type)
+{
+    if (const auto it{m_routine_lookup.find(type.value)}; it != m_routine_lookup.end()) {
+        return it->second;
+    }
+
+    const std::string struct_name{identifier_from_type(type.value)};
+    const Def_mem& struct_def{m_definition_table.get_first_member(struct_name, Def_type::struct_type)};
+    const size_t routine{m_program->routines.size()};
+    m_program->routines.push_back(limits::invalid_size);
+    m_routine_lookup.emplace(type.value, routine);
+    m_pending_routines.push_back(Pending_routine{.routine = routine,
+        .definition_index = gsl::narrow<size_t>(struct_def.value),
+        .is_template = false,
+        .instantiating_type = Token{}});
+    return routine;
+}
+
+size_t Schema_compiler::routine_for_template_(const Token& type, const Token& instantiating_type)
+{
+    // The type is either template or alias (toa).  An alias shares the definition of the template it names, so
+    // instantiations are keyed by definition index rather than by name.
+    const std::string toa_name{identifier_from_type(type.value)};
+    const Def_type toa_type{m_definition_table.get_type(toa_name)};
+    const Def_mem& template_def{m_definition_table.get_first_member(toa_name, toa_type)};
+    const size_t template_index{gsl::narrow<size_t>(template_def.value)};
+    const std::string key{std::format("{}<{}>", template_index, instantiating_type.value)};
+    if (const auto it{m_routine_lookup.find(key)}; it != m_routine_lookup.end()) {
+        return it->second;
+    }
+
+    const size_t routine{m_program->routines.size()};
+    m_program->routines.push_back(limits::invalid_size);
+    m_routine_lookup.emplace(key, routine);
+    m_pending_routines.push_back(Pending_routine{.routine = routine,
+        .definition_index = template_index,
+        .is_template = true,
+        .instantiating_type = instantiating_type});
+    return routine;
+}
+
+// Finds where the expression beginning at index ends: at the first terminator not enclosed by parentheses or square
+// brackets.  Returns the index of the terminator.
+size_t Schema_compiler::skip_expression_(size_t index, std::initializer_list<Token_type> terminators) const
+{
+    const size_t begin{index};
+    int nest{0};
+    for (;; ++index) {
+        const Token_type type{at_(index).type};
+        if (nest == 0 && std::ranges::find(terminators, type) != terminators.end()) {
+            break;
+        }
+
+        if (type == Token_type::open_parenthesis || type == Token_type::open_square_bracket) {
+            ++nest;
+        }
+        else if (type == Token_type::close_parenthesis || type == Token_type::close_square_bracket) {
+            if (--nest < 0) {
+                throw_syntax_error_(index);
+            }
+        }
+        else if (type >= Token_type::meta_expression_eos) {
+            throw_syntax_error_(index);
+        }
+    }
+
+    if (index == begin) {
+        throw_syntax_error_(index);
+    }
+    return index;
+}
+
+void Schema_compiler::throw_syntax_error_(size_t index) const
+{
+    const Token& t{at_(index)};
+    throw make_ex<Parser_error>(fmt::syntax_error, t.get_loc(), to_string(t.type));
+}
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,136 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <lib/expression-parser/parser.hpp>
+#include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace c4lib::schema_parser {
+
+// The schema compiler lowers the struct and template definitions found by the phase one parser into a Program.
+// Compilation starts at the root structure and proceeds transitively through each struct and template
+// instantiation used.  Templates are instantiated at compile time: each distinct instantiating type yields its own
+// routine.  Each expression is compiled by the expression parser as it is reached; the tokenizer's index is moved to do
+// so, but the tokens themselves are not altered.  Once every routine has been compiled, the operands of the expressions
+// are resolved to local variable slots, node references and constants so that evaluation need not look names up.
+//
+// The program is interpreted by Parser_phase_two unless Reader_generator has generated a reader for it, in which case
+// the generated reader is run instead.
+class Schema_compiler {
+public:
+    Schema_compiler(Tokenizer& tokenizer, const Def_tbl& def_tbl);
+
+    ~Schema_compiler() = default;
+
+    Schema_compiler(const Schema_compiler&) = delete;
+
+    Schema_compiler& operator=(const Schema_compiler&) = delete;
+
+    Schema_compiler(Schema_compiler&&) noexcept = delete;
+
+    Schema_compiler& operator=(Schema_compiler&&) noexcept = delete;
+
+    // Compiles the schema starting from the structure named by the token at root_name_index and stores the result
+    // in program.  Throws Parser_error if a syntax error is detected.
+    void compile(size_t root_name_index, Program& program);
+
+    // Builds the prototype of each statement of program.  compile builds the prototypes of the program it compiles.
+    // The prototypes hold symbols, which are specific to the process, so they are not cached; build_prototypes must
+    // be called for a program loaded from the schema cache.
+    static void build_prototypes(Program& program);
+
+    // Returns the names of the leaves whose values are read by the expressions of program, including the nodes named
+    // by use_capture suffixes.  For a reference to an array element, e.g., Lengths.[i], the name is that of the
+    // array.  The values of these leaves determine the layout of the save or are checked by asserts.
+    [[nodiscard]] static std::unordered_set<Symbol> get_referenced_node_names(const Program& program);
+
+private:
+    struct Template_context {
+        // Pointer to the type-name token for the template; nullptr when not compiling a template.
+        const Token* type_name{nullptr};
+        // Instantiating type for the template.
+        Token instantiating_type;
+    };
+
+    struct Pending_routine {
+        size_t routine{limits::invalid_size};
+        // Index of the token at which the definition begins: the open brace for a struct and the open angle
+        // bracket for a template.
+        size_t definition_index{limits::invalid_size};
+        bool is_template{false};
+        Token instantiating_type;
+    };
+
+    [[nodiscard]] const Token& at_(size_t index) const;
+
+    size_t compile_array_suffix_(size_t index, Array_suffix& suffix);
+
+    size_t compile_assert_statement_(size_t index);
+
+    size_t compile_block_(size_t index, const Template_context& tc);
+
+    size_t compile_definition_statement_(size_t index, const Template_context& tc);
+
+    size_t compile_expression_(size_t index, std::initializer_list<Token_type> terminators, size_t& expression);
+
+    size_t compile_for_loop_block_(size_t index, const Template_context& tc);
+
+    size_t compile_if_elif_else_block_(size_t index, const Template_context& tc);
+
+    void compile_routine_(const Pending_routine& pending);
+
+    size_t compile_statement_(size_t index, const Template_context& tc);
+
+    size_t emit_(const Instruction& instruction);
+
+    // Resolves the operands of each expression of the program.  See Expression.
+    void resolve_operands_();
+
+    // Resolves the operands of expression, which is evaluated within the for-loops whose variables are locals.
+    void resolve_operands_(size_t expression, const std::vector<Symbol>& locals);
+
+    size_t expect_(size_t index, Token_type type) const;
+
+    [[nodiscard]] static bool is_instantiating_type_(Token_type type);
+
+    [[nodiscard]] static bool is_simple_or_struct_type_(Token_type type);
+
+    size_t routine_for_struct_(const Token& type);
+
+    size_t routine_for_template_(const Token& type, const Token& instantiating_type);
+
+    size_t skip_expression_(size_t index, std::initializer_list<Token_type> terminators) const;
+
+    [[noreturn]] void throw_syntax_error_(size_t index) const;
+
+    const Def_tbl& m_definition_table;
+    // Maps the index of the first token of each expression compiled to its index within Program::expressions.
+    std::unordered_map<size_t, size_t> m_expression_lookup;
+    // True for each expression whose operands have been resolved.
+    std::vector<bool> m_is_resolved;
+    // Names of the nodes emitted by the program and of the variables of its for-loops.
+    std::unordered_set<Symbol> m_node_names;
+    std::unordered_set<Symbol> m_variable_names;
+    c4lib::expression_parser::Parser m_expression_parser;
+    std::deque<Pending_routine> m_pending_routines;
+    Program* m_program{nullptr};
+    // Maps struct names and template instantiations to routine indices.
+    std::unordered_map<std::string, size_t> m_routine_lookup;
+    Tokenizer& m_tokenizer;
+};
+
+} // namespace c4lib::schema_parser
@@ -186,7 +186,7 @@ const std::string& to_string(Token_type type)
     return token_type_names.at(index).second;
 }
 
-std::string token_type_to_node_type_as_string(Token_type type)
+cpt::Node_type token_type_to_node_type(Token_type type)
 {
     // Ensure that order of Token_type enumerators matches that of Node_type.
     constexpr int offset{static_cast<int>(Token_type::bool_type) - static_cast<int>(cpt::Node_type::bool_type)};
@@ -207,7 +207,11 @@ std::string token_type_to_node_type_as_string(Token_type type)
         static_cast<int>(Token_type::template_type) == static_cast<int>(cpt::Node_type::template_type) + offset);
 
     // The above assertions ensure that we can use simple arithmetic to convert a Token_type to Node_type.
-    const cpt::Node_type node_type{static_cast<int>(type) - offset};
-    return cpt::node_type_as_string(node_type);
+    return cpt::Node_type{static_cast<int>(type) - offset};
+}
+
+std::string token_type_to_node_type_as_string(Token_type type)
+{
+    return cpt::node_type_as_string(token_type_to_node_type(type));
 }
 } // namespace c4lib::schema_parser
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <include/node-type.hpp>
 #include <string>
 #include <utility>
 
@@ -141,6 +142,8 @@ const std::pair<Token_type, Token_type>& get_punc_pair(Token_type punc);
 
 const std::string& to_string(Token_type type);
 
+property_tree::Node_type token_type_to_node_type(Token_type type);
+
 std::string token_type_to_node_type_as_string(Token_type type);
 
 } // namespace c4lib::schema_parser
@@ -9,6 +9,8 @@
 #include <lib/schema-parser/token-type.hpp>
 #include <lib/util/file-location.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/location-table.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <lib/util/text.hpp>
 #include <string>
 #include <utility>
@@ -21,16 +23,42 @@ public:
 
     Token(Token_type token_type_, std::string value_)
         : index(limits::invalid_size), type(token_type_), value(std::move(value_))
-    {}
+    {
+        intern();
+    }
 
-    Token(Token_type token_type_, std::string value_, File_location loc_, size_t index_)
-        : index(index_), loc(std::move(loc_)), type(token_type_), value(std::move(value_))
-    {}
+    Token(Token_type token_type_, std::string value_, const File_location& loc_, size_t index_)
+        : index(index_), location(location_table::add(loc_)), type(token_type_), value(std::move(value_))
+    {
+        intern();
+    }
+
+    Token(Token_type token_type_, std::string value_, Location location_, size_t index_)
+        : index(index_), location(location_), type(token_type_), value(std::move(value_))
+    {
+        intern();
+    }
+
+    // Returns the location at which the token was found.  Locations are resolved only when needed, e.g., to report
+    // an error, since tokens hold a compact reference to their location.
+    [[nodiscard]] File_location get_loc() const
+    {
+        return location_table::get(location);
+    }
+
+    // Sets symbol from value if the token is an identifier.
+    void intern()
+    {
+        symbol = type == Token_type::identifier ? symbol_table::intern(value) : invalid_symbol;
+    }
 
     // Index within the token vector at which this token is found
     size_t index{limits::invalid_size};
     // Location at which the token was found.  Useful for debugging.
-    File_location loc;
+    Location location;
+    // Symbol of value for identifier tokens; invalid_symbol for other tokens.  Used to look up variables without
+    // hashing value.
+    Symbol symbol{invalid_symbol};
     Token_type type{Token_type::invalid};
     std::string value;
 };
@@ -38,7 +66,7 @@ public:
 inline std::ostream& operator<<(std::ostream& out, const Token& token)
 {
     std::string message{"Token: " + to_string(token.type) + "; Value: " + token.value};
-    text::add_location_to_message(message, token.loc);
+    text::add_location_to_message(message, token.get_loc());
     return out << message;
 }
 
@@ -4,11 +4,14 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <format>
-#include <fstream>
 #include <include/exceptions.hpp>
 #include <ios>
 #include <iosfwd>
+#include <istream>
+#include <iterator>
+#include <lib/native/mapped-file.hpp>
 #include <lib/schema-parser/token-type.hpp>
 #include <lib/schema-parser/token.hpp>
 #include <lib/schema-parser/tokenizer-constants.hpp>
@@ -16,10 +19,13 @@
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/file-location.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/location-table.hpp>
+#include <lib/util/narrow.hpp>
 #include <memory>
 #include <regex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace c4lib::schema_parser {
@@ -67,48 +73,18 @@ void Tokenizer::run(const std::string& filename)
 {
     check_bad_();
     set_filename(filename);
-    std::ifstream in(filename, std::ios_base::in);
-    if (!in) {
-        throw std::runtime_error{std::format(fmt::runtime_error_opening_file, filename)};
-    }
-    run(in);
+    const native::Mapped_file file{filename};
+    run_(file.text());
 }
 
 void Tokenizer::run(std::istream& in)
 {
     check_bad_();
-    reset();
-    auto filename{std::make_shared<std::string>(get_filename())};
-    size_t lineNumber{0};
-    while (in) {
-        auto line{std::make_shared<std::string>()};
-        std::getline(in, *line);
-        lineNumber++;
-        if (line->length() > limits::max_schema_line_length) {
-            const File_location loc{filename, line, lineNumber, 1};
-            throw make_ex<Tokenizer_error>(fmt::line_exceeds_maximum_length, loc, limits::max_schema_line_length);
-        }
-
-        size_t start{0};
-        while (skip_whitespace_(*line, start)) {
-            const File_location loc{filename, line, lineNumber, start + 1};
-            m_stream.emplace_back(Token_type::invalid, "", loc, m_stream.size());
-            Token& token{m_stream.back()};
-            get_token_(*line, start, token);
-
-            // Comments are not stored in the token stream.
-            if (token.type == Token_type::double_slash) {
-                m_stream.pop_back();
-            }
-        }
-    }
+    const std::string text{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
     if (in.bad()) {
         throw std::runtime_error{std::format(fmt::runtime_error_reading_from_file, get_filename())};
     }
-
-    // Mark the end of the token stream with the end-of-stream meta token.
-    const File_location end_of_file{filename, std::make_shared<std::string>(""), lineNumber + 1, 1};
-    m_stream.emplace_back(Token_type::meta_eos, "$", end_of_file, m_stream.size());
+    run_(text);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -121,7 +97,7 @@ void Tokenizer::check_number_(Token& token)
     // precaution.
     if (token.value.length() > limits::max_number_length) {
         throw make_ex<Tokenizer_error>(
-            fmt::number_exceeds_maximum_length, token.loc, token.value, limits::max_number_length);
+            fmt::number_exceeds_maximum_length, token.get_loc(), token.value, limits::max_number_length);
     }
 
     token.type = Token_type::numeric_literal;
@@ -132,7 +108,7 @@ void Tokenizer::disambiguate_name_(Token& token)
     // Check length of identifier
     if (token.value.length() > limits::max_identifier_length) {
         throw make_ex<Tokenizer_error>(
-            fmt::identifier_exceeds_maximum_length, token.loc, token.value, limits::max_identifier_length);
+            fmt::identifier_exceeds_maximum_length, token.get_loc(), token.value, limits::max_identifier_length);
     }
 
     // Check for function name
@@ -155,6 +131,7 @@ void Tokenizer::disambiguate_name_(Token& token)
 
     // If it's not a keyword, and it's not a type, it's an identifier
     token.type = Token_type::identifier;
+    token.intern();
 }
 
 void Tokenizer::disambiguate_punc_or_op_(Token& token)
@@ -196,7 +173,7 @@ void Tokenizer::get_token_(const std::string& line, size_t& start, Token& token)
         }
         return;
     }
-    throw make_ex<Tokenizer_error>(fmt::invalid_token, token.loc, line[start]);
+    throw make_ex<Tokenizer_error>(fmt::invalid_token, token.get_loc(), line[start]);
 }
 
 bool Tokenizer::match_comment_(const std::string& line, size_t start, Token& token)
@@ -264,7 +241,7 @@ bool Tokenizer::match_string_literal_(const std::string& line, size_t start, Tok
 
             // Check length of string literal.
             if (token.value.length() > limits::max_string_literal_length) {
-                throw make_ex<Tokenizer_error>(fmt::string_literal_exceeds_maximum_length, token.loc, token.value,
+                throw make_ex<Tokenizer_error>(fmt::string_literal_exceeds_maximum_length, token.get_loc(), token.value,
                     limits::max_string_literal_length);
             }
 
@@ -299,6 +276,58 @@ bool Tokenizer::match_using_regex_(
     return false;
 }
 
+void Tokenizer::run_(std::string_view text)
+{
+    reset();
+    auto filename{std::make_shared<std::string>(get_filename())};
+    size_t lineNumber{0};
+    size_t line_begin{0};
+    bool is_last_line{false};
+    while (!is_last_line) {
+        size_t line_end{text.find('\n', line_begin)};
+        if (line_end == std::string_view::npos) {
+            line_end = text.length();
+            is_last_line = true;
+        }
+        std::string_view line_text{text.substr(line_begin, line_end - line_begin)};
+        if (line_text.ends_with('\r')) {
+            line_text.remove_suffix(1);
+        }
+        line_begin = line_end + 1;
+
+        auto line{std::make_shared<std::string>(line_text)};
+        lineNumber++;
+        if (line->length() > limits::max_schema_line_length) {
+            const File_location loc{filename, line, lineNumber, 1};
+            throw make_ex<Tokenizer_error>(fmt::line_exceeds_maximum_length, loc, limits::max_schema_line_length);
+        }
+
+        // The line is added to the location table once; each token then refers to it by index.
+        Location line_location;
+        bool is_line_added{false};
+        size_t start{0};
+        while (skip_whitespace_(*line, start)) {
+            if (!is_line_added) {
+                line_location = location_table::add(File_location{filename, line, lineNumber, 1});
+                is_line_added = true;
+            }
+            line_location.character_number = gsl::narrow<uint32_t>(start + 1);
+            m_stream.emplace_back(Token_type::invalid, "", line_location, m_stream.size());
+            Token& token{m_stream.back()};
+            get_token_(*line, start, token);
+
+            // Comments are not stored in the token stream.
+            if (token.type == Token_type::double_slash) {
+                m_stream.pop_back();
+            }
+        }
+    }
+
+    // Mark the end of the token stream with the end-of-stream meta token.
+    const File_location end_of_file{filename, std::make_shared<std::string>(""), lineNumber + 1, 1};
+    m_stream.emplace_back(Token_type::meta_eos, "$", end_of_file, m_stream.size());
+}
+
 bool Tokenizer::skip_whitespace_(const std::string& line, size_t& start)
 {
     start = line.find_first_not_of(whitespace, start);
@@ -14,7 +14,9 @@
 #include <lib/util/limits.hpp>
 #include <lib/util/tune.hpp>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace c4lib::schema_parser {
@@ -131,13 +133,13 @@ public:
     // Replaces the current token, which must be of type identifier with type.  Throws an exception if the
     // current token is not of type identifier or if a replacement is already in force.  Only one replacement
     // is allowed at a time.  The replacement can be restored using restore_type_name_token.  The pair of
-    // functions - replace_type_name_token and restore_type_name_token - are used by the phase 2 parser to
-    // instantiate templates
+    // functions - replace_type_name_token and restore_type_name_token - may be used to instantiate templates by
+    // substituting the instantiating type for the typename in the token stream
     void replace_type_name_token(const Token& type)
     {
         check_bad_();
         if (m_replaced_type_name.type != Token_type::invalid || peek().type != Token_type::identifier) {
-            throw make_ex<Tokenizer_error>(fmt::replace_typename_error, type.loc);
+            throw make_ex<Tokenizer_error>(fmt::replace_typename_error, type.get_loc());
         }
         m_replaced_type_name = peek();
         m_stream.at(m_index) = type;
@@ -172,10 +174,10 @@ public:
         m_index = 0;
     }
 
-    // Calls setFile(filename), opens filename and creates an ifstream.  Then calls run(ifstream).
+    // Calls set_filename(filename), maps filename into memory and tokenizes its content in place.
     void run(const std::string& filename);
 
-    // Reads lines from in, performs tokenization and generates the token stack.
+    // Reads in, performs tokenization and generates the token stack.
     void run(std::istream& in);
 
     void set_filename(const std::string& filename)
@@ -194,6 +196,19 @@ public:
         m_index = index;
     }
 
+    // Replaces the token stack with tokens previously obtained from get_tokens, e.g., tokens loaded from the
+    // schema cache, and rewinds the stream.  Identifiers are interned since symbols are not persistent.
+    void set_tokens(std::vector<Token> tokens)
+    {
+        m_bad = false;
+        m_replaced_type_name = Token();
+        m_stream = std::move(tokens);
+        for (Token& token : m_stream) {
+            token.intern();
+        }
+        rewind();
+    }
+
 private:
     void check_bad_() const
     {
@@ -241,6 +256,10 @@ private:
     static bool match_using_regex_(
         const std::string& line, size_t start, Token& token, const std::string& regex, void (*disambiguate)(Token&));
 
+    // Splits text into lines, performs tokenization and generates the token stack.  A trailing carriage return is
+    // removed from each line.
+    void run_(std::string_view text);
+
     // Beginning at start, searches for the first non-whitespace character.  If found, updates start to this
     // location and returns true.  If not found, sets start to std::string::npos and returns false.
     static bool skip_whitespace_(const std::string& line, size_t& start);
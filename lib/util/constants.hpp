@@ -55,6 +55,8 @@ inline constexpr const char* enum_definitions_filename{"EnumDefinitions"};
 inline constexpr const char* definitions_extension{".txt"};
 inline constexpr const char* crash_dump_extension{".crash-dump.info"};
 inline constexpr const char* info_extension{".info"};
+inline constexpr const char* save_extension{".CivBeyondSwordSave"};
+inline constexpr const char* schema_cache_extension{".cache"};
 inline constexpr const char* translation_extension{".txt"};
 
 // Lengths
@@ -29,11 +29,13 @@ inline constexpr const char* bad_type_invalid_size{"Bad type.  Invalid size: '{}
 inline constexpr const char* bad_type_size_missing{"Bad type.  Size missing: '{}'."};
 inline constexpr const char* bad_type_underscore_missing{"Bad type.  Underscore missing: '{}'."};
 inline constexpr const char* const_definition_exists{"Duplicated const name '{}' during import."};
+inline constexpr const char* cv_init_core_not_scanned{"CvInitCore has not been scanned."};
 inline constexpr const char* definition_does_not_exist{"Definition for '{}' does not exist."};
 inline constexpr const char* dereference_of_iterator_at_end{"Error - deference of iterator at end."};
 inline constexpr const char* duplicated_name{"Duplicated name '{}' during import."};
 inline constexpr const char* enum_definition_exists{"Duplicated enum name '{}' during import."};
 inline constexpr const char* enumerator_not_found{"Enumerator {}.{} not found."};
+inline constexpr const char* enumerator_value_not_found{"{} is not a value of enum {} in {}."};
 inline constexpr const char* export_of_type_not_supported{"Export of definition type {} not supported."};
 inline constexpr const char* failure_importing_const{"Failure importing const '{}'."};
 inline constexpr const char* failure_importing_enum{"Failure importing enum '{}'."};
@@ -51,14 +53,19 @@ inline constexpr const char* malformed_enumerator_reference{"Malformed enumerato
 inline constexpr const char* mismatched_type_names{
     "Typename from template definition '{}' does not match typename from statement '{}'"};
 inline constexpr const char* missing_file{"Cannot find '{}'."};
+inline constexpr const char* missing_xml_element{"Element '{}' missing from XML path '{}'."};
 inline constexpr const char* narrowing_error{"Narrowing error."};
 inline constexpr const char* no_led{"No left denotation for token '{}'."};
 inline constexpr const char* no_nud{"No null denotation for token '{}'."};
+inline constexpr const char* node_cannot_be_patched{"Node '{}' of type {} cannot be patched."};
+inline constexpr const char* node_referenced_by_schema{
+    "Node '{}' cannot be patched because the schema refers to its value."};
 inline constexpr const char* node_not_found{"Node '{}' not found."};
 inline constexpr const char* node_source_error{"Error parsing token {}."};
 inline constexpr const char* null_pointer_error{"Null pointer error."};
 inline constexpr const char* number_exceeds_maximum_length{"Number '{}' exceeds maximum length {}."};
 inline constexpr const char* out_of_range_error{"{} out of range in {}."};
+inline constexpr const char* parser_not_prepared{"Parser used before Parser::prepare was called."};
 inline constexpr const char* parser_skip_error{"Error skipping past tokens.  Expected {}: actual {}."};
 inline constexpr const char* replace_typename_error{"Error replacing typename."};
 inline constexpr const char* referenced_node_not_int{"Referenced node '{}' is not of type int."};
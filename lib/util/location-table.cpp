@@ -0,0 +1,101 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <lib/util/file-location.hpp>
+#include <lib/util/location-table.hpp>
+#include <lib/util/narrow.hpp>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+struct Line {
+    std::shared_ptr<const std::string> filename;
+    std::shared_ptr<const std::string> text;
+    size_t line_number{0};
+};
+
+// Views of the strings held by a Line.  The strings are immutable and owned by the table, so the views remain valid.
+struct Line_key {
+    std::string_view filename;
+    std::string_view text;
+    size_t line_number{0};
+
+    bool operator==(const Line_key&) const = default;
+};
+
+struct Line_key_hash {
+    size_t operator()(const Line_key& key) const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+        constexpr size_t multiplier{0x9E3779B97F4A7C15ULL};
+        size_t hash{std::hash<std::string_view>{}(key.filename)};
+        hash = hash * multiplier ^ std::hash<std::string_view>{}(key.text);
+        return hash * multiplier ^ key.line_number;
+    }
+};
+
+struct Table {
+    Table()
+    {
+        // Line 0 is the line of the default File_location.
+        const c4lib::File_location loc;
+        const Line& line{lines.emplace_back(loc.filename, loc.line, loc.line_number)};
+        ids.emplace(Line_key{*line.filename, *line.text, line.line_number}, 0);
+    }
+
+    std::shared_mutex mutex;
+    // A deque is used so that adding lines does not move those already held.
+    std::deque<Line> lines;
+    std::unordered_map<Line_key, uint32_t, Line_key_hash> ids;
+};
+
+Table& get_table_()
+{
+    static Table table;
+    return table;
+}
+} // namespace
+
+namespace c4lib::location_table {
+
+Location add(const File_location& loc)
+{
+    const Line_key key{*loc.filename, *loc.line, loc.line_number};
+    const auto character_number{gsl::narrow<uint32_t>(loc.character_number)};
+    Table& table{get_table_()};
+    {
+        const std::shared_lock lock{table.mutex};
+        if (const auto it{table.ids.find(key)}; it != table.ids.end()) {
+            return Location{it->second, character_number};
+        }
+    }
+
+    const std::unique_lock lock{table.mutex};
+    // Another thread may have added the line after the shared lock was released.
+    if (const auto it{table.ids.find(key)}; it != table.ids.end()) {
+        return Location{it->second, character_number};
+    }
+    const auto id{gsl::narrow<uint32_t>(table.lines.size())};
+    const Line& line{table.lines.emplace_back(loc.filename, loc.line, loc.line_number)};
+    table.ids.emplace(Line_key{*line.filename, *line.text, line.line_number}, id);
+    return Location{id, character_number};
+}
+
+File_location get(Location location)
+{
+    Table& table{get_table_()};
+    const std::shared_lock lock{table.mutex};
+    const Line& line{table.lines.at(location.line)};
+    return File_location{line.filename, line.text, line.line_number, location.character_number};
+}
+
+} // namespace c4lib::location_table
@@ -0,0 +1,33 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstdint>
+#include <lib/util/file-location.hpp>
+
+namespace c4lib {
+
+// Compact reference to a File_location held by location_table: the index of the source line within the table and the
+// character number within the line.  Tokens hold a Location rather than a File_location so that they may be copied
+// without touching reference counts.  A default-constructed Location refers to the default File_location.
+struct Location {
+    uint32_t line{0};
+    uint32_t character_number{1};
+};
+
+} // namespace c4lib
+
+// Process-wide table of the source lines to which locations refer.  Each line is identified by its filename, line
+// number and text and is held once however many times it is added, so tokenizing the same schema again does not grow
+// the table.  The functions are thread-safe.
+namespace c4lib::location_table {
+
+// Returns the location of loc, adding its line to the table if the line has not already been added.
+Location add(const File_location& loc);
+
+// Returns the File_location to which location refers.
+File_location get(Location location);
+
+} // namespace c4lib::location_table
@@ -63,6 +63,56 @@ inline const hopts::Option_info use_modular_loading_option_info{.name = "USE_MOD
     .required = false,
     .depends_on = {}};
 
+inline const hopts::Option_info schema_cache_dir_option_info{.name = "SCHEMA_CACHE_DIR",
+    .help_type = "<path>",
+    .help_meaning = "Directory in which the compiled schema and imported definitions are cached.  Speeds up "
+                    "subsequent loads which use the same schema and assets.  If not specified, no cache is used.",
+    .help_sort_order = 370,
+    .type = hopts::Option_type::text,
+    .default_value = "",
+    .required = false,
+    .depends_on = {}};
+
+inline const hopts::Option_info worker_count_option_info{.name = "WORKER_COUNT",
+    .help_type = "<count>",
+    .help_meaning = "Number of threads used to read saves concurrently when loading a batch of saves.  If not "
+                    "specified or not positive, one thread per hardware thread is used.",
+    .help_sort_order = 380,
+    .type = hopts::Option_type::integer,
+    .default_value = "0",
+    .required = false,
+    .depends_on = {}};
+
+inline const hopts::Option_info import_worker_count_option_info{.name = "IMPORT_WORKER_COUNT",
+    .help_type = "<count>",
+    .help_meaning = "Number of threads used to import definitions.  If not specified or not positive, one thread per "
+                    "hardware thread is used.",
+    .help_sort_order = 385,
+    .type = hopts::Option_type::integer,
+    .default_value = "0",
+    .required = false,
+    .depends_on = {}};
+
+inline const hopts::Option_info pipelined_read_option_info{.name = "PIPELINED_READ",
+    .help_type = "[0|1]",
+    .help_meaning = "Set to 1 to inflate a save on a separate thread while it is read.  Reduces the time taken and "
+                    "the memory used to read large saves.",
+    .help_sort_order = 390,
+    .type = hopts::Option_type::boolean,
+    .default_value = "0",
+    .required = false,
+    .depends_on = {}};
+
+inline const hopts::Option_info deflate_checkpoints_option_info{.name = "DEFLATE_CHECKPOINTS",
+    .help_type = "[0|1]",
+    .help_meaning = "Set to 1 for a session to record checkpoints while writing a save.  Reduces the time taken to "
+                    "write a save which differs only slightly from the save previously written.",
+    .help_sort_order = 400,
+    .type = hopts::Option_type::boolean,
+    .default_value = "0",
+    .required = false,
+    .depends_on = {}};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // TRANSLATION - OPTIONAL
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -134,6 +184,11 @@ inline const std::unordered_map<std::string, hopts::Option_info> lib_options_inf
     {schema_option_info.name, schema_option_info},
     {mod_name_option_info.name, mod_name_option_info},
     {use_modular_loading_option_info.name, use_modular_loading_option_info},
+    {schema_cache_dir_option_info.name, schema_cache_dir_option_info},
+    {worker_count_option_info.name, worker_count_option_info},
+    {import_worker_count_option_info.name, import_worker_count_option_info},
+    {pipelined_read_option_info.name, pipelined_read_option_info},
+    {deflate_checkpoints_option_info.name, deflate_checkpoints_option_info},
 
     {omit_offset_column_option_info.name, omit_offset_column_option_info},
     {omit_hex_column_option_info.name, omit_hex_column_option_info},
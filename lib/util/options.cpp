@@ -0,0 +1,24 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <cstddef>
+#include <lib/util/options.hpp>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace c4lib::options {
+
+size_t get_worker_count(const std::unordered_map<std::string, std::string>& options, const char* option)
+{
+    const auto it{options.find(option)};
+    const int worker_count{it == options.end() || it->second.empty() ? 0 : std::stoi(it->second)};
+    if (worker_count <= 0) {
+        return std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t{1});
+    }
+    return static_cast<size_t>(worker_count);
+}
+
+} // namespace c4lib::options
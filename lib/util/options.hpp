@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
 namespace c4lib::options {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +52,32 @@ inline constexpr const char* debug_write_imports{"DEBUG_WRITE_IMPORTS"};
 // Optional: Name of mod associated with the save.  Leave blank if the save isn't for a mod.
 inline constexpr const char* mod_name{"MOD_NAME"};
 
+// Optional: Name of directory in which the compiled schema and imported definitions are cached.  Leave blank to
+// disable the cache.
+inline constexpr const char* schema_cache_dir{"SCHEMA_CACHE_DIR"};
+
 // Optional: Set to "1" if modular loading should be used.  Leave blank to use normal loading.
 inline constexpr const char* use_modular_loading{"USE_MODULAR_LOADING"};
+
+// Optional: Number of threads used by read_saves to read saves concurrently.  Leave blank or set to "0" to use one
+// thread per hardware thread.
+inline constexpr const char* worker_count{"WORKER_COUNT"};
+
+// Optional: Number of threads used to import definitions.  Leave blank or set to "0" to use one thread per hardware
+// thread.
+inline constexpr const char* import_worker_count{"IMPORT_WORKER_COUNT"};
+
+// Optional: Set to "1" to inflate a save on a separate thread while it is read.  Inflated data is passed to the reader
+// through a bounded ring of buffers, so the inflated save is never held in memory in its entirety.
+inline constexpr const char* pipelined_read{"PIPELINED_READ"};
+
+// Optional: Set to "1" for a Session to record deflate checkpoints as it writes a save.  A subsequent write of a similar
+// save resumes compression from the checkpoint preceding the first changed byte, reusing the compressed data before it.
+inline constexpr const char* deflate_checkpoints{"DEFLATE_CHECKPOINTS"};
+
+// Returns the number of threads set by option, a thread count option such as WORKER_COUNT.  If option is absent,
+// blank or not positive, returns the number of hardware threads, or 1 if that is unknown.  Throws
+// std::invalid_argument if the option is not an integer.
+[[nodiscard]] size_t get_worker_count(const std::unordered_map<std::string, std::string>& options, const char* option);
+
 } // namespace c4lib::options
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+namespace {
+// Interned strings are held in chunks, chunk k holding first_chunk_size << k strings, so that strings never move and
+// the chunk holding a symbol's string is found from the symbol alone.  Enough chunks are provided for every symbol.
+constexpr size_t first_chunk_bits{10};
+constexpr uint64_t first_chunk_size{uint64_t{1} << first_chunk_bits};
+constexpr size_t chunk_count{33 - first_chunk_bits};
+
+struct Table {
+    // Guards symbols, count and the creation of chunks.  Reading a string, once its symbol is known, needs no lock:
+    // the string is written before its symbol is published and is never modified afterwards.
+    std::shared_mutex mutex;
+    std::array<std::atomic<std::string*>, chunk_count> chunks{};
+    std::array<std::unique_ptr<std::string[]>, chunk_count> chunk_owners;
+    size_t count{0};
+    // Maps each interned string, viewed in its chunk, to its symbol.
+    std::unordered_map<std::string_view, c4lib::Symbol> symbols;
+};
+
+Table& get_table_()
+{
+    static Table table;
+    return table;
+}
+
+// Sets chunk and offset to the location of the string for symbol.
+void locate_(uint64_t symbol, size_t& chunk, size_t& offset)
+{
+    const uint64_t position{symbol + first_chunk_size};
+    chunk = static_cast<size_t>(std::bit_width(position)) - first_chunk_bits - 1;
+    offset = static_cast<size_t>(position - (first_chunk_size << chunk));
+}
+} // namespace
+
+namespace c4lib::symbol_table {
+
+Symbol find(std::string_view name)
+{
+    Table& table{get_table_()};
+    const std::shared_lock lock{table.mutex};
+    const auto it{table.symbols.find(name)};
+    return it == table.symbols.end() ? invalid_symbol : it->second;
+}
+
+Symbol intern(std::string_view name)
+{
+    if (const Symbol symbol{find(name)}; symbol != invalid_symbol) {
+        return symbol;
+    }
+
+    Table& table{get_table_()};
+    const std::unique_lock lock{table.mutex};
+    // Another thread may have interned name after the shared lock was released.
+    if (const auto it{table.symbols.find(name)}; it != table.symbols.end()) {
+        return it->second;
+    }
+    const auto symbol{gsl::narrow<Symbol>(table.count)};
+    size_t chunk{0};
+    size_t offset{0};
+    locate_(symbol, chunk, offset);
+    if (offset == 0) {
+        table.chunk_owners.at(chunk) = std::make_unique<std::string[]>(first_chunk_size << chunk);
+        table.chunks.at(chunk).store(table.chunk_owners.at(chunk).get(), std::memory_order_release);
+    }
+    std::string& interned{table.chunk_owners.at(chunk)[offset]};
+    interned = name;
+    table.symbols.emplace(interned, symbol);
+    ++table.count;
+    return symbol;
+}
+
+const std::string& name(Symbol symbol)
+{
+    size_t chunk{0};
+    size_t offset{0};
+    locate_(symbol, chunk, offset);
+    return get_table_().chunks.at(chunk).load(std::memory_order_acquire)[offset];
+}
+
+Symbol subscript(size_t index)
+{
+    // Entries hold the symbol plus one so that zero marks an index whose symbol has not been cached.  Interning is
+    // idempotent, so threads racing to fill an entry store the same value.
+    static std::vector<std::atomic<uint64_t>> cache(limits::max_array_dimension);
+    if (index >= cache.size()) {
+        return intern("[" + std::to_string(index) + "]");
+    }
+    std::atomic<uint64_t>& entry{cache[index]};
+    if (const uint64_t cached{entry.load(std::memory_order_relaxed)}; cached != 0) {
+        return static_cast<Symbol>(cached - 1);
+    }
+    const Symbol symbol{intern("[" + std::to_string(index) + "]")};
+    entry.store(uint64_t{symbol} + 1, std::memory_order_relaxed);
+    return symbol;
+}
+
+} // namespace c4lib::symbol_table
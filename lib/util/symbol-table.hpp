@@ -0,0 +1,30 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <include/symbol.hpp>
+#include <string>
+#include <string_view>
+
+// Process-wide table of interned strings.  Strings are never removed, so a symbol and the string it stands for remain
+// valid for the lifetime of the process.  The functions are thread-safe.  find and intern lock the table; name does
+// not, so that the string for a symbol may be obtained on hot paths without contention.
+namespace c4lib::symbol_table {
+
+// Returns the symbol for name or invalid_symbol if name has not been interned.
+Symbol find(std::string_view name);
+
+// Returns the symbol for name, interning name if it has not already been interned.
+Symbol intern(std::string_view name);
+
+// Returns the string for which symbol stands.  symbol must have been returned by intern.
+const std::string& name(Symbol symbol);
+
+// Returns the symbol for the name of the array element at index, e.g., [3].  Symbols for indices within
+// limits::max_array_dimension are cached, so that the table is locked only the first time an index is seen.
+Symbol subscript(size_t index);
+
+} // namespace c4lib::symbol_table
@@ -17,6 +17,22 @@ inline constexpr size_t definition_reserve_size{512};
 // 64K Buffer for MD5 data.  64K chosen because this is the size of a civ4 compressed data chuck.
 inline constexpr size_t md5_buffer_size{0x10000};
 
+// Ratio of the reserved size of an inflated (composite) savegame to the size of the savegame.  The saves in
+// test/data/saves inflate to between 10 and 48 times their size; 16 covers late-game saves, which are the largest,
+// without reallocation.
+inline constexpr size_t inflate_reserve_ratio{16};
+
+// Number and size of the buffers in the ring through which a pipelined read passes inflated data from the inflating
+// thread to the reader.  A 64K chunk of compressed data typically inflates to several hundred kilobytes, so four 256K
+// buffers let the inflating thread stay about a chunk ahead of the reader while bounding memory use to 1M.
+inline constexpr size_t pipeline_buffer_count{4};
+inline constexpr size_t pipeline_buffer_size{0x40000};
+
+// Number of bytes of inflated data between deflate checkpoints.  Each checkpoint holds a copy of the deflater's state,
+// about 256K, so a 512K interval bounds the memory used by checkpoints to half the size of the inflated save while
+// limiting the data deflated again after a change to at most 512K.
+inline constexpr size_t deflate_checkpoint_interval{0x80000};
+
 // When the schema-processor parses the BTS schema, somewhat over 4000 tokens are generated.  Reserve space for 8192
 // tokens to avoid token vector resizing.
 inline constexpr size_t schema_token_vector_reserve_size{8192};
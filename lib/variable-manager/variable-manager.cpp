@@ -2,42 +2,98 @@
 // This software is licensed under the MIT License.
 // Created by Hankinsohl on 11/13/2024.
 
+#include <algorithm>
 #include <array>
-#include <boost/property_tree/ptree.hpp>
+#include <cassert>
+#include <charconv>
 #include <cstddef>
 #include <format>
 #include <include/exceptions.hpp>
-#include <include/node-attributes.hpp>
 #include <include/node-type.hpp>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/ptree/node-emitter.hpp>
 #include <lib/schema-parser/def-mem.hpp>
 #include <lib/util/exception-formats.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <lib/variable-manager/variable-manager.hpp>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
-namespace bpt = boost::property_tree;
 namespace cpt = c4lib::property_tree;
 namespace csp = c4lib::schema_parser;
+namespace esp = c4lib::expression_parser;
+
+namespace {
+// Forms the name of a node from keys and subscripts as described for Variable_manager::get.
+std::string join_(std::span<const c4lib::Symbol> keys, std::span<const int> subscripts)
+{
+    std::string variable;
+    size_t subscript_index{0};
+    for (const c4lib::Symbol key : keys) {
+        if (!variable.empty()) {
+            variable += '.';
+        }
+        if (key == c4lib::invalid_symbol) {
+            variable += std::format("[{}]", subscripts[subscript_index++]);
+        }
+        else {
+            variable += c4lib::symbol_table::name(key);
+        }
+    }
+    return variable;
+}
+} // namespace
 
 namespace c4lib {
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void Variable_manager::add(const std::string& variable, const int value)
 {
     if (variable.find_first_of('.') != std::string::npos) {
         throw Variable_manager_error(std::format(fmt::variable_name_contains_dot, variable));
     }
-    if (m_lookup.contains(variable)) {
-        throw Variable_manager_error(std::format(fmt::add_variable_error, variable));
+    add(symbol_table::intern(variable), value);
+}
+
+void Variable_manager::add(Symbol variable, const int value)
+{
+    assert(variable != invalid_symbol);
+    if (!m_lookup.try_emplace(variable, m_values.size()).second) {
+        throw Variable_manager_error(std::format(fmt::add_variable_error, symbol_table::name(variable)));
     }
-    m_lookup[variable] = value;
-    m_scopes.back().emplace_back(variable);
+    m_names.push_back(variable);
+    m_values.push_back(value);
+}
+
+void Variable_manager::add_local(size_t slot, Symbol variable, int value)
+{
+    assert(m_frame + slot == m_values.size());
+    add(variable, value);
+}
+
+size_t Variable_manager::begin_frame()
+{
+    const size_t frame{m_frame};
+    m_frame = m_values.size();
+    return frame;
+}
+
+void Variable_manager::end_frame(size_t frame)
+{
+    m_frame = frame;
 }
 
 int Variable_manager::get(const std::string& variable)
 {
     // Attempt to resolve the variable reference.  Resolution checks three sources:
     //      1. The lookup - resolves references to local variables, and;
-    //      2. The ptrees - resolves references to ptree nodes
+    //      2. The nodes - resolves references to emitted nodes
     //      3. The definition table - resolves references to global constants and enumerators;
 
     // We begin by checking variable for the presence of "::" - if found, it's a reference to an
@@ -46,64 +102,151 @@ int Variable_manager::get(const std::string& variable)
         if (pos_sr_op + 2 > variable.size()) {
             throw Variable_manager_error(std::format(fmt::malformed_enumerator_reference, variable));
         }
-        const std::string enum_name{variable.substr(0, pos_sr_op)};
-        const std::string enumerator{variable.substr(pos_sr_op + 2)};
-        const csp::Def_mem& enumerator_def{m_definition_table->get_enumerator(enum_name, enumerator)};
-        return enumerator_def.value;
-    }
-
-    // 1.  Check the lookup table.
-    if (m_lookup.contains(variable)) {
-        // Resolution succeeded.
-        return m_lookup[variable];
+        return get_enumerator(variable.substr(0, pos_sr_op), variable.substr(pos_sr_op + 2));
     }
 
-    // 2.  Check the ptrees.
-    const std::string path{variable + "." + cpt::nn_attributes};
-    // The variable reference might be relative to the root or to the parent.  Check both possibilities
-    const std::array ptrees{*m_parent_ptree, m_root_ptree};
-    for (bpt::ptree* ptree : ptrees) {
-        if (const boost::optional<bpt::ptree&> node{ptree->get_child_optional(path)}) {
+    // 1.  Check the lookup table.  A name which has never been interned cannot name a scoped variable.
+    if (const Symbol symbol{symbol_table::find(variable)}; symbol != invalid_symbol) {
+        if (const auto it{m_lookup.find(symbol)}; it != m_lookup.end()) {
             // Resolution succeeded.
+            return m_values[it->second];
+        }
+    }
 
-            // Check the node type.  We support lookup of integer values only.
-            const cpt::Node_type type{node->get<cpt::Node_type>(cpt::nn_type)};
-            if (type < cpt::Node_type::first_integer_type || type > cpt::Node_type::last_integer_type) {
-                throw Variable_manager_error(std::format(fmt::variable_not_an_integer_type, variable));
-            }
-            return node->get<int>(cpt::nn_data);
+    // Split the variable into the keys of a node path.  A name which has never been interned cannot name a node.
+    std::vector<Symbol> keys;
+    std::vector<int> subscripts;
+    bool is_node_name{true};
+    for (size_t first = 0; is_node_name;) {
+        const size_t dot{variable.find('.', first)};
+        const std::string_view key{std::string_view{variable}.substr(first, dot - first)};
+        const char* const last{key.data() + key.size() - 1};
+        int subscript{0};
+        if (key.size() > 2 && key.front() == '[' && key.back() == ']'
+            && std::from_chars(key.data() + 1, last, subscript).ptr == last) {
+            keys.push_back(invalid_symbol);
+            subscripts.push_back(subscript);
+        }
+        else {
+            keys.push_back(symbol_table::find(key));
+            is_node_name = keys.back() != invalid_symbol;
         }
+        if (dot == std::string::npos) {
+            break;
+        }
+        first = dot + 1;
+    }
+    if (int value{0}; is_node_name && find_node_value_(keys, subscripts, value)) {
+        return value;
     }
 
     // 3. Check the definition table.  If lookup fails the definition table throws an exception.  We
     // check the definition table last to facilitate debugging with break on exception enabled.  Checking
     // the definition table earlier would result in spurious exceptions.
-    const int value{m_definition_table->get_const_value(variable)};
+    return m_definition_table->get_const_value(variable);
+}
+
+int Variable_manager::get(Symbol variable)
+{
+    return get(std::span{&variable, 1}, {});
+}
+
+int Variable_manager::get(std::span<const Symbol> keys, std::span<const int> subscripts)
+{
+    // Only a single key can name a scoped variable since scoped variable names cannot contain ".".
+    if (keys.size() == 1) {
+        if (const auto it{m_lookup.find(keys.front())}; it != m_lookup.end()) {
+            return m_values[it->second];
+        }
+    }
 
-    // Resolution succeeded.
-    return value;
+    if (int value{0}; find_node_value_(keys, subscripts, value)) {
+        return value;
+    }
+
+    // 3. Check the definition table.  Const names cannot contain ".", so a path of several keys throws.
+    if (keys.size() == 1 && keys.front() != invalid_symbol) {
+        return m_definition_table->get_const_value(keys.front());
+    }
+    return m_definition_table->get_const_value(join_(keys, subscripts));
+}
+
+int Variable_manager::get(const esp::Node_reference& reference, std::span<const int> subscripts)
+{
+    const auto first_subscript{std::ranges::find(reference.keys, invalid_symbol)};
+    if (reference.slot == limits::invalid_size || m_emitter == nullptr || first_subscript == reference.keys.begin()) {
+        return get(reference.keys, subscripts);
+    }
+    if (reference.slot >= m_node_cache.size()) {
+        m_node_cache.resize(reference.slot + 1);
+    }
+
+    // The node reached by the keys preceding the first subscript is found as find_node_value_ would find it: relative
+    // to the parent and then to the root.  A node found relative to the root remains the node found only until the
+    // parent gains a child, which might match the first key.
+    Node_cache_entry& entry{m_node_cache[reference.slot]};
+    if (entry.parent != *m_parent
+        || (entry.is_root_relative && m_emitter->get_child_count(*m_parent) != entry.child_count)) {
+        const std::span<const Symbol> base_keys{reference.keys.begin(), first_subscript};
+        entry.parent = *m_parent;
+        entry.base = m_emitter->find(*m_parent, base_keys, {});
+        entry.is_root_relative = entry.base == limits::invalid_size;
+        if (entry.is_root_relative) {
+            entry.base = m_emitter->find(cpt::Node_emitter::root, base_keys, {});
+            entry.child_count = m_emitter->get_child_count(*m_parent);
+        }
+        if (entry.base == limits::invalid_size) {
+            entry.parent = limits::invalid_size;
+            return get(reference.keys, subscripts);
+        }
+    }
+
+    const std::span<const Symbol> subscripted_keys{first_subscript, reference.keys.end()};
+    const size_t node{
+        subscripted_keys.empty() ? entry.base : m_emitter->find(entry.base, subscripted_keys, subscripts)};
+    if (node == limits::invalid_size) {
+        // Resolve the reference without the cache so that the root and the definition table are checked as usual.
+        return get(reference.keys, subscripts);
+    }
+    return get_node_value_(node, reference.keys, subscripts);
 }
 
-void Variable_manager::init(bpt::ptree* ptree, bpt::ptree** parent_ptree, csp::Def_tbl* definition_table)
+int Variable_manager::get_enumerator(const std::string& enum_name, const std::string& enumerator) const
 {
-    m_root_ptree = ptree;
-    m_parent_ptree = parent_ptree;
+    const csp::Def_mem& enumerator_def{m_definition_table->get_enumerator(enum_name, enumerator)};
+    return enumerator_def.value;
+}
+
+int Variable_manager::get_enumerator(Symbol enum_name, Symbol enumerator) const
+{
+    const csp::Def_mem& enumerator_def{m_definition_table->get_enumerator(enum_name, enumerator)};
+    return enumerator_def.value;
+}
+
+void Variable_manager::init(cpt::Node_emitter* emitter, const size_t* parent, csp::Def_tbl* definition_table)
+{
+    m_emitter = emitter;
+    m_parent = parent;
     m_definition_table = definition_table;
+    m_frame = 0;
+    m_node_cache.clear();
 }
 
 void Variable_manager::pop()
 {
-    const std::vector<std::string>& last_scope{m_scopes.back()};
-    for (const auto& name : last_scope) {
-        m_lookup.erase(name);
+    const size_t first{m_scopes.back()};
+    for (size_t index = first; index < m_names.size(); ++index) {
+        m_lookup.erase(m_names[index]);
     }
+    m_names.resize(first);
+    m_values.resize(first);
     m_scopes.pop_back();
 }
 
 // Pushes a new scope.
 void Variable_manager::push()
 {
-    m_scopes.emplace_back();
+    m_scopes.push_back(m_values.size());
 }
 
 void Variable_manager::set(const std::string& variable, const int value)
@@ -111,10 +254,50 @@ void Variable_manager::set(const std::string& variable, const int value)
     if (variable.find_first_of('.') != std::string::npos) {
         throw Variable_manager_error(std::format(fmt::variable_name_contains_dot, variable));
     }
-    if (!m_lookup.contains(variable)) {
+    const Symbol symbol{symbol_table::find(variable)};
+    if (symbol == invalid_symbol) {
         throw Variable_manager_error(std::format(fmt::variable_does_not_exist, variable));
     }
-    m_lookup[variable] = value;
+    set(symbol, value);
+}
+
+void Variable_manager::set(Symbol variable, const int value)
+{
+    const auto it{m_lookup.find(variable)};
+    if (it == m_lookup.end()) {
+        throw Variable_manager_error(std::format(fmt::variable_does_not_exist, symbol_table::name(variable)));
+    }
+    m_values[it->second] = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool Variable_manager::find_node_value_(
+    std::span<const Symbol> keys, std::span<const int> subscripts, int& value) const
+{
+    // 2.  Check the nodes.
+    // The variable reference might be relative to the root or to the parent.  Check both possibilities
+    const std::array nodes{*m_parent, cpt::Node_emitter::root};
+    for (const size_t node : nodes) {
+        if (const size_t found{m_emitter->find(node, keys, subscripts)}; found != limits::invalid_size) {
+            // Resolution succeeded.
+            value = get_node_value_(found, keys, subscripts);
+            return true;
+        }
+    }
+    return false;
+}
+
+int Variable_manager::get_node_value_(
+    size_t node, std::span<const Symbol> keys, std::span<const int> subscripts) const
+{
+    // Check the node type.  We support lookup of integer values only.
+    if (const cpt::Node_type type{m_emitter->get_type(node)};
+        type < cpt::Node_type::first_integer_type || type > cpt::Node_type::last_integer_type) {
+        throw Variable_manager_error(std::format(fmt::variable_not_an_integer_type, join_(keys, subscripts)));
+    }
+    return gsl::narrow<int>(m_emitter->get_value(node));
 }
 
 } // namespace c4lib
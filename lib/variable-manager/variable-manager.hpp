@@ -4,8 +4,13 @@
 
 #pragma once
 
-#include <boost/property_tree/ptree_fwd.hpp>
+#include <cstddef>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/ptree/node-emitter.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,16 +36,58 @@ public:
     // thrown.  The dot syntax is used to refer to ptree variables.
     void add(const std::string& variable, int value);
 
+    // As above for the variable whose name is symbol.  The name must be an identifier, e.g., the symbol of an
+    // identifier token, and so cannot contain ".".
+    void add(Symbol variable, int value);
+
+    // As above for a variable of the routine being run, which the schema compiler has assigned slot.  Slots are
+    // assigned in the order variables are added, so slot must be the number of variables the routine has added and
+    // not yet removed.
+    void add_local(size_t slot, Symbol variable, int value);
+
+    // Begins the frame of a routine about to be run and returns the frame of the routine running it, which must be
+    // passed to end_frame once the routine returns.  The slots of local variables are relative to the frame.
+    [[nodiscard]] size_t begin_frame();
+
+    // Ends the frame begun by begin_frame, restoring frame, which begin_frame returned.
+    void end_frame(size_t frame);
+
     // Looks up variable and returns its value.  Throws an exception if variable does not exist.
-    // Variable may refer to a scoped variable or to a ptree variable.
+    // Variable may refer to a scoped variable or to a node variable.
     int get(const std::string& variable);
 
-    // Initializes property trees enabling resolution of ptree node references.  Also initializes the
+    // As above for the variable whose name is symbol.  Neither this overload nor the one below forms or looks up
+    // strings: variables and nodes are found by comparing symbols.
+    int get(Symbol variable);
+
+    // As above for the variable whose name is formed by joining keys with ".", where a key of invalid_symbol stands
+    // for the next of subscripts, e.g., keys {r, cn1, invalid_symbol} and subscripts {3} for r.cn1.[3].  The name is
+    // formed only if needed for an error message.
+    int get(std::span<const Symbol> keys, std::span<const int> subscripts);
+
+    // As above for the keys of reference.  If the schema compiler has assigned reference a slot, the node found for
+    // the keys preceding the first subscript is cached for the parent node and reused until the parent changes, so
+    // repeated evaluation, e.g., of a loop condition, doesn't search for the node again.
+    int get(const expression_parser::Node_reference& reference, std::span<const int> subscripts);
+
+    // Returns the value of enumerator within the enum named enum_name.  Equivalent to get for the variable
+    // "enum_name::enumerator".
+    [[nodiscard]] int get_enumerator(const std::string& enum_name, const std::string& enumerator) const;
+
+    [[nodiscard]] int get_enumerator(Symbol enum_name, Symbol enumerator) const;
+
+    // Returns the value of the local variable at slot within the current frame.
+    [[nodiscard]] int get_local(size_t slot) const
+    {
+        return m_values[m_frame + slot];
+    }
+
+    // Initializes the node emitter, enabling resolution of references to the nodes it has emitted.  References are
+    // resolved relative to the node whose id is held by parent and then relative to the root.  Also initializes the
     // definition table, used to resolve references to consts. The variable manager can be used prior to calling
-    // init if ptree reference resolution and const-name lookup are not required (e.g., in  phase 1 parsing).
-    void init(boost::property_tree::ptree* ptree,
-        boost::property_tree::ptree** parent_ptree,
-        schema_parser::Def_tbl* definition_table);
+    // init if node reference resolution and const-name lookup are not required (e.g., in  phase 1 parsing).  The
+    // node cache is cleared, since node ids are specific to the emitter.
+    void init(property_tree::Node_emitter* emitter, const size_t* parent, schema_parser::Def_tbl* definition_table);
 
     // Pops the current scope, removing all variables defined in the scope.
     void pop();
@@ -49,15 +96,52 @@ public:
     void push();
 
     // Looks up variable and sets its value.  Throws an exception if the variable does
-    // not exist, or if the variable name refers to a ptree variable.
+    // not exist, or if the variable name refers to a node variable.
     void set(const std::string& variable, int value);
 
+    // As above for the variable whose name is symbol.  The name must be an identifier.
+    void set(Symbol variable, int value);
+
+    // Sets the value of the local variable at slot within the current frame.
+    void set_local(size_t slot, int value)
+    {
+        m_values[m_frame + slot] = value;
+    }
+
 private:
+    struct Node_cache_entry {
+        // Parent node for which base was found or limits::invalid_size if the entry is empty.
+        size_t parent{limits::invalid_size};
+        // Node reached by the keys preceding the first subscript.
+        size_t base{limits::invalid_size};
+        // True if base was found relative to the root rather than to parent, in which case it remains valid only
+        // while parent has child_count children.
+        bool is_root_relative{false};
+        size_t child_count{0};
+    };
+
+    // Sets value to the value of the node reached by following keys, with subscripts, from the parent node or, failing
+    // that, from the root.  Returns false if there is no such node.
+    bool find_node_value_(std::span<const Symbol> keys, std::span<const int> subscripts, int& value) const;
+
+    // Returns the value of node, reached by following keys with subscripts.  Throws if node isn't of integer type.
+    [[nodiscard]] int get_node_value_(
+        size_t node, std::span<const Symbol> keys, std::span<const int> subscripts) const;
+
     schema_parser::Def_tbl* m_definition_table{nullptr};
-    std::unordered_map<std::string, int> m_lookup;
-    boost::property_tree::ptree** m_parent_ptree{nullptr};
-    boost::property_tree::ptree* m_root_ptree{nullptr};
-    std::vector<std::vector<std::string>> m_scopes;
+    property_tree::Node_emitter* m_emitter{nullptr};
+    // Index within m_values of the first variable of the routine being run.
+    size_t m_frame{0};
+    // Maps the symbol of the name of each scoped variable to the index of its value within m_values.
+    std::unordered_map<Symbol, size_t> m_lookup;
+    // Name of the scoped variable whose value is held by the corresponding element of m_values.
+    std::vector<Symbol> m_names;
+    std::vector<Node_cache_entry> m_node_cache;
+    const size_t* m_parent{nullptr};
+    // Index within m_values of the first variable of each scope.
+    std::vector<size_t> m_scopes;
+    // Values of the scoped variables in the order they were added.
+    std::vector<int> m_values;
 };
 
 } // namespace c4lib
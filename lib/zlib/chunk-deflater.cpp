@@ -0,0 +1,89 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cassert>
+#include <algorithm>
+#include <cstddef>
+#include <lib/util/narrow.hpp>
+#include <lib/zlib/chunk-deflater.hpp>
+#include <lib/zlib/constants.hpp>
+#include <lib/zlib/zstream.hpp>
+#include <memory>
+#include <span>
+#include <utility>
+#include <zconf.h>
+#include <zlib.h>
+
+namespace c4lib::zlib {
+
+Chunk_deflater::Chunk_deflater(Chunk_output output)
+    : m_chunk(constants::max_chunk_size),
+      m_output(std::move(output)),
+      m_zstream(std::make_unique<ZStream>(ZStream::Type::deflate))
+{}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast)
+void Chunk_deflater::deflate(std::span<const std::byte> in, bool is_last)
+{
+    // zlib does not modify its input, but next_in is only declared const if ZLIB_CONST is defined.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    m_zstream->next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(in.data()));
+    m_zstream->avail_in = gsl::narrow<uInt>(in.size());
+
+    // N.B:
+    // Z_SYNC_FLUSH is intentionally used instead of Z_FINISH, even though this use is
+    // produces output that is not conformant with the zlib standard, because
+    // use of Z_SYNC_FLUSH produces output consistent with that generated by Civ4,
+    // whereas use of Z_FINISH does not.  Civ4's zlib output is certainly non-conformant
+    // but its use of Z_SYNC_FLUSH has been confirmed under a debugger.
+    const int flush{is_last ? Z_SYNC_FLUSH : Z_NO_FLUSH};
+
+    // Deflate into the chunk, outputting it each time it is filled.  All input has been deflated once it has been
+    // consumed and zlib leaves space unused in the chunk.
+    do {
+        m_zstream->next_out = reinterpret_cast<Bytef*>(m_chunk.data() + m_chunk_size);
+        m_zstream->avail_out = constants::max_chunk_size - m_chunk_size;
+        [[maybe_unused]] const int zreturn{::deflate(m_zstream.get(), flush)}; // no bad return value
+        assert(zreturn != Z_STREAM_ERROR); // state not clobbered
+        m_chunk_size = constants::max_chunk_size - m_zstream->avail_out;
+        if (m_zstream->avail_out == 0) {
+            m_output(m_chunk);
+            m_chunk_size = 0;
+        }
+    }
+    while (m_zstream->avail_in != 0 || m_zstream->avail_out == 0);
+
+    if (is_last && m_chunk_size != 0) {
+        m_output(std::span{m_chunk}.first(m_chunk_size));
+        m_chunk_size = 0;
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast)
+
+void Chunk_deflater::resume(ZStream& state, std::span<const std::byte> compressed)
+{
+    assert(m_zstream->total_in == 0 && state.total_out == compressed.size());
+    m_zstream = ZStream::copy_deflate(state);
+
+    // Output the compressed data in chunks, leaving the final partial chunk to be filled by subsequent calls to
+    // deflate.
+    while (!compressed.empty()) {
+        const size_t count{std::min(compressed.size(), size_t{constants::max_chunk_size - m_chunk_size})};
+        std::ranges::copy(compressed.first(count), m_chunk.begin() + m_chunk_size);
+        m_chunk_size += gsl::narrow<uint32_t>(count);
+        compressed = compressed.subspan(count);
+        if (m_chunk_size == constants::max_chunk_size) {
+            m_output(m_chunk);
+            m_chunk_size = 0;
+        }
+    }
+}
+
+std::unique_ptr<ZStream> Chunk_deflater::snapshot()
+{
+    return ZStream::copy_deflate(*m_zstream);
+}
+
+} // namespace c4lib::zlib
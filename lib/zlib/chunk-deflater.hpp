@@ -0,0 +1,70 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <lib/zlib/zstream.hpp>
+#include <span>
+#include <vector>
+
+namespace c4lib::zlib {
+
+// Chunk_deflater deflates data exactly as Civ4 does, passing the compressed data to a function in chunks as it is
+// produced.  Civ4 writes compressed data in chunks, each preceded by its 4-byte size.  Each chunk is 64K bytes long
+// except for the last, which may be shorter.  Data may be passed to the deflater in pieces of any size; the compressed
+// data does not depend upon how the data is divided.
+class Chunk_deflater {
+public:
+    // Called with each chunk of compressed data.  The chunk is only valid for the duration of the call.
+    using Chunk_output = std::function<void(std::span<const std::byte> chunk)>;
+
+    explicit Chunk_deflater(Chunk_output output);
+
+    ~Chunk_deflater() = default;
+
+    Chunk_deflater(const Chunk_deflater&) = delete;
+
+    Chunk_deflater& operator=(const Chunk_deflater&) = delete;
+
+    Chunk_deflater(Chunk_deflater&&) noexcept = delete;
+
+    Chunk_deflater& operator=(Chunk_deflater&&) noexcept = delete;
+
+    // Number of bytes of compressed data output, excluding chunk sizes.
+    [[nodiscard]] size_t count_compressed() const
+    {
+        return m_zstream->total_out;
+    }
+
+    // Number of bytes of data deflated.
+    [[nodiscard]] size_t count_decompressed() const
+    {
+        return m_zstream->total_in;
+    }
+
+    // Deflates in.  If is_last is true, the compressed data is flushed and the final chunk, which may be shorter than
+    // 64K bytes, is output; deflate may not be called again.
+    void deflate(std::span<const std::byte> in, bool is_last);
+
+    // Replaces the state of a deflater to which nothing has yet been passed with a copy of state, a snapshot taken
+    // from another deflater.  compressed is the compressed data output before the snapshot was taken; it is output
+    // again so that the chunks output are the same as those output by the deflater from which state was taken.
+    void resume(ZStream& state, std::span<const std::byte> compressed);
+
+    // Returns a copy of the state of the deflater, which may be passed to resume.  Must not be called once deflate has
+    // been called with is_last set to true.
+    [[nodiscard]] std::unique_ptr<ZStream> snapshot();
+
+private:
+    std::vector<std::byte> m_chunk;
+    uint32_t m_chunk_size{0};
+    Chunk_output m_output;
+    std::unique_ptr<ZStream> m_zstream;
+};
+
+} // namespace c4lib::zlib
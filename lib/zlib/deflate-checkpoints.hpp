@@ -0,0 +1,52 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <lib/zlib/zstream.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace c4lib::zlib {
+
+// Checkpoints recorded while a save is written, which allow a subsequent write of a similar save to reuse the
+// compressed data preceding the first modified byte.  The data to be deflated is divided into segments of interval
+// bytes.  A checkpoint, a copy of the deflater's state, is recorded at the start of each segment along with the number
+// of bytes of compressed data output before it.  The MD5 of each complete segment is recorded so that a later write
+// can identify the segments which are unchanged.  See Deflate_streambuf.
+struct Deflate_checkpoints {
+    struct Checkpoint {
+        size_t count_compressed{0};
+
+        // Null for the checkpoint at the start of the data, which is the state of a newly constructed deflater.
+        std::unique_ptr<ZStream> state;
+    };
+
+    explicit Deflate_checkpoints(size_t segment_interval)
+        : interval(segment_interval)
+    {}
+
+    // Discards the checkpoints, leaving the table empty.
+    void clear()
+    {
+        checkpoints.clear();
+        segment_md5s.clear();
+        compressed.clear();
+    }
+
+    size_t interval;
+
+    // checkpoints[k] is the checkpoint at decompressed offset k * interval.
+    std::vector<Checkpoint> checkpoints;
+
+    // segment_md5s[k] is the MD5 of the decompressed data between checkpoints[k] and checkpoints[k + 1].
+    std::vector<std::string> segment_md5s;
+
+    // The compressed data of the save, excluding chunk sizes.
+    std::vector<std::byte> compressed;
+};
+
+} // namespace c4lib::zlib
@@ -0,0 +1,265 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <lib/io/cursor.hpp>
+#include <lib/io/io.hpp>
+#include <lib/layout/header-layout.hpp>
+#include <lib/md5/checksum.hpp>
+#include <lib/util/constants.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/zlib/constants.hpp>
+#include <lib/zlib/deflate-checkpoints.hpp>
+#include <lib/zlib/deflate-streambuf.hpp>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace c4lib::zlib {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Deflate_streambuf::Deflate_streambuf(std::ostream& out,
+    size_t count_footer,
+    int max_players,
+    int num_game_option_types,
+    int num_multiplayer_option_types,
+    Deflate_checkpoints* checkpoints)
+    : m_buffer(constants::max_chunk_size),
+      m_checkpoints(checkpoints),
+      m_count_footer(count_footer),
+      m_deflater([this](std::span<const std::byte> chunk) { write_chunk_(chunk); }),
+      m_max_players(max_players),
+      m_num_game_option_types(num_game_option_types),
+      m_num_multiplayer_option_types(num_multiplayer_option_types),
+      m_out(&out)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+
+    if (m_checkpoints != nullptr) {
+        // The previous checkpoints are taken from the table so that it is left empty should the save not be completed.
+        m_previous = std::move(*m_checkpoints);
+        m_checkpoints->clear();
+        m_recorded.interval = m_previous.interval;
+        m_is_matching = !m_previous.checkpoints.empty();
+        if (!m_is_matching) {
+            m_recorded.checkpoints.emplace_back();
+        }
+    }
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+void Deflate_streambuf::finish()
+{
+    consume_(std::as_bytes(std::span{pbase(), pptr()}));
+    setp(nullptr, nullptr);
+    if (m_count_header == limits::invalid_size) {
+        end_header_(true);
+    }
+    if (m_footer.size() != m_count_footer) {
+        throw std::logic_error(fmt::bad_file_offset);
+    }
+
+    // Deflate any data held back while matching the previous checkpoints.
+    if (m_is_matching) {
+        resume_();
+        m_deflater.deflate(m_segment, false);
+        m_segment.clear();
+    }
+
+    // Flush the deflater and write the final chunk size (the size will be zero).
+    m_deflater.deflate({}, true);
+    uint32_t chunk_size{0};
+    io::write_int(*m_out, chunk_size);
+
+    // The checksum is the final field of the footer and is written as a civ4 string (4 byte length followed by
+    // characters in string).
+    m_header_layout->scan_cv_init_core(m_max_players, m_num_game_option_types, m_num_multiplayer_option_types);
+    md5::Checksum checksum{*m_header_layout, m_footer, m_compressed_data_digest.get_hash()};
+    const std::string md5{checksum.get_hash()};
+    const size_t checksum_offset{4 + md5.length()};
+    if (checksum_offset > m_footer.size()) {
+        throw std::logic_error(fmt::bad_file_offset);
+    }
+    io::write_string(&m_footer[m_footer.size() - checksum_offset], md5);
+    io::write_bytes(
+        *m_out, reinterpret_cast<const char*>(m_footer.data()), gsl::narrow<std::streamsize>(m_footer.size()));
+
+    if (m_checkpoints != nullptr) {
+        *m_checkpoints = std::move(m_recorded);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Deflate_streambuf::int_type Deflate_streambuf::overflow(int_type ch)
+{
+    consume_(std::as_bytes(std::span{pbase(), pptr()}));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+    }
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+void Deflate_streambuf::consume_(std::span<const std::byte> bytes)
+{
+    if (m_count_header != limits::invalid_size) {
+        deflate_(bytes);
+        return;
+    }
+
+    m_header.insert(m_header.end(), bytes.begin(), bytes.end());
+    if (end_header_(false)) {
+        // Civ4 writes a 4-byte pad field, which is not part of the savegame, prior to the data to be deflated.
+        const size_t count_data_offset{m_count_header + sizeof(uint32_t)};
+        const std::vector<std::byte> data{m_header.begin() + gsl::narrow<std::ptrdiff_t>(count_data_offset),
+            m_header.end()};
+        m_header.resize(m_count_header);
+        m_header_layout->reset(m_header);
+        deflate_(data);
+    }
+}
+
+void Deflate_streambuf::deflate_(std::span<const std::byte> bytes)
+{
+    // m_footer holds the last m_count_footer bytes written.  Deflate whatever precedes them, first from m_footer and
+    // then from bytes.
+    const size_t count_total{m_footer.size() + bytes.size()};
+    if (count_total <= m_count_footer) {
+        m_footer.insert(m_footer.end(), bytes.begin(), bytes.end());
+        return;
+    }
+    const size_t count_to_deflate{count_total - m_count_footer};
+    const size_t count_from_footer{std::min(m_footer.size(), count_to_deflate)};
+    const size_t count_from_bytes{count_to_deflate - count_from_footer};
+    pass_to_deflater_(std::span{m_footer}.first(count_from_footer));
+    pass_to_deflater_(bytes.first(count_from_bytes));
+    m_footer.erase(m_footer.begin(), m_footer.begin() + gsl::narrow<std::ptrdiff_t>(count_from_footer));
+    m_footer.insert(m_footer.end(), bytes.begin() + gsl::narrow<std::ptrdiff_t>(count_from_bytes), bytes.end());
+}
+
+bool Deflate_streambuf::end_header_(bool is_final)
+{
+    // The size of the header is given by fields near its beginning, but the pad which follows the header must also
+    // have been written.  Until enough has been written, scanning the header overruns the cursor.
+    std::unique_ptr<layout::Header_layout> header_layout;
+    std::streamoff count_header{limits::invalid_off};
+    try {
+        header_layout = std::make_unique<layout::Header_layout>(m_header);
+        count_header = header_layout->get_civ4_compressed_data_offset(false);
+        io::Cursor cursor{m_header};
+        cursor.seek(count_header + std::streamoff{sizeof(uint32_t)});
+    }
+    catch (const std::runtime_error&) {
+        if (is_final) {
+            throw;
+        }
+        return false;
+    }
+    m_count_header = gsl::narrow<size_t>(count_header);
+    m_header_layout = std::move(header_layout);
+
+    // The header is copied to the savegame unchanged.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    io::write_bytes(*m_out, reinterpret_cast<const char*>(m_header.data()),
+        gsl::narrow<std::streamsize>(m_count_header));
+    return true;
+}
+
+void Deflate_streambuf::end_segment_()
+{
+    std::string md5{m_segment_digest.get_hash()};
+    m_segment_digest = md5::Md5_digest{};
+    m_count_segment = 0;
+
+    if (m_is_matching) {
+        // A segment may only be skipped if the checkpoint which follows it was recorded.
+        if (m_count_matched + 1 < m_previous.checkpoints.size() && m_previous.segment_md5s[m_count_matched] == md5) {
+            ++m_count_matched;
+            m_segment.clear();
+            return;
+        }
+        resume_();
+        m_deflater.deflate(m_segment, false);
+        m_segment.clear();
+    }
+
+    m_recorded.segment_md5s.push_back(std::move(md5));
+    m_recorded.checkpoints.push_back({m_deflater.count_compressed(), m_deflater.snapshot()});
+}
+
+void Deflate_streambuf::pass_to_deflater_(std::span<const std::byte> bytes)
+{
+    if (m_checkpoints == nullptr) {
+        m_deflater.deflate(bytes, false);
+        return;
+    }
+
+    // Divide bytes at segment boundaries.
+    while (!bytes.empty()) {
+        const size_t count{std::min(bytes.size(), m_recorded.interval - m_count_segment)};
+        const std::span<const std::byte> piece{bytes.first(count)};
+        bytes = bytes.subspan(count);
+        if (m_is_matching) {
+            m_segment.insert(m_segment.end(), piece.begin(), piece.end());
+        }
+        else {
+            m_deflater.deflate(piece, false);
+        }
+        m_segment_digest.add(piece);
+        m_count_segment += count;
+        if (m_count_segment == m_recorded.interval) {
+            end_segment_();
+        }
+    }
+}
+
+void Deflate_streambuf::resume_()
+{
+    m_is_matching = false;
+    const Deflate_checkpoints::Checkpoint& checkpoint{m_previous.checkpoints[m_count_matched]};
+    if (checkpoint.state) {
+        m_deflater.resume(*checkpoint.state, std::span{m_previous.compressed}.first(checkpoint.count_compressed));
+        m_count_reused = checkpoint.count_compressed;
+    }
+
+    // The checkpoints up to and including the one resumed from remain valid for this save.
+    for (size_t i = 0; i <= m_count_matched; ++i) {
+        m_recorded.checkpoints.push_back(std::move(m_previous.checkpoints[i]));
+    }
+    for (size_t i = 0; i < m_count_matched; ++i) {
+        m_recorded.segment_md5s.push_back(std::move(m_previous.segment_md5s[i]));
+    }
+    m_previous.clear();
+}
+
+void Deflate_streambuf::write_chunk_(std::span<const std::byte> chunk)
+{
+    uint32_t chunk_size{gsl::narrow<uint32_t>(chunk.size())};
+    io::write_int(*m_out, chunk_size);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    io::write_bytes(*m_out, reinterpret_cast<const char*>(chunk.data()), chunk_size);
+    m_compressed_data_digest.add(chunk);
+    if (m_checkpoints != nullptr) {
+        m_recorded.compressed.insert(m_recorded.compressed.end(), chunk.begin(), chunk.end());
+    }
+}
+
+} // namespace c4lib::zlib
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <lib/layout/header-layout.hpp>
+#include <lib/md5/md5-digest.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/zlib/chunk-deflater.hpp>
+#include <lib/zlib/deflate-checkpoints.hpp>
+#include <memory>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace c4lib::zlib {
+
+// Write-only stream buffer which converts the composite savegame written to it into a Civilization 4 savegame in a
+// single pass.  The header is copied to the output stream once its size is known, the data following it is deflated
+// as it is written, and each chunk of compressed data is hashed as it is output.  Only the footer, whose size must be
+// known in advance, is held back; finish computes the checksum from the header and footer and writes the footer.
+//
+// If a checkpoint table is supplied, checkpoints are recorded in it as the data is deflated.  If the table already
+// holds the checkpoints recorded while an earlier save was written, the data is not deflated until it first differs
+// from that of the earlier save.  Deflation then resumes from the last checkpoint preceding the difference, and the
+// compressed data which precedes that checkpoint is copied from the earlier save.
+class Deflate_streambuf : public std::streambuf {
+public:
+    // out receives the savegame.  count_footer is the size of the footer of the composite savegame.  max_players,
+    // num_game_option_types and num_multiplayer_option_types are the arguments required by md5::Checksum.  If
+    // checkpoints is not null, its checkpoints are used and then replaced by those recorded for this save once finish
+    // completes; it is left empty if finish is not completed.
+    Deflate_streambuf(std::ostream& out,
+        size_t count_footer,
+        int max_players,
+        int num_game_option_types,
+        int num_multiplayer_option_types,
+        Deflate_checkpoints* checkpoints = nullptr);
+
+    ~Deflate_streambuf() override = default;
+
+    Deflate_streambuf(const Deflate_streambuf&) = delete;
+
+    Deflate_streambuf& operator=(const Deflate_streambuf&) = delete;
+
+    Deflate_streambuf(Deflate_streambuf&&) noexcept = delete;
+
+    Deflate_streambuf& operator=(Deflate_streambuf&&) noexcept = delete;
+
+    // Completes the savegame.  Must be called once the entire composite savegame has been written.  Throws if the
+    // composite savegame is malformed.
+    void finish();
+
+    // Number of bytes of compressed data copied from the save for which the checkpoints were recorded.
+    [[nodiscard]] size_t count_reused() const
+    {
+        return m_count_reused;
+    }
+
+protected:
+    int_type overflow(int_type ch) override;
+
+private:
+    // Passes bytes, the next bytes of the composite savegame, to the header, the deflater or the footer.
+    void consume_(std::span<const std::byte> bytes);
+
+    // Sets m_count_header from the header written so far and writes the header.  Returns false if too little of the
+    // header has been written to determine its size, unless is_final is true, in which case the error is thrown.
+    bool end_header_(bool is_final);
+
+    // Passes bytes to the deflater, holding back the last m_count_footer bytes written.
+    void deflate_(std::span<const std::byte> bytes);
+
+    // Passes bytes to the deflater, recording a checkpoint at the end of each segment, or holds bytes back while they
+    // match the data for which the previous checkpoints were recorded.
+    void pass_to_deflater_(std::span<const std::byte> bytes);
+
+    // Records the checkpoint at the end of the current segment, or, if the segment is being held back, passes it to
+    // the deflater unless it matches the corresponding segment of the previous checkpoints.
+    void end_segment_();
+
+    // Resumes deflation from the last previous checkpoint matched, recording the checkpoints which precede it.
+    void resume_();
+
+    // Writes chunk, preceded by its size, and adds it to the compressed data digest.
+    void write_chunk_(std::span<const std::byte> chunk);
+
+    std::vector<char> m_buffer;
+    Deflate_checkpoints* m_checkpoints;
+    md5::Md5_digest m_compressed_data_digest;
+    size_t m_count_footer;
+    size_t m_count_header{limits::invalid_size};
+    size_t m_count_matched{0};
+    size_t m_count_reused{0};
+    size_t m_count_segment{0};
+    Chunk_deflater m_deflater;
+    std::vector<std::byte> m_footer;
+    std::vector<std::byte> m_header;
+    // Layout of m_header, which is shared with the checksum.
+    std::unique_ptr<layout::Header_layout> m_header_layout;
+    bool m_is_matching{false};
+    int m_max_players;
+    int m_num_game_option_types;
+    int m_num_multiplayer_option_types;
+    std::ostream* m_out;
+    Deflate_checkpoints m_previous{0};
+    Deflate_checkpoints m_recorded{0};
+    std::vector<std::byte> m_segment;
+    md5::Md5_digest m_segment_digest;
+};
+
+} // namespace c4lib::zlib
@@ -0,0 +1,204 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <ios>
+#include <lib/io/cursor.hpp>
+#include <lib/layout/header-layout.hpp>
+#include <lib/layout/layout.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/zlib/inflate-pipeline.hpp>
+#include <lib/zlib/zlib-engine.hpp>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+
+namespace {
+
+// Thrown by the producer to unwind out of the engine when the pipeline is cancelled.
+struct Cancelled_ {};
+
+} // namespace
+
+namespace c4lib::zlib {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERFACE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Inflate_pipeline::Inflate_pipeline(std::span<const std::byte> save, size_t buffer_count, size_t buffer_size)
+    : m_save(save), m_ring(std::max(buffer_count, size_t{2}))
+{
+    // Determine the sizes of the header and footer before starting so that layout errors are thrown to the caller.
+    const layout::Header_layout header_layout{save};
+    const std::streamoff compressed_data_offset{header_layout.get_civ4_compressed_data_offset(true)};
+    io::Cursor cursor{save};
+    m_count_header = gsl::narrow<size_t>(compressed_data_offset);
+    const std::streamoff footer_offset{layout::get_civ4_footer_offset(cursor, compressed_data_offset)};
+    m_count_footer = save.size() - gsl::narrow<size_t>(footer_offset);
+
+    for (auto& buffer : m_ring) {
+        buffer.bytes.resize(buffer_size);
+    }
+    m_producer = std::jthread{[this]() { produce_(); }};
+}
+
+Inflate_pipeline::~Inflate_pipeline()
+{
+    {
+        const std::scoped_lock lock{m_mutex};
+        m_is_cancelled = true;
+    }
+    m_freed.notify_one();
+    m_producer.join();
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+void Inflate_pipeline::read(char* out, std::streamsize size)
+{
+    if (size < 0) {
+        throw std::runtime_error(fmt::runtime_error_read);
+    }
+
+    auto remaining{static_cast<size_t>(size)};
+    while (remaining > 0) {
+        if (m_consumer_buffer == nullptr || m_consumer_position == m_consumer_buffer->size) {
+            if (!acquire_filled_()) {
+                throw std::runtime_error(fmt::runtime_error_read);
+            }
+            continue;
+        }
+        const size_t count{std::min(remaining, m_consumer_buffer->size - m_consumer_position)};
+        std::memcpy(out, m_consumer_buffer->bytes.data() + m_consumer_position, count);
+        m_consumer_position += count;
+        m_count_read += count;
+        out += count;
+        remaining -= count;
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool Inflate_pipeline::acquire_filled_()
+{
+    std::unique_lock lock{m_mutex};
+
+    // Release the buffer just read so that the producer may refill it.
+    if (m_consumer_buffer != nullptr) {
+        m_head = (m_head + 1) % m_ring.size();
+        --m_count;
+        m_consumer_buffer = nullptr;
+        m_freed.notify_one();
+    }
+
+    m_filled.wait(lock, [this]() { return m_count > 0 || m_is_done; });
+    if (m_count == 0) {
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+        return false;
+    }
+    m_consumer_buffer = &m_ring[m_head];
+    m_consumer_position = 0;
+    return true;
+}
+
+bool Inflate_pipeline::acquire_free_()
+{
+    std::unique_lock lock{m_mutex};
+    m_freed.wait(lock, [this]() { return m_count < m_ring.size() || m_is_cancelled; });
+    if (m_is_cancelled) {
+        return false;
+    }
+    m_producer_buffer = &m_ring[(m_head + m_count) % m_ring.size()];
+    m_producer_buffer->size = 0;
+    return true;
+}
+
+void Inflate_pipeline::publish_()
+{
+    {
+        const std::scoped_lock lock{m_mutex};
+        ++m_count;
+        m_producer_buffer = nullptr;
+    }
+    m_filled.notify_one();
+}
+
+void Inflate_pipeline::produce_()
+{
+    try {
+        // The composite savegame consists of the header, a 4-byte pad whose value is 0, the inflated data and
+        // the footer.
+        put_(m_save.first(m_count_header));
+        constexpr std::array<std::byte, sizeof(uint32_t)> pad{};
+        put_(pad);
+
+        // Inflate directly into the ring.
+        const ZLib_engine::Inflate_output output{[this](size_t count_inflated) {
+            m_producer_buffer->size += count_inflated;
+            if (m_producer_buffer->size == m_producer_buffer->bytes.size()) {
+                publish_();
+                if (!acquire_free_()) {
+                    throw Cancelled_{};
+                }
+            }
+            return std::span<std::byte>{m_producer_buffer->bytes}.subspan(m_producer_buffer->size);
+        }};
+        ZLib_engine zlib;
+        size_t count_compressed{0};
+        size_t count_decompressed{0};
+        zlib.inflate(m_save, gsl::narrow<std::streamoff>(m_count_header), output, count_compressed,
+            count_decompressed);
+
+        put_(m_save.last(m_count_footer));
+        if (m_producer_buffer != nullptr && m_producer_buffer->size > 0) {
+            publish_();
+        }
+    }
+    catch (const Cancelled_&) {
+        return;
+    }
+    catch (...) {
+        const std::scoped_lock lock{m_mutex};
+        m_error = std::current_exception();
+    }
+
+    {
+        const std::scoped_lock lock{m_mutex};
+        m_is_done = true;
+    }
+    m_filled.notify_one();
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+void Inflate_pipeline::put_(std::span<const std::byte> bytes)
+{
+    while (!bytes.empty()) {
+        if (m_producer_buffer == nullptr || m_producer_buffer->size == m_producer_buffer->bytes.size()) {
+            if (m_producer_buffer != nullptr) {
+                publish_();
+            }
+            if (!acquire_free_()) {
+                throw Cancelled_{};
+            }
+        }
+        const size_t count{std::min(bytes.size(), m_producer_buffer->bytes.size() - m_producer_buffer->size)};
+        std::memcpy(m_producer_buffer->bytes.data() + m_producer_buffer->size, bytes.data(), count);
+        m_producer_buffer->size += count;
+        bytes = bytes.subspan(count);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+} // namespace c4lib::zlib
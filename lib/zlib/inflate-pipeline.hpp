@@ -0,0 +1,120 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <ios>
+#include <lib/util/tune.hpp>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace c4lib::zlib {
+
+// Inflate_pipeline inflates a Civilization 4 savegame on a producer thread while the composite savegame is read on
+// the calling thread.  Inflated data is passed from the producer to the reader through a bounded ring of buffers, so
+// the composite savegame is never held in memory in its entirety and inflation overlaps with reading.  The composite
+// bytes read are identical to those produced by ZLib_engine::inflate.
+class Inflate_pipeline {
+public:
+    // Starts inflating save on the producer thread.  save is not copied, so it must outlive the pipeline.  Throws if
+    // the layout of save is invalid; errors which occur while inflating are thrown by read.
+    explicit Inflate_pipeline(std::span<const std::byte> save,
+        size_t buffer_count = tune::pipeline_buffer_count,
+        size_t buffer_size = tune::pipeline_buffer_size);
+
+    // Stops the producer thread if it is still running.
+    ~Inflate_pipeline();
+
+    Inflate_pipeline(const Inflate_pipeline&) = delete;
+
+    Inflate_pipeline& operator=(const Inflate_pipeline&) = delete;
+
+    Inflate_pipeline(Inflate_pipeline&&) noexcept = delete;
+
+    Inflate_pipeline& operator=(Inflate_pipeline&&) noexcept = delete;
+
+    // Number of bytes in the Civ4 footer.
+    [[nodiscard]] size_t count_footer() const
+    {
+        return m_count_footer;
+    }
+
+    // Number of bytes in the Civ4 header.
+    [[nodiscard]] size_t count_header() const
+    {
+        return m_count_header;
+    }
+
+    // Returns the offset in the composite savegame of the next byte to be read.
+    [[nodiscard]] std::streamoff tell() const
+    {
+        return static_cast<std::streamoff>(m_count_read);
+    }
+
+    // Copies the next size bytes of the composite savegame to out, waiting for them to be inflated if necessary.
+    // Throws std::runtime_error if fewer than size bytes remain, or rethrows the error which stopped the producer.
+    void read(char* out, std::streamsize size);
+
+private:
+    struct Buffer {
+        std::vector<std::byte> bytes;
+        size_t size{0};
+    };
+
+    // Waits for the next buffer filled by the producer and makes it the consumer's buffer.  Returns false at the end
+    // of the composite savegame.
+    bool acquire_filled_();
+
+    // Waits for a free buffer and makes it the producer's buffer.  Returns false if the pipeline is cancelled.
+    bool acquire_free_();
+
+    // Passes the producer's buffer to the consumer.
+    void publish_();
+
+    // Body of the producer thread.
+    void produce_();
+
+    // Copies bytes into the producer's buffer, publishing the buffer whenever it is full.
+    void put_(std::span<const std::byte> bytes);
+
+    std::span<const std::byte> m_save;
+    size_t m_count_footer{0};
+    size_t m_count_header{0};
+
+    // The ring.  m_head is the index of the oldest filled buffer and m_count is the number of filled buffers,
+    // including the buffer being read by the consumer.  Both are guarded by m_mutex.
+    std::vector<Buffer> m_ring;
+    size_t m_head{0};
+    size_t m_count{0};
+    bool m_is_cancelled{false};
+    bool m_is_done{false};
+    std::exception_ptr m_error;
+    std::mutex m_mutex;
+    std::condition_variable m_filled;
+    std::condition_variable m_freed;
+
+    // Consumer state, accessed only by the consumer.
+    Buffer* m_consumer_buffer{nullptr};
+    size_t m_consumer_position{0};
+    size_t m_count_read{0};
+
+    // Producer state, accessed only by the producer.
+    Buffer* m_producer_buffer{nullptr};
+
+    // Declared last so that the thread is started after, and joined before, the members it uses are destroyed.
+    std::jthread m_producer;
+};
+
+// Allows io::read_int and io::read_string to read from an Inflate_pipeline.
+inline void read_bytes(Inflate_pipeline& in, char* out, std::streamsize size)
+{
+    in.read(out, size);
+}
+
+} // namespace c4lib::zlib
@@ -5,18 +5,27 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <ios>
 #include <iosfwd>
+#include <lib/io/cursor.hpp>
 #include <lib/native/path.hpp>
 #include <lib/util/limits.hpp>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <zlib.h>
 
 namespace c4lib::zlib {
 
 class ZLib_engine {
 public:
+    // Supplies the space into which compressed data is inflated.  The function is passed the number of bytes
+    // inflated into the span it last returned (0 for the first call) and returns the span to inflate into next, which
+    // must not be empty.
+    using Inflate_output = std::function<std::span<std::byte>(size_t count_inflated)>;
+
     // Creates the name for a binary file as generated by deflate/inflate.
     static native::Path create_binary_filename(const native::Path& output_dir,
         const native::Path& original,
@@ -44,6 +53,17 @@ public:
         size_t& count_total,
         std::unordered_map<std::string, std::string>& options);
 
+    // As above, but reads the composite savegame from in, a contiguous buffer.
+    void deflate(const native::Path& savegame,
+        std::span<const std::byte> in,
+        std::iostream& out,
+        size_t count_footer,
+        size_t& count_header,
+        size_t& count_compressed,
+        size_t& count_decompressed,
+        size_t& count_total,
+        std::unordered_map<std::string, std::string>& options);
+
     // Opens the Civilization 4 savegame for input and calls zlib inflate to decompress and then write
     // the savegame to the output stream.
     // Sets output parameters as follows:
@@ -61,6 +81,50 @@ public:
         size_t& count_total,
         std::unordered_map<std::string, std::string>& options);
 
+    // As above, but reads the Civilization 4 savegame from in rather than opening it.  The savegame input parameter
+    // is only used when creating debug output files.
+    void inflate(const native::Path& savegame,
+        std::istream& in,
+        std::iostream& out,
+        size_t& count_header,
+        size_t& count_compressed,
+        size_t& count_decompressed,
+        size_t& count_footer,
+        size_t& count_total,
+        std::unordered_map<std::string, std::string>& options);
+
+    // As above, but writes the composite savegame to out, a single contiguous buffer.  out is sized from the
+    // compressed size of the savegame, so it is rarely grown while inflating.  Existing content of out is replaced.
+    void inflate(const native::Path& savegame,
+        std::vector<std::byte>& out,
+        size_t& count_header,
+        size_t& count_compressed,
+        size_t& count_decompressed,
+        size_t& count_footer,
+        size_t& count_total,
+        std::unordered_map<std::string, std::string>& options);
+
+    // As above, but reads the Civilization 4 savegame from in, a contiguous buffer.  The savegame input parameter is
+    // only used when creating debug output files.
+    void inflate(const native::Path& savegame,
+        std::span<const std::byte> in,
+        std::vector<std::byte>& out,
+        size_t& count_header,
+        size_t& count_compressed,
+        size_t& count_decompressed,
+        size_t& count_footer,
+        size_t& count_total,
+        std::unordered_map<std::string, std::string>& options);
+
+    // Inflates the Civ4 compressed data of the savegame in, which begins at offset, passing inflated data to output as
+    // it is produced.  Unlike the overloads above, the header and footer are not copied.  count_compressed and
+    // count_decompressed are set as for inflate_ below.
+    void inflate(std::span<const std::byte> in,
+        std::streamoff offset,
+        const Inflate_output& output,
+        size_t& count_compressed,
+        size_t& count_decompressed);
+
 private:
     static native::Path create_base_binary_path_(
         const native::Path& output_dir, const native::Path& original, const std::string& suffix);
@@ -69,7 +133,7 @@ private:
     // because they avoid possible narrowing issues when converting signed types such as std::streampos,
     // std::streamoff and std::streamsize to a size type.
     void deflate_(const native::Path& savegame,
-        std::istream& in,
+        std::span<const std::byte> in,
         std::iostream& out,
         ssize_t count_footer,
         ssize_t& count_header,
@@ -78,16 +142,16 @@ private:
         ssize_t& count_total,
         std::unordered_map<std::string, std::string>& options);
 
-    // Deflate the Civ4 decompressed data from the input stream, writing compressed data to the output stream.  Note
+    // Deflate the Civ4 decompressed data from the input buffer, writing compressed data to the output stream.  Note
     // that Civ4 writes compressed data in chunks.  The size of a chunk is written, followed by the compressed data
     // proper.  Each chunk is 64K bytes long except for the first and last chunks which may be shorter.  Due to the
     // layout above, straight-forward deflation of the decompressed data will not work as chunk lengths are
     // interspersed with the compressed data.  The deflate_ method accommodates this layout.  The number of
     // compressed bytes processed, including the size fields and the zlib header is written to count_compressed_written.
     // The number of deflated bytes is written to count_decompressed.  On error, an exception is thrown.
-    void deflate_(std::istream& in,
+    void deflate_(std::span<const std::byte> in,
         std::ostream& out,
-        std::streampos offset,
+        std::streamoff offset,
         ssize_t count_footer,
         ssize_t& count_compressed_written,
         ssize_t& count_decompressed);
@@ -96,7 +160,8 @@ private:
     // because they avoid possible narrowing issues when converting signed types such as std::streampos,
     // std::streamoff and std::streamsize to a size type.
     void inflate_(const native::Path& savegame,
-        std::iostream& out,
+        std::span<const std::byte> in,
+        std::vector<std::byte>& out,
         ssize_t& count_header,
         ssize_t& count_compressed,
         ssize_t& count_decompressed,
@@ -104,16 +169,16 @@ private:
         ssize_t& count_total,
         std::unordered_map<std::string, std::string>& options);
 
-    // Inflate the Civ4 compressed data from the input stream, writing uncompressed data to the output stream.  Note
+    // Inflate the Civ4 compressed data from the input cursor, passing uncompressed data to output.  Note
     // that Civ4 writes compressed data in chunks.  The size of a chunk is written, followed by the compressed data
     // proper.  Each chunk is 64K bytes long except for the first and last chunks which may shorter.  Due to the
     // layout above, straight-forward inflation of the compressed data will not work as chunk lengths are interspersed
     // with the compressed data.  The inflate_ method accommodates this layout.  The number of compressed bytes
     // processed, including the size fields and the zlib header is written to count_compressed.  The number of
     // inflated bytes is written to count_decompressed.  On error, an exception is thrown.
-    void inflate_(std::istream& in,
-        std::ostream& out,
-        std::streampos offset,
+    void inflate_(io::Cursor& in,
+        const Inflate_output& output,
+        std::streamoff offset,
         ssize_t& count_compressed,
         ssize_t& count_decompressed);
 
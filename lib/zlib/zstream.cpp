@@ -8,6 +8,7 @@
 #include <lib/util/exception-formats.hpp>
 #include <lib/util/limits.hpp>
 #include <lib/zlib/zstream.hpp>
+#include <memory>
 #include <string>
 #include <zlib.h>
 
@@ -36,6 +37,10 @@ ZStream::ZStream(ZStream::Type type, int level)
     }
 }
 
+ZStream::ZStream()
+    : z_stream_s(), m_type(ZStream::Type::deflate)
+{}
+
 ZStream::~ZStream()
 {
     if (m_type == ZStream::Type::deflate) {
@@ -57,6 +62,19 @@ ZStream::~ZStream()
     }
 }
 
+std::unique_ptr<ZStream> ZStream::copy_deflate(ZStream& source)
+{
+    // ZStream's constructor is private, so std::make_unique cannot be used.
+    std::unique_ptr<ZStream> copy{new ZStream};
+    const int zreturn{deflateCopy(copy.get(), &source)};
+    if (zreturn != Z_OK) {
+        // The copy's state is null if deflateCopy fails, which deflateEnd tolerates.
+        const std::string error{std::format(fmt::zlib_initialization_error, zreturn)};
+        throw ZLib_error{error};
+    }
+    return copy;
+}
+
 ZStream::operator z_stream*()
 {
     return this;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <zlib.h>
 
 namespace c4lib::zlib {
@@ -26,6 +27,9 @@ public:
 
     ZStream& operator=(ZStream&&) noexcept = delete;
 
+    // Returns a copy of source, which must be a deflate stream, including its compression state.
+    static std::unique_ptr<ZStream> copy_deflate(ZStream& source);
+
     // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
     operator z_stream*();
 
@@ -33,6 +37,10 @@ public:
     operator const z_stream*() const;
 
     Type m_type;
+
+private:
+    // Constructs an uninitialized deflate stream for use by copy_deflate.
+    ZStream();
 };
 
 } // namespace c4lib::zlib
@@ -0,0 +1,64 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+// c4gen compiles a schema, importing definitions from a BTS installation, and writes C++ source for a reader
+// generated from the compiled program.  It is run by the build to produce the c4lib_bts_generated target:
+//
+//     c4gen <schema> <bts-install-dir> <custom-assets-dir> <output> [<mod-name> [<use-modular-loading>]]
+
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <lib/native/path.hpp>
+#include <lib/schema-parser/parser.hpp>
+#include <lib/schema-parser/reader-generator.hpp>
+#include <lib/util/narrow.hpp>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace csp = c4lib::schema_parser;
+
+namespace {
+constexpr size_t min_argument_count{5};
+constexpr size_t max_argument_count{7};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::span<const char* const> args{argv, gsl::narrow<size_t>(argc)};
+    if (args.size() < min_argument_count || args.size() > max_argument_count) {
+        std::cerr << "Usage: c4gen <schema> <bts-install-dir> <custom-assets-dir> <output> [<mod-name> "
+                     "[<use-modular-loading>]]\n";
+        return -1;
+    }
+
+    int rc{0};
+    try {
+        const c4lib::native::Path schema{args[1]};
+        const std::string mod_name{args.size() > 5 ? args[5] : ""};
+        const bool use_modular_loading{args.size() > 6 && std::string{args[6]} == "1"};
+        std::unordered_map<std::string, std::string> options;
+        csp::Parser parser;
+        parser.prepare(schema, c4lib::native::Path{args[2]}, c4lib::native::Path{args[3]}, mod_name,
+            use_modular_loading, options);
+
+        const csp::Reader_generator generator{parser.get_program()};
+        std::ofstream out{std::filesystem::path{args[4]}, std::ios_base::out};
+        if (!out.is_open()) {
+            std::cerr << "Unable to open " << args[4] << '\n';
+            return -1;
+        }
+        generator.write(out, std::filesystem::path{args[1]}.filename().string());
+        std::cout << "Generated reader for program " << generator.get_hash() << '\n';
+    }
+    catch (const std::exception& ex) {
+        std::cerr << '\n' << ex.what() << '\n';
+        rc = -1;
+    }
+    return rc;
+}
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <lib/options/exceptions.hpp>
 #include <lib/options/options-manager.hpp>
+#include <lib/util/constants.hpp>
 #include <lib/util/narrow.hpp>
 #include <lib/util/options-data.hpp>
 #include <lib/util/timer.hpp>
@@ -55,7 +56,8 @@ int main(int argc, char* argv[])
         options_manager.add_info(edopt::exe_options_info_lookup);
         options_manager.add_aggregate_checks({{edopt::requires_one_load_option, hopt::check_requires_at_least_one_of},
             {edopt::requires_one_write_option, hopt::check_requires_at_least_one_of},
-            {edopt::multiple_load_options_are_incompatible, hopt::check_compatibility}});
+            {edopt::multiple_load_options_are_incompatible, hopt::check_compatibility},
+            {edopt::batch_and_write_save_are_incompatible, hopt::check_compatibility}});
         options_manager.add_info(libopt::lib_options_info_lookup);
 
         // Check the options
@@ -75,31 +77,43 @@ int main(int argc, char* argv[])
             c4lib::Logger::start(log_filename, c4lib::Logger::Severity::info);
         }
 
-        // Process open option
-        std::string in_path;
-        bpt::ptree ptree;
-        if (options.contains(edopt::load_save)) {
-            in_path = options[edopt::load_save];
-            std::cout << c4edit::text::reading_save_from << ' ' << in_path << "... " << std::flush;
-            c4lib::read_save(ptree, in_path, lib_options);
-        }
-        else if (options.contains(edopt::load_info)) {
-            in_path = options[edopt::load_info];
-            std::cout << c4edit::text::reading_info_from << ' ' << in_path << "... " << std::flush;
-            c4lib::read_info(ptree, in_path, lib_options);
-        }
-        std::cout << c4edit::text::finished_in << ' ' << timer.to_string() << '\n' << std::flush;
-
-        // Process write options
         const std::array write_options{c4edit::Write_option_info{.option = edopt::write_translation,
                                            .func = &c4lib::write_translation,
-                                           .progress_message = c4edit::text::writing_translation_to},
-            c4edit::Write_option_info{
-                .option = edopt::write_info, .func = &c4lib::write_info, .progress_message = c4edit::text::writing_info_to},
-            c4edit::Write_option_info{
-                .option = edopt::write_save, .func = &c4lib::write_save, .progress_message = c4edit::text::writing_save_to}};
-        for (const auto& write_option : write_options) {
-            process_write_option(write_option, ptree, options, lib_options);
+                                           .progress_message = c4edit::text::writing_translation_to,
+                                           .extension = c4lib::constants::translation_extension},
+            c4edit::Write_option_info{.option = edopt::write_info,
+                .func = &c4lib::write_info,
+                .progress_message = c4edit::text::writing_info_to,
+                .extension = c4lib::constants::info_extension},
+            c4edit::Write_option_info{.option = edopt::write_save,
+                .func = &c4lib::write_save,
+                .progress_message = c4edit::text::writing_save_to,
+                .extension = c4lib::constants::save_extension}};
+
+        // Process batch option.  Saves in the batch are read and written by c4edit::process_batch.
+        if (options.contains(edopt::load_batch)) {
+            c4edit::process_batch(write_options, options, lib_options);
+        }
+        else {
+            // Process open option
+            std::string in_path;
+            bpt::ptree ptree;
+            if (options.contains(edopt::load_save)) {
+                in_path = options[edopt::load_save];
+                std::cout << c4edit::text::reading_save_from << ' ' << in_path << "... " << std::flush;
+                c4lib::read_save(ptree, in_path, lib_options);
+            }
+            else if (options.contains(edopt::load_info)) {
+                in_path = options[edopt::load_info];
+                std::cout << c4edit::text::reading_info_from << ' ' << in_path << "... " << std::flush;
+                c4lib::read_info(ptree, in_path, lib_options);
+            }
+            std::cout << c4edit::text::finished_in << ' ' << timer.to_string() << '\n' << std::flush;
+
+            // Process write options
+            for (const auto& write_option : write_options) {
+                process_write_option(write_option, ptree, options, lib_options);
+            }
         }
     }
     catch (const hopt::Display_help_error& ex) {
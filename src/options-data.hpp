@@ -26,7 +26,7 @@ inline const hopts::Option_info config_file_option_info{.name = "CONFIG_FILE",
     .depends_on = {}};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// FILE TO LOAD - ONE REQUIRED
+// FILE(S) TO LOAD - ONE REQUIRED
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 inline const hopts::Option_info load_save_option_info{.name = "LOAD_SAVE",
     .help_type = "<filename>",
@@ -46,6 +46,16 @@ inline const hopts::Option_info load_info_option_info{.name = "LOAD_INFO",
     .required = false,
     .depends_on = {}};
 
+inline const hopts::Option_info load_batch_option_info{.name = "LOAD_BATCH",
+    .help_type = "<directory>",
+    .help_meaning = "Name of a directory of .CivBeyondSwordSave files to load concurrently.  WRITE_TRANSLATION and "
+                    "WRITE_INFO then name the directories into which a file for each save is written.",
+    .help_sort_order = 220,
+    .type = hopts::Option_type::text,
+    .default_value = "",
+    .required = false,
+    .depends_on = {"BTS_INSTALL_DIR", "CUSTOM_ASSETS_DIR", "SCHEMA"}};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE(S) TO SAVE - AT LEAST ONE REQUIRED
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -96,6 +106,7 @@ inline const std::unordered_map<std::string, hopts::Option_info> exe_options_inf
 
     {load_save_option_info.name, load_save_option_info},
     {load_info_option_info.name, load_info_option_info},
+    {load_batch_option_info.name, load_batch_option_info},
 
     {write_translation_option_info.name, write_translation_option_info},
     {write_info_option_info.name, write_info_option_info},
@@ -110,6 +121,7 @@ inline const std::unordered_map<std::string, hopts::Option_info> exe_options_inf
 inline const std::vector<std::string> requires_one_load_option{
     "LOAD_SAVE",
     "LOAD_INFO",
+    "LOAD_BATCH",
 };
 
 inline const std::vector<std::string> requires_one_write_option{
@@ -121,6 +133,13 @@ inline const std::vector<std::string> requires_one_write_option{
 inline const std::vector<std::string> multiple_load_options_are_incompatible{
     "LOAD_SAVE",
     "LOAD_INFO",
+    "LOAD_BATCH",
+};
+
+// Converting a batch of saves back to saves serves no purpose.
+inline const std::vector<std::string> batch_and_write_save_are_incompatible{
+    "LOAD_BATCH",
+    "WRITE_SAVE",
 };
 
 } // namespace c4edit::options
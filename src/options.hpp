@@ -13,7 +13,7 @@ namespace c4edit::options {
 inline constexpr const char* config_file{"CONFIG_FILE"};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// FILE TO LOAD - ONE REQUIRED
+// FILE(S) TO LOAD - ONE REQUIRED
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Name of a .CivBeyondSwordSave to load.  Either a BTS save or an info file must be loaded.
 inline constexpr const char* load_save{"LOAD_SAVE"};
@@ -21,6 +21,10 @@ inline constexpr const char* load_save{"LOAD_SAVE"};
 // Name of an info file to load.  Either a BTS save or an info file must be loaded.
 inline constexpr const char* load_info{"LOAD_INFO"};
 
+// Name of a directory of .CivBeyondSwordSave files to load.  The saves are read concurrently and the values of the
+// write options name the directories into which a file for each save is written.
+inline constexpr const char* load_batch{"LOAD_BATCH"};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE(S) TO SAVE - AT LEAST ONE REQUIRED
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -8,10 +8,12 @@ namespace c4edit::text {
 
 inline constexpr const char* exe_name{"c4edit"};
 inline constexpr const char* finished_in{"Finished in"};
+inline constexpr const char* reading_batch_from{"Reading saves from"};
 inline constexpr const char* reading_info_from{"Reading info from"};
 inline constexpr const char* reading_save_from{"Reading save from"};
 inline constexpr const char* options{"options"};
 inline constexpr const char* options_capitalized{"Options"};
+inline constexpr const char* saves_read{"saves read."};
 inline constexpr const char* usage_capitalized{"Usage"};
 inline constexpr const char* version{"version"};
 inline constexpr const char* writing_info_to{"Writing info to"};
@@ -4,14 +4,22 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <c4lib-version.hpp>
+#include <filesystem>
 #include <format>
+#include <include/c4lib.hpp>
 #include <iostream>
+#include <lib/util/constants.hpp>
 #include <lib/util/timer.hpp>
+#include <span>
+#include <src/options.hpp>
 #include <src/text.hpp>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace c4edit {
 
@@ -21,6 +29,9 @@ struct Write_option_info {
     void (*func)(const boost::property_tree::ptree&, const std::string&, std::unordered_map<std::string, std::string>&);
 
     std::string progress_message;
+
+    // Extension of the files written for each save when loading a batch.
+    std::string extension;
 };
 
 inline std::string banner()
@@ -52,4 +63,48 @@ inline void process_write_option(const Write_option_info& write_option,
     }
 }
 
+// Reads each .CivBeyondSwordSave in the batch directory concurrently.  For each save, each write option present in
+// write_options is processed, writing a file named after the save to the directory named by the option.
+inline void process_batch(std::span<const Write_option_info> write_options,
+    std::unordered_map<std::string, std::string>& exe_options,
+    std::unordered_map<std::string, std::string>& lib_options)
+{
+    c4lib::Timer timer;
+    timer.start();
+    const std::filesystem::path batch_dir{exe_options[options::load_batch]};
+    std::vector<std::string> filenames;
+    for (const auto& entry : std::filesystem::directory_iterator{batch_dir}) {
+        if (entry.is_regular_file() && entry.path().extension() == c4lib::constants::save_extension) {
+            filenames.push_back(entry.path().string());
+        }
+    }
+    std::ranges::sort(filenames);
+
+    // Pair each write option present with its output directory.  The pairs are read concurrently by the callback.
+    std::vector<std::pair<const Write_option_info*, std::filesystem::path>> outputs;
+    for (const auto& write_option : write_options) {
+        if (exe_options.contains(write_option.option)) {
+            outputs.emplace_back(&write_option, std::filesystem::path{exe_options[write_option.option]});
+            std::filesystem::create_directories(outputs.back().second);
+        }
+    }
+
+    std::cout << text::reading_batch_from << ' ' << batch_dir.string() << "... " << std::flush;
+    c4lib::read_saves(
+        filenames,
+        [&outputs, &lib_options](const std::string& filename, boost::property_tree::ptree& pt) {
+            // Writers may modify options, so each call requires its own copy.
+            std::unordered_map<std::string, std::string> options{lib_options};
+            const std::string stem{std::filesystem::path{filename}.stem().string()};
+            for (const auto& [write_option, dir] : outputs) {
+                const std::filesystem::path out_path{dir / (stem + write_option->extension)};
+                (*write_option->func)(pt, out_path.string(), options);
+            }
+        },
+        lib_options);
+    std::cout << filenames.size() << ' ' << text::saves_read << ' ' << text::finished_in << ' ' << timer.to_string()
+              << '\n'
+              << std::flush;
+}
+
 } // namespace c4edit
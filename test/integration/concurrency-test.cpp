@@ -0,0 +1,148 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <gtest/gtest.h>
+#include <include/c4lib.hpp>
+#include <include/node-attributes.hpp>
+#include <ios>
+#include <lib/io/io.hpp>
+#include <lib/native/path.hpp>
+#include <lib/ptree/debug.hpp>
+#include <lib/util/constants.hpp>
+#include <lib/util/options.hpp>
+#include <sstream>
+#include <string>
+#include <test/util/constants.hpp>
+#include <test/util/util.hpp>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bpt = boost::property_tree;
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib::property_tree {
+
+// Stress test for the thread-safety guarantee documented in c4lib.hpp.  Build with TSAN_ENABLED set in the
+// environment to run the test under ThreadSanitizer; the concurrency_stress_test target runs this test only.
+class Concurrency_test : public testing::Test {
+public:
+    Concurrency_test() = default;
+
+    ~Concurrency_test() override = default;
+
+    Concurrency_test(const Concurrency_test&) = delete;
+
+    Concurrency_test& operator=(const Concurrency_test&) = delete;
+
+    Concurrency_test(Concurrency_test&&) noexcept = delete;
+
+    Concurrency_test& operator=(Concurrency_test&&) noexcept = delete;
+
+protected:
+    // The result of reading a save and then writing it back.
+    struct Result {
+        std::string dump;
+        std::string save;
+        std::exception_ptr error;
+    };
+
+    void SetUp() override
+    {
+        m_options[options::schema] = ctc::relative_root_path / native::Path{R"(\doc\BTS.schema)"};
+        m_options[options::bts_install_dir]
+            = R"(C:\Program Files (x86)\GOG Galaxy\Games\Civilization IV Complete\Civ4\Beyond the Sword)";
+        m_options[options::custom_assets_dir]
+            = R"(C:\Users\Passenger\Documents\My Games\beyond the sword\CustomAssets)";
+        m_options[options::debug_output_dir] = ctc::out_common_dir;
+        std::filesystem::create_directories(std::filesystem::path{out_dir});
+    }
+
+    void TearDown() override {}
+
+    // Reads filename, writes the save to out_filename and records the result.  options is passed by value since
+    // each concurrent call requires its own options.
+    static void read_then_write(const std::string& filename,
+        const std::string& out_filename,
+        std::unordered_map<std::string, std::string> options,
+        Result& result)
+    {
+        try {
+            bpt::ptree pt;
+            read_save(pt, filename, options);
+            write_save(pt, out_filename, options);
+            pt.erase(nn_origin);
+            std::stringstream dump;
+            dump_ptree(dump, pt);
+            result.dump = dump.str();
+            std::stringstream save;
+            save.unsetf(std::ios::skipws);
+            io::read_binary_file_to_stream(native::Path{out_filename}, 0, 0, save);
+            result.save = save.str();
+        }
+        catch (...) {
+            result.error = std::current_exception();
+        }
+    }
+
+    const native::Path out_dir{ctc::out_common_dir / native::Path{"concurrency-test"}};
+    std::unordered_map<std::string, std::string> m_options;
+};
+
+// Reads and writes every save in data/saves, first sequentially and then concurrently with each save processed by
+// several threads at once, and checks that the concurrent results match the sequential ones.
+TEST_F(Concurrency_test, integration_test_read_all_saves_concurrently)
+{
+    constexpr size_t threads_per_save{2};
+
+    std::vector<std::string> filenames;
+    for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{ctc::data_saves_dir}}) {
+        if (entry.path().extension() == constants::save_extension) {
+            filenames.push_back(entry.path().string());
+        }
+    }
+    ASSERT_FALSE(filenames.empty());
+
+    const auto make_out_filename{[this](const std::string& filename, size_t thread_index) {
+        const std::string stem{std::filesystem::path{filename}.stem().string()};
+        return std::string{out_dir / native::Path{stem + "-" + std::to_string(thread_index) + ".CivBeyondSwordSave"}};
+    }};
+
+    std::vector<Result> expected(filenames.size());
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        read_then_write(filenames[i], make_out_filename(filenames[i], 0), m_options, expected[i]);
+        ASSERT_FALSE(expected[i].error) << filenames[i];
+    }
+
+    std::vector<Result> actual(filenames.size() * threads_per_save);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < actual.size(); ++i) {
+            const std::string& filename{filenames[i / threads_per_save]};
+            threads.emplace_back(
+                read_then_write, filename, make_out_filename(filename, 1 + i % threads_per_save), m_options,
+                std::ref(actual[i]));
+        }
+    }
+
+    for (size_t i = 0; i < actual.size(); ++i) {
+        const std::string& filename{filenames[i / threads_per_save]};
+        const Result& expected_result{expected[i / threads_per_save]};
+        EXPECT_FALSE(actual[i].error) << filename;
+        std::stringstream expected_dump{expected_result.dump};
+        std::stringstream actual_dump{actual[i].dump};
+        std::stringstream errors;
+        EXPECT_EQ(test::compare_text_streams(expected_dump, actual_dump, 10, errors), 0) << filename << errors.str();
+        std::stringstream expected_save{expected_result.save};
+        std::stringstream actual_save{actual[i].save};
+        EXPECT_EQ(test::compare_binary_streams(expected_save, actual_save, errors), 0) << filename << errors.str();
+    }
+}
+
+} // namespace c4lib::property_tree
@@ -0,0 +1,129 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <boost/property_tree/ptree.hpp>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <gtest/gtest.h>
+#include <include/c4lib.hpp>
+#include <include/node-attributes.hpp>
+#include <include/session.hpp>
+#include <lib/native/path.hpp>
+#include <lib/ptree/debug.hpp>
+#include <lib/util/constants.hpp>
+#include <lib/util/options.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <test/util/constants.hpp>
+#include <test/util/util.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace bpt = boost::property_tree;
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib::property_tree {
+
+// Compares the time taken to read each save with and without the PIPELINED_READ option.  The benchmark is disabled in
+// the default suite; the pipelined_read_benchmark target runs it.  Build in release mode for meaningful timings.
+class Pipelined_read_benchmark : public testing::Test {
+public:
+    Pipelined_read_benchmark() = default;
+
+    ~Pipelined_read_benchmark() override = default;
+
+    Pipelined_read_benchmark(const Pipelined_read_benchmark&) = delete;
+
+    Pipelined_read_benchmark& operator=(const Pipelined_read_benchmark&) = delete;
+
+    Pipelined_read_benchmark(Pipelined_read_benchmark&&) noexcept = delete;
+
+    Pipelined_read_benchmark& operator=(Pipelined_read_benchmark&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        m_options[options::schema] = ctc::relative_root_path / native::Path{R"(\doc\BTS.schema)"};
+        m_options[options::bts_install_dir]
+            = R"(C:\Program Files (x86)\GOG Galaxy\Games\Civilization IV Complete\Civ4\Beyond the Sword)";
+        m_options[options::custom_assets_dir]
+            = R"(C:\Users\Passenger\Documents\My Games\beyond the sword\CustomAssets)";
+        m_options[options::debug_output_dir] = ctc::out_common_dir;
+    }
+
+    void TearDown() override {}
+
+    // Reads filename repetitions times using session and returns the fastest time taken.  The dump of the last
+    // property tree read, less its origin node, is written to dump.
+    static std::chrono::microseconds time_read(
+        Session& session, const std::string& filename, size_t repetitions, std::string& dump)
+    {
+        auto fastest{std::chrono::microseconds::max()};
+        for (size_t i = 0; i < repetitions; ++i) {
+            bpt::ptree pt;
+            const auto start{std::chrono::steady_clock::now()};
+            session.read_save(pt, filename);
+            const auto elapsed{
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)};
+            fastest = std::min(fastest, elapsed);
+
+            if (i + 1 == repetitions) {
+                pt.erase(nn_origin);
+                std::stringstream ss;
+                dump_ptree(ss, pt);
+                dump = ss.str();
+            }
+        }
+        return fastest;
+    }
+
+    std::unordered_map<std::string, std::string> m_options;
+};
+
+// Reads every save in data/saves with and without pipelining, records the fastest time for each mode as a test
+// property and checks that both modes read the same property tree.
+TEST_F(Pipelined_read_benchmark, DISABLED_integration_test_benchmark_pipelined_read)
+{
+    constexpr size_t repetitions{5};
+
+    std::vector<std::string> filenames;
+    for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{ctc::data_saves_dir}}) {
+        if (entry.path().extension() == constants::save_extension) {
+            filenames.push_back(entry.path().string());
+        }
+    }
+    ASSERT_FALSE(filenames.empty());
+
+    std::unordered_map<std::string, std::string> contiguous_options{m_options};
+    contiguous_options[options::pipelined_read] = "0";
+    std::unique_ptr<Session> contiguous;
+    ASSERT_NO_THROW(contiguous = std::make_unique<Session>(contiguous_options));
+    std::unordered_map<std::string, std::string> pipelined_options{m_options};
+    pipelined_options[options::pipelined_read] = "1";
+    std::unique_ptr<Session> pipelined;
+    ASSERT_NO_THROW(pipelined = std::make_unique<Session>(pipelined_options));
+
+    for (const auto& filename : filenames) {
+        std::string expected;
+        std::string actual;
+        const auto contiguous_time{time_read(*contiguous, filename, repetitions, expected)};
+        const auto pipelined_time{time_read(*pipelined, filename, repetitions, actual)};
+
+        const double ratio{static_cast<double>(pipelined_time.count()) / static_cast<double>(contiguous_time.count())};
+        RecordProperty(std::filesystem::path{filename}.stem().string(),
+            std::format("contiguous {} us, pipelined {} us, ratio {:.2f}", contiguous_time.count(),
+                pipelined_time.count(), ratio));
+
+        std::stringstream expected_dump{expected};
+        std::stringstream actual_dump{actual};
+        std::stringstream errors;
+        EXPECT_EQ(test::compare_text_streams(expected_dump, actual_dump, 10, errors), 0) << filename << errors.str();
+    }
+}
+
+} // namespace c4lib::property_tree
@@ -0,0 +1,133 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <include/c4lib.hpp>
+#include <include/node-attributes.hpp>
+#include <lib/native/path.hpp>
+#include <lib/ptree/debug.hpp>
+#include <lib/util/options.hpp>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <test/util/constants.hpp>
+#include <test/util/util.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace bpt = boost::property_tree;
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib::property_tree {
+
+class Read_saves_test : public testing::Test {
+public:
+    Read_saves_test() = default;
+
+    ~Read_saves_test() override = default;
+
+    Read_saves_test(const Read_saves_test&) = delete;
+
+    Read_saves_test& operator=(const Read_saves_test&) = delete;
+
+    Read_saves_test(Read_saves_test&&) noexcept = delete;
+
+    Read_saves_test& operator=(Read_saves_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        m_options[options::schema] = ctc::relative_root_path / native::Path{R"(\doc\BTS.schema)"};
+        m_options[options::bts_install_dir]
+            = R"(C:\Program Files (x86)\GOG Galaxy\Games\Civilization IV Complete\Civ4\Beyond the Sword)";
+        m_options[options::custom_assets_dir]
+            = R"(C:\Users\Passenger\Documents\My Games\beyond the sword\CustomAssets)";
+        m_options[options::debug_output_dir] = ctc::out_common_dir;
+    }
+
+    void TearDown() override {}
+
+    // Dumps pt, less its origin node which contains the time at which the save was read.
+    static std::string dump(bpt::ptree& pt)
+    {
+        pt.erase(nn_origin);
+        std::stringstream ss;
+        dump_ptree(ss, pt);
+        return ss.str();
+    }
+
+    std::unordered_map<std::string, std::string> m_options;
+};
+
+// Reads several saves concurrently, including the same save more than once, and checks that each result matches
+// that obtained from the free function read_save.
+TEST_F(Read_saves_test, integration_test_read_saves_matches_read_save)
+{
+    std::vector<std::string> filenames;
+    for (const std::string save_name : {"Brennus BC-4000", "Mao Zedong_1936-AD_Feb-26-2023_07-31-57",
+             "Tiny-Map-BC-4000", "Brennus BC-4000"}) {
+        filenames.push_back(ctc::data_saves_dir / native::Path{save_name + ".CivBeyondSwordSave"});
+    }
+
+    std::mutex mutex;
+    std::multimap<std::string, std::string> actual_dumps;
+    m_options[options::worker_count] = "3";
+    m_options[options::import_worker_count] = "2";
+    EXPECT_NO_THROW(read_saves(
+        filenames,
+        [&](const std::string& filename, bpt::ptree& pt) {
+            const std::string actual_dump{dump(pt)};
+            const std::scoped_lock lock{mutex};
+            actual_dumps.emplace(filename, actual_dump);
+        },
+        m_options));
+    ASSERT_EQ(actual_dumps.size(), filenames.size());
+
+    for (const auto& [filename, actual_dump] : actual_dumps) {
+        bpt::ptree expected;
+        EXPECT_NO_THROW(read_save(expected, filename, m_options)) << filename;
+        std::stringstream expected_stream{dump(expected)};
+        std::stringstream actual_stream{actual_dump};
+        std::stringstream errors;
+        EXPECT_EQ(test::compare_text_streams(expected_stream, actual_stream, 10, errors), 0) << filename << errors.str();
+    }
+}
+
+// Checks that a save which cannot be read does not prevent the remaining saves from being read and that the error
+// is reported once all saves have been processed.
+TEST_F(Read_saves_test, integration_test_read_saves_reports_error)
+{
+    const std::vector<std::string> filenames{
+        ctc::data_saves_dir / native::Path{"No-Such-Save.CivBeyondSwordSave"},
+        ctc::data_saves_dir / native::Path{"Tiny-Map-BC-4000.CivBeyondSwordSave"}};
+
+    std::mutex mutex;
+    std::vector<std::string> read_filenames;
+    EXPECT_ANY_THROW(read_saves(
+        filenames,
+        [&](const std::string& filename, bpt::ptree&) {
+            const std::scoped_lock lock{mutex};
+            read_filenames.push_back(filename);
+        },
+        m_options));
+    ASSERT_EQ(read_filenames.size(), 1);
+    EXPECT_EQ(read_filenames.at(0), filenames.at(1));
+}
+
+// Checks that thread counts which are not positive select one thread per hardware thread rather than failing.
+TEST_F(Read_saves_test, integration_test_read_saves_non_positive_worker_count)
+{
+    const std::vector<std::string> filenames{ctc::data_saves_dir / native::Path{"Tiny-Map-BC-4000.CivBeyondSwordSave"}};
+
+    size_t read_count{0};
+    m_options[options::worker_count] = "-1";
+    m_options[options::import_worker_count] = "-1";
+    EXPECT_NO_THROW(read_saves(filenames, [&](const std::string&, bpt::ptree&) { ++read_count; }, m_options));
+    EXPECT_EQ(read_count, 1);
+}
+
+} // namespace c4lib::property_tree
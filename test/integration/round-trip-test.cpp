@@ -5,6 +5,8 @@
 #include <array>
 #include <boost/property_tree/ptree.hpp>
 #include <cstddef>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <include/c4lib.hpp>
 #include <ios>
@@ -13,6 +15,7 @@
 #include <lib/native/path.hpp>
 #include <lib/ptree/debug.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
 #include <lib/util/options.hpp>
 #include <lib/zlib/constants.hpp>
 #include <lib/zlib/zlib-engine.hpp>
@@ -22,6 +25,7 @@
 #include <test/util/util.hpp>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 using namespace std::string_literals;
 namespace bpt = boost::property_tree;
@@ -325,4 +329,31 @@ TEST_F(Round_trip_test, integration_test_round_trip_all_saves)
     }
 }
 
+// Reads a save from memory and writes it back to memory.  The result must match both the original save and the
+// property tree obtained by reading the save from its file.
+TEST_F(Round_trip_test, integration_test_round_trip_in_memory)
+{
+    const native::Path savegame{ctc::data_saves_dir / native::Path{"Brennus BC-4000.CivBeyondSwordSave"}};
+    m_options[options::debug_output_dir] = ctc::out_common_dir;
+    m_options[options::debug_write_binaries] = "0";
+
+    std::vector<std::byte> original(std::filesystem::file_size(std::filesystem::path{savegame}));
+    std::ifstream file{savegame, std::ios_base::in | std::ios_base::binary};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.read(reinterpret_cast<char*>(original.data()), gsl::narrow<std::streamsize>(original.size()));
+    ASSERT_TRUE(file);
+
+    bpt::ptree ptree_from_memory;
+    EXPECT_NO_THROW(read_save(ptree_from_memory, original, savegame, m_options));
+    bpt::ptree ptree_from_file;
+    EXPECT_NO_THROW(read_save(ptree_from_file, savegame, m_options));
+    ptree_from_memory.erase(nn_origin);
+    ptree_from_file.erase(nn_origin);
+    EXPECT_TRUE(ptree_from_memory == ptree_from_file);
+
+    std::vector<std::byte> round_trip;
+    EXPECT_NO_THROW(write_save(ptree_from_memory, round_trip, m_options));
+    EXPECT_EQ(round_trip, original);
+}
+
 } // namespace c4lib::property_tree
@@ -0,0 +1,189 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <boost/property_tree/ptree.hpp>
+#include <gtest/gtest.h>
+#include <include/c4lib.hpp>
+#include <include/exceptions.hpp>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/offset-index.hpp>
+#include <include/session.hpp>
+#include <lib/native/path.hpp>
+#include <lib/io/cursor.hpp>
+#include <lib/io/io.hpp>
+#include <lib/ptree/debug.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/options.hpp>
+#include <lib/zlib/zlib-engine.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <test/util/constants.hpp>
+#include <test/util/macros.hpp>
+#include <test/util/util.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace bpt = boost::property_tree;
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib::property_tree {
+
+class Session_test : public testing::Test {
+public:
+    Session_test() = default;
+
+    ~Session_test() override = default;
+
+    Session_test(const Session_test&) = delete;
+
+    Session_test& operator=(const Session_test&) = delete;
+
+    Session_test(Session_test&&) noexcept = delete;
+
+    Session_test& operator=(Session_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        m_options[options::schema] = ctc::relative_root_path / native::Path{R"(\doc\BTS.schema)"};
+        m_options[options::bts_install_dir]
+            = R"(C:\Program Files (x86)\GOG Galaxy\Games\Civilization IV Complete\Civ4\Beyond the Sword)";
+        m_options[options::custom_assets_dir]
+            = R"(C:\Users\Passenger\Documents\My Games\beyond the sword\CustomAssets)";
+        m_options[options::debug_output_dir] = ctc::out_common_dir;
+    }
+
+    void TearDown() override {}
+
+    // Dumps pt, less its origin node which contains the time at which the save was read.
+    static std::string dump(bpt::ptree& pt)
+    {
+        pt.erase(nn_origin);
+        std::stringstream ss;
+        dump_ptree(ss, pt);
+        return ss.str();
+    }
+
+    std::unordered_map<std::string, std::string> m_options;
+};
+
+// Reads several saves, some more than once, using a single session and checks that each result matches that
+// obtained from the free function read_save.  Saves have differing PlayerTypes definitions, so this also checks
+// that per-save definitions are discarded between reads.
+TEST_F(Session_test, integration_test_session_matches_read_save)
+{
+    const std::array<std::string, 4> save_names{
+        "Brennus BC-4000", "Mao Zedong_1936-AD_Feb-26-2023_07-31-57", "Tiny-Map-BC-4000", "Brennus BC-4000"};
+
+    std::unique_ptr<Session> session;
+    ASSERT_NO_THROW(session = std::make_unique<Session>(m_options));
+
+    for (const auto& save_name : save_names) {
+        const native::Path filename{ctc::data_saves_dir / native::Path{save_name + ".CivBeyondSwordSave"}};
+
+        bpt::ptree expected;
+        EXPECT_NO_THROW(read_save(expected, filename, m_options)) << save_name;
+        bpt::ptree actual;
+        EXPECT_NO_THROW(session->read_save(actual, filename)) << save_name;
+
+        std::stringstream expected_dump{dump(expected)};
+        std::stringstream actual_dump{dump(actual)};
+        std::stringstream errors;
+        EXPECT_EQ(test::compare_text_streams(expected_dump, actual_dump, 10, errors), 0) << save_name << errors.str();
+    }
+}
+
+// Reads a save with an offset index and checks that the bytes at the offset of each 4-byte integer leaf hold the
+// leaf's value, and that the leaves are ordered by offset and do not overlap.
+TEST_F(Session_test, integration_test_session_offset_index)
+{
+    const native::Path filename{ctc::data_saves_dir / native::Path{"Brennus BC-4000.CivBeyondSwordSave"}};
+
+    std::unique_ptr<Session> session;
+    ASSERT_NO_THROW(session = std::make_unique<Session>(m_options));
+    bpt::ptree pt;
+    Offset_index index;
+    ASSERT_NO_THROW(session->read_save(pt, index, filename));
+    ASSERT_NE(index.count(), 0);
+
+    zlib::ZLib_engine engine;
+    size_t count_header{limits::invalid_size};
+    size_t count_compressed{limits::invalid_size};
+    size_t count_decompressed{limits::invalid_size};
+    size_t count_footer{limits::invalid_size};
+    size_t count_total{limits::invalid_size};
+    std::vector<std::byte> composite;
+    ASSERT_NO_THROW(engine.inflate(filename, composite, count_header, count_compressed, count_decompressed,
+        count_footer, count_total, m_options));
+
+    for (size_t i = 0; i < index.count(); ++i) {
+        const Leaf_offset& leaf{index.at(i)};
+        EXPECT_EQ(index.find(leaf.path), i) << leaf.path;
+        if (i + 1 < index.count()) {
+            EXPECT_LE(leaf.offset + leaf.size, index.at(i + 1).offset) << leaf.path;
+        }
+        if (leaf.type == Node_type::int_type && leaf.size == 4) {
+            io::Cursor cursor{composite};
+            cursor.seek(static_cast<std::streamoff>(leaf.offset));
+            int32_t value{0};
+            io::read_int(cursor, value);
+            const std::string data_path{leaf.path + '.' + nn_attributes + '.' + nn_data};
+            EXPECT_EQ(value, pt.get<int32_t>(data_path)) << leaf.path;
+        }
+    }
+}
+
+// Patches an int leaf of a save and checks that the patched save reads as the original does except for that leaf.
+TEST_F(Session_test, integration_test_session_patch_save)
+{
+    const native::Path filename{ctc::data_saves_dir / native::Path{"Brennus BC-4000.CivBeyondSwordSave"}};
+    const native::Path patched_filename{ctc::out_common_dir / native::Path{"Brennus BC-4000-patched.CivBeyondSwordSave"}};
+
+    std::unique_ptr<Session> session;
+    ASSERT_NO_THROW(session = std::make_unique<Session>(m_options));
+    bpt::ptree expected;
+    Offset_index index;
+    ASSERT_NO_THROW(session->read_save(expected, index, filename));
+
+    // Patch the last 4-byte int leaf.
+    size_t leaf_index{index.count()};
+    while (leaf_index != 0
+           && (index.at(leaf_index - 1).type != Node_type::int_type || index.at(leaf_index - 1).size != 4)) {
+        --leaf_index;
+    }
+    ASSERT_NE(leaf_index, 0);
+    const std::string& path{index.at(leaf_index - 1).path};
+    const std::string data_path{path + '.' + nn_attributes + '.' + nn_data};
+    const int32_t value{expected.get<int32_t>(data_path) + 1};
+    ASSERT_NO_THROW(session->patch_save(filename, patched_filename, {{path, std::to_string(value)}}));
+    EXPECT_THROW(session->patch_save(filename, patched_filename, {{path + "_", "0"}}), Ptree_error);
+    EXPECT_THROW(session->patch_save(filename, patched_filename, {{path, "4294967296"}}), Ptree_error);
+    // Leaves read by the schema, e.g., array dimensions, cannot be patched, and an enum must be given a value its enum
+    // defines.
+    EXPECT_THROW_CONTAINS_MSG(
+        session->patch_save(filename, patched_filename, {{"Savegame.CvInitCore.NumCustomMapOptions", "0"}}),
+        Ptree_error, "the schema refers to its value");
+    EXPECT_THROW_CONTAINS_MSG(
+        session->patch_save(filename, patched_filename, {{"Savegame.CvInitCore.Calendar", "1000"}}), Ptree_error,
+        "is not a value of enum CalendarTypes");
+
+    bpt::ptree actual;
+    ASSERT_NO_THROW(session->read_save(actual, patched_filename));
+    EXPECT_EQ(actual.get<int32_t>(data_path), value);
+    actual.put(data_path, expected.get<std::string>(data_path));
+    actual.put(path + '.' + nn_attributes + '.' + nn_formatted_data,
+        expected.get<std::string>(path + '.' + nn_attributes + '.' + nn_formatted_data));
+
+    std::stringstream expected_dump{dump(expected)};
+    std::stringstream actual_dump{dump(actual)};
+    std::stringstream errors;
+    EXPECT_EQ(test::compare_text_streams(expected_dump, actual_dump, 10, errors), 0) << errors.str();
+}
+
+} // namespace c4lib::property_tree
@@ -4,15 +4,23 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <cstddef>
+#include <exception>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <ios>
 #include <lib/native/path.hpp>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/ptree/ptree-node-emitter.hpp>
+#include <lib/schema-parser/def-mem-type.hpp>
+#include <lib/schema-parser/def-mem.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
 #include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/definition.hpp>
 #include <lib/schema-parser/parser-phase-one.hpp>
 #include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/file-location.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/symbol-table.hpp>
 #include <lib/variable-manager/variable-manager.hpp>
 #include <stdexcept>
 #include <string>
@@ -49,7 +57,7 @@ protected:
         m_root_name_index = limits::invalid_size;
         m_tokenizer.reset();
         m_use_modular_loading = false;
-        m_variable_manager.init(&m_ptree, &m_ptree_parent, &m_definition_table);
+        m_variable_manager.init(&m_emitter, &m_parent, &m_definition_table);
     }
 
     void TearDown() override {}
@@ -60,7 +68,8 @@ protected:
     Def_tbl m_definition_table;
     native::Path m_install_root;
     bpt::ptree m_ptree;
-    bpt::ptree* m_ptree_parent{&m_ptree};
+    property_tree::Ptree_node_emitter m_emitter{m_ptree};
+    size_t m_parent{property_tree::Node_emitter::root};
     std::string m_mod_name;
     size_t m_root_name_index{limits::invalid_size};
     Tokenizer m_tokenizer;
@@ -90,4 +99,81 @@ TEST_F(Definition_table_test, unit_test_export)
         export_(m_definition_table, Def_type::enum_type, ctc::out_common_dir / native::Path{"EnumDefinitions.txt"}));
 }
 
+TEST_F(Definition_table_test, unit_test_rollback)
+{
+    const File_location loc;
+    bool was_created{false};
+    Definition& leaders{m_definition_table.create_definition("LeaderHeadTypes", Def_type::enum_type, loc, was_created)};
+    Def_mem no_leader{Def_mem_type::enum_type, "NO_LEADERHEAD", -1, loc};
+    leaders.add_member(no_leader, false, false);
+    m_definition_table.checkpoint();
+
+    // Simulate the per-save definitions created while reading a save.
+    Def_mem leader{Def_mem_type::enum_type, "LEADER_ALEXANDER", 0, loc};
+    leaders.add_member(leader, false, false);
+    Definition& players{m_definition_table.create_definition("PlayerTypes", Def_type::enum_type, loc, was_created)};
+    Def_mem no_player{Def_mem_type::enum_type, "NO_PLAYER", -1, loc};
+    players.add_member(no_player, false, false);
+    EXPECT_EQ(m_definition_table.size(), 2);
+
+    EXPECT_NO_THROW(m_definition_table.rollback());
+    EXPECT_EQ(m_definition_table.size(), 1);
+    EXPECT_THROW(static_cast<void>(m_definition_table.get_type("PlayerTypes")), std::exception);
+    EXPECT_EQ(m_definition_table.get_definition("LeaderHeadTypes", Def_type::enum_type).get_members().size(), 1);
+    EXPECT_THROW(static_cast<void>(m_definition_table.get_enumerator("LeaderHeadTypes", "LEADER_ALEXANDER")),
+        std::exception);
+
+    // Definitions may be recreated following rollback.
+    Definition& recreated{m_definition_table.create_definition("PlayerTypes", Def_type::enum_type, loc, was_created)};
+    EXPECT_TRUE(was_created);
+    EXPECT_NO_THROW(recreated.add_member(no_player, false, false));
+}
+
+TEST_F(Definition_table_test, unit_test_copy_from)
+{
+    const File_location loc;
+    bool was_created{false};
+    Definition& leaders{m_definition_table.create_definition("LeaderHeadTypes", Def_type::enum_type, loc, was_created)};
+    Def_mem no_leader{Def_mem_type::enum_type, "NO_LEADERHEAD", -1, loc};
+    leaders.add_member(no_leader, false, false);
+    m_definition_table.checkpoint();
+
+    Def_tbl copy;
+    EXPECT_NO_THROW(copy.copy_from(m_definition_table));
+    EXPECT_EQ(copy.size(), 1);
+    EXPECT_EQ(copy.get_enumerator("LeaderHeadTypes", "NO_LEADERHEAD").value, -1);
+
+    // Changes to the copy do not affect the original, and the checkpoint is copied.
+    Definition& players{copy.create_definition("PlayerTypes", Def_type::enum_type, loc, was_created)};
+    Def_mem no_player{Def_mem_type::enum_type, "NO_PLAYER", -1, loc};
+    players.add_member(no_player, false, false);
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(m_definition_table.size(), 1);
+    EXPECT_NO_THROW(copy.rollback());
+    EXPECT_EQ(copy.size(), 1);
+}
+
+TEST_F(Definition_table_test, unit_test_symbol_lookup)
+{
+    const File_location loc;
+    bool was_created{false};
+    Definition& leaders{m_definition_table.create_definition("LeaderHeadTypes", Def_type::enum_type, loc, was_created)};
+    Def_mem no_leader{Def_mem_type::enum_type, "NO_LEADERHEAD", -1, loc};
+    leaders.add_member(no_leader, false, false);
+
+    // Lookups by symbol find the same definitions and members as lookups by name.
+    const Symbol enum_name{symbol_table::intern("LeaderHeadTypes")};
+    EXPECT_EQ(leaders.get_symbol(), enum_name);
+    EXPECT_EQ(&m_definition_table.get_definition(enum_name, Def_type::enum_type), &leaders);
+    EXPECT_EQ(m_definition_table.get_enumerator(enum_name, symbol_table::intern("NO_LEADERHEAD")).value, -1);
+    EXPECT_EQ(m_definition_table.get_enumerator(enum_name, -1).name, "NO_LEADERHEAD");
+    EXPECT_THROW(static_cast<void>(m_definition_table.get_enumerator(enum_name, symbol_table::intern("NO_PLAYER"))),
+        std::exception);
+    EXPECT_THROW(static_cast<void>(m_definition_table.get_type(symbol_table::intern("PlayerTypes"))), std::exception);
+
+    // A name which has never been interned names no definition.
+    EXPECT_THROW(
+        static_cast<void>(m_definition_table.get_type("Definition_table_test_never_interned")), std::exception);
+}
+
 } // namespace c4lib::schema_parser
@@ -4,11 +4,15 @@
 
 #include <array>
 #include <boost/property_tree/ptree.hpp>
+#include <cstddef>
 #include <gtest/gtest.h>
 #include <include/node-attributes.hpp>
 #include <include/node-type.hpp>
+#include <lib/expression-parser/expression.hpp>
 #include <lib/expression-parser/infix-representation.hpp>
 #include <lib/expression-parser/parser.hpp>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/ptree/ptree-node-emitter.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
 #include <lib/schema-parser/tokenizer.hpp>
 #include <lib/variable-manager/variable-manager.hpp>
@@ -115,7 +119,7 @@ public:
 protected:
     void SetUp() override
     {
-        m_variable_manager.init(&m_ptree, &m_ptree_parent, m_definition_table);
+        m_variable_manager.init(&m_emitter, &m_parent, m_definition_table);
 
         // Add variables i2 and j17.
         m_variable_manager.push();
@@ -141,7 +145,8 @@ protected:
 
     csp::Def_tbl* m_definition_table{nullptr};
     bpt::ptree m_ptree;
-    bpt::ptree* m_ptree_parent{&m_ptree};
+    cpt::Ptree_node_emitter m_emitter{m_ptree};
+    size_t m_parent{cpt::Node_emitter::root};
     Variable_manager m_variable_manager;
 };
 
@@ -166,4 +171,31 @@ TEST_F(Expression_parser_test, unit_test_constant_expressions)
     }
 }
 
+TEST_F(Expression_parser_test, unit_test_compile_once)
+{
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    bpt::ptree& value{m_ptree.put_child("r.cn1.cn2.[2]", bpt::ptree{})};
+    bpt::ptree& attributes{value.put_child(cpt::nn_attributes, bpt::ptree{})};
+    attributes.put<cpt::Node_type>(cpt::nn_type, cpt::Node_type::int_type);
+    attributes.put<std::string>(cpt::nn_data, std::string("5"));
+
+    csp::Tokenizer tokenizer;
+    tokenize_expression("r.cn1.cn2.[i2 + 1] * j17 + i2", tokenizer);
+    Parser parser;
+    Expression expression;
+    Infix_representation logger;
+    parser.compile(tokenizer, expression, &logger);
+    EXPECT_EQ(logger.pop(), "((r.cn1.cn2.[(i2 + 1)] * j17) + i2)");
+
+    // The compiled expression is evaluated against the current values of the variables and nodes it refers to.
+    EXPECT_EQ(parser.evaluate(expression, m_variable_manager), 53);
+    m_variable_manager.set("i2", 1);
+    EXPECT_EQ(parser.evaluate(expression, m_variable_manager), 86);
+    m_variable_manager.set("j17", 2);
+    EXPECT_EQ(parser.evaluate(expression, m_variable_manager), 11);
+    m_variable_manager.set("i2", 2);
+    EXPECT_EQ(parser.evaluate(expression, m_variable_manager), 8);
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+}
+
 } // namespace c4lib::expression_parser
@@ -0,0 +1,122 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <lib/importer/file-manager.hpp>
+#include <lib/native/path.hpp>
+#include <string>
+#include <test/util/constants.hpp>
+#include <vector>
+
+namespace ctc = c4lib::test::constants;
+
+namespace {
+const c4lib::native::Path file_manager_dir{ctc::out_common_dir / c4lib::native::Path{"file-manager"}};
+const c4lib::native::Path install_root{file_manager_dir / c4lib::native::Path{"install"}};
+const c4lib::native::Path custom_assets_path{file_manager_dir / c4lib::native::Path{"CustomAssets"}};
+const c4lib::native::Path mod_xml_dir{install_root / c4lib::native::Path{"Mods/Test/Assets/XML"}};
+const c4lib::native::Path modules_dir{install_root / c4lib::native::Path{"Mods/Test/Modules"}};
+const c4lib::native::Path xml_dir{install_root / c4lib::native::Path{"Assets/XML"}};
+} // namespace
+
+namespace c4lib {
+
+class File_manager_test : public testing::Test {
+public:
+    File_manager_test() = default;
+
+    ~File_manager_test() override = default;
+
+    File_manager_test(const File_manager_test&) = delete;
+
+    File_manager_test& operator=(const File_manager_test&) = delete;
+
+    File_manager_test(File_manager_test&&) noexcept = delete;
+
+    File_manager_test& operator=(File_manager_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        std::filesystem::remove_all(std::filesystem::path{file_manager_dir});
+        for (const auto& dir : {mod_xml_dir / native::Path{"Units"}, xml_dir / native::Path{"Units"},
+                 modules_dir / native::Path{"Lions/Units"}, modules_dir / native::Path{"Bears"}}) {
+            std::filesystem::create_directories(std::filesystem::path{dir});
+        }
+        create_file(xml_dir / native::Path{"GlobalDefines.xml"});
+        create_file(xml_dir / native::Path{"Units/CIV4UnitInfos.xml"});
+        create_file(mod_xml_dir / native::Path{"Units/CIV4UnitInfos.xml"});
+        create_file(modules_dir / native::Path{"Lions/Units/Lions_CIV4UnitInfos.xml"});
+        create_file(modules_dir / native::Path{"Bears/BEARS_civ4unitinfos.XML"});
+        create_file(modules_dir / native::Path{"Bears/Bears_CIV4BuildingInfos.xml"});
+    }
+
+    void TearDown() override {}
+
+    static void create_file(const native::Path& filename)
+    {
+        std::ofstream out{filename, std::ios_base::out | std::ios_base::trunc};
+    }
+};
+
+TEST_F(File_manager_test, unit_test_get_full_path)
+{
+    const File_manager file_manager{install_root, custom_assets_path, "Test", false};
+    native::Path full_path;
+
+    // The mod takes precedence over the installation and lookups ignore case.
+    file_manager.get_full_path(native::Path{"units/civ4unitinfos.xml"}, full_path);
+    EXPECT_TRUE(std::filesystem::equivalent(std::filesystem::path{full_path},
+        std::filesystem::path{mod_xml_dir / native::Path{"Units/CIV4UnitInfos.xml"}}));
+
+    file_manager.get_full_path(native::Path{"GlobalDefines.xml"}, full_path);
+    EXPECT_TRUE(std::filesystem::equivalent(
+        std::filesystem::path{full_path}, std::filesystem::path{xml_dir / native::Path{"GlobalDefines.xml"}}));
+
+    file_manager.get_full_path(native::Path{"GlobalDefinesAlt.xml"}, full_path);
+    EXPECT_TRUE(full_path.empty());
+
+    // Modules are not indexed unless modular loading is used.
+    std::vector<native::Path> full_paths;
+    file_manager.get_full_paths_modular(native::Path{"Units/CIV4UnitInfos.xml"}, full_paths);
+    EXPECT_TRUE(full_paths.empty());
+}
+
+TEST_F(File_manager_test, unit_test_probe_full_path)
+{
+    const File_manager file_manager{install_root, custom_assets_path, "Test", false};
+    native::Path full_path;
+
+    // Probing resolves paths as get_full_path does.
+    file_manager.probe_full_path(native::Path{"units/civ4unitinfos.xml"}, full_path);
+    EXPECT_TRUE(std::filesystem::equivalent(std::filesystem::path{full_path},
+        std::filesystem::path{mod_xml_dir / native::Path{"Units/CIV4UnitInfos.xml"}}));
+
+    file_manager.probe_full_path(native::Path{"globaldefines.XML"}, full_path);
+    EXPECT_TRUE(std::filesystem::equivalent(
+        std::filesystem::path{full_path}, std::filesystem::path{xml_dir / native::Path{"GlobalDefines.xml"}}));
+
+    file_manager.probe_full_path(native::Path{"Units"}, full_path);
+    EXPECT_TRUE(full_path.empty());
+
+    file_manager.probe_full_path(native::Path{"GlobalDefinesAlt.xml"}, full_path);
+    EXPECT_TRUE(full_path.empty());
+}
+
+TEST_F(File_manager_test, unit_test_get_full_paths_modular)
+{
+    const File_manager file_manager{install_root, custom_assets_path, "Test", true};
+    std::vector<native::Path> full_paths;
+    file_manager.get_full_paths_modular(native::Path{"Units/CIV4UnitInfos.xml"}, full_paths);
+    ASSERT_EQ(full_paths.size(), 2);
+    for (const auto& full_path : full_paths) {
+        EXPECT_TRUE(std::filesystem::is_regular_file(std::filesystem::path{full_path}));
+    }
+
+    EXPECT_THROW(File_manager(install_root, custom_assets_path, "Missing", true), std::filesystem::filesystem_error);
+}
+
+} // namespace c4lib
@@ -0,0 +1,74 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <lib/layout/header-layout.hpp>
+#include <lib/layout/layout.hpp>
+#include <lib/native/mapped-file.hpp>
+#include <lib/native/path.hpp>
+#include <stdexcept>
+#include <string>
+#include <test/util/constants.hpp>
+#include <vector>
+
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib::layout {
+
+class Header_layout_test : public testing::Test {
+public:
+    Header_layout_test() = default;
+
+    ~Header_layout_test() override = default;
+
+    Header_layout_test(const Header_layout_test&) = delete;
+
+    Header_layout_test& operator=(const Header_layout_test&) = delete;
+
+    Header_layout_test(Header_layout_test&&) noexcept = delete;
+
+    Header_layout_test& operator=(Header_layout_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    const native::Mapped_file m_save{
+        (ctc::data_saves_dir / native::Path{"Play_By_Email.CivBeyondSwordSave"}).str()};
+};
+
+TEST_F(Header_layout_test, unit_test_header_layout)
+{
+    Header_layout header_layout{m_save.bytes()};
+    EXPECT_EQ(header_layout.get_game_version(), 302);
+    std::streamoff compressed_data_offset{0};
+    ASSERT_NO_THROW(compressed_data_offset = header_layout.get_civ4_compressed_data_offset(true));
+    std::vector<std::string> lma_strings;
+    header_layout.get_lma_strings(lma_strings);
+    EXPECT_EQ(lma_strings.size(), num_lma_strings);
+
+    // The fields of CvInitCore are unavailable until it has been scanned.
+    EXPECT_THROW(static_cast<void>(header_layout.get_game_password_hash()), std::logic_error);
+    header_layout.scan_cv_init_core(bts_max_players, bts_num_game_option_types, bts_num_multiplayer_option_types);
+    std::vector<std::u16string> player_password_hashes;
+    header_layout.get_player_password_hashes(player_password_hashes);
+    ASSERT_EQ(player_password_hashes.size(), bts_max_players);
+    EXPECT_EQ(player_password_hashes[0], u"5f4dcc3b5aa765d61d8327deb882cf99");
+
+    // A layout may be created from a prefix of the save holding its header.
+    const Header_layout prefix_layout{m_save.bytes().first(static_cast<size_t>(compressed_data_offset)),
+        bts_max_players, bts_num_game_option_types, bts_num_multiplayer_option_types};
+    EXPECT_EQ(prefix_layout.get_checksum_dword(), header_layout.get_checksum_dword());
+
+    // Counts which do not match those of the save are detected.
+    EXPECT_ANY_THROW(Header_layout(
+        m_save.bytes(), bts_max_players, bts_num_game_option_types + 1, bts_num_multiplayer_option_types));
+
+    // A truncated GameHeader overruns the bytes scanned.
+    EXPECT_THROW(Header_layout{m_save.bytes().first(16)}, std::runtime_error);
+}
+
+} // namespace c4lib::layout
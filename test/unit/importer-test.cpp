@@ -2,12 +2,51 @@
 // This software is licensed under the MIT License.
 // Created by Hankinsohl on 10/11/2024.
 
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <include/exceptions.hpp>
 #include <lib/importer/importer.hpp>
 #include <lib/native/path.hpp>
+#include <lib/schema-parser/def-mem.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/definition.hpp>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <string>
+#include <test/util/constants.hpp>
 
 namespace csp = c4lib::schema_parser;
+namespace ctc = c4lib::test::constants;
+
+namespace {
+const c4lib::native::Path importer_dir{ctc::out_common_dir / c4lib::native::Path{"importer"}};
+const c4lib::native::Path importer_install_root{importer_dir / c4lib::native::Path{"install"}};
+const c4lib::native::Path importer_xml_dir{importer_install_root / c4lib::native::Path{"Assets/XML"}};
+const c4lib::native::Path importer_modules_dir{importer_install_root / c4lib::native::Path{"Mods/Test/Modules"}};
+
+void write_file(const c4lib::native::Path& filename, const std::string& text)
+{
+    std::ofstream out{filename, std::ios_base::out | std::ios_base::trunc};
+    out << text;
+}
+
+void write_defines(const c4lib::native::Path& filename, const std::string& defines)
+{
+    write_file(filename, "<Civ4Defines>" + defines + "</Civ4Defines>");
+}
+
+// Creates an empty installation holding the mod Test.
+void create_install()
+{
+    std::filesystem::remove_all(std::filesystem::path{importer_dir});
+    std::filesystem::create_directories(std::filesystem::path{importer_xml_dir / c4lib::native::Path{"Units"}});
+    std::filesystem::create_directories(std::filesystem::path{importer_modules_dir / c4lib::native::Path{"Extra"}});
+    write_defines(importer_xml_dir / c4lib::native::Path{"GlobalDefinesAlt.xml"}, "");
+    write_defines(importer_xml_dir / c4lib::native::Path{"GlobalDefines.xml"}, "");
+}
+} // namespace
 
 namespace c4lib {
 
@@ -54,4 +93,128 @@ TEST_F(Importer_test, unit_test_import)
         definitionTable, m_install_root, m_custom_assets_path, m_mod_name, m_use_modular_loading));
 }
 
+TEST_F(Importer_test, unit_test_import_consts)
+{
+    create_install();
+    write_defines(importer_xml_dir / native::Path{"GlobalDefinesAlt.xml"},
+        "<Define><DefineName>ALT</DefineName><iDefineIntVal>1</iDefineIntVal></Define>");
+    write_defines(importer_xml_dir / native::Path{"GlobalDefines.xml"},
+        "<Define><DefineName>ALT</DefineName><iDefineIntVal>2</iDefineIntVal></Define>"
+        "<Define><DefineName>RATIO</DefineName><fDefineFloatVal>0.5</fDefineFloatVal></Define>"
+        "<Define><DefineName>BASE</DefineName><iDefineIntVal>3</iDefineIntVal></Define>"
+        "<Define><DefineName>BASE</DefineName><iDefineIntVal>4</iDefineIntVal></Define>"
+        "<Define><DefineName>MODULAR</DefineName><iDefineIntVal>5</iDefineIntVal></Define>");
+    write_defines(importer_modules_dir / native::Path{"Extra/Extra_GlobalDefines.xml"},
+        "<Define><DefineName>MODULAR</DefineName><iDefineIntVal>6</iDefineIntVal></Define>");
+
+    csp::Def_tbl definition_table;
+    Importer importer;
+    importer.add_const(csp::Token{csp::Token_type::identifier, "ALT"});
+    importer.add_const(csp::Token{csp::Token_type::identifier, "BASE"});
+    importer.add_const(csp::Token{csp::Token_type::identifier, "MODULAR"});
+    ASSERT_NO_THROW(importer.import_definitions(
+        definition_table, importer_install_root, importer_dir / native::Path{"CustomAssets"}, "Test", true));
+
+    // GlobalDefinesAlt.xml takes precedence over GlobalDefines.xml, the first definition within a file is used and
+    // modular files override both.
+    EXPECT_EQ(definition_table.get_const_value("ALT"), 1);
+    EXPECT_EQ(definition_table.get_const_value("BASE"), 3);
+    EXPECT_EQ(definition_table.get_const_value("MODULAR"), 6);
+
+    csp::Def_tbl missing_definition_table;
+    importer.add_const(csp::Token{csp::Token_type::identifier, "MISSING"});
+    EXPECT_THROW(importer.import_definitions(missing_definition_table, importer_install_root,
+                     importer_dir / native::Path{"CustomAssets"}, "Test", true),
+        Importer_error);
+}
+
+TEST_F(Importer_test, unit_test_import_enums)
+{
+    create_install();
+    write_file(importer_xml_dir / native::Path{"Units/CIV4UnitInfos.xml"},
+        R"(<?xml version="1.0"?>
+<Civ4UnitInfos xmlns="x-schema:CIV4UnitSchema.xml">
+    <UnitClassInfos><UnitInfo><Type>UNIT_WRONG_PARENT</Type></UnitInfo></UnitClassInfos>
+    <UnitInfos>
+        <UnitInfo><Class>UNITCLASS_LION</Class><Type>UNIT_LION</Type></UnitInfo>
+        <!-- <UnitInfo><Type>UNIT_COMMENTED</Type></UnitInfo> -->
+        <UnitInfo><Type>UNIT_BEAR</Type><Type>UNIT_SECOND_TYPE</Type></UnitInfo>
+    </UnitInfos>
+    <UnitInfos><UnitInfo><Type>UNIT_SECOND_PARENT</Type></UnitInfo></UnitInfos>
+</Civ4UnitInfos>)");
+
+    // The importer refers to the enum name token, which must outlive the import.
+    const csp::Token enum_name{csp::Token_type::identifier, "UnitTypes"};
+    const csp::Token search_path{csp::Token_type::string_literal, "Units/CIV4UnitInfos.xml"};
+    csp::Def_tbl definition_table;
+    Importer importer;
+    importer.add_enum(
+        enum_name, csp::Token{csp::Token_type::string_literal, "Civ4UnitInfos/UnitInfos/UnitInfo"}, search_path);
+    ASSERT_NO_THROW(importer.import_definitions(
+        definition_table, importer_install_root, importer_dir / native::Path{"CustomAssets"}, "Test", false));
+
+    // Only the first element on the path is searched and only the first Type of each node is used.
+    EXPECT_EQ(definition_table.get_enumerator("UnitTypes", "UNIT_LION").value, 0);
+    EXPECT_EQ(definition_table.get_enumerator("UnitTypes", "UNIT_BEAR").value, 1);
+    EXPECT_EQ(definition_table.get_definition("UnitTypes", csp::Def_type::enum_type).get_members().size(), 2);
+
+    csp::Def_tbl bad_path_definition_table;
+    importer.reset();
+    importer.add_enum(
+        enum_name, csp::Token{csp::Token_type::string_literal, "Civ4UnitInfos/Missing/UnitInfo"}, search_path);
+    EXPECT_THROW(importer.import_definitions(bad_path_definition_table, importer_install_root,
+                     importer_dir / native::Path{"CustomAssets"}, "Test", false),
+        Importer_error);
+}
+
+TEST_F(Importer_test, unit_test_import_enums_concurrently)
+{
+    create_install();
+    write_file(importer_xml_dir / native::Path{"Units/CIV4UnitInfos.xml"},
+        "<Civ4UnitInfos><UnitInfos><UnitInfo><Type>UNIT_LION</Type></UnitInfo>"
+        "<UnitInfo><Type>UNIT_BEAR</Type></UnitInfo></UnitInfos></Civ4UnitInfos>");
+    write_file(importer_xml_dir / native::Path{"CIV4BuildingInfos.xml"},
+        "<Civ4BuildingInfos><BuildingInfos><BuildingInfo><Type>BUILDING_PALACE</Type></BuildingInfo>"
+        "</BuildingInfos></Civ4BuildingInfos>");
+    write_file(importer_modules_dir / native::Path{"Extra/Extra_CIV4UnitInfos.xml"},
+        "<Civ4UnitInfos><UnitInfos><UnitInfo><Type>UNIT_TIGER</Type></UnitInfo></UnitInfos></Civ4UnitInfos>");
+
+    // The importer refers to the enum name tokens, which must outlive the import.  Token indexes give schema order.
+    const csp::Token unit_types{csp::Token_type::identifier, "UnitTypes", Location{}, 1};
+    const csp::Token building_types{csp::Token_type::identifier, "BuildingTypes", Location{}, 2};
+    const csp::Token missing_types{csp::Token_type::identifier, "MissingTypes", Location{}, 3};
+    const csp::Token other_missing_types{csp::Token_type::identifier, "OtherMissingTypes", Location{}, 4};
+    csp::Def_tbl definition_table;
+    Importer importer;
+    importer.add_enum(other_missing_types, csp::Token{csp::Token_type::string_literal, "A/B"},
+        csp::Token{csp::Token_type::string_literal, "OtherMissing.xml"});
+    importer.add_enum(building_types,
+        csp::Token{csp::Token_type::string_literal, "Civ4BuildingInfos/BuildingInfos/BuildingInfo"},
+        csp::Token{csp::Token_type::string_literal, "CIV4BuildingInfos.xml"});
+    importer.add_enum(unit_types, csp::Token{csp::Token_type::string_literal, "Civ4UnitInfos/UnitInfos/UnitInfo"},
+        csp::Token{csp::Token_type::string_literal, "Units/CIV4UnitInfos.xml"});
+    importer.add_enum(missing_types, csp::Token{csp::Token_type::string_literal, "A/B"},
+        csp::Token{csp::Token_type::string_literal, "Missing.xml"});
+
+    // The error reported is that of the first enum in schema order which cannot be imported, and the enums
+    // preceding it are imported, even though the enums are scanned concurrently.
+    try {
+        importer.import_definitions(
+            definition_table, importer_install_root, importer_dir / native::Path{"CustomAssets"}, "Test", true, 4);
+        FAIL();
+    }
+    catch (const Importer_error& e) {
+        EXPECT_NE(std::string{e.what()}.find("'Missing.xml'"), std::string::npos) << e.what();
+    }
+    ASSERT_EQ(importer.get_search_paths().size(), 6);
+    EXPECT_EQ(std::string{importer.get_search_paths().at(2)}, "Units/CIV4UnitInfos.xml");
+    EXPECT_EQ(std::string{importer.get_search_paths().at(3)}, "CIV4BuildingInfos.xml");
+
+    // Modular files follow the file found using the search path.
+    EXPECT_EQ(definition_table.get_enumerator("UnitTypes", "UNIT_BEAR").value, 1);
+    EXPECT_EQ(definition_table.get_enumerator("UnitTypes", "UNIT_TIGER").value, 0);
+    EXPECT_EQ(definition_table.get_definition("UnitTypes", csp::Def_type::enum_type).get_members().size(), 3);
+    EXPECT_EQ(definition_table.get_enumerator("BuildingTypes", "BUILDING_PALACE").value, 0);
+}
+
 } // namespace c4lib
@@ -0,0 +1,65 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <gtest/gtest.h>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/util/file-location.hpp>
+#include <lib/util/location-table.hpp>
+#include <memory>
+#include <string>
+
+namespace c4lib {
+
+class Location_table_test : public testing::Test {
+public:
+    Location_table_test() = default;
+
+    ~Location_table_test() override = default;
+
+    Location_table_test(const Location_table_test&) = delete;
+
+    Location_table_test& operator=(const Location_table_test&) = delete;
+
+    Location_table_test(Location_table_test&&) noexcept = delete;
+
+    Location_table_test& operator=(Location_table_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(Location_table_test, unit_test_add)
+{
+    const auto filename{std::make_shared<const std::string>("location-table-test.schema")};
+    const auto text{std::make_shared<const std::string>("int32 Location_table_test;")};
+    const File_location loc{filename, text, 7, 3};
+
+    const Location location{location_table::add(loc)};
+    EXPECT_EQ(location.character_number, 3);
+    const File_location resolved{location_table::get(location)};
+    EXPECT_EQ(to_string(resolved), to_string(loc));
+    EXPECT_EQ(*resolved.line, *text);
+
+    // The same line is held once, whichever character is referred to and however its strings are allocated.
+    const File_location same_line{std::make_shared<const std::string>(*filename),
+        std::make_shared<const std::string>(*text), 7, 9};
+    const Location same_line_location{location_table::add(same_line)};
+    EXPECT_EQ(same_line_location.line, location.line);
+    EXPECT_EQ(same_line_location.character_number, 9);
+
+    const File_location next_line{filename, text, 8, 3};
+    EXPECT_NE(location_table::add(next_line).line, location.line);
+
+    // The default Location refers to the default File_location.
+    EXPECT_EQ(to_string(location_table::get(Location{})), to_string(File_location{}));
+    EXPECT_EQ(location_table::add(File_location{}).line, Location{}.line);
+
+    const schema_parser::Token token{schema_parser::Token_type::identifier, "Location_table_test", loc, 0};
+    EXPECT_EQ(to_string(token.get_loc()), to_string(loc));
+}
+
+} // namespace c4lib
@@ -0,0 +1,79 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <ios>
+#include <lib/io/io.hpp>
+#include <lib/native/mapped-file.hpp>
+#include <lib/native/path.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <test/util/constants.hpp>
+#include <test/util/macros.hpp>
+
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib::native {
+
+class Mapped_file_test : public testing::Test {
+public:
+    Mapped_file_test() = default;
+
+    ~Mapped_file_test() override = default;
+
+    Mapped_file_test(const Mapped_file_test&) = delete;
+
+    Mapped_file_test& operator=(const Mapped_file_test&) = delete;
+
+    Mapped_file_test(Mapped_file_test&&) noexcept = delete;
+
+    Mapped_file_test& operator=(Mapped_file_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(Mapped_file_test, unit_test_map_file)
+{
+    const Path savegame{ctc::data_saves_dir / Path{"Brennus BC-4000.CivBeyondSwordSave"}};
+    std::stringstream expected;
+    expected.unsetf(std::ios::skipws);
+    io::read_binary_file_to_stream(savegame, 0, 0, expected);
+    const std::string expected_bytes{expected.str()};
+
+    const Mapped_file file{savegame};
+#ifdef linux
+    EXPECT_TRUE(file.is_mapped());
+#endif
+    EXPECT_EQ(file.text(), expected_bytes);
+    EXPECT_TRUE(std::ranges::equal(file.bytes(), std::as_bytes(std::span{expected_bytes})));
+}
+
+TEST_F(Mapped_file_test, unit_test_map_empty_file)
+{
+    const Path empty{ctc::out_common_dir / Path{"mapped-file-test-empty.txt"}};
+    std::ofstream{empty, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc}.close();
+
+    const Mapped_file file{empty};
+    EXPECT_FALSE(file.is_mapped());
+    EXPECT_TRUE(file.bytes().empty());
+}
+
+TEST_F(Mapped_file_test, unit_test_missing_file)
+{
+    const Path missing{ctc::out_common_dir / Path{"mapped-file-test-missing.txt"}};
+    EXPECT_THROW_CONTAINS_MSG(static_cast<void>(Mapped_file{missing}), std::runtime_error,
+        std::format(fmt::runtime_error_opening_file, missing).c_str());
+}
+
+} // namespace c4lib::native
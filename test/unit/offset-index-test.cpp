@@ -0,0 +1,79 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <include/node-type.hpp>
+#include <include/offset-index.hpp>
+#include <lib/util/limits.hpp>
+#include <utility>
+
+namespace c4lib::property_tree {
+
+class Offset_index_test : public testing::Test {
+public:
+    Offset_index_test() = default;
+
+    ~Offset_index_test() override = default;
+
+    Offset_index_test(const Offset_index_test&) = delete;
+
+    Offset_index_test& operator=(const Offset_index_test&) = delete;
+
+    Offset_index_test(Offset_index_test&&) noexcept = delete;
+
+    Offset_index_test& operator=(Offset_index_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        // Leaves occupy [10, 14), [14, 15), [15, 23) and [30, 32).
+        m_index.add({"Savegame.A", 10, 4, Node_type::int_type});
+        m_index.add({"Savegame.B", 14, 1, Node_type::bool_type});
+        m_index.add({"Savegame.C", 15, 8, Node_type::string_type});
+        m_index.add({"Savegame.D.[0]", 30, 2, Node_type::uint_type});
+    }
+
+    void TearDown() override {}
+
+    Offset_index m_index;
+};
+
+TEST_F(Offset_index_test, unit_test_find)
+{
+    ASSERT_EQ(m_index.count(), 4);
+    EXPECT_EQ(m_index.find("Savegame.C"), 2);
+    EXPECT_EQ(m_index.at(m_index.find("Savegame.D.[0]")).offset, 30);
+    EXPECT_EQ(m_index.find("Savegame.E"), limits::invalid_size);
+
+    m_index.clear();
+    EXPECT_EQ(m_index.count(), 0);
+    EXPECT_EQ(m_index.find("Savegame.A"), limits::invalid_size);
+}
+
+TEST_F(Offset_index_test, unit_test_find_offset)
+{
+    EXPECT_EQ(m_index.find_offset(9), limits::invalid_size);
+    EXPECT_EQ(m_index.find_offset(10), 0);
+    EXPECT_EQ(m_index.find_offset(13), 0);
+    EXPECT_EQ(m_index.find_offset(14), 1);
+    EXPECT_EQ(m_index.find_offset(22), 2);
+    EXPECT_EQ(m_index.find_offset(23), limits::invalid_size);
+    EXPECT_EQ(m_index.find_offset(31), 3);
+    EXPECT_EQ(m_index.find_offset(32), limits::invalid_size);
+}
+
+TEST_F(Offset_index_test, unit_test_find_range)
+{
+    using Range = std::pair<size_t, size_t>;
+    EXPECT_EQ(m_index.find_range(0, 10), (Range{0, 0}));
+    EXPECT_EQ(m_index.find_range(0, 11), (Range{0, 1}));
+    EXPECT_EQ(m_index.find_range(13, 16), (Range{0, 3}));
+    EXPECT_EQ(m_index.find_range(23, 30), (Range{3, 3}));
+    EXPECT_EQ(m_index.find_range(20, 40), (Range{2, 4}));
+    EXPECT_EQ(m_index.find_range(32, 40), (Range{4, 4}));
+    EXPECT_EQ(m_index.find_range(12, 12).first, m_index.find_range(12, 12).second);
+}
+
+} // namespace c4lib::property_tree
@@ -0,0 +1,82 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cstddef>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <include/c4lib.hpp>
+#include <include/save-summary.hpp>
+#include <lib/native/path.hpp>
+#include <lib/util/constants.hpp>
+#include <string>
+#include <test/util/constants.hpp>
+#include <unordered_map>
+
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib {
+
+class Peek_save_test : public testing::Test {
+public:
+    Peek_save_test() = default;
+
+    ~Peek_save_test() override = default;
+
+    Peek_save_test(const Peek_save_test&) = delete;
+
+    Peek_save_test& operator=(const Peek_save_test&) = delete;
+
+    Peek_save_test(Peek_save_test&&) noexcept = delete;
+
+    Peek_save_test& operator=(Peek_save_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    std::unordered_map<std::string, std::string> m_options;
+};
+
+TEST_F(Peek_save_test, unit_test_peek_save)
+{
+    // The header of each save must end at its compressed data, which peek_save confirms.
+    for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{ctc::data_saves_dir}}) {
+        if (entry.path().extension() != constants::save_extension) {
+            continue;
+        }
+        Save_summary summary;
+        ASSERT_NO_THROW(peek_save(summary, entry.path().string(), m_options)) << entry.path();
+        EXPECT_EQ(summary.game_version, 302) << entry.path();
+        EXPECT_EQ(summary.players.size(), 19) << entry.path();
+    }
+
+    Save_summary summary;
+    const native::Path brennus{ctc::data_saves_dir / native::Path{"Brennus BC-4000-2.CivBeyondSwordSave"}};
+    ASSERT_NO_THROW(peek_save(summary, brennus.str(), m_options));
+    EXPECT_EQ(summary.required_mod, "");
+    EXPECT_EQ(summary.game_name, "Passenger's Game");
+    EXPECT_EQ(summary.map_script_name, "NC 335 Brennus Emperor.CivBeyondSwordWBSave");
+    EXPECT_EQ(summary.game_turn, 0);
+    EXPECT_EQ(summary.max_turns, 500);
+    const Save_player& human{summary.players[0]};
+    EXPECT_EQ(human.leader_name, "Brennus");
+    EXPECT_EQ(human.civ_description, "Celtic Empire");
+    EXPECT_EQ(human.civ_short_description, "Celtia");
+    EXPECT_EQ(human.civ_adjective, "Celtic");
+    EXPECT_EQ(human.slot_claim, 2);
+    EXPECT_TRUE(human.is_playable);
+    EXPECT_EQ(summary.players[3].leader_name, "Mao Zedong");
+    EXPECT_EQ(summary.players[3].team, 3);
+    EXPECT_FALSE(summary.players[3].is_playable);
+
+    const native::Path pbem{ctc::data_saves_dir / native::Path{"Play_By_Email.CivBeyondSwordSave"}};
+    ASSERT_NO_THROW(peek_save(summary, pbem.str(), m_options));
+    EXPECT_EQ(summary.game_name, "Play By Email Test");
+    EXPECT_EQ(summary.players[0].leader_name, "Hankinsohl");
+    EXPECT_EQ(summary.players[0].email, "dhank1ns@hotmail.com");
+    EXPECT_EQ(summary.players[0].password_hash, "5f4dcc3b5aa765d61d8327deb882cf99");
+}
+
+} // namespace c4lib
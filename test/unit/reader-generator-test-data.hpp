@@ -0,0 +1,209 @@
+// Reader generated from the test schema in reader-generator-test.cpp by c4gen.  Do not edit.
+// Program hash a252a09cf215699dde1b023ac2b1a3db.
+
+#include <cstddef>
+#include <include/symbol.hpp>
+#include <lib/schema-parser/generated-reader.hpp>
+#include <lib/util/limits.hpp>
+#include <string>
+#include <vector>
+
+namespace c4lib::schema_parser {
+
+namespace {
+using Parent_scope = Generated_reader_runtime::Parent_scope;
+
+// Generated code version 1.
+void routine_0(Generated_reader_runtime& rt);
+
+void read_save(Generated_reader_runtime& rt)
+{
+    {
+        // struct_Savegame Savegame
+        const size_t node{rt.add_node(0)};
+        static_cast<void>(rt.read_node(node));
+        const Parent_scope scope{rt, node};
+        routine_0(rt);
+    }
+}
+
+void routine_0(Generated_reader_runtime& rt)
+{
+    const size_t frame{rt.begin_frame()};
+    {
+        // int32 Count
+        const size_t node{rt.add_node(1)};
+        static_cast<void>(rt.read_node(node));
+    }
+    rt.assert_true(static_cast<int>(rt.get_node(0, 0, {}) < 8), 5);
+    {
+        // int8[:ColorTypes] Lengths
+        const size_t n0{rt.get_dimension(2, rt.get_node(1, 0, {}))};
+        const size_t a0{rt.add_array(2, n0)};
+        std::vector<size_t> leaves;
+        leaves.reserve(n0);
+        const Symbol e0{rt.get_enum_name(2, 0)};
+        for (size_t i0 = 0; i0 < n0; ++i0) {
+            leaves.push_back(rt.add_element(a0, 2, i0, limits::invalid_size, rt.format_subscript({}, i0, e0)));
+        }
+        for (const size_t node : leaves) {
+            static_cast<void>(rt.read_node(node));
+        }
+    }
+    {
+        // int8[][] Values
+        size_t captured{limits::invalid_size};
+        const size_t n0{rt.get_dimension(3, rt.get_node(2, 0, {}))};
+        const size_t a0{rt.add_array(3, n0)};
+        std::vector<size_t> leaves;
+        leaves.reserve(n0);
+        std::vector<size_t> a1(n0);
+        std::vector<size_t> n1(n0);
+        std::vector<std::string> s1(n0);
+        for (size_t i0 = 0; i0 < n0; ++i0) {
+            captured = i0;
+            s1[i0] = rt.format_subscript({}, i0, invalid_symbol);
+            n1[i0] = rt.get_captured_value(3, 1, captured);
+            a1[i0] = rt.add_array(a0, 3, i0, limits::invalid_size, n1[i0]);
+        }
+        for (size_t i0 = 0; i0 < n0; ++i0) {
+            captured = i0;
+            for (size_t i1 = 0; i1 < n1[i0]; ++i1) {
+                leaves.push_back(rt.add_element(a1[i0], 3, i1, i0, rt.format_subscript(s1[i0], i1, invalid_symbol)));
+            }
+        }
+        for (const size_t node : leaves) {
+            static_cast<void>(rt.read_node(node));
+        }
+    }
+    {
+        // int16[][:ColorTypes][] Cube
+        const size_t n0{rt.get_dimension(4, rt.get_node(3, 0, {}))};
+        const size_t a0{rt.add_array(4, n0)};
+        std::vector<size_t> leaves;
+        leaves.reserve(n0);
+        std::vector<size_t> a1(n0);
+        std::vector<size_t> n1(n0);
+        std::vector<std::string> s1(n0);
+        for (size_t i0 = 0; i0 < n0; ++i0) {
+            s1[i0] = rt.format_subscript({}, i0, invalid_symbol);
+            n1[i0] = 2;
+            a1[i0] = rt.add_array(a0, 4, i0, limits::invalid_size, n1[i0]);
+        }
+        for (size_t i0 = 0; i0 < n0; ++i0) {
+            const Symbol e1{rt.get_enum_name(4, 1)};
+            std::vector<size_t> a2(n1[i0]);
+            std::vector<size_t> n2(n1[i0]);
+            std::vector<std::string> s2(n1[i0]);
+            for (size_t i1 = 0; i1 < n1[i0]; ++i1) {
+                s2[i1] = rt.format_subscript(s1[i0], i1, e1);
+                n2[i1] = (rt.get_node(5, 0, {}) - 1);
+                a2[i1] = rt.add_array(a1[i0], 4, i1, i0, n2[i1]);
+            }
+            for (size_t i1 = 0; i1 < n1[i0]; ++i1) {
+                for (size_t i2 = 0; i2 < n2[i1]; ++i2) {
+                    leaves.push_back(rt.add_element(a2[i1], 4, i2, i1, rt.format_subscript(s2[i1], i2, invalid_symbol)));
+                }
+            }
+        }
+        for (const size_t node : leaves) {
+            static_cast<void>(rt.read_node(node));
+        }
+    }
+    rt.push_scope();
+    rt.add_local(0, 48, 0);
+pc_7:
+    if (static_cast<int>(rt.get_local(0) < rt.get_node(7, 0, {})) == 0) {
+        goto pc_24;
+    }
+    if (static_cast<int>(rt.get_local(0) == 0) == 0) {
+        goto pc_11;
+    }
+    {
+        // int8 First
+        const size_t node{rt.add_node(5)};
+        static_cast<void>(rt.read_node(node));
+    }
+    goto pc_15;
+pc_11:
+    if (Generated_reader_runtime::logical_and(static_cast<int>(rt.get_node(10, 0, {rt.get_local(0)}) > 4), static_cast<int>((-rt.get_local(0)) != (-2))) == 0) {
+        goto pc_14;
+    }
+    {
+        // int8[] Second
+        const size_t n0{rt.get_dimension(6, (rt.get_local(0) + 1))};
+        const size_t a0{rt.add_array(6, n0)};
+        std::vector<size_t> leaves;
+        leaves.reserve(n0);
+        for (size_t i0 = 0; i0 < n0; ++i0) {
+            leaves.push_back(rt.add_element(a0, 6, i0, limits::invalid_size, rt.format_subscript({}, i0, invalid_symbol)));
+        }
+        for (const size_t node : leaves) {
+            static_cast<void>(rt.read_node(node));
+        }
+    }
+    goto pc_15;
+pc_14:
+    {
+        // uint32 Third
+        const size_t node{rt.add_node(7)};
+        static_cast<void>(rt.read_node(node));
+    }
+pc_15:
+    rt.push_scope();
+    rt.add_local(1, 104, 0);
+pc_17:
+    if (static_cast<int>(rt.get_local(1) < rt.get_node(13, 0, {rt.get_local(0), 0})) == 0) {
+        goto pc_21;
+    }
+    {
+        // int8 Inner
+        const size_t node{rt.add_node(8)};
+        static_cast<void>(rt.read_node(node));
+    }
+    rt.set_local(1, (rt.get_local(1) + 1));
+    goto pc_17;
+pc_21:
+    rt.pop_scope();
+    rt.set_local(0, (rt.get_local(0) + 1));
+    goto pc_7;
+pc_24:
+    rt.pop_scope();
+    if (static_cast<int>(Generated_reader_runtime::logical_or((rt.get_node(15, 0, {}) % 2), Generated_reader_runtime::logical_and(static_cast<int>(((rt.get_node(15, 1, {}) / 2) * 2) <= rt.get_node(15, 2, {})), static_cast<int>(rt.get_node(15, 3, {}) != rt.get_enumerator(15, 0)))) == 0) == 0) {
+        goto pc_28;
+    }
+    {
+        // int8 Even
+        const size_t node{rt.add_node(9)};
+        static_cast<void>(rt.read_node(node));
+    }
+    goto pc_28;
+pc_28:
+    {
+        // int8[] Footer
+        const size_t n0{rt.get_dimension(10, rt.get_footer_bytes_count())};
+        const size_t a0{rt.add_array(10, n0)};
+        std::vector<size_t> leaves;
+        leaves.reserve(n0);
+        for (size_t i0 = 0; i0 < n0; ++i0) {
+            leaves.push_back(rt.add_element(a0, 10, i0, limits::invalid_size, rt.format_subscript({}, i0, invalid_symbol)));
+        }
+        for (const size_t node : leaves) {
+            static_cast<void>(rt.read_node(node));
+        }
+    }
+    rt.end_frame(frame);
+}
+
+const Generated_reader reader{"a252a09cf215699dde1b023ac2b1a3db", &read_save};
+
+// Registers the reader during static initialization.
+const struct Registration {
+    Registration()
+    {
+        register_generated_reader(reader);
+    }
+} registration;
+} // namespace
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,247 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <include/exceptions.hpp>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/save-document.hpp>
+#include <lib/native/path.hpp>
+#include <lib/ptree/document-node-emitter.hpp>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/ptree/node-reader.hpp>
+#include <lib/ptree/ptree-node-emitter.hpp>
+#include <lib/schema-parser/def-mem-type.hpp>
+#include <lib/schema-parser/def-mem.hpp>
+#include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/definition.hpp>
+#include <lib/schema-parser/generated-reader.hpp>
+#include <lib/schema-parser/parser-phase-two.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/reader-generator.hpp>
+#include <lib/schema-parser/schema-compiler.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/constants.hpp>
+#include <lib/util/file-location.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/variable-manager/variable-manager.hpp>
+#include <sstream>
+#include <string>
+#include <test/unit/reader-generator-test-data.hpp>
+#include <test/util/macros.hpp>
+#include <unordered_map>
+
+namespace c4lib::schema_parser {
+
+namespace bpt = boost::property_tree;
+namespace cpt = c4lib::property_tree;
+
+// Node reader which sets the data of the nth node read to first + n % 3.
+class Sequence_node_reader : public cpt::Node_reader {
+public:
+    explicit Sequence_node_reader(int first)
+        : m_first(first)
+    {}
+
+    size_t get_undocumented_footer_bytes_count() override
+    {
+        return 0;
+    }
+
+    void init(const native::Path&, Def_tbl*, std::unordered_map<std::string, std::string>&) override {}
+
+    void read_node(bpt::ptree& node) override
+    {
+        node.get_child(cpt::nn_attributes).put(cpt::nn_data, next_());
+    }
+
+    void read_node(cpt::Document_node& node, cpt::Leaf_data& data) override
+    {
+        const int value{next_()};
+        if (node.type >= cpt::Node_type::first_integer_type && node.type <= cpt::Node_type::last_integer_type) {
+            node.value = value;
+        }
+        else {
+            data.text = std::to_string(value);
+        }
+        node.flags |= cpt::Document_node::has_data;
+    }
+
+private:
+    int next_()
+    {
+        return m_first + m_count++ % 3;
+    }
+
+    int m_count{0};
+    int m_first{0};
+};
+
+class Reader_generator_test : public testing::Test {
+public:
+    Reader_generator_test() = default;
+
+    ~Reader_generator_test() override = default;
+
+    Reader_generator_test(const Reader_generator_test&) = delete;
+
+    Reader_generator_test& operator=(const Reader_generator_test&) = delete;
+
+    Reader_generator_test(Reader_generator_test&&) noexcept = delete;
+
+    Reader_generator_test& operator=(Reader_generator_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        m_definition_table.reset();
+        m_program.clear();
+        m_tokenizer.reset();
+    }
+
+    void TearDown() override {}
+
+    // Defines the const MAX_COUNT and the enum ColorTypes, which would otherwise be imported by phase one parsing,
+    // then tokenizes schema, which must define a single structure named Savegame, and compiles it.
+    void compile(const std::string& schema, int max_count)
+    {
+        bool was_created{false};
+        const File_location loc;
+        Definition& max{m_definition_table.create_definition("MAX_COUNT", Def_type::const_type, loc, was_created)};
+        Def_mem max_member{Def_mem_type::const_type, "MAX_COUNT", max_count, loc};
+        max.add_member(max_member, false, false);
+        Definition& colors{m_definition_table.create_definition("ColorTypes", Def_type::enum_type, loc, was_created)};
+        for (const auto& [name, value] : {std::pair{"NO_COLOR", -1}, std::pair{"COLOR_RED", 0},
+                 std::pair{"COLOR_GREEN", 1}, std::pair{"COLOR_BLUE", 2}, std::pair{"COLOR_WHITE", 3},
+                 std::pair{"COLOR_BLACK", 4}}) {
+            Def_mem color{Def_mem_type::enum_type, name, value, loc};
+            colors.add_member(color, false, false);
+        }
+
+        std::stringstream str;
+        str << schema;
+        m_tokenizer.run(str);
+        constexpr size_t root_name_index{1};
+        const Token& root_name{m_tokenizer.at(root_name_index)};
+        Definition& definition{m_definition_table.create_definition(
+            root_name.value, Def_type::struct_type, root_name.get_loc(), was_created)};
+        Def_mem member{Def_mem_type::struct_type, constants::index_member, gsl::narrow<int>(root_name_index + 1),
+            root_name.get_loc()};
+        definition.add_member(member, false, false);
+
+        Schema_compiler compiler(m_tokenizer, m_definition_table);
+        compiler.compile(root_name_index, m_program);
+    }
+
+    // Reads a save whose nth node read is first + n % 3, passing the nodes to emitter.  The save is read by reader
+    // or, if reader is nullptr, by interpreting the program.
+    void parse(cpt::Node_emitter& emitter, int first, const Generated_reader* reader)
+    {
+        Variable_manager variable_manager;
+        Sequence_node_reader node_reader{first};
+        std::unordered_map<std::string, std::string> options;
+        Parser_phase_two parser(
+            m_tokenizer, m_definition_table, m_program, variable_manager, emitter, node_reader, options);
+        if (reader != nullptr) {
+            parser.parse(*reader);
+        }
+        else {
+            parser.parse();
+        }
+    }
+
+    // As above, storing the nodes in pt.
+    void parse(bpt::ptree& pt, int first, const Generated_reader* reader)
+    {
+        cpt::Ptree_node_emitter emitter{pt};
+        parse(emitter, first, reader);
+    }
+
+    Def_tbl m_definition_table;
+    Program m_program;
+    Tokenizer m_tokenizer;
+};
+
+// The schema from which test/unit/reader-generator-test-data.hpp was generated.  If the schema or the generated code
+// changes, regenerate the test data by writing the output of Reader_generator::write for the schema compiled with a
+// MAX_COUNT of 8.
+constexpr const char* test_schema{R"(struct Savegame {
+    int32 Count
+    assert(Count < MAX_COUNT)
+    int8[Count:ColorTypes] Lengths
+    int8[Count:capture_index][Lengths[use_capture]] Values
+    int16[Count][2:ColorTypes][Count - 1] Cube
+    for (i = 0; i < Count; i = i + 1) {
+        if (i == 0) { int8 First }
+        elif (Lengths.[i] > 4 && -i != -2) { int8[i + 1] Second }
+        else { uint32 Third }
+        for (j = 0; j < Values.[i].[0]; j = j + 1) { int8 Inner }
+    }
+    if (!(Count % 2) || Count / 2 * 2 <= Count && Count != ColorTypes::NO_COLOR) { int8 Even }
+    int8[query_reader] Footer
+})"};
+
+TEST_F(Reader_generator_test, unit_test_generated_reader)
+{
+    ASSERT_NO_THROW(compile(test_schema, 8));
+    const Reader_generator generator{m_program};
+    const Generated_reader* reader{find_generated_reader(generator.get_hash())};
+    ASSERT_NE(reader, nullptr) << "Regenerate test/unit/reader-generator-test-data.hpp";
+
+    // The generated reader must emit the nodes emitted by interpreting the program.
+    constexpr int first{3};
+    bpt::ptree interpreted;
+    ASSERT_NO_THROW(parse(interpreted, first, nullptr));
+    bpt::ptree generated;
+    ASSERT_NO_THROW(parse(generated, first, reader));
+    EXPECT_EQ(generated, interpreted);
+    EXPECT_EQ(generated.get<std::string>("Savegame.Lengths.[2].__Attributes__.__Subscripts__"), "[2:COLOR_BLUE]");
+    EXPECT_EQ(generated.get_child("Savegame").count("Inner"), 16);
+
+    cpt::Save_document document;
+    cpt::Document_node_emitter emitter{document};
+    ASSERT_NO_THROW(parse(emitter, first, reader));
+    emitter.finish();
+    bpt::ptree converted;
+    document.to_ptree(converted);
+    EXPECT_EQ(converted, interpreted);
+}
+
+TEST_F(Reader_generator_test, unit_test_generated_reader_error)
+{
+    ASSERT_NO_THROW(compile(test_schema, 8));
+    const Generated_reader* reader{find_generated_reader(Reader_generator{m_program}.get_hash())};
+    ASSERT_NE(reader, nullptr);
+
+    // Errors are reported as they are when the program is interpreted.
+    bpt::ptree pt;
+    EXPECT_THROW_CONTAINS_MSG(parse(pt, 8, reader), Parser_error, "Assertion failed");
+    EXPECT_THROW_CONTAINS_MSG(parse(pt, -2, reader), std::exception, "");
+}
+
+TEST_F(Reader_generator_test, unit_test_hash)
+{
+    ASSERT_NO_THROW(compile(test_schema, 8));
+    const Reader_generator generator{m_program};
+    const Reader_generator again{m_program};
+    EXPECT_EQ(generator.get_hash(), again.get_hash());
+
+    std::stringstream source;
+    generator.write(source, "test");
+    EXPECT_NE(source.str().find(generator.get_hash()), std::string::npos);
+    EXPECT_NE(source.str().find("register_generated_reader"), std::string::npos);
+
+    // A different value for an imported const yields a different program and hence no generated reader.
+    SetUp();
+    ASSERT_NO_THROW(compile(test_schema, 9));
+    const Reader_generator other{m_program};
+    EXPECT_NE(other.get_hash(), generator.get_hash());
+    EXPECT_EQ(find_generated_reader(other.get_hash()), nullptr);
+}
+
+} // namespace c4lib::schema_parser
@@ -0,0 +1,239 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <array>
+#include <boost/property_tree/ptree.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <include/c4lib.hpp>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/save-document.hpp>
+#include <lib/c4lib/c4lib-internal.hpp>
+#include <lib/native/path.hpp>
+#include <lib/ptree/debug.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/options.hpp>
+#include <sstream>
+#include <string>
+#include <test/util/constants.hpp>
+#include <test/util/util.hpp>
+#include <unordered_map>
+
+namespace bpt = boost::property_tree;
+namespace ctc = c4lib::test::constants;
+
+namespace c4lib::property_tree {
+
+class Save_document_test : public testing::Test {
+public:
+    Save_document_test() = default;
+
+    ~Save_document_test() override = default;
+
+    Save_document_test(const Save_document_test&) = delete;
+
+    Save_document_test& operator=(const Save_document_test&) = delete;
+
+    Save_document_test(Save_document_test&&) noexcept = delete;
+
+    Save_document_test& operator=(Save_document_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        m_options[options::schema] = ctc::relative_root_path / native::Path{R"(\doc\BTS.schema)"};
+        m_options[options::bts_install_dir]
+            = R"(C:\Program Files (x86)\GOG Galaxy\Games\Civilization IV Complete\Civ4\Beyond the Sword)";
+        m_options[options::custom_assets_dir]
+            = R"(C:\Users\Passenger\Documents\My Games\beyond the sword\CustomAssets)";
+        m_options[options::debug_output_dir] = ctc::out_common_dir;
+    }
+
+    void TearDown() override {}
+
+    // Adds a node to parent with attributes in the order used by the node source and binary node reader.
+    static bpt::ptree& add_node(bpt::ptree& parent,
+        const std::string& name,
+        Node_type type,
+        const std::string& type_name,
+        const std::string& size = "",
+        const std::string& data = "",
+        const std::string& formatted_data = "",
+        const std::string& array_name = "",
+        const std::string& subscripts = "",
+        const std::string& enum_name = "")
+    {
+        bpt::ptree& node{parent.add_child(name, bpt::ptree{})};
+        bpt::ptree& attributes{node.put_child(nn_attributes, bpt::ptree{nv_meta})};
+        attributes.add(nn_name, name);
+        if (!array_name.empty()) {
+            attributes.add(nn_array_name, array_name);
+        }
+        attributes.add(nn_type, to_string(type));
+        attributes.add(nn_typename, type_name);
+        if (!subscripts.empty()) {
+            attributes.add(nn_subscripts, subscripts);
+        }
+        if (!enum_name.empty()) {
+            attributes.add(nn_enum, enum_name);
+        }
+        if (!size.empty()) {
+            attributes.add(nn_size, size);
+            attributes.add(nn_data, data);
+            attributes.add(nn_formatted_data, formatted_data);
+        }
+        return node;
+    }
+
+    // Returns a property tree containing a node of each type.
+    static bpt::ptree make_ptree()
+    {
+        bpt::ptree pt;
+        bpt::ptree& origin{pt.put_child(nn_origin, bpt::ptree{nv_meta})};
+        origin.add(nn_savegame, "test.CivBeyondSwordSave");
+        origin.add(nn_schema, "BTS.schema");
+        origin.add(nn_date, "10-16-2026 12:00:00 UTC");
+        origin.add(nn_c4lib_version, "01.00.00");
+
+        bpt::ptree& savegame{add_node(pt, "Savegame", Node_type::struct_type, "struct_Savegame")};
+        add_node(savegame, "GameVersion", Node_type::uint_type, "uint32", "4", "302", "302");
+        add_node(savegame, "IsHuman", Node_type::bool_type, "bool8", "1", "1", "True");
+        add_node(savegame, "Mask", Node_type::hex_type, "hex16", "2", "255", "0x00ff");
+        add_node(savegame, "Era", Node_type::enum_type, "enum32_EraTypes", "4", "1", "ERA_CLASSICAL", "", "",
+            "EraTypes");
+        add_node(savegame, "Name", Node_type::string_type, "string_type", "", "", "");
+        savegame.get_child("Name").get_child(nn_attributes).add(nn_data, "Brennus");
+        savegame.get_child("Name").get_child(nn_attributes).add(nn_formatted_data, "\"Brennus\"");
+
+        bpt::ptree& values{add_node(savegame, "Values", Node_type::array_type, "int8", "", "", "", "Values", "[2]")};
+        add_node(values, "[0]", Node_type::int_type, "int8", "1", "-5", "-5", "Values", "[0]");
+        add_node(values, "[1]", Node_type::int_type, "int8", "1", "7", "7", "Values", "[1]");
+        return pt;
+    }
+
+    // Dumps pt, less its origin node which contains the time at which the save was read.
+    static std::string dump(bpt::ptree& pt)
+    {
+        pt.erase(nn_origin);
+        std::stringstream ss;
+        dump_ptree(ss, pt);
+        return ss.str();
+    }
+
+    std::unordered_map<std::string, std::string> m_options;
+};
+
+TEST_F(Save_document_test, unit_test_round_trip)
+{
+    const bpt::ptree expected{make_ptree()};
+    Save_document document;
+    ASSERT_NO_THROW(document.from_ptree(expected));
+
+    // Root, Savegame, 6 members of Savegame and 2 array elements.
+    EXPECT_EQ(document.count(), 10);
+    EXPECT_TRUE(document.has_origin());
+    EXPECT_EQ(document.get_origin().savegame, "test.CivBeyondSwordSave");
+
+    bpt::ptree actual;
+    document.to_ptree(actual);
+    EXPECT_TRUE(actual == expected);
+}
+
+TEST_F(Save_document_test, unit_test_typed_data)
+{
+    Save_document document;
+    document.from_ptree(make_ptree());
+
+    EXPECT_EQ(document.find("Savegame.Missing"), limits::invalid_size);
+    EXPECT_EQ(document.find("Missing"), limits::invalid_size);
+
+    const size_t version_index{document.find("Savegame.GameVersion")};
+    ASSERT_NE(version_index, limits::invalid_size);
+    EXPECT_EQ(document.at(version_index).type, Node_type::uint_type);
+    EXPECT_EQ(document.at(version_index).value, 302);
+    EXPECT_EQ(document.at(version_index).size, 4);
+
+    const size_t mask_index{document.find("Savegame.Mask")};
+    ASSERT_NE(mask_index, limits::invalid_size);
+    EXPECT_EQ(document.get_formatted_data(mask_index), "0x00ff");
+
+    const size_t name_index{document.find("Savegame.Name")};
+    ASSERT_NE(name_index, limits::invalid_size);
+    EXPECT_EQ(document.get_text(name_index), "Brennus");
+
+    // Array elements are contiguous and share symbols.
+    const size_t values_index{document.find("Savegame.Values")};
+    ASSERT_NE(values_index, limits::invalid_size);
+    const Document_node& values{document.at(values_index)};
+    ASSERT_EQ(values.child_count, 2);
+    const Document_node& first{document.at(values.first_child)};
+    const Document_node& second{document.at(values.first_child + 1)};
+    EXPECT_EQ(first.value, -5);
+    EXPECT_EQ(second.value, 7);
+    EXPECT_EQ(first.type_name, second.type_name);
+    EXPECT_EQ(first.array_name, values.array_name);
+    EXPECT_EQ(document.get_subscripts(values.first_child + 1), "[1]");
+}
+
+TEST_F(Save_document_test, unit_test_write_composite)
+{
+    const bpt::ptree pt{make_ptree()};
+    Save_document document;
+    document.from_ptree(pt);
+
+    std::stringstream expected;
+    EXPECT_NO_THROW(write_composite(pt, expected, m_options));
+    std::stringstream actual;
+    EXPECT_NO_THROW(write_composite(document, actual, m_options));
+    EXPECT_EQ(actual.str(), expected.str());
+}
+
+TEST_F(Save_document_test, unit_test_write_translation)
+{
+    const bpt::ptree pt{make_ptree()};
+    Save_document document;
+    document.from_ptree(pt);
+
+    // The document is written node by node rather than by way of a property tree.
+    const native::Path expected_filename{ctc::out_common_dir / native::Path{"save-document-ptree.txt"}};
+    const native::Path actual_filename{ctc::out_common_dir / native::Path{"save-document-document.txt"}};
+    EXPECT_NO_THROW(write_translation(pt, expected_filename, m_options));
+    EXPECT_NO_THROW(write_translation(document, actual_filename, m_options));
+    std::stringstream errors;
+    EXPECT_FALSE(test::compare_text_files(expected_filename, actual_filename, 0, errors)) << errors.str();
+}
+
+// Reads each save as both a property tree and a document and checks that the document converts to the same property
+// tree and writes the same save.
+TEST_F(Save_document_test, integration_test_read_and_write_saves)
+{
+    const std::array<std::string, 3> save_names{
+        "Brennus BC-4000", "Mao Zedong_1936-AD_Feb-26-2023_07-31-57", "Tiny-Map-BC-4000"};
+
+    for (const auto& save_name : save_names) {
+        const native::Path filename{ctc::data_saves_dir / native::Path{save_name + ".CivBeyondSwordSave"}};
+
+        bpt::ptree pt;
+        EXPECT_NO_THROW(read_save(pt, filename, m_options)) << save_name;
+        Save_document document;
+        EXPECT_NO_THROW(read_save(document, filename, m_options)) << save_name;
+
+        bpt::ptree converted;
+        document.to_ptree(converted);
+        EXPECT_EQ(dump(converted), dump(pt)) << save_name;
+
+        const native::Path expected_filename{
+            ctc::out_common_dir / native::Path{save_name + "-ptree.CivBeyondSwordSave"}};
+        const native::Path actual_filename{
+            ctc::out_common_dir / native::Path{save_name + "-document.CivBeyondSwordSave"}};
+        EXPECT_NO_THROW(write_save(pt, expected_filename, m_options)) << save_name;
+        EXPECT_NO_THROW(write_save(document, actual_filename, m_options)) << save_name;
+        std::stringstream errors;
+        EXPECT_FALSE(test::compare_binary_files(expected_filename, actual_filename, errors)) << save_name
+                                                                                            << errors.str();
+    }
+}
+
+} // namespace c4lib::property_tree
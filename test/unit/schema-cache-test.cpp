@@ -0,0 +1,230 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <ios>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/native/path.hpp>
+#include <lib/schema-parser/def-mem-type.hpp>
+#include <lib/schema-parser/def-mem.hpp>
+#include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/definition.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/schema-cache.hpp>
+#include <lib/schema-parser/schema-compiler.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/constants.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <string>
+#include <test/util/constants.hpp>
+#include <vector>
+
+namespace ctc = c4lib::test::constants;
+namespace esp = c4lib::expression_parser;
+
+namespace {
+const c4lib::native::Path cache_dir{ctc::out_common_dir / c4lib::native::Path{"schema-cache"}};
+const c4lib::native::Path assets_dir{cache_dir / c4lib::native::Path{"assets"}};
+const c4lib::native::Path schema_filename{cache_dir / c4lib::native::Path{"schema-cache-test.schema"}};
+const c4lib::native::Path xml_search_path{"Test.xml"};
+
+const char* const schema_text{R"(struct Savegame {
+    int32 Count
+    for (i = 0; i < Count; i = i + 1) {
+        int8[Count:capture_index] Data
+    }
+})"};
+} // namespace
+
+namespace c4lib::schema_parser {
+
+class Schema_cache_test : public testing::Test {
+public:
+    Schema_cache_test() = default;
+
+    ~Schema_cache_test() override = default;
+
+    Schema_cache_test(const Schema_cache_test&) = delete;
+
+    Schema_cache_test& operator=(const Schema_cache_test&) = delete;
+
+    Schema_cache_test(Schema_cache_test&&) noexcept = delete;
+
+    Schema_cache_test& operator=(Schema_cache_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        std::filesystem::remove_all(std::filesystem::path{cache_dir});
+        std::filesystem::create_directories(std::filesystem::path{assets_dir / native::Path{"XML"}});
+        write_file(schema_filename, schema_text);
+        write_file(assets_dir / native::Path{"XML"} / xml_search_path, "<Test/>");
+    }
+
+    void TearDown() override {}
+
+    static void write_file(const native::Path& filename, const std::string& text)
+    {
+        std::ofstream out{filename, std::ios_base::out | std::ios_base::trunc};
+        out << text;
+    }
+
+    [[nodiscard]] static Schema_cache make_cache()
+    {
+        return Schema_cache{cache_dir, schema_filename, native::Path{"no-install-root"}, assets_dir, "", false};
+    }
+
+    // Tokenizes and compiles the schema, bypassing phase one parsing, and saves the result to the cache.
+    void compile_and_save()
+    {
+        m_tokenizer.run(schema_filename);
+
+        // The schema begins "struct Savegame {"; the root name is at index 1 and the definition at index 2.
+        constexpr size_t root_name_index{1};
+        const Token& root_name{m_tokenizer.at(root_name_index)};
+        bool was_created{false};
+        Definition& definition{m_definition_table.create_definition(
+            root_name.value, Def_type::struct_type, root_name.get_loc(), was_created)};
+        Def_mem member{Def_mem_type::struct_type, constants::index_member, gsl::narrow<int>(root_name_index + 1),
+            root_name.get_loc()};
+        definition.add_member(member, false, false);
+
+        Schema_compiler compiler(m_tokenizer, m_definition_table);
+        compiler.compile(root_name_index, m_program);
+
+        make_cache().save(m_tokenizer, m_definition_table, m_program, root_name_index, {xml_search_path});
+    }
+
+    bool load()
+    {
+        return make_cache().load(m_loaded_tokenizer, m_loaded_definition_table, m_loaded_program, m_root_name_index);
+    }
+
+    Def_tbl m_definition_table;
+    Def_tbl m_loaded_definition_table;
+    Program m_loaded_program;
+    Tokenizer m_loaded_tokenizer;
+    Program m_program;
+    size_t m_root_name_index{limits::invalid_size};
+    Tokenizer m_tokenizer;
+};
+
+TEST_F(Schema_cache_test, unit_test_round_trip)
+{
+    EXPECT_FALSE(load());
+    EXPECT_NO_THROW(compile_and_save());
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path{make_cache().get_path()}));
+    ASSERT_TRUE(load());
+
+    EXPECT_EQ(m_root_name_index, 1);
+    ASSERT_EQ(m_loaded_tokenizer.count(), m_tokenizer.count());
+    for (size_t i = 0; i < m_tokenizer.count(); ++i) {
+        const Token& expected{m_tokenizer.at(i)};
+        const Token& actual{m_loaded_tokenizer.at(i)};
+        EXPECT_EQ(actual.index, expected.index);
+        EXPECT_EQ(actual.type, expected.type);
+        EXPECT_EQ(actual.value, expected.value);
+        EXPECT_EQ(*actual.get_loc().filename, *expected.get_loc().filename);
+        EXPECT_EQ(*actual.get_loc().line, *expected.get_loc().line);
+        EXPECT_EQ(actual.get_loc().line_number, expected.get_loc().line_number);
+        EXPECT_EQ(actual.get_loc().character_number, expected.get_loc().character_number);
+    }
+
+    const Def_mem& member{m_loaded_definition_table.get_first_member("Savegame", Def_type::struct_type)};
+    EXPECT_EQ(member.name, constants::index_member);
+    EXPECT_EQ(member.value, 2);
+
+    ASSERT_EQ(m_loaded_program.instructions.size(), m_program.instructions.size());
+    for (size_t i = 0; i < m_program.instructions.size(); ++i) {
+        EXPECT_EQ(m_loaded_program.instructions.at(i).opcode, m_program.instructions.at(i).opcode);
+        EXPECT_EQ(m_loaded_program.instructions.at(i).operand, m_program.instructions.at(i).operand);
+        EXPECT_EQ(m_loaded_program.instructions.at(i).expression, m_program.instructions.at(i).expression);
+    }
+    EXPECT_EQ(m_loaded_program.routines, m_program.routines);
+    EXPECT_EQ(m_loaded_program.root_statement, m_program.root_statement);
+    ASSERT_EQ(m_loaded_program.statements.size(), m_program.statements.size());
+    for (size_t i = 0; i < m_program.statements.size(); ++i) {
+        const Definition_statement& expected{m_program.statements.at(i)};
+        const Definition_statement& actual{m_loaded_program.statements.at(i)};
+        EXPECT_EQ(actual.identifier.value, expected.identifier.value);
+        EXPECT_EQ(actual.routine, expected.routine);
+        EXPECT_EQ(actual.array_suffixes.size(), expected.array_suffixes.size());
+    }
+
+    // Symbols are stored as strings and interned again on load, so the loaded symbols must match the originals.
+    ASSERT_EQ(m_loaded_program.expressions.size(), m_program.expressions.size());
+    for (size_t i = 0; i < m_program.expressions.size(); ++i) {
+        const esp::Expression& expected{m_program.expressions.at(i)};
+        const esp::Expression& actual{m_loaded_program.expressions.at(i)};
+        ASSERT_EQ(actual.operations.size(), expected.operations.size());
+        for (size_t j = 0; j < expected.operations.size(); ++j) {
+            EXPECT_EQ(actual.operations.at(j).kind, expected.operations.at(j).kind);
+            EXPECT_EQ(actual.operations.at(j).operator_type, expected.operations.at(j).operator_type);
+            EXPECT_EQ(actual.operations.at(j).value, expected.operations.at(j).value);
+            EXPECT_EQ(actual.operations.at(j).symbol, expected.operations.at(j).symbol);
+            EXPECT_EQ(actual.operations.at(j).reference, expected.operations.at(j).reference);
+        }
+        EXPECT_EQ(actual.node_references.size(), expected.node_references.size());
+        EXPECT_EQ(actual.enumerator_references.size(), expected.enumerator_references.size());
+    }
+}
+
+TEST_F(Schema_cache_test, unit_test_stale_schema)
+{
+    EXPECT_NO_THROW(compile_and_save());
+    write_file(schema_filename, std::string{schema_text} + "\n");
+    EXPECT_FALSE(load());
+    EXPECT_EQ(m_loaded_tokenizer.count(), 0);
+    EXPECT_EQ(m_root_name_index, limits::invalid_size);
+}
+
+TEST_F(Schema_cache_test, unit_test_stale_xml)
+{
+    EXPECT_NO_THROW(compile_and_save());
+    write_file(assets_dir / native::Path{"XML"} / xml_search_path, "<Test></Test>");
+    EXPECT_FALSE(load());
+}
+
+TEST_F(Schema_cache_test, unit_test_corrupt_cache)
+{
+    EXPECT_NO_THROW(compile_and_save());
+    const std::filesystem::path path{make_cache().get_path()};
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    EXPECT_FALSE(load());
+    EXPECT_EQ(m_loaded_program.instructions.size(), 0);
+}
+
+TEST_F(Schema_cache_test, unit_test_damaged_body)
+{
+    EXPECT_NO_THROW(compile_and_save());
+
+    // Alter the last byte of the body without changing the size of the entry.
+    const std::filesystem::path path{make_cache().get_path()};
+    std::fstream file{path, std::ios_base::in | std::ios_base::out | std::ios_base::binary};
+    file.seekg(-1, std::ios_base::end);
+    const auto last{static_cast<char>(file.get())};
+    file.seekp(-1, std::ios_base::end);
+    file.put(static_cast<char>(last ^ 1));
+    file.close();
+
+    EXPECT_FALSE(load());
+    EXPECT_EQ(m_loaded_program.instructions.size(), 0);
+}
+
+TEST_F(Schema_cache_test, unit_test_no_temporary_files)
+{
+    EXPECT_NO_THROW(compile_and_save());
+    EXPECT_NO_THROW(compile_and_save());
+    for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{cache_dir}}) {
+        EXPECT_NE(entry.path().extension(), ".tmp");
+    }
+}
+
+} // namespace c4lib::schema_parser
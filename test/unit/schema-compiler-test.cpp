@@ -0,0 +1,340 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <algorithm>
+#include <boost/property_tree/ptree.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <include/exceptions.hpp>
+#include <include/node-attributes.hpp>
+#include <include/node-type.hpp>
+#include <include/save-document.hpp>
+#include <lib/expression-parser/expression.hpp>
+#include <lib/native/path.hpp>
+#include <lib/ptree/document-node-emitter.hpp>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/ptree/node-reader.hpp>
+#include <lib/ptree/ptree-node-emitter.hpp>
+#include <lib/schema-parser/def-mem-type.hpp>
+#include <lib/schema-parser/def-mem.hpp>
+#include <lib/schema-parser/def-tbl.hpp>
+#include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/definition.hpp>
+#include <lib/schema-parser/opcode.hpp>
+#include <lib/schema-parser/parser-phase-two.hpp>
+#include <lib/schema-parser/program.hpp>
+#include <lib/schema-parser/schema-compiler.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/schema-parser/tokenizer.hpp>
+#include <lib/util/constants.hpp>
+#include <lib/util/exception-formats.hpp>
+#include <lib/util/file-location.hpp>
+#include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <lib/variable-manager/variable-manager.hpp>
+#include <sstream>
+#include <string>
+#include <test/util/macros.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace c4lib::schema_parser {
+
+namespace bpt = boost::property_tree;
+namespace cpt = c4lib::property_tree;
+namespace esp = c4lib::expression_parser;
+
+// Node reader which sets the data of each leaf to 1.
+class One_node_reader : public cpt::Node_reader {
+public:
+    size_t get_undocumented_footer_bytes_count() override
+    {
+        return 0;
+    }
+
+    void init(const native::Path&, Def_tbl*, std::unordered_map<std::string, std::string>&) override {}
+
+    void read_node(bpt::ptree& node) override
+    {
+        node.get_child(cpt::nn_attributes).put(cpt::nn_data, 1);
+    }
+
+    void read_node(cpt::Document_node& node, cpt::Leaf_data& data) override
+    {
+        if (node.type >= cpt::Node_type::first_integer_type && node.type <= cpt::Node_type::last_integer_type) {
+            node.value = 1;
+        }
+        else {
+            data.text = "1";
+        }
+        node.flags |= cpt::Document_node::has_data;
+    }
+};
+
+class Schema_compiler_test : public testing::Test {
+public:
+    Schema_compiler_test() = default;
+
+    ~Schema_compiler_test() override = default;
+
+    Schema_compiler_test(const Schema_compiler_test&) = delete;
+
+    Schema_compiler_test& operator=(const Schema_compiler_test&) = delete;
+
+    Schema_compiler_test(Schema_compiler_test&&) noexcept = delete;
+
+    Schema_compiler_test& operator=(Schema_compiler_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override
+    {
+        m_definition_table.reset();
+        m_program.clear();
+        m_tokenizer.reset();
+    }
+
+    void TearDown() override {}
+
+    // Tokenizes schema, which must define a single structure named Savegame, and compiles it.  Phase one parsing
+    // is bypassed so that the test does not depend upon the presence of game assets.
+    void compile(const std::string& schema)
+    {
+        std::stringstream str;
+        str << schema;
+        m_tokenizer.run(str);
+
+        // The schema begins "struct Savegame {"; the root name is at index 1 and the definition at index 2.
+        constexpr size_t root_name_index{1};
+        const Token& root_name{m_tokenizer.at(root_name_index)};
+        bool was_created{false};
+        Definition& definition{m_definition_table.create_definition(
+            root_name.value, Def_type::struct_type, root_name.get_loc(), was_created)};
+        Def_mem member{Def_mem_type::struct_type, constants::index_member, gsl::narrow<int>(root_name_index + 1),
+            root_name.get_loc()};
+        definition.add_member(member, false, false);
+
+        Schema_compiler compiler(m_tokenizer, m_definition_table);
+        compiler.compile(root_name_index, m_program);
+    }
+
+    // Runs the compiled program, reading each leaf with One_node_reader, and passes the nodes to emitter.
+    void parse(cpt::Node_emitter& emitter)
+    {
+        Variable_manager variable_manager;
+        One_node_reader node_reader;
+        std::unordered_map<std::string, std::string> options;
+        Parser_phase_two parser(
+            m_tokenizer, m_definition_table, m_program, variable_manager, emitter, node_reader, options);
+        parser.parse();
+    }
+
+    // As above, storing the nodes in pt.
+    void parse(bpt::ptree& pt)
+    {
+        cpt::Ptree_node_emitter emitter{pt};
+        parse(emitter);
+    }
+
+    [[nodiscard]] size_t count(Opcode opcode) const
+    {
+        return gsl::narrow<size_t>(std::ranges::count_if(
+            m_program.instructions, [opcode](const Instruction& i) { return i.opcode == opcode; }));
+    }
+
+    Def_tbl m_definition_table;
+    Program m_program;
+    Tokenizer m_tokenizer;
+};
+
+TEST_F(Schema_compiler_test, unit_test_control_flow)
+{
+    EXPECT_NO_THROW(compile(R"(struct Savegame {
+        int32 Count
+        assert(Count >= 0)
+        for (i = 0; i < Count; i = i + 1) {
+            if (i == 0) { int8 First }
+            elif (i == 1) { int8[Count:capture_index] Second }
+            else { }
+        }
+    })"));
+
+    EXPECT_EQ(m_program.routines.size(), 1);
+    EXPECT_EQ(m_program.instructions.back().opcode, Opcode::ret);
+    EXPECT_EQ(count(Opcode::emit), 3);
+    EXPECT_EQ(count(Opcode::assert_true), 1);
+    EXPECT_EQ(count(Opcode::push_scope), 1);
+    EXPECT_EQ(count(Opcode::pop_scope), 1);
+    EXPECT_EQ(count(Opcode::branch_if_false), 3);
+    // Count >= 0, 0, i < Count, i + 1, i == 0, i == 1 and Count.
+    EXPECT_EQ(m_program.expressions.size(), 7);
+    for (const Instruction& instruction : m_program.instructions) {
+        const bool has_expression{instruction.opcode == Opcode::add_variable
+                                  || instruction.opcode == Opcode::assert_true
+                                  || instruction.opcode == Opcode::branch_if_false
+                                  || instruction.opcode == Opcode::set_variable};
+        EXPECT_EQ(instruction.expression < m_program.expressions.size(), has_expression);
+    }
+
+    const auto it{std::ranges::find_if(
+        m_program.statements, [](const Definition_statement& s) { return s.identifier.value == "Second"; })};
+    ASSERT_NE(it, m_program.statements.end());
+    const Definition_statement& second{*it};
+    ASSERT_EQ(second.array_suffixes.size(), 1);
+    EXPECT_EQ(second.array_suffixes.at(0).kind, Array_suffix::Kind::standard);
+    EXPECT_TRUE(second.array_suffixes.at(0).is_capture);
+    EXPECT_LT(second.array_suffixes.at(0).expression, m_program.expressions.size());
+}
+
+TEST_F(Schema_compiler_test, unit_test_document_emitter)
+{
+    ASSERT_NO_THROW(compile(R"(struct Savegame {
+        int32 Count
+        int8[Count] Lengths
+        int8[Count:capture_index][Lengths[use_capture]] Values
+        if (Values.[0].[0] == 1) { bool8 Done }
+    })"));
+
+    // The document emitted directly must match the document converted from the property tree.
+    bpt::ptree pt;
+    ASSERT_NO_THROW(parse(pt));
+    cpt::Save_document document;
+    cpt::Document_node_emitter emitter{document};
+    ASSERT_NO_THROW(parse(emitter));
+    emitter.finish();
+    bpt::ptree converted;
+    document.to_ptree(converted);
+    EXPECT_EQ(converted, pt);
+
+    cpt::Save_document expected;
+    expected.from_ptree(pt);
+    ASSERT_EQ(document.count(), expected.count());
+    for (size_t index = 0; index < document.count(); ++index) {
+        EXPECT_EQ(document.at(index).first_child, expected.at(index).first_child) << index;
+        EXPECT_EQ(document.at(index).child_count, expected.at(index).child_count) << index;
+    }
+    EXPECT_NE(document.find("Savegame.Done"), limits::invalid_size);
+}
+
+TEST_F(Schema_compiler_test, unit_test_expression_error)
+{
+    // Malformed expressions are reported when the schema is compiled rather than when a save is read.
+    EXPECT_THROW_CONTAINS_MSG(
+        compile("struct Savegame { int32 Count assert(Count +) }"), Parser_error, "Syntax error parsing token");
+}
+
+TEST_F(Schema_compiler_test, unit_test_build_prototypes)
+{
+    ASSERT_NO_THROW(compile(R"(struct Savegame {
+        int32 Count
+        bool8 Done
+        int16[Count] Values
+        if (Count == 1) { uint32 Flags }
+    })"));
+
+    const auto find{[this](const std::string& identifier) -> const cpt::Emitted_node& {
+        const auto it{std::ranges::find_if(m_program.statements,
+            [&identifier](const Definition_statement& s) { return s.identifier.value == identifier; })};
+        EXPECT_NE(it, m_program.statements.end()) << identifier;
+        return it->prototype;
+    }};
+    EXPECT_EQ(find("Savegame").type, cpt::Node_type::struct_type);
+    EXPECT_EQ(find("Savegame").size, 0);
+    EXPECT_EQ(find("Done").type, cpt::Node_type::bool_type);
+    EXPECT_EQ(find("Done").size, 1);
+    EXPECT_EQ(cpt::Save_document::get_symbol(find("Done").name), "Done");
+    EXPECT_EQ(cpt::Save_document::get_symbol(find("Done").type_name), "bool8");
+    // The prototype of an array holds the attributes of its elements.
+    EXPECT_EQ(find("Values").type, cpt::Node_type::int_type);
+    EXPECT_EQ(find("Values").size, 2);
+
+    bpt::ptree pt;
+    ASSERT_NO_THROW(parse(pt));
+    EXPECT_EQ(pt.get<int>("Savegame.Flags.__Attributes__.__Data__"), 1);
+    EXPECT_EQ(pt.get<std::string>("Savegame.Values.[0].__Attributes__.__ArrayName__"), "Values");
+}
+
+TEST_F(Schema_compiler_test, unit_test_referenced_node_names)
+{
+    ASSERT_NO_THROW(compile(R"(struct Savegame {
+        int32 Count
+        int8[Count] Lengths
+        int8[Count:capture_index][Lengths[use_capture]] Values
+        if (Values.[0].[0] == 1) { bool8 Done }
+    })"));
+
+    const std::unordered_set<Symbol> names{Schema_compiler::get_referenced_node_names(m_program)};
+    EXPECT_EQ(names.size(), 3);
+    EXPECT_TRUE(names.contains(symbol_table::find("Count")));
+    EXPECT_TRUE(names.contains(symbol_table::find("Lengths")));
+    EXPECT_TRUE(names.contains(symbol_table::find("Values")));
+}
+
+TEST_F(Schema_compiler_test, unit_test_resolve_operands)
+{
+    // Consts are imported by phase one parsing, which is bypassed.
+    bool was_created{false};
+    const File_location loc;
+    Definition& definition{m_definition_table.create_definition("MAX_COUNT", Def_type::const_type, loc, was_created)};
+    Def_mem member{Def_mem_type::const_type, "MAX_COUNT", 8, loc};
+    definition.add_member(member, false, false);
+
+    ASSERT_NO_THROW(compile(R"(struct Savegame {
+        int32 Count
+        int8[Count] Lengths
+        for (i = 0; i < Count; i = i + 1) {
+            for (j = 0; j < Lengths.[i]; j = j + 1) { int8 Value }
+        }
+        assert(Count < MAX_COUNT)
+    })"));
+
+    // Each identifier is resolved to the kind of operand it names.
+    const auto kinds{[this](const std::string& name) {
+        std::vector<esp::Operation::Kind> result;
+        for (const esp::Expression& expression : m_program.expressions) {
+            for (const esp::Operation& operation : expression.operations) {
+                if (operation.symbol == symbol_table::find(name)) {
+                    result.push_back(operation.kind);
+                }
+                else if (operation.kind == esp::Operation::Kind::node_reference
+                         && expression.node_references.at(operation.reference).keys.front()
+                                == symbol_table::find(name)) {
+                    result.push_back(operation.kind);
+                }
+            }
+        }
+        return result;
+    }};
+    using Kind = esp::Operation::Kind;
+    EXPECT_EQ(kinds("i"), (std::vector{Kind::local_variable, Kind::local_variable, Kind::local_variable}));
+    EXPECT_EQ(kinds("j"), (std::vector{Kind::local_variable, Kind::local_variable}));
+    EXPECT_EQ(kinds("Count"), (std::vector{Kind::node_reference, Kind::node_reference, Kind::node_reference}));
+    EXPECT_EQ(kinds("Lengths"), (std::vector{Kind::node_reference}));
+    EXPECT_TRUE(std::ranges::any_of(m_program.expressions, [](const esp::Expression& expression) {
+        return std::ranges::any_of(expression.operations,
+            [](const esp::Operation& operation) { return operation.kind == Kind::constant && operation.value == 8; });
+    }));
+    EXPECT_EQ(m_program.node_reference_count, 4);
+
+    // The slot of the inner loop's variable follows that of the outer loop's.
+    const auto it{std::ranges::find_if(m_program.instructions, [this](const Instruction& instruction) {
+        return instruction.opcode == Opcode::set_variable
+               && m_tokenizer.at(instruction.token_index).symbol == symbol_table::find("j");
+    })};
+    ASSERT_NE(it, m_program.instructions.end());
+    EXPECT_EQ(it->operand, 1);
+
+    bpt::ptree pt;
+    ASSERT_NO_THROW(parse(pt));
+    EXPECT_EQ(pt.get_child("Savegame").count("Value"), 1);
+}
+
+TEST_F(Schema_compiler_test, unit_test_syntax_error)
+{
+    EXPECT_THROW_CONTAINS_MSG(
+        compile("struct Savegame { int32[Count Length }"), Parser_error, "Syntax error parsing token");
+}
+
+} // namespace c4lib::schema_parser
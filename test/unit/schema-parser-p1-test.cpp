@@ -6,6 +6,8 @@
 #include <cstddef>
 #include <gtest/gtest.h>
 #include <lib/native/path.hpp>
+#include <lib/ptree/node-emitter.hpp>
+#include <lib/ptree/ptree-node-emitter.hpp>
 #include <lib/schema-parser/def-tbl.hpp>
 #include <lib/schema-parser/parser-phase-one.hpp>
 #include <lib/schema-parser/tokenizer.hpp>
@@ -44,7 +46,7 @@ protected:
         m_root_name_index = limits::invalid_size;
         m_tokenizer.reset();
         m_use_modular_loading = false;
-        m_variable_manager.init(&m_ptree, &m_ptree_parent, &m_definition_table);
+        m_variable_manager.init(&m_emitter, &m_parent, &m_definition_table);
     }
 
     void TearDown() override {}
@@ -54,7 +56,8 @@ protected:
     native::Path m_install_root;
     std::string m_mod_name;
     bpt::ptree m_ptree;
-    bpt::ptree* m_ptree_parent{&m_ptree};
+    property_tree::Ptree_node_emitter m_emitter{m_ptree};
+    size_t m_parent{property_tree::Node_emitter::root};
     size_t m_root_name_index{limits::invalid_size};
     Tokenizer m_tokenizer;
     bool m_use_modular_loading{false};
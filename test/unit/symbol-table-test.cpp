@@ -0,0 +1,77 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <lib/schema-parser/token-type.hpp>
+#include <lib/schema-parser/token.hpp>
+#include <lib/util/symbol-table.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace c4lib {
+
+class Symbol_table_test : public testing::Test {
+public:
+    Symbol_table_test() = default;
+
+    ~Symbol_table_test() override = default;
+
+    Symbol_table_test(const Symbol_table_test&) = delete;
+
+    Symbol_table_test& operator=(const Symbol_table_test&) = delete;
+
+    Symbol_table_test(Symbol_table_test&&) noexcept = delete;
+
+    Symbol_table_test& operator=(Symbol_table_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(Symbol_table_test, unit_test_intern)
+{
+    EXPECT_EQ(symbol_table::find("Symbol_table_test_never_interned"), invalid_symbol);
+
+    const Symbol symbol{symbol_table::intern("Symbol_table_test_name")};
+    ASSERT_NE(symbol, invalid_symbol);
+    EXPECT_EQ(symbol_table::intern(std::string{"Symbol_table_test_name"}), symbol);
+    EXPECT_EQ(symbol_table::find("Symbol_table_test_name"), symbol);
+    EXPECT_EQ(symbol_table::name(symbol), "Symbol_table_test_name");
+    EXPECT_NE(symbol_table::intern("Symbol_table_test_other_name"), symbol);
+
+    // Only identifier tokens are interned.
+    EXPECT_EQ(schema_parser::Token(schema_parser::Token_type::identifier, "Symbol_table_test_name").symbol, symbol);
+    EXPECT_EQ(schema_parser::Token(schema_parser::Token_type::string_literal, "Symbol_table_test_name").symbol,
+        invalid_symbol);
+}
+
+TEST_F(Symbol_table_test, unit_test_intern_concurrently)
+{
+    // Threads interning the same names concurrently must obtain the same symbols.
+    constexpr size_t thread_count{4};
+    constexpr size_t name_count{1000};
+    std::vector<std::vector<Symbol>> symbols(thread_count, std::vector<Symbol>(name_count));
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&symbols, t]() {
+                for (size_t i = 0; i < name_count; ++i) {
+                    symbols[t][i] = symbol_table::intern("Symbol_table_test_" + std::to_string(i));
+                }
+            });
+        }
+    }
+    for (size_t t = 1; t < thread_count; ++t) {
+        EXPECT_EQ(symbols[t], symbols[0]);
+    }
+    for (size_t i = 0; i < name_count; ++i) {
+        EXPECT_EQ(symbol_table::name(symbols[0][i]), "Symbol_table_test_" + std::to_string(i));
+    }
+}
+
+} // namespace c4lib
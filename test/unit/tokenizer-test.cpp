@@ -453,7 +453,8 @@ TEST_F(Tokenizer_test, unit_test_replace_and_restore_type_name_token)
     EXPECT_STREQ(replacement_token->value.c_str(), "int32");
 
     // Test replace_type_name_token when a replacement already exists
-    const Tokenizer_error expected_exception{make_ex<Tokenizer_error>(fmt::replace_typename_error, token_int32->loc)};
+    const Tokenizer_error expected_exception{
+        make_ex<Tokenizer_error>(fmt::replace_typename_error, token_int32->get_loc())};
     const std::string expected_error{expected_exception.what()};
     EXPECT_THROW_CONTAINS_MSG(
         m_tokenizer.replace_type_name_token(*token_int32), Tokenizer_error, expected_error.c_str());
@@ -6,6 +6,7 @@
 #include <include/node-type.hpp>
 #include <lib/schema-parser/def-mem-type.hpp>
 #include <lib/schema-parser/def-type.hpp>
+#include <lib/schema-parser/opcode.hpp>
 #include <lib/schema-parser/token-type.hpp>
 #include <lib/util/enum-range.hpp>
 
@@ -27,6 +28,13 @@ void test_def_type_to_string()
     }
 }
 
+void test_opcode_to_string()
+{
+    for (const auto& e : c4lib::enum_range(csp::Opcode::begin, csp::Opcode::end)) {
+        static_cast<void>(to_string(e));
+    }
+}
+
 void test_token_type_to_string()
 {
     for (const auto& e : c4lib::enum_range(csp::Token_type::begin, csp::Token_type::end)) {
@@ -75,6 +83,11 @@ TEST_F(Types_test, unit_test_def_type_to_string)
     EXPECT_NO_THROW(test_def_type_to_string());
 }
 
+TEST_F(Types_test, unit_test_opcode_to_string)
+{
+    EXPECT_NO_THROW(test_opcode_to_string());
+}
+
 TEST_F(Types_test, unit_test_token_type_to_string)
 {
     EXPECT_NO_THROW(test_token_type_to_string());
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 By David "Hankinsohl" Hankins.
+// This software is licensed under the MIT License.
+// Created by Hankinsohl on 10/16/2026.
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <gtest/gtest.h>
+#include <lib/importer/xml-scanner.hpp>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bpt = boost::property_tree;
+
+namespace {
+const char* const document{"\xEF\xBB\xBF"
+                           R"(<?xml version="1.0" encoding="ISO-8859-1"?>
+<!DOCTYPE Civ4UnitInfos [ <!ENTITY unused "x"> ]>
+<!-- Comment before the root with <Type>NOT_A_TYPE</Type> -->
+<Civ4UnitInfos xmlns="x-schema:CIV4UnitSchema.xml">
+    <UnitInfos>
+        <UnitInfo>
+            <Class>UNITCLASS_LION</Class>
+            <Type>UNIT_LION</Type>
+        </UnitInfo>
+        <UnitInfo attribute="a > b">
+            <!-- <Type>UNIT_COMMENTED</Type> -->
+            <Type>UNIT_&amp;&lt;&#65;&#x42;</Type>
+            <Type>UNIT_SECOND</Type>
+        </UnitInfo>
+        <Empty/>
+        <UnitInfo>
+            <Type><![CDATA[UNIT_<CDATA>]]></Type>
+        </UnitInfo>
+    </UnitInfos>
+</Civ4UnitInfos>
+)"};
+} // namespace
+
+namespace c4lib {
+
+class Xml_scanner_test : public testing::Test {
+public:
+    Xml_scanner_test() = default;
+
+    ~Xml_scanner_test() override = default;
+
+    Xml_scanner_test(const Xml_scanner_test&) = delete;
+
+    Xml_scanner_test& operator=(const Xml_scanner_test&) = delete;
+
+    Xml_scanner_test(Xml_scanner_test&&) noexcept = delete;
+
+    Xml_scanner_test& operator=(Xml_scanner_test&&) noexcept = delete;
+
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    // Returns the Type of each UnitInfo, as scanned.
+    static std::vector<std::string> scan_types(std::string_view text)
+    {
+        using Event = Xml_scanner::Event;
+        Xml_scanner scanner{text, "test.xml"};
+        std::vector<std::string> types;
+        size_t depth{0};
+        bool is_first_type{false};
+        for (auto event{scanner.next()}; event != Event::end_of_document; event = scanner.next()) {
+            if (event == Event::start_element) {
+                ++depth;
+                if (scanner.get_name() == "UnitInfo") {
+                    types.emplace_back();
+                    is_first_type = true;
+                }
+                else if (scanner.get_name() == "Type" && is_first_type) {
+                    is_first_type = false;
+                    for (event = scanner.next(); event != Event::end_element; event = scanner.next()) {
+                        scanner.append_text(types.back());
+                    }
+                    --depth;
+                }
+                else if (scanner.get_name() == "Class") {
+                    scanner.skip_element();
+                    --depth;
+                }
+            }
+            else if (event == Event::end_element) {
+                --depth;
+            }
+        }
+        EXPECT_EQ(depth, 0);
+        return types;
+    }
+};
+
+TEST_F(Xml_scanner_test, unit_test_scan)
+{
+    // The Types scanned must match those read into a property tree.
+    std::istringstream in{document};
+    bpt::ptree tree;
+    bpt::read_xml(in, tree);
+    std::vector<std::string> expected;
+    for (const auto& [name, child] : tree.get_child("Civ4UnitInfos.UnitInfos")) {
+        if (name == "UnitInfo") {
+            expected.push_back(child.get<std::string>("Type"));
+        }
+    }
+
+    const std::vector<std::string> types{scan_types(document)};
+    EXPECT_EQ(types, expected);
+    EXPECT_EQ(types, (std::vector<std::string>{"UNIT_LION", "UNIT_&<AB", "UNIT_<CDATA>"}));
+}
+
+TEST_F(Xml_scanner_test, unit_test_malformed)
+{
+    EXPECT_THROW(static_cast<void>(scan_types("<A><B></A>")), bpt::xml_parser_error);
+    EXPECT_THROW(static_cast<void>(scan_types("<A><UnitInfo><Type>")), bpt::xml_parser_error);
+    EXPECT_THROW(
+        static_cast<void>(scan_types("<A><UnitInfo><Type>&bad;</Type></UnitInfo></A>")), bpt::xml_parser_error);
+    EXPECT_THROW(static_cast<void>(scan_types("text<A/>")), bpt::xml_parser_error);
+    EXPECT_THROW(static_cast<void>(scan_types("<A><!-- unterminated </A>")), bpt::xml_parser_error);
+
+    try {
+        static_cast<void>(scan_types("<A>\n\n</B>"));
+        FAIL();
+    }
+    catch (const bpt::xml_parser_error& e) {
+        EXPECT_EQ(e.filename(), "test.xml");
+        EXPECT_EQ(e.line(), 3);
+    }
+}
+
+} // namespace c4lib
@@ -2,19 +2,38 @@
 // This software is licensed under the MIT License.
 // Created by Hankinsohl on 10/29/2024.
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <gtest/gtest.h>
 #include <ios>
+#include <istream>
 #include <lib/io/io.hpp>
+#include <lib/io/span-streambuf.hpp>
+#include <lib/md5/checksum.hpp>
 #include <lib/native/path.hpp>
+#include <lib/util/constants.hpp>
 #include <lib/util/limits.hpp>
+#include <lib/util/narrow.hpp>
 #include <lib/util/options.hpp>
+#include <lib/util/tune.hpp>
+#include <lib/zlib/deflate-checkpoints.hpp>
+#include <lib/zlib/deflate-streambuf.hpp>
+#include <lib/zlib/inflate-pipeline.hpp>
 #include <lib/zlib/zlib-engine.hpp>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <span>
 #include <sstream>
 #include <string>
 #include <test/util/constants.hpp>
 #include <test/util/util.hpp>
 #include <unordered_map>
+#include <vector>
 
 using namespace std::string_literals;
 namespace ctc = c4lib::test::constants;
@@ -61,6 +80,300 @@ TEST_F(ZLib_engine_test, unit_test_inflate)
         savegame, out, count_header, count_compressed, count_decompressed, count_footer, count_total, m_options));
 }
 
+// Inflates a save held in memory and checks that the result matches that obtained by inflating the save's file.
+TEST_F(ZLib_engine_test, unit_test_inflate_from_memory)
+{
+    const native::Path savegame{ctc::data_saves_dir / native::Path{"Brennus BC-4000-2.CivBeyondSwordSave"}};
+    m_options[options::debug_write_binaries] = "0";
+
+    ZLib_engine file_engine;
+    size_t count_header{limits::invalid_size};
+    size_t count_compressed{limits::invalid_size};
+    size_t count_decompressed{limits::invalid_size};
+    size_t count_footer{limits::invalid_size};
+    size_t count_total{limits::invalid_size};
+    std::stringstream expected;
+    ASSERT_NO_THROW(file_engine.inflate(savegame, expected, count_header, count_compressed, count_decompressed,
+        count_footer, count_total, m_options));
+
+    std::stringstream original;
+    original.unsetf(std::ios::skipws);
+    io::read_binary_file_to_stream(savegame, 0, 0, original);
+    const std::string bytes{original.str()};
+    io::Span_streambuf buffer{std::as_bytes(std::span{bytes})};
+    std::istream in{&buffer};
+
+    ZLib_engine memory_engine;
+    size_t memory_count_header{limits::invalid_size};
+    size_t memory_count_compressed{limits::invalid_size};
+    size_t memory_count_decompressed{limits::invalid_size};
+    size_t memory_count_footer{limits::invalid_size};
+    size_t memory_count_total{limits::invalid_size};
+    std::stringstream actual;
+    ASSERT_NO_THROW(memory_engine.inflate(savegame, in, actual, memory_count_header, memory_count_compressed,
+        memory_count_decompressed, memory_count_footer, memory_count_total, m_options));
+
+    EXPECT_EQ(memory_count_header, count_header);
+    EXPECT_EQ(memory_count_compressed, count_compressed);
+    EXPECT_EQ(memory_count_decompressed, count_decompressed);
+    EXPECT_EQ(memory_count_footer, count_footer);
+    EXPECT_EQ(memory_count_total, count_total);
+    EXPECT_EQ(actual.str(), expected.str());
+}
+
+// Inflates saves into a contiguous buffer and deflates them back.  Tiny-Map-BC-4000 inflates to more than
+// tune::inflate_reserve_ratio times its size, so the buffer must grow while inflating.
+TEST_F(ZLib_engine_test, unit_test_inflate_to_buffer)
+{
+    m_options[options::debug_write_binaries] = "0";
+    for (const std::string save_name : {"Tiny-Map-BC-4000", "Mao Zedong_1936-AD_Feb-26-2023_07-31-57"}) {
+        const native::Path savegame{ctc::data_saves_dir / native::Path{save_name + ".CivBeyondSwordSave"}};
+
+        ZLib_engine stream_engine;
+        size_t count_header{limits::invalid_size};
+        size_t count_compressed{limits::invalid_size};
+        size_t count_decompressed{limits::invalid_size};
+        size_t count_footer{limits::invalid_size};
+        size_t count_total{limits::invalid_size};
+        std::stringstream expected;
+        ASSERT_NO_THROW(stream_engine.inflate(savegame, expected, count_header, count_compressed, count_decompressed,
+            count_footer, count_total, m_options))
+            << save_name;
+
+        ZLib_engine buffer_engine;
+        size_t buffer_count_header{limits::invalid_size};
+        size_t buffer_count_compressed{limits::invalid_size};
+        size_t buffer_count_decompressed{limits::invalid_size};
+        size_t buffer_count_footer{limits::invalid_size};
+        size_t buffer_count_total{limits::invalid_size};
+        std::vector<std::byte> composite;
+        ASSERT_NO_THROW(buffer_engine.inflate(savegame, composite, buffer_count_header, buffer_count_compressed,
+            buffer_count_decompressed, buffer_count_footer, buffer_count_total, m_options))
+            << save_name;
+
+        EXPECT_EQ(buffer_count_header, count_header) << save_name;
+        EXPECT_EQ(buffer_count_compressed, count_compressed) << save_name;
+        EXPECT_EQ(buffer_count_decompressed, count_decompressed) << save_name;
+        EXPECT_EQ(buffer_count_footer, count_footer) << save_name;
+        EXPECT_EQ(buffer_count_total, count_total) << save_name;
+        EXPECT_EQ(composite.size(), count_total) << save_name;
+        const std::string expected_bytes{expected.str()};
+        EXPECT_TRUE(std::ranges::equal(composite, std::as_bytes(std::span{expected_bytes}))) << save_name;
+
+        std::stringstream compressed;
+        EXPECT_NO_THROW(buffer_engine.deflate(savegame, composite, compressed, count_footer, count_header,
+            count_compressed, count_decompressed, count_total, m_options))
+            << save_name;
+        std::stringstream original;
+        original.unsetf(std::ios::skipws);
+        io::read_binary_file_to_stream(savegame, 0, 0, original);
+        std::stringstream errors;
+        EXPECT_EQ(test::compare_binary_streams(original, compressed, errors), 0) << save_name << errors.str();
+    }
+}
+
+// Reads every save through an inflate pipeline and checks that the composite read matches that written by inflate.
+// A small ring is also used so that buffers are reused many times and reads span buffers.
+TEST_F(ZLib_engine_test, unit_test_inflate_pipeline)
+{
+    m_options[options::debug_write_binaries] = "0";
+    for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{ctc::data_saves_dir}}) {
+        if (entry.path().extension() != c4lib::constants::save_extension) {
+            continue;
+        }
+        const std::string filename{entry.path().string()};
+        const native::Path savegame{filename};
+
+        ZLib_engine engine;
+        size_t count_header{limits::invalid_size};
+        size_t count_compressed{limits::invalid_size};
+        size_t count_decompressed{limits::invalid_size};
+        size_t count_footer{limits::invalid_size};
+        size_t count_total{limits::invalid_size};
+        std::vector<std::byte> expected;
+        ASSERT_NO_THROW(engine.inflate(savegame, expected, count_header, count_compressed, count_decompressed,
+            count_footer, count_total, m_options))
+            << filename;
+
+        std::stringstream save_stream;
+        save_stream.unsetf(std::ios::skipws);
+        io::read_binary_file_to_stream(savegame, 0, 0, save_stream);
+        const std::string save{save_stream.str()};
+
+        for (const size_t buffer_size : {tune::pipeline_buffer_size, size_t{1000}}) {
+            Inflate_pipeline pipeline{std::as_bytes(std::span{save}), 2, buffer_size};
+            EXPECT_EQ(pipeline.count_header(), count_header) << filename;
+            EXPECT_EQ(pipeline.count_footer(), count_footer) << filename;
+
+            // Read in pieces of varying size, as the binary node reader does.
+            std::vector<std::byte> actual(count_total);
+            size_t position{0};
+            size_t piece{1};
+            while (position < actual.size()) {
+                const size_t count{std::min(piece, actual.size() - position)};
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                ASSERT_NO_THROW(pipeline.read(reinterpret_cast<char*>(actual.data() + position),
+                    gsl::narrow<std::streamsize>(count)))
+                    << filename;
+                position += count;
+                piece = piece % 4099 + 3;
+            }
+            EXPECT_TRUE(std::ranges::equal(actual, expected)) << filename;
+
+            char past_end{0};
+            EXPECT_THROW(pipeline.read(&past_end, 1), std::runtime_error) << filename;
+        }
+    }
+}
+
+// Destroys pipelines before they are read to the end, which requires the producer thread to be stopped.
+TEST_F(ZLib_engine_test, unit_test_inflate_pipeline_cancel)
+{
+    const native::Path savegame{
+        ctc::data_saves_dir / native::Path{"Mao Zedong_1936-AD_Feb-26-2023_07-31-57.CivBeyondSwordSave"}};
+    std::stringstream save_stream;
+    save_stream.unsetf(std::ios::skipws);
+    io::read_binary_file_to_stream(savegame, 0, 0, save_stream);
+    const std::string save{save_stream.str()};
+
+    EXPECT_NO_THROW(std::make_unique<Inflate_pipeline>(std::as_bytes(std::span{save}), 2, 1000).reset());
+
+    auto pipeline{std::make_unique<Inflate_pipeline>(std::as_bytes(std::span{save}), 2, 1000)};
+    std::array<char, 5000> bytes{};
+    EXPECT_NO_THROW(pipeline->read(bytes.data(), gsl::narrow<std::streamsize>(bytes.size())));
+    EXPECT_NO_THROW(pipeline.reset());
+}
+
+// Writes the composite of every save through a Deflate_streambuf and checks that the result matches that obtained by
+// deflating the composite and then calculating the checksum.  The composite is written in pieces of varying size, as
+// the binary node writer does.
+TEST_F(ZLib_engine_test, unit_test_deflate_streambuf)
+{
+    // MAX_PLAYERS, NUM_GAME_OPTION_TYPES and NUM_MULTIPLAYER_OPTION_TYPES for BTS saves.
+    constexpr int max_players{19};
+    constexpr int num_game_option_types{24};
+    constexpr int num_multiplayer_option_types{5};
+
+    m_options[options::debug_write_binaries] = "0";
+    for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{ctc::data_saves_dir}}) {
+        if (entry.path().extension() != c4lib::constants::save_extension) {
+            continue;
+        }
+        const std::string filename{entry.path().string()};
+        const native::Path savegame{filename};
+
+        ZLib_engine engine;
+        size_t count_header{limits::invalid_size};
+        size_t count_compressed{limits::invalid_size};
+        size_t count_decompressed{limits::invalid_size};
+        size_t count_footer{limits::invalid_size};
+        size_t count_total{limits::invalid_size};
+        std::vector<std::byte> composite;
+        ASSERT_NO_THROW(engine.inflate(savegame, composite, count_header, count_compressed, count_decompressed,
+            count_footer, count_total, m_options))
+            << filename;
+
+        std::stringstream expected;
+        ASSERT_NO_THROW(engine.deflate(savegame, composite, expected, count_footer, count_header, count_compressed,
+            count_decompressed, count_total, m_options))
+            << filename;
+        const std::string expected_bytes{expected.str()};
+        md5::Checksum checksum{std::as_bytes(std::span{expected_bytes}), max_players, num_game_option_types,
+            num_multiplayer_option_types};
+        const std::string md5{checksum.get_hash()};
+        expected.seekp(-gsl::narrow<std::streamoff>(4 + md5.length()), std::ios_base::end);
+        io::write_string(expected, md5);
+
+        std::stringstream actual;
+        {
+            Deflate_streambuf save_buffer{
+                actual, count_footer, max_players, num_game_option_types, num_multiplayer_option_types};
+            std::ostream out{&save_buffer};
+            size_t position{0};
+            size_t piece{1};
+            while (position < composite.size()) {
+                const size_t count{std::min(piece, composite.size() - position)};
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                out.write(reinterpret_cast<const char*>(composite.data() + position),
+                    gsl::narrow<std::streamsize>(count));
+                position += count;
+                piece = piece % 70001 + 3;
+            }
+            ASSERT_TRUE(out) << filename;
+            ASSERT_NO_THROW(save_buffer.finish()) << filename;
+        }
+        std::stringstream errors;
+        EXPECT_EQ(test::compare_binary_streams(expected, actual, errors), 0) << filename << errors.str();
+    }
+}
+
+// Writes each save repeatedly through Deflate_streambufs which share a checkpoint table, modifying the composite
+// between writes, and checks that each save written matches that written without checkpoints.
+TEST_F(ZLib_engine_test, unit_test_deflate_checkpoints)
+{
+    // MAX_PLAYERS, NUM_GAME_OPTION_TYPES and NUM_MULTIPLAYER_OPTION_TYPES for BTS saves.
+    constexpr int max_players{19};
+    constexpr int num_game_option_types{24};
+    constexpr int num_multiplayer_option_types{5};
+
+    // A small interval exercises many checkpoints, including checkpoints which do not fall on chunk boundaries.
+    constexpr size_t interval{0x10000};
+
+    const auto write{[&](const std::vector<std::byte>& composite, size_t count_footer,
+                         Deflate_checkpoints* checkpoints, size_t& count_reused) {
+        std::stringstream save;
+        Deflate_streambuf save_buffer{
+            save, count_footer, max_players, num_game_option_types, num_multiplayer_option_types, checkpoints};
+        std::ostream out{&save_buffer};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        out.write(reinterpret_cast<const char*>(composite.data()), gsl::narrow<std::streamsize>(composite.size()));
+        save_buffer.finish();
+        count_reused = save_buffer.count_reused();
+        return save.str();
+    }};
+
+    m_options[options::debug_write_binaries] = "0";
+    for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{ctc::data_saves_dir}}) {
+        if (entry.path().extension() != c4lib::constants::save_extension) {
+            continue;
+        }
+        const std::string filename{entry.path().string()};
+        const native::Path savegame{filename};
+
+        ZLib_engine engine;
+        size_t count_header{limits::invalid_size};
+        size_t count_compressed{limits::invalid_size};
+        size_t count_decompressed{limits::invalid_size};
+        size_t count_footer{limits::invalid_size};
+        size_t count_total{limits::invalid_size};
+        std::vector<std::byte> composite;
+        ASSERT_NO_THROW(engine.inflate(savegame, composite, count_header, count_compressed, count_decompressed,
+            count_footer, count_total, m_options))
+            << filename;
+
+        // The deflated data follows the header and the 4-byte pad.
+        const size_t count_data_offset{count_header + sizeof(uint32_t)};
+        Deflate_checkpoints checkpoints{interval};
+        size_t count_reused{0};
+        const std::string expected{write(composite, count_footer, nullptr, count_reused)};
+
+        // The first write records checkpoints; the second reuses all the compressed data preceding the last.
+        EXPECT_EQ(write(composite, count_footer, &checkpoints, count_reused), expected) << filename;
+        EXPECT_EQ(count_reused, 0) << filename;
+        EXPECT_FALSE(checkpoints.checkpoints.empty()) << filename;
+        EXPECT_EQ(write(composite, count_footer, &checkpoints, count_reused), expected) << filename;
+        EXPECT_EQ(count_reused != 0, count_decompressed >= interval) << filename;
+
+        // Modify a byte three quarters of the way through the data, and then a byte at its start.
+        for (const size_t offset : {count_decompressed * 3 / 4, size_t{0}}) {
+            composite[count_data_offset + offset] ^= std::byte{0xFF};
+            const std::string modified{write(composite, count_footer, nullptr, count_reused)};
+            EXPECT_EQ(write(composite, count_footer, &checkpoints, count_reused), modified) << filename;
+            EXPECT_EQ(count_reused != 0, offset >= interval) << filename;
+        }
+    }
+}
+
 TEST_F(ZLib_engine_test, unit_test_deflate)
 {
     // Obtain a composite, decompressed stream by first inflating a savegame.
@@ -100,4 +413,41 @@ TEST_F(ZLib_engine_test, unit_test_deflate)
     EXPECT_EQ(test::compare_binary_streams(original, compressed, errors), 0) << errors.str();
 }
 
+// Deflates a small save followed by a large one whose decompressed data has been replaced by incompressible bytes.
+// A buffer sized for the first save is too small for the second, so buffers must not be reused between saves.
+TEST_F(ZLib_engine_test, unit_test_deflate_saves_of_differing_size)
+{
+    std::mt19937 generator; // NOLINT(cert-msc32-c, cert-msc51-cpp): a fixed seed is wanted for repeatability.
+    bool is_first{true};
+    for (const std::string save_name : {"Tiny-Map-BC-4000", "Mao Zedong_1936-AD_Feb-26-2023_07-31-57"}) {
+        const native::Path savegame{ctc::data_saves_dir / native::Path{save_name + ".CivBeyondSwordSave"}};
+        ZLib_engine engine;
+        size_t count_header{limits::invalid_size};
+        size_t count_compressed{limits::invalid_size};
+        size_t count_decompressed{limits::invalid_size};
+        size_t count_footer{limits::invalid_size};
+        size_t count_total{limits::invalid_size};
+        std::stringstream composite;
+        ASSERT_NO_THROW(engine.inflate(savegame, composite, count_header, count_compressed, count_decompressed,
+            count_footer, count_total, m_options))
+            << save_name;
+
+        if (!is_first) {
+            std::string data{composite.str()};
+            for (size_t i = count_header; i < count_header + count_decompressed; ++i) {
+                data[i] = static_cast<char>(generator());
+            }
+            composite.str(data);
+        }
+        is_first = false;
+
+        const size_t expected_count_decompressed{count_decompressed};
+        std::stringstream compressed;
+        EXPECT_NO_THROW(engine.deflate(savegame, composite, compressed, count_footer, count_header, count_compressed,
+            count_decompressed, count_total, m_options))
+            << save_name;
+        EXPECT_EQ(count_decompressed, expected_count_decompressed) << save_name;
+    }
+}
+
 } // namespace c4lib::zlib